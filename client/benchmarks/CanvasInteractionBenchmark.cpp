@@ -0,0 +1,489 @@
+// CanvasInteractionBenchmark.cpp - Headless replay of the S1/S2/S3 canvas scenarios
+// (docs/text-performance-blueprint-checklist.md) with machine-readable results.
+//
+// Runs ScreenCanvas under the offscreen platform, generates a synthetic scene, drives it with
+// synthetic input (ctrl-wheel zoom, wheel pan, mouse drag, group transform with snap, inline text
+// editing) and prints one JSON document with frame-time percentiles, canvas relayout counters and
+// text raster job totals per scenario.
+//
+// --document-check also loads a canvas document with two videos, serializes it again and fails
+// (exit code 1) unless their volume and mute state survive the round trip.
+//
+// Usage:
+//   MouffetteCanvasBenchmark [--scenario s1|s2|s3|all] [--text-items N] [--image-items N]
+//                            [--frames N] [--frame-interval-ms N] [--document-check]
+//                            [--output results.json]
+
+#include "frontend/rendering/canvas/ScreenCanvas.h"
+#include "backend/domain/media/MediaItems.h"
+#include "backend/domain/media/TextMediaItem.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGraphicsScene>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QTemporaryDir>
+#include <QPainter>
+#include <QWheelEvent>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+struct BenchConfig {
+    int textItems = 20;
+    int imageItems = 20;
+    int frames = 240;
+    int frameIntervalMs = 16;
+};
+
+struct FrameSamples {
+    QVector<double> workMs;  // input dispatch + synchronous repaint
+    QVector<double> frameMs; // full frame including deferred timers (>= interval when idle)
+};
+
+QJsonObject percentiles(QVector<double> samples) {
+    QJsonObject o;
+    if (samples.isEmpty()) {
+        return o;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        const int upperBound = static_cast<int>(samples.size()) - 1;
+        const int idx = std::clamp(static_cast<int>(std::ceil(upperBound * q)), 0, upperBound);
+        return samples.at(idx);
+    };
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    o["p50"] = at(0.50);
+    o["p90"] = at(0.90);
+    o["p95"] = at(0.95);
+    o["p99"] = at(0.99);
+    o["max"] = samples.last();
+    o["mean"] = sum / samples.size();
+    return o;
+}
+
+QPixmap syntheticImage(int index) {
+    QPixmap pm(640, 360);
+    pm.fill(QColor::fromHsv((index * 47) % 360, 160, 200));
+    QPainter p(&pm);
+    p.setPen(Qt::white);
+    p.drawRect(pm.rect().adjusted(8, 8, -9, -9));
+    p.drawText(pm.rect(), Qt::AlignCenter, QStringLiteral("image %1").arg(index));
+    return pm;
+}
+
+QString heavyText(int paragraphs) {
+    QStringList lines;
+    for (int i = 0; i < paragraphs; ++i) {
+        lines << QStringLiteral("Line %1 - The quick brown fox jumps over the lazy dog 0123456789").arg(i + 1);
+    }
+    return lines.join('\n');
+}
+
+class CanvasBenchmark {
+public:
+    explicit CanvasBenchmark(const BenchConfig& config) : m_config(config) {
+        m_canvas = new ScreenCanvas();
+        m_canvas->resize(1600, 900);
+        m_canvas->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+        m_canvas->setScreens({ScreenInfo(0, 1920, 1080, 0, 0, true), ScreenInfo(1, 1920, 1080, 1920, 0, false)});
+        m_canvas->show();
+        pump(50);
+        m_canvas->recenterWithMargin();
+        pump(50);
+    }
+
+    ~CanvasBenchmark() { delete m_canvas; }
+
+    void buildScene(int textItems, int imageItems, bool heavyBorderedText) {
+        clearMedia();
+        QGraphicsScene* scene = m_canvas->scene();
+        const QRectF area = screensArea();
+        const int total = std::max(1, textItems + imageItems);
+        const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(total)))));
+        const qreal cellW = area.width() / columns;
+        const qreal cellH = area.height() / columns;
+        int slot = 0;
+        auto cellPos = [&](int s) {
+            return area.topLeft() + QPointF((s % columns) * cellW, (s / columns) * cellH);
+        };
+
+        for (int i = 0; i < textItems; ++i, ++slot) {
+            const bool heavy = heavyBorderedText && i == 0;
+            auto* text = new TextMediaItem(QSize(heavy ? 1200 : 400, heavy ? 900 : 160), 12, 30,
+                                           heavy ? heavyText(40) : QStringLiteral("Text item %1").arg(i + 1));
+            if (heavy) {
+                text->setTextBorderWidth(4.0);
+            }
+            text->setScale(std::min(cellW / text->baseSizePx().width(), cellH / text->baseSizePx().height()) * 0.9);
+            text->setPos(cellPos(slot));
+            text->setZValue(1.0 + slot);
+            scene->addItem(text);
+            m_media.append(text);
+        }
+        for (int i = 0; i < imageItems; ++i, ++slot) {
+            auto* image = new ResizablePixmapItem(syntheticImage(i), 12, 30, QStringLiteral("image_%1.png").arg(i));
+            image->setScale(std::min(cellW / image->baseSizePx().width(), cellH / image->baseSizePx().height()) * 0.9);
+            image->setPos(cellPos(slot));
+            image->setZValue(1.0 + slot);
+            scene->addItem(image);
+            m_media.append(image);
+        }
+        pump(100);
+    }
+
+    QJsonObject runScenario(const QString& name, const std::function<void(int)>& step) {
+        m_canvas->resetInteractionCounters();
+        TextMediaItem::resetRasterJobTotals();
+        FrameSamples samples;
+        for (int frame = 0; frame < m_config.frames; ++frame) {
+            QElapsedTimer frameTimer;
+            frameTimer.start();
+            step(frame);
+            QCoreApplication::processEvents();
+            m_canvas->viewport()->repaint();
+            samples.workMs.append(frameTimer.nsecsElapsed() / 1e6);
+            pumpUntil(frameTimer, m_config.frameIntervalMs);
+            samples.frameMs.append(frameTimer.nsecsElapsed() / 1e6);
+        }
+        // Let trailing relayouts and raster jobs settle so counters reflect the whole scenario
+        pump(250);
+
+        const ScreenCanvas::InteractionCounters counters = m_canvas->interactionCounters();
+        const TextMediaItem::RasterJobTotals raster = TextMediaItem::rasterJobTotals();
+
+        QJsonObject canvas;
+        canvas["zoomEvents"] = static_cast<qint64>(counters.zoomEvents);
+        canvas["relayouts"] = static_cast<qint64>(counters.relayouts);
+        canvas["fullRelayouts"] = static_cast<qint64>(counters.fullRelayouts);
+        canvas["selectionChrome"] = static_cast<qint64>(counters.selectionChrome);
+        canvas["sceneChangedBatches"] = static_cast<qint64>(counters.sceneChangedBatches);
+        canvas["groupTransforms"] = static_cast<qint64>(counters.groupTransforms);
+
+        QJsonObject text;
+        text["started"] = static_cast<qint64>(raster.started);
+        text["completed"] = static_cast<qint64>(raster.completed);
+        text["dropped"] = static_cast<qint64>(raster.dropped);
+        text["stale"] = static_cast<qint64>(raster.stale);
+        text["avgMs"] = raster.completed > 0 ? static_cast<double>(raster.totalDurationMs) / raster.completed : 0.0;
+
+        QJsonObject result;
+        result["name"] = name;
+        result["frames"] = m_config.frames;
+        result["mediaItems"] = static_cast<int>(m_media.size());
+        result["workMs"] = percentiles(samples.workMs);
+        result["frameMs"] = percentiles(samples.frameMs);
+        result["canvas"] = canvas;
+        result["textRaster"] = text;
+        return result;
+    }
+
+    // Ctrl+wheel zoom oscillating in/out around the viewport center
+    void zoomStep(int frame) {
+        const int direction = ((frame / 30) % 2 == 0) ? 1 : -1;
+        sendWheel(QPoint(0, 40 * direction), Qt::ControlModifier);
+    }
+
+    void panStep(int frame) {
+        const int phase = (frame / 20) % 4;
+        const QPoint delta = phase == 0 ? QPoint(30, 0) : phase == 1 ? QPoint(0, 30) : phase == 2 ? QPoint(-30, 0) : QPoint(0, -30);
+        sendWheel(delta, Qt::NoModifier);
+    }
+
+    // Single-item drag with screen/media snapping enabled
+    void dragSnapStep(int frame) {
+        if (m_media.isEmpty()) return;
+        ResizableMediaBase* item = m_media.last();
+        if (frame == 0) {
+            m_canvas->scene()->clearSelection();
+            item->setSelected(true);
+            m_canvas->beginGroupTransform({item});
+        }
+        const qreal t = static_cast<qreal>(frame) / std::max(1, m_config.frames - 1);
+        m_canvas->updateGroupTranslation(QPointF(std::sin(t * 6.283) * 400.0, std::cos(t * 6.283) * 200.0), true);
+        if (frame == m_config.frames - 1) {
+            m_canvas->endGroupTransform();
+        }
+    }
+
+    // Mouse drag of a multi-item selection through the canvas' own event handling
+    void multiMoveStep(int frame) {
+        if (m_media.size() < 2) return;
+        QWidget* vp = m_canvas->viewport();
+        if (frame == 0) {
+            m_canvas->scene()->clearSelection();
+            const int count = std::min<int>(8, m_media.size());
+            for (int i = 0; i < count; ++i) m_media.at(i)->setSelected(true);
+            m_dragAnchorVp = m_canvas->mapFromScene(m_media.first()->sceneBoundingRect().center());
+            sendMouse(vp, QEvent::MouseButtonPress, m_dragAnchorVp, Qt::LeftButton);
+        }
+        const qreal t = static_cast<qreal>(frame) / std::max(1, m_config.frames - 1);
+        const QPoint offset(static_cast<int>(std::sin(t * 6.283) * 120.0), static_cast<int>(t * 80.0));
+        sendMouse(vp, QEvent::MouseMove, m_dragAnchorVp + offset, Qt::LeftButton);
+        if (frame == m_config.frames - 1) {
+            sendMouse(vp, QEvent::MouseButtonRelease, m_dragAnchorVp + offset, Qt::NoButton);
+        }
+    }
+
+    // Inline text editing interleaved with zoom, pan and selection changes (S3)
+    void textEditStep(int frame) {
+        TextMediaItem* text = firstTextItem();
+        if (!text) return;
+        if (frame == 0) {
+            m_canvas->scene()->clearSelection();
+            text->setSelected(true);
+            text->beginInlineEditing();
+        }
+        switch (frame % 4) {
+            case 0: sendKey(QStringLiteral("abcdefghijklmnopqrstuvwxyz").at(frame % 26)); break;
+            case 1: zoomStep(frame); break;
+            case 2: panStep(frame); break;
+            case 3: {
+                if (m_media.size() > 1) {
+                    ResizableMediaBase* other = m_media.at(1 + (frame / 4) % (m_media.size() - 1));
+                    other->setSelected(!other->isSelected());
+                }
+                break;
+            }
+        }
+        if (frame == m_config.frames - 1 && text->isEditing()) {
+            text->commitInlineEditing();
+        }
+    }
+
+    // Load a document with two videos (one muted) and check their audio state after re-serializing
+    QJsonObject runDocumentRoundTrip() {
+        clearMedia();
+        QJsonObject result;
+        result["name"] = QStringLiteral("document.videoAudio");
+        QTemporaryDir dir;
+        QFile clip(dir.filePath(QStringLiteral("clip.mp4")));
+        // Video sources load lazily, so the placeholder is never decoded during the check
+        if (!dir.isValid() || !clip.open(QIODevice::WriteOnly) || clip.write("placeholder") < 0) {
+            result["passed"] = false;
+            result["error"] = QStringLiteral("cannot create placeholder video file");
+            return result;
+        }
+        clip.close();
+
+        QJsonObject file;
+        file["path"] = clip.fileName();
+        file["fileName"] = QStringLiteral("clip.mp4");
+        file["width"] = 320;
+        file["height"] = 180;
+        QJsonObject files;
+        files["roundtrip-file"] = file;
+
+        struct Expected { QString mediaId; qreal volume; bool muted; };
+        const QVector<Expected> expected = {
+            {QStringLiteral("roundtrip-muted"), 0.35, true},
+            {QStringLiteral("roundtrip-audible"), 0.6, false}};
+        QJsonArray media;
+        for (int i = 0; i < expected.size(); ++i) {
+            QJsonObject m;
+            m["type"] = QStringLiteral("video");
+            m["mediaId"] = expected.at(i).mediaId;
+            m["fileId"] = QStringLiteral("roundtrip-file");
+            m["baseWidth"] = 320;
+            m["baseHeight"] = 180;
+            m["x"] = 400.0 * i;
+            m["z"] = 1.0 + i;
+            m["volume"] = expected.at(i).volume;
+            m["muted"] = expected.at(i).muted;
+            media.append(m);
+        }
+        QJsonObject document;
+        document["files"] = files;
+        document["media"] = media;
+
+        QString error;
+        if (!m_canvas->loadDocument(document, &error)) {
+            result["passed"] = false;
+            result["error"] = error;
+            return result;
+        }
+        pump(50);
+
+        bool passed = true;
+        QJsonArray items;
+        const QJsonArray saved = m_canvas->serializeDocument().value("media").toArray();
+        for (const Expected& e : expected) {
+            QJsonObject item;
+            item["mediaId"] = e.mediaId;
+            bool found = false;
+            for (const QJsonValue& v : saved) {
+                const QJsonObject m = v.toObject();
+                if (m.value("mediaId").toString() != e.mediaId) continue;
+                found = true;
+                item["volume"] = m.value("volume").toDouble(-1.0);
+                item["muted"] = m.value("muted").toBool();
+                passed = passed && std::abs(m.value("volume").toDouble(-1.0) - e.volume) < 0.01
+                    && m.value("muted").toBool() == e.muted;
+            }
+            passed = passed && found;
+            items.append(item);
+        }
+        result["items"] = items;
+        result["passed"] = passed;
+        return result;
+    }
+
+private:
+    void clearMedia() {
+        for (ResizableMediaBase* media : m_media) {
+            m_canvas->deleteMediaItem(media);
+        }
+        m_media.clear();
+        pump(50);
+    }
+
+    QRectF screensArea() const {
+        QRectF area;
+        for (QGraphicsItem* item : m_canvas->scene()->items()) {
+            // Screen rectangles are top-level rect items below the media z range
+            if (dynamic_cast<QGraphicsRectItem*>(item) && !item->parentItem() && item->zValue() < 1.0) {
+                area = area.united(item->sceneBoundingRect());
+            }
+        }
+        return area.isEmpty() ? QRectF(0, 0, 1920, 540) : area;
+    }
+
+    TextMediaItem* firstTextItem() const {
+        for (ResizableMediaBase* media : m_media) {
+            if (auto* text = dynamic_cast<TextMediaItem*>(media)) return text;
+        }
+        return nullptr;
+    }
+
+    void sendWheel(const QPoint& pixelDelta, Qt::KeyboardModifiers modifiers) {
+        QWidget* vp = m_canvas->viewport();
+        const QPointF pos(vp->width() / 2.0, vp->height() / 2.0);
+        QWheelEvent ev(pos, vp->mapToGlobal(pos), pixelDelta, pixelDelta * 8 / 5, Qt::NoButton, modifiers,
+                       Qt::NoScrollPhase, false, Qt::MouseEventSynthesizedByApplication);
+        QCoreApplication::sendEvent(vp, &ev);
+    }
+
+    void sendMouse(QWidget* vp, QEvent::Type type, const QPoint& pos, Qt::MouseButtons buttons) {
+        const Qt::MouseButton button = (type == QEvent::MouseMove) ? Qt::NoButton : Qt::LeftButton;
+        QMouseEvent ev(type, QPointF(pos), vp->mapToGlobal(QPointF(pos)), button, buttons, Qt::NoModifier);
+        QCoreApplication::sendEvent(vp, &ev);
+    }
+
+    void sendKey(QChar c) {
+        // Key events go to the view, which forwards them to the focused inline editor
+        QKeyEvent press(QEvent::KeyPress, Qt::Key_unknown, Qt::NoModifier, QString(c));
+        QKeyEvent release(QEvent::KeyRelease, Qt::Key_unknown, Qt::NoModifier, QString(c));
+        QCoreApplication::sendEvent(m_canvas, &press);
+        QCoreApplication::sendEvent(m_canvas, &release);
+    }
+
+    static void pump(int ms) {
+        QElapsedTimer t;
+        t.start();
+        pumpUntil(t, ms);
+    }
+
+    static void pumpUntil(const QElapsedTimer& timer, int ms) {
+        while (timer.elapsed() < ms) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, static_cast<int>(ms - timer.elapsed()));
+        }
+    }
+
+    BenchConfig m_config;
+    ScreenCanvas* m_canvas = nullptr;
+    QList<ResizableMediaBase*> m_media;
+    QPoint m_dragAnchorVp;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("MouffetteCanvasBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless ScreenCanvas interaction benchmark");
+    parser.addHelpOption();
+    QCommandLineOption scenarioOpt("scenario", "Scenario suite: s1, s2, s3 or all.", "name", "all");
+    QCommandLineOption textOpt("text-items", "Text items in generated S2/S3 scenes.", "count", "20");
+    QCommandLineOption imageOpt("image-items", "Image items in generated S2/S3 scenes.", "count", "20");
+    QCommandLineOption framesOpt("frames", "Frames per scenario.", "count", "240");
+    QCommandLineOption intervalOpt("frame-interval-ms", "Frame pacing interval.", "ms", "16");
+    QCommandLineOption documentOpt("document-check", "Also check that video audio state survives a document round trip.");
+    QCommandLineOption outputOpt("output", "Write JSON results to this file instead of stdout.", "path");
+    parser.addOptions({scenarioOpt, textOpt, imageOpt, framesOpt, intervalOpt, documentOpt, outputOpt});
+    parser.process(app);
+
+    BenchConfig config;
+    config.textItems = std::max(0, parser.value(textOpt).toInt());
+    config.imageItems = std::max(0, parser.value(imageOpt).toInt());
+    config.frames = std::max(1, parser.value(framesOpt).toInt());
+    config.frameIntervalMs = std::max(1, parser.value(intervalOpt).toInt());
+    const QString suite = parser.value(scenarioOpt).toLower();
+
+    CanvasBenchmark bench(config);
+    QJsonArray scenarios;
+
+    if (suite == "all" || suite == "s1") {
+        bench.buildScene(1, 0, true);
+        scenarios.append(bench.runScenario("s1.zoom", [&](int f) { bench.zoomStep(f); }));
+    }
+    if (suite == "all" || suite == "s2") {
+        bench.buildScene(config.textItems, config.imageItems, false);
+        scenarios.append(bench.runScenario("s2.zoom", [&](int f) { bench.zoomStep(f); }));
+        scenarios.append(bench.runScenario("s2.pan", [&](int f) { bench.panStep(f); }));
+        scenarios.append(bench.runScenario("s2.dragSnap", [&](int f) { bench.dragSnapStep(f); }));
+        scenarios.append(bench.runScenario("s2.multiSelectMove", [&](int f) { bench.multiMoveStep(f); }));
+    }
+    if (suite == "all" || suite == "s3") {
+        bench.buildScene(config.textItems, config.imageItems, false);
+        scenarios.append(bench.runScenario("s3.textEdit", [&](int f) { bench.textEditStep(f); }));
+    }
+
+    // Last: loading a document replaces the generated scene
+    QJsonObject documentCheck;
+    if (parser.isSet(documentOpt)) {
+        documentCheck = bench.runDocumentRoundTrip();
+    }
+
+    QJsonObject root;
+    root["benchmark"] = "canvas-interaction";
+    root["qtVersion"] = QString::fromLatin1(qVersion());
+    root["platform"] = QGuiApplication::platformName();
+    root["frameIntervalMs"] = config.frameIntervalMs;
+    root["scenarios"] = scenarios;
+    if (!documentCheck.isEmpty()) {
+        root["documentCheck"] = documentCheck;
+    }
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOpt)) {
+        QFile out(parser.value(outputOpt));
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Cannot write benchmark results to" << out.fileName();
+            return 1;
+        }
+        out.write(json);
+    } else {
+        QTextStream(stdout) << json;
+    }
+    if (!documentCheck.isEmpty() && !documentCheck.value("passed").toBool()) {
+        qCritical() << "Video audio state did not survive the document round trip:" << documentCheck;
+        return 1;
+    }
+    return scenarios.isEmpty() ? 2 : 0;
+}
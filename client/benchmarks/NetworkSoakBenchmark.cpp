@@ -0,0 +1,691 @@
+// NetworkSoakBenchmark.cpp - Headless end-to-end protocol benchmark and soak run
+//
+// Spawns N simulated clients in one process, each built from the client's own network classes
+// (WebSocketClient plus an UploadManager with its own FileManager, wired as in MainWindow), against
+// a local relay: an in-process EmbeddedHub on a free port by default, or a running server.js with
+// --server. Clients form a ring: client i watches client i+1 and is its only upload and remote-scene
+// sender. Every client streams cursor updates, cycles uploads (upload, then unload; every Nth upload
+// is cancelled once it reports progress) and starts/stops a remote scene on its target. The
+// target answers the scene like RemoteSceneController would (validation, launched, stopped) without
+// rendering anything. One client at a time is periodically disconnected and reconnected.
+//
+// Prints one JSON document with latency percentiles per message type, relay throughput, reconnect
+// recovery time and per-client memory, plus periodic samples of process RSS and of bookkeeping that
+// must stay flat over a long --duration-s run (canceled upload ids, hub routing tables). All clients
+// share the process clock, so latencies are sender-to-receiver times through the relay.
+//
+// Usage:
+//   MouffetteNetworkSoak [--clients 8] [--duration-s 30] [--server ws://host:port]
+//                        [--cursor-interval-ms 16] [--upload-interval-ms 1500] [--upload-kb 256]
+//                        [--cancel-every 4] [--scene-interval-ms 2000] [--reconnect-interval-s 5]
+//                        [--sample-interval-s 5] [--action-timeout-ms 15000] [--verbose]
+//                        [--output results.json]
+
+#include "backend/domain/session/SessionManager.h" // DEFAULT_IDEA_ID
+#include "backend/files/FileManager.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/network/EmbeddedHub.h"
+#include "backend/network/IncomingChunkWriter.h"
+#include "backend/network/UploadManager.h"
+#include "backend/network/WebSocketClient.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int kStartupTimeoutMs = 15000;
+constexpr double kCursorLostAfterMs = 5000.0;
+
+struct SoakConfig {
+    int clients = 8;
+    int durationS = 30;
+    int cursorIntervalMs = 16;
+    int uploadIntervalMs = 1500;
+    int uploadKb = 256;
+    int cancelEvery = 4;
+    int sceneIntervalMs = 2000;
+    int reconnectIntervalS = 5;
+    int sampleIntervalS = 5;
+    int actionTimeoutMs = 15000;
+    QString serverUrl;
+};
+
+QElapsedTimer& runClock() {
+    static QElapsedTimer timer;
+    return timer;
+}
+
+double nowMs() {
+    return runClock().nsecsElapsed() / 1.0e6;
+}
+
+// Resident set size of the whole process; -1 where /proc is not available
+qint64 residentBytes() {
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().simplified().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields.at(1).toLongLong() * static_cast<qint64>(sysconf(_SC_PAGESIZE));
+#else
+    return -1;
+#endif
+}
+
+QJsonObject percentiles(QVector<double> samples) {
+    QJsonObject o;
+    if (samples.isEmpty()) {
+        return o;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        const int upperBound = static_cast<int>(samples.size()) - 1;
+        const int idx = std::clamp(static_cast<int>(std::ceil(upperBound * q)), 0, upperBound);
+        return samples.at(idx);
+    };
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    o["count"] = static_cast<int>(samples.size());
+    o["p50"] = at(0.50);
+    o["p90"] = at(0.90);
+    o["p95"] = at(0.95);
+    o["p99"] = at(0.99);
+    o["max"] = samples.last();
+    o["mean"] = sum / samples.size();
+    return o;
+}
+
+struct SimClient {
+    enum class UploadPhase { Idle, Uploading, Cancelling, Loaded, Unloading };
+    enum class ScenePhase { Idle, Starting, Running, Stopping };
+
+    int index = 0;
+    QString persistentId;
+    UploadFileInfo file;
+    std::unique_ptr<FileManager> files;
+    WebSocketClient* ws = nullptr;
+    UploadManager* uploads = nullptr;
+
+    bool registered = false;
+    bool everRegistered = false;
+    bool reconnecting = false;
+    double connectStartMs = -1.0;
+
+    int cursorSeq = 0;
+    QHash<int, double> cursorSentMs; // seq -> send time, until the watcher sees it
+
+    UploadPhase uploadPhase = UploadPhase::Idle;
+    double uploadPhaseStartMs = 0.0;
+    bool cancelThisUpload = false;
+    int uploadCycles = 0;
+
+    ScenePhase scenePhase = ScenePhase::Idle;
+    double scenePhaseStartMs = 0.0;
+
+    bool busy() const {
+        return uploadPhase == UploadPhase::Uploading || uploadPhase == UploadPhase::Cancelling ||
+               uploadPhase == UploadPhase::Unloading || scenePhase == ScenePhase::Starting ||
+               scenePhase == ScenePhase::Stopping;
+    }
+};
+
+class SoakRun {
+public:
+    explicit SoakRun(const SoakConfig& config) : m_config(config) {}
+
+    ~SoakRun() {
+        for (auto& client : m_clients) {
+            if (client->ws) client->ws->disconnect();
+        }
+        // Let the close frames go out before the sockets and the hub are torn down
+        waitFor([]() { return false; }, 300);
+        for (auto& client : m_clients) {
+            delete client->uploads;
+            delete client->ws;
+        }
+        m_clients.clear();
+    }
+
+    bool start() {
+        if (!m_dir.isValid()) {
+            qCritical() << "Cannot create a temporary directory for upload payloads";
+            return false;
+        }
+        m_baselineRss = residentBytes();
+        if (m_config.serverUrl.isEmpty()) {
+            m_hub = std::make_unique<EmbeddedHub>();
+            if (!m_hub->start(0, false)) {
+                qCritical() << "Cannot start the embedded hub";
+                return false;
+            }
+            m_url = m_hub->localUrl().toString();
+        } else {
+            m_url = m_config.serverUrl;
+        }
+
+        for (int i = 0; i < m_config.clients; ++i) {
+            auto client = std::make_unique<SimClient>();
+            client->index = i;
+            client->persistentId = QStringLiteral("soak-%1-%2").arg(QCoreApplication::applicationPid()).arg(i);
+            if (!writePayload(*client)) {
+                return false;
+            }
+            m_clients.push_back(std::move(client));
+        }
+        for (auto& client : m_clients) {
+            wire(*client);
+            client->connectStartMs = nowMs();
+            client->ws->connectToServer(m_url);
+        }
+
+        const bool allRegistered = waitFor([this]() {
+            return std::all_of(m_clients.cbegin(), m_clients.cend(), [](const auto& c) { return c->registered; });
+        }, kStartupTimeoutMs);
+        if (!allRegistered) {
+            qCritical() << "Not every client registered with" << m_url << "within" << kStartupTimeoutMs << "ms";
+            return false;
+        }
+        m_registeredRss = residentBytes();
+        return true;
+    }
+
+    void run() {
+        QObject context;
+        const int n = static_cast<int>(m_clients.size());
+        auto every = [&context](int intervalMs, std::function<void()> tick) {
+            auto* timer = new QTimer(&context);
+            timer->setInterval(std::max(1, intervalMs));
+            QObject::connect(timer, &QTimer::timeout, &context, std::move(tick));
+            timer->start();
+        };
+
+        every(m_config.cursorIntervalMs, [this]() {
+            for (auto& client : m_clients) sendCursor(*client);
+        });
+        // Round-robin ticks spread each client's uploads and scenes evenly over the interval
+        every(m_config.uploadIntervalMs / n, [this, n]() {
+            stepUpload(*m_clients[m_nextUpload]);
+            m_nextUpload = (m_nextUpload + 1) % n;
+        });
+        every(m_config.sceneIntervalMs / n, [this, n]() {
+            stepScene(*m_clients[m_nextScene]);
+            m_nextScene = (m_nextScene + 1) % n;
+        });
+        if (m_config.reconnectIntervalS > 0) {
+            every(m_config.reconnectIntervalS * 1000, [this]() { reconnectNext(); });
+        }
+        every(m_config.sampleIntervalS * 1000, [this]() { sample(); });
+
+        m_runStartMs = nowMs();
+        sample();
+        QEventLoop loop;
+        QTimer::singleShot(m_config.durationS * 1000, &loop, &QEventLoop::quit);
+        loop.exec();
+        m_runEndMs = nowMs();
+        sample();
+    }
+
+    QJsonObject report() const {
+        const double runSec = std::max(1e-3, (m_runEndMs - m_runStartMs) / 1000.0);
+
+        QJsonObject latency;
+        for (auto it = m_latencyMs.cbegin(); it != m_latencyMs.cend(); ++it) {
+            latency[it.key()] = percentiles(it.value());
+        }
+        QJsonObject counts;
+        for (auto it = m_counts.cbegin(); it != m_counts.cend(); ++it) {
+            counts[it.key()] = it.value();
+        }
+
+        QJsonObject throughput;
+        const qint64 uploadedBytes = m_counts.value(QStringLiteral("uploadBytes"));
+        throughput["uploadBytes"] = uploadedBytes;
+        throughput["uploadBytesPerSec"] = uploadedBytes / runSec;
+        throughput["uploadMBps"] = percentiles(m_uploadMBps);
+        throughput["cursorUpdatesPerSec"] = m_counts.value(QStringLiteral("cursorReceived")) / runSec;
+
+        QJsonObject memory;
+        memory["baselineRssBytes"] = m_baselineRss;
+        memory["registeredRssBytes"] = m_registeredRss;
+        const qint64 finalRss = m_samples.isEmpty() ? -1 : m_samples.last().toObject().value("rssBytes").toInteger();
+        memory["finalRssBytes"] = finalRss;
+        if (m_baselineRss > 0 && m_registeredRss > 0) {
+            memory["perClientBytes"] = static_cast<double>(m_registeredRss - m_baselineRss) / m_clients.size();
+        }
+        if (m_samples.size() >= 2) {
+            const QJsonObject first = m_samples.first().toObject();
+            const QJsonObject last = m_samples.last().toObject();
+            const double minutes = (last.value("tSec").toDouble() - first.value("tSec").toDouble()) / 60.0;
+            if (minutes > 0.0 && first.value("rssBytes").toInteger() > 0) {
+                memory["rssGrowthBytesPerMin"] =
+                    (last.value("rssBytes").toInteger() - first.value("rssBytes").toInteger()) / minutes;
+            }
+        }
+        memory["samples"] = m_samples;
+
+        QJsonObject root;
+        root["benchmark"] = "network-soak";
+        root["qtVersion"] = QString::fromLatin1(qVersion());
+        root["relay"] = m_hub ? QStringLiteral("embedded-hub") : m_url;
+        root["clients"] = static_cast<int>(m_clients.size());
+        root["durationSec"] = runSec;
+        root["uploadKb"] = m_config.uploadKb;
+        root["latencyMs"] = latency;
+        root["counts"] = counts;
+        root["throughput"] = throughput;
+        root["memory"] = memory;
+        if (Metrics::enabled()) {
+            root["metrics"] = Metrics::snapshot();
+        }
+        return root;
+    }
+
+private:
+    SimClient& next(const SimClient& c) { return *m_clients[(c.index + 1) % m_clients.size()]; }
+    SimClient& previous(const SimClient& c) { return *m_clients[(c.index + m_clients.size() - 1) % m_clients.size()]; }
+    bool online(const SimClient& c) const { return c.registered && !c.reconnecting; }
+
+    void record(const QString& type, double ms) { m_latencyMs[type].append(ms); }
+    void count(const QString& name, qint64 n = 1) { m_counts[name] += n; }
+
+    static bool waitFor(const std::function<bool()>& done, int timeoutMs) {
+        QEventLoop loop;
+        QTimer poll;
+        QObject::connect(&poll, &QTimer::timeout, &loop, [&]() {
+            if (done()) loop.quit();
+        });
+        poll.start(20);
+        QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+        if (!done()) loop.exec();
+        return done();
+    }
+
+    bool writePayload(SimClient& c) {
+        const QString path = m_dir.filePath(QStringLiteral("client%1.bin").arg(c.index));
+        QFile out(path);
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Cannot write upload payload" << path;
+            return false;
+        }
+        // Random bytes so nothing along the way benefits from compressible input
+        QByteArray data(m_config.uploadKb * 1024, Qt::Uninitialized);
+        QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(data.data()), data.size() / 4);
+        out.write(data);
+        c.file.fileId = QStringLiteral("soak-file-%1").arg(c.index);
+        c.file.mediaId = QStringLiteral("soak-media-%1").arg(c.index);
+        c.file.path = path;
+        c.file.name = QStringLiteral("client%1.bin").arg(c.index);
+        c.file.extension = QStringLiteral("bin");
+        c.file.size = data.size();
+        return true;
+    }
+
+    void wire(SimClient& c) {
+        c.files = std::make_unique<FileManager>();
+        c.ws = new WebSocketClient();
+        c.ws->setPersistentClientId(c.persistentId);
+        // One uploads cache per client: a reconnect clears its whole root, which must not take other clients' files with it
+        c.ws->chunkWriter()->setCacheRoot(m_dir.filePath(QStringLiteral("uploads%1").arg(c.index)));
+        c.uploads = new UploadManager(c.files.get());
+        c.uploads->setMyClientId(c.persistentId);
+        c.uploads->setActiveIdeaId(DEFAULT_IDEA_ID);
+        c.uploads->setTargetClientId(next(c).persistentId);
+
+        WebSocketClient* ws = c.ws;
+        UploadManager* uploads = c.uploads;
+        SimClient* self = &c;
+        // Same forwarding as MainWindow
+        QObject::connect(ws, &WebSocketClient::messageReceived, uploads, &UploadManager::handleIncomingMessage);
+        QObject::connect(ws, &WebSocketClient::uploadProgressReceived, uploads, &UploadManager::onUploadProgress);
+        QObject::connect(ws, &WebSocketClient::uploadFinishedReceived, uploads, &UploadManager::onUploadFinished);
+        QObject::connect(ws, &WebSocketClient::uploadCompletedFileIdsReceived, uploads, &UploadManager::onUploadCompletedFileIds);
+        QObject::connect(ws, &WebSocketClient::allFilesRemovedReceived, uploads, &UploadManager::onAllFilesRemovedRemote);
+        uploads->setWebSocketClient(ws);
+
+        QObject::connect(ws, &WebSocketClient::connected, ws, [self]() {
+            const QList<ScreenInfo> screens{ScreenInfo(0, 1920, 1080, 0, 0, true)};
+            self->ws->registerClient(QStringLiteral("soak-%1").arg(self->index), QStringLiteral("Soak"), screens, 50);
+        });
+        QObject::connect(ws, &WebSocketClient::registrationConfirmed, ws, [this, self](const ClientInfo&) {
+            onRegistered(*self);
+        });
+        QObject::connect(ws, &WebSocketClient::disconnected, ws, [this, self]() {
+            self->registered = false;
+            self->uploads->onConnectionLost();
+            if (self->reconnecting) {
+                // Reconnect from a clean stack, as a restarted client would
+                QTimer::singleShot(0, self->ws, [this, self]() { self->ws->connectToServer(m_url); });
+            } else {
+                // WebSocketClient retries on its own; recovery is reported as auto_reconnect
+                count(QStringLiteral("unexpectedDisconnects"));
+                self->connectStartMs = nowMs();
+            }
+        });
+
+        // Watcher side: the sender's index travels in y and its sequence number in x
+        QObject::connect(ws, &WebSocketClient::cursorPositionReceived, ws, [this](const QString&, int x, int y) {
+            if (y < 0 || y >= static_cast<int>(m_clients.size())) return;
+            SimClient& sender = *m_clients[y];
+            auto it = sender.cursorSentMs.find(x);
+            if (it == sender.cursorSentMs.end()) return;
+            record(QStringLiteral("cursor_update"), nowMs() - it.value());
+            sender.cursorSentMs.erase(it);
+            count(QStringLiteral("cursorReceived"));
+        });
+
+        // Sender side upload lifecycle
+        QObject::connect(uploads, &UploadManager::uploadProgress, uploads, [self](int percent, int, int) {
+            // Only once chunks are flowing; a cancel before that never reaches the target
+            if (percent <= 0 || self->uploadPhase != SimClient::UploadPhase::Uploading || !self->cancelThisUpload) return;
+            self->cancelThisUpload = false;
+            self->uploadPhase = SimClient::UploadPhase::Cancelling;
+            self->uploadPhaseStartMs = nowMs();
+            self->uploads->requestCancel();
+        });
+        QObject::connect(uploads, &UploadManager::uploadFinished, uploads, [this, self]() {
+            if (self->uploadPhase != SimClient::UploadPhase::Uploading) return;
+            const double ms = nowMs() - self->uploadPhaseStartMs;
+            record(QStringLiteral("upload"), ms);
+            if (ms > 0.0) m_uploadMBps.append(self->file.size / (ms * 1000.0));
+            count(QStringLiteral("uploadsCompleted"));
+            count(QStringLiteral("uploadBytes"), self->file.size);
+            self->uploadPhase = SimClient::UploadPhase::Loaded;
+        });
+        QObject::connect(uploads, &UploadManager::allFilesRemoved, uploads, [this, self]() {
+            const double ms = nowMs() - self->uploadPhaseStartMs;
+            if (self->uploadPhase == SimClient::UploadPhase::Unloading) {
+                record(QStringLiteral("remove_all_files"), ms);
+            } else if (self->uploadPhase == SimClient::UploadPhase::Cancelling) {
+                record(QStringLiteral("upload_cancel"), ms);
+                count(QStringLiteral("uploadsCancelled"));
+            } else {
+                return;
+            }
+            self->uploadPhase = SimClient::UploadPhase::Idle;
+        });
+
+        // Target side of a remote scene: acknowledge like RemoteSceneController, without rendering
+        QObject::connect(ws, &WebSocketClient::remoteSceneStartReceived, ws, [ws](const QString& senderClientId, const QJsonObject&) {
+            ws->sendRemoteSceneValidationResult(senderClientId, true);
+            ws->sendRemoteSceneLaunched(senderClientId);
+        });
+        QObject::connect(ws, &WebSocketClient::remoteSceneStopReceived, ws, [ws](const QString& senderClientId) {
+            ws->sendRemoteSceneStopResult(senderClientId, true);
+        });
+        // Sender side of a remote scene
+        QObject::connect(ws, &WebSocketClient::remoteSceneValidationReceived, ws, [this, self](const QString&, bool success, const QString&) {
+            if (self->scenePhase != SimClient::ScenePhase::Starting) return;
+            record(QStringLiteral("remote_scene_validation"), nowMs() - self->scenePhaseStartMs);
+            if (!success) count(QStringLiteral("sceneValidationFailures"));
+        });
+        QObject::connect(ws, &WebSocketClient::remoteSceneLaunchedReceived, ws, [this, self](const QString&) {
+            if (self->scenePhase != SimClient::ScenePhase::Starting) return;
+            record(QStringLiteral("remote_scene_launched"), nowMs() - self->scenePhaseStartMs);
+            self->scenePhase = SimClient::ScenePhase::Running;
+        });
+        QObject::connect(ws, &WebSocketClient::remoteSceneStoppedReceived, ws, [this, self](const QString&, bool, const QString&) {
+            if (self->scenePhase != SimClient::ScenePhase::Stopping) return;
+            record(QStringLiteral("remote_scene_stop"), nowMs() - self->scenePhaseStartMs);
+            self->scenePhase = SimClient::ScenePhase::Idle;
+        });
+    }
+
+    void onRegistered(SimClient& c) {
+        const double ms = nowMs() - c.connectStartMs;
+        if (c.reconnecting) {
+            record(QStringLiteral("reconnect"), ms);
+            count(QStringLiteral("reconnects"));
+        } else {
+            record(c.everRegistered ? QStringLiteral("auto_reconnect") : QStringLiteral("register"), ms);
+        }
+        c.registered = true;
+        c.everRegistered = true;
+        c.reconnecting = false;
+        // Watch relationships are re-established from whichever side registers last
+        SimClient& target = next(c);
+        if (target.registered) c.ws->watchScreens(target.persistentId);
+        SimClient& watcher = previous(c);
+        if (&watcher != &c && watcher.registered) watcher.ws->watchScreens(c.persistentId);
+    }
+
+    void sendCursor(SimClient& c) {
+        if (!online(c)) return;
+        const int seq = ++c.cursorSeq;
+        c.cursorSentMs.insert(seq, nowMs());
+        c.ws->sendCursorUpdate(seq, c.index);
+        count(QStringLiteral("cursorSent"));
+    }
+
+    void stepUpload(SimClient& c) {
+        if (!online(c) || !online(next(c))) return;
+        const double now = nowMs();
+        switch (c.uploadPhase) {
+        case SimClient::UploadPhase::Idle:
+            c.cancelThisUpload = m_config.cancelEvery > 0 && ++c.uploadCycles % m_config.cancelEvery == 0;
+            c.uploadPhase = SimClient::UploadPhase::Uploading;
+            c.uploadPhaseStartMs = now;
+            c.uploads->toggleUpload({c.file});
+            if (c.uploadPhase == SimClient::UploadPhase::Uploading && !c.uploads->isUploading()) {
+                // Rate limited or still settling; retried on the next tick
+                c.uploadPhase = SimClient::UploadPhase::Idle;
+                count(QStringLiteral("uploadsRejected"));
+            }
+            break;
+        case SimClient::UploadPhase::Loaded:
+            c.uploadPhase = SimClient::UploadPhase::Unloading;
+            c.uploadPhaseStartMs = now;
+            c.uploads->toggleUpload({});
+            break;
+        default:
+            if (now - c.uploadPhaseStartMs > m_config.actionTimeoutMs) {
+                count(QStringLiteral("uploadTimeouts"));
+                c.uploads->forceResetForClient();
+                c.uploadPhase = SimClient::UploadPhase::Idle;
+            }
+            break;
+        }
+    }
+
+    void stepScene(SimClient& c) {
+        SimClient& target = next(c);
+        if (!online(c) || !online(target)) return;
+        const double now = nowMs();
+        switch (c.scenePhase) {
+        case SimClient::ScenePhase::Idle: {
+            QJsonObject media;
+            media["mediaId"] = c.file.mediaId;
+            media["fileId"] = c.file.fileId;
+            media["type"] = "image";
+            media["screenId"] = 0;
+            QJsonObject scene;
+            scene["screens"] = QJsonArray{ScreenInfo(0, 1920, 1080, 0, 0, true).toJson()};
+            scene["media"] = QJsonArray{media};
+            c.scenePhase = SimClient::ScenePhase::Starting;
+            c.scenePhaseStartMs = now;
+            c.ws->sendRemoteSceneStart(target.persistentId, scene);
+            count(QStringLiteral("scenesStarted"));
+            break;
+        }
+        case SimClient::ScenePhase::Running:
+            c.scenePhase = SimClient::ScenePhase::Stopping;
+            c.scenePhaseStartMs = now;
+            c.ws->sendRemoteSceneStop(target.persistentId);
+            break;
+        default:
+            if (now - c.scenePhaseStartMs > m_config.actionTimeoutMs) {
+                count(QStringLiteral("sceneTimeouts"));
+                c.scenePhase = SimClient::ScenePhase::Idle;
+            }
+            break;
+        }
+    }
+
+    void reconnectNext() {
+        const int n = static_cast<int>(m_clients.size());
+        // Pick a client with nothing in flight on either side of it, so every drop measures recovery
+        // rather than aborting a transfer
+        for (int attempt = 0; attempt < n; ++attempt) {
+            SimClient& c = *m_clients[m_nextReconnect];
+            m_nextReconnect = (m_nextReconnect + 1) % n;
+            if (!online(c) || c.busy() || previous(c).busy()) continue;
+            c.reconnecting = true;
+            c.connectStartMs = nowMs();
+            c.ws->disconnect();
+            return;
+        }
+        count(QStringLiteral("reconnectsSkipped"));
+    }
+
+    void sample() {
+        const double now = nowMs();
+        int canceledUploadIds = 0;
+        int pendingCursor = 0;
+        for (auto& client : m_clients) {
+            canceledUploadIds += client->ws->canceledUploadCount();
+            // Coalesced or dropped cursor updates never arrive; stop waiting for them
+            for (auto it = client->cursorSentMs.begin(); it != client->cursorSentMs.end();) {
+                if (now - it.value() > kCursorLostAfterMs) {
+                    it = client->cursorSentMs.erase(it);
+                    count(QStringLiteral("cursorLost"));
+                } else {
+                    ++it;
+                }
+            }
+            pendingCursor += client->cursorSentMs.size();
+        }
+        QJsonObject s;
+        s["tSec"] = (now - m_runStartMs) / 1000.0;
+        s["rssBytes"] = residentBytes();
+        s["canceledUploadIds"] = canceledUploadIds;
+        s["pendingCursorUpdates"] = pendingCursor;
+        if (m_hub) s["hub"] = m_hub->stats();
+        m_samples.append(s);
+    }
+
+    SoakConfig m_config;
+    QTemporaryDir m_dir;
+    std::unique_ptr<EmbeddedHub> m_hub;
+    QString m_url;
+    std::vector<std::unique_ptr<SimClient>> m_clients;
+    int m_nextUpload = 0;
+    int m_nextScene = 0;
+    int m_nextReconnect = 0;
+    QHash<QString, QVector<double>> m_latencyMs;
+    QHash<QString, qint64> m_counts;
+    QVector<double> m_uploadMBps;
+    QJsonArray m_samples;
+    qint64 m_baselineRss = -1;
+    qint64 m_registeredRss = -1;
+    double m_runStartMs = 0.0;
+    double m_runEndMs = 0.0;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    // Relay counters (chunks, bytes, dropped frames) go into the report unless metrics are configured otherwise
+    if (qEnvironmentVariableIsEmpty("MOUFFETTE_METRICS")) {
+        qputenv("MOUFFETTE_METRICS", "1");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("MouffetteNetworkSoak");
+    // Received uploads land in a throwaway cache instead of the user's
+    QStandardPaths::setTestModeEnabled(true);
+    runClock().start();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless end-to-end network protocol benchmark and soak run");
+    parser.addHelpOption();
+    QCommandLineOption clientsOpt("clients", "Simulated clients (at least 2).", "count", "8");
+    QCommandLineOption durationOpt("duration-s", "Run length in seconds after all clients registered.", "s", "30");
+    QCommandLineOption serverOpt("server", "Relay URL; an embedded hub on a free port when omitted.", "url");
+    QCommandLineOption cursorOpt("cursor-interval-ms", "Cursor update interval per client.", "ms", "16");
+    QCommandLineOption uploadOpt("upload-interval-ms", "Upload/unload step interval per client.", "ms", "1500");
+    QCommandLineOption uploadKbOpt("upload-kb", "Upload payload size per client.", "kb", "256");
+    QCommandLineOption cancelOpt("cancel-every", "Cancel every Nth upload of a client (0: never).", "n", "4");
+    QCommandLineOption sceneOpt("scene-interval-ms", "Remote scene start/stop step interval per client.", "ms", "2000");
+    QCommandLineOption reconnectOpt("reconnect-interval-s", "Reconnect one client this often (0: never).", "s", "5");
+    QCommandLineOption sampleOpt("sample-interval-s", "Memory and bookkeeping sample interval.", "s", "5");
+    QCommandLineOption timeoutOpt("action-timeout-ms", "Give up on an upload or scene step after this long.", "ms", "15000");
+    QCommandLineOption verboseOpt("verbose", "Keep client debug logging.");
+    QCommandLineOption outputOpt("output", "Write JSON results to this file instead of stdout.", "path");
+    parser.addOptions({clientsOpt, durationOpt, serverOpt, cursorOpt, uploadOpt, uploadKbOpt, cancelOpt, sceneOpt,
+                       reconnectOpt, sampleOpt, timeoutOpt, verboseOpt, outputOpt});
+    parser.process(app);
+
+    if (!parser.isSet(verboseOpt)) {
+        // Per-message debug lines would dominate a soak run
+        QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+    }
+
+    SoakConfig config;
+    config.clients = std::clamp(parser.value(clientsOpt).toInt(), 2, 512);
+    config.durationS = std::max(1, parser.value(durationOpt).toInt());
+    config.serverUrl = parser.value(serverOpt);
+    config.cursorIntervalMs = std::max(1, parser.value(cursorOpt).toInt());
+    // UploadManager ignores actions closer together than its debounce window
+    config.uploadIntervalMs = std::max(600, parser.value(uploadOpt).toInt());
+    config.uploadKb = std::clamp(parser.value(uploadKbOpt).toInt(), 1, 1024 * 1024);
+    config.cancelEvery = std::max(0, parser.value(cancelOpt).toInt());
+    config.sceneIntervalMs = std::max(50, parser.value(sceneOpt).toInt());
+    config.reconnectIntervalS = std::max(0, parser.value(reconnectOpt).toInt());
+    config.sampleIntervalS = std::max(1, parser.value(sampleOpt).toInt());
+    config.actionTimeoutMs = std::max(1000, parser.value(timeoutOpt).toInt());
+
+    QByteArray json;
+    {
+        SoakRun soak(config);
+        if (!soak.start()) {
+            return 1;
+        }
+        soak.run();
+        json = QJsonDocument(soak.report()).toJson(QJsonDocument::Indented);
+    }
+
+    int exitCode = 0;
+    if (parser.isSet(outputOpt)) {
+        QFile out(parser.value(outputOpt));
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Cannot write benchmark results to" << out.fileName();
+            exitCode = 1;
+        } else {
+            out.write(json);
+        }
+    } else {
+        QTextStream(stdout) << json;
+    }
+    // Runs aboutToQuit so the shared network thread shuts down cleanly
+    QTimer::singleShot(0, &app, &QCoreApplication::quit);
+    app.exec();
+    return exitCode;
+}
@@ -0,0 +1,354 @@
+// TextRenderBenchmark.cpp - Headless micro-benchmark of the text raster hot path
+//
+// Paints synthetic text through TextMediaItem::paintBenchmarkSnapshot (shaping, glyph outline and
+// stroke geometry caches, GlyphBitmapCache coverage masks and compositing) without any canvas or
+// UI, over a parameter matrix:
+//   text length x font family x outline width x raster scale x cold/warm cache x thread count
+// and prints one JSON document with ns/glyph, glyphs/s, glyph cache hit rate and bytes per cached
+// glyph per case. Scales above 8x exercise the vector stroke path instead of the glyph atlas.
+//
+// A case runs a number of rounds; every thread paints the text once per round into its own image.
+// Cold rounds drop all text caches before each round (outside the timed section), warm cases do
+// one untimed warm-up round first. Renderer env flags (e.g. MOUFFETTE_TEXT_SDF_GLYPHS) apply as usual.
+//
+// --churn-check inserts unique glyphs until several times the glyph cache budget has passed through
+// it and fails (exit code 1) if the resident atlas pages ever exceed the budget plus one page per shard.
+//
+// Usage:
+//   MouffetteTextBenchmark [--lengths 16,256,2048] [--fonts "DejaVu Sans,DejaVu Sans Mono"]
+//                          [--font-px 32] [--strokes 0,10,30] [--scales 0.5,1,2,4,12]
+//                          [--cache cold,warm] [--threads 1,4] [--rounds 10]
+//                          [--max-megapixels 64] [--churn-check] [--output results.json]
+
+#include "backend/domain/media/GlyphBitmapCache.h"
+#include "backend/domain/media/TextMediaItem.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFontDatabase>
+#include <QFontMetricsF>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRawFont>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr qreal kLayoutWidthPx = 640.0;
+
+struct BenchCase {
+    int length = 0;
+    QString family;
+    qreal outlinePercent = 0.0;
+    qreal scale = 1.0;
+    bool cold = false;
+    int threads = 1;
+};
+
+struct BenchConfig {
+    int fontPx = 32;
+    int rounds = 10;
+    qreal maxMegapixels = 64.0;
+};
+
+QString sampleText(int length) {
+    static const QString words = QStringLiteral(
+        "The quick brown fox jumps over the lazy dog 0123456789 Sphinx of black quartz, judge my vow! ");
+    QString text;
+    text.reserve(length);
+    while (text.size() < length) {
+        text.append(words);
+    }
+    text.truncate(length);
+    return text;
+}
+
+template <typename T>
+QVector<T> parseList(const QString& value, T (*convert)(const QString&, bool*)) {
+    QVector<T> out;
+    for (const QString& part : value.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const T parsed = convert(part.trimmed(), &ok);
+        if (ok) {
+            out.append(parsed);
+        }
+    }
+    return out;
+}
+
+int toInt(const QString& s, bool* ok) { return s.toInt(ok); }
+qreal toReal(const QString& s, bool* ok) { return s.toDouble(ok); }
+
+QSize baseSizeFor(const QString& text, const QFont& font) {
+    // Generous height estimate for the wrapped text; the painter clips anything beyond it
+    const QFontMetricsF metrics(font);
+    const qreal lineWidth = kLayoutWidthPx - 16.0;
+    const qreal textWidth = metrics.horizontalAdvance(text);
+    const int lines = std::max(1, static_cast<int>(std::ceil(textWidth / lineWidth * 1.15)));
+    const int height = static_cast<int>(std::ceil(lines * metrics.lineSpacing() + 2.0 * metrics.height()));
+    return QSize(static_cast<int>(kLayoutWidthPx), height);
+}
+
+GlyphBitmapCache::ConsumerStats editorCacheStats() {
+    return GlyphBitmapCache::instance().stats().consumers[static_cast<int>(GlyphBitmapCache::Consumer::Editor)];
+}
+
+QJsonObject runCase(const BenchCase& c, const BenchConfig& config) {
+    QFont font(c.family);
+    font.setPixelSize(config.fontPx);
+
+    TextMediaItem::BenchmarkPaintRequest request;
+    request.text = sampleText(c.length);
+    request.font = font;
+    request.fillColor = Qt::white;
+    request.outlineColor = Qt::black;
+    request.outlineWidthPercent = c.outlinePercent;
+    request.baseSize = baseSizeFor(request.text, font);
+    request.scaleFactor = c.scale;
+
+    QJsonObject result;
+    result["length"] = c.length;
+    result["font"] = c.family;
+    result["outlinePercent"] = c.outlinePercent;
+    result["scale"] = c.scale;
+    result["cache"] = c.cold ? QStringLiteral("cold") : QStringLiteral("warm");
+    result["threads"] = c.threads;
+
+    const qreal megapixels = request.baseSize.width() * c.scale * request.baseSize.height() * c.scale / 1e6;
+    if (megapixels * c.threads > config.maxMegapixels) {
+        result["skipped"] = QStringLiteral("raster exceeds --max-megapixels");
+        return result;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(c.threads);
+    QVector<QImage> targets(c.threads);
+    QVector<qint64> threadNs(c.threads, 0);
+    QVector<qint64> threadGlyphs(c.threads, 0);
+
+    auto runRound = [&](bool timed) {
+        QVector<QFuture<void>> futures;
+        futures.reserve(c.threads);
+        for (int t = 0; t < c.threads; ++t) {
+            futures.append(QtConcurrent::run(&pool, [&, t]() {
+                QElapsedTimer timer;
+                timer.start();
+                const int glyphs = TextMediaItem::paintBenchmarkSnapshot(request, &targets[t]);
+                if (timed) {
+                    threadNs[t] += timer.nsecsElapsed();
+                    threadGlyphs[t] += glyphs;
+                }
+            }));
+        }
+        for (QFuture<void>& future : futures) {
+            future.waitForFinished();
+        }
+    };
+
+    TextMediaItem::clearTextCaches();
+    if (!c.cold) {
+        runRound(false);
+    }
+
+    const GlyphBitmapCache::ConsumerStats before = editorCacheStats();
+    qint64 wallNs = 0;
+    for (int round = 0; round < config.rounds; ++round) {
+        if (c.cold) {
+            TextMediaItem::clearTextCaches();
+        }
+        QElapsedTimer wall;
+        wall.start();
+        runRound(true);
+        wallNs += wall.nsecsElapsed();
+    }
+    const GlyphBitmapCache::ConsumerStats after = editorCacheStats();
+    const GlyphBitmapCache::Stats cache = GlyphBitmapCache::instance().stats();
+
+    qint64 totalNs = 0;
+    qint64 totalGlyphs = 0;
+    for (int t = 0; t < c.threads; ++t) {
+        totalNs += threadNs[t];
+        totalGlyphs += threadGlyphs[t];
+    }
+    const quint64 hits = after.hits - before.hits;
+    const quint64 misses = after.misses - before.misses;
+
+    result["rounds"] = config.rounds;
+    result["raster"] = QJsonArray{targets.first().width(), targets.first().height()};
+    result["glyphsPerPaint"] = c.threads > 0 && config.rounds > 0
+        ? static_cast<qint64>(totalGlyphs / (static_cast<qint64>(c.threads) * config.rounds))
+        : 0;
+    result["nsPerGlyph"] = totalGlyphs > 0 ? static_cast<double>(totalNs) / totalGlyphs : 0.0;
+    result["glyphsPerSec"] = wallNs > 0 ? static_cast<double>(totalGlyphs) * 1e9 / wallNs : 0.0;
+    result["msPerPaint"] = totalGlyphs > 0 ? totalNs / 1e6 / (static_cast<double>(c.threads) * config.rounds) : 0.0;
+
+    QJsonObject glyphCache;
+    glyphCache["hits"] = static_cast<qint64>(hits);
+    glyphCache["misses"] = static_cast<qint64>(misses);
+    glyphCache["hitRate"] = (hits + misses) > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0;
+    glyphCache["entries"] = cache.entryCount;
+    glyphCache["costKb"] = cache.totalCostKb;
+    glyphCache["bytesPerGlyph"] = cache.entryCount > 0
+        ? static_cast<double>(cache.totalCostKb) * 1024.0 / cache.entryCount
+        : 0.0;
+    result["glyphCache"] = glyphCache;
+    return result;
+}
+
+QJsonObject runChurnCheck(const QString& family, int fontPx) {
+    QFont font(family);
+    font.setPixelSize(fontPx);
+    const QRawFont rawFont = QRawFont::fromFont(font);
+    GlyphBitmapCache& glyphCache = GlyphBitmapCache::instance();
+    const int maxCostKb = glyphCache.maxCostKb();
+    const int pageKb = GlyphBitmapCache::kAtlasPageSize * GlyphBitmapCache::kAtlasPageSize / 1024;
+    const int costBoundKb = maxCostKb + GlyphBitmapCache::kShardCount * pageKb;
+    const int pageBound = maxCostKb / 16 + GlyphBitmapCache::kShardCount; // smallest pages are 128px
+
+    TextMediaItem::clearTextCaches();
+    const auto pathForGlyph = [](const QRawFont& f, quint32 glyph) { return f.pathForGlyph(glyph); };
+    const QVector<quint32> glyphs = rawFont.glyphIndexesForString(sampleText(96));
+    qint64 insertedKb = 0;
+    int inserts = 0;
+    int peakPages = 0;
+    int peakCostKb = 0;
+    // Each scale bucket makes every glyph a new key; stop once the budget has turned over a few times
+    for (int bucket = 0; insertedKb < 4LL * maxCostKb && bucket < 4096 && !glyphs.isEmpty(); ++bucket) {
+        const qreal scale = 1.0 + bucket / 256.0;
+        for (quint32 glyph : glyphs) {
+            GlyphBitmapCache::InsertInfo info;
+            const GlyphCoverage coverage = glyphCache.fetchOrRender(rawFont, glyph, 0.0, scale, pathForGlyph,
+                                                                    GlyphBitmapCache::Consumer::Editor,
+                                                                    nullptr, &info);
+            if (!info.inserted) {
+                continue;
+            }
+            ++inserts;
+            insertedKb += std::max(1, coverage.fill.rect.width() * coverage.fill.rect.height() / 1024);
+        }
+        const GlyphBitmapCache::Stats stats = glyphCache.stats();
+        peakPages = std::max(peakPages, stats.pageCount);
+        peakCostKb = std::max(peakCostKb, stats.totalCostKb);
+    }
+    TextMediaItem::clearTextCaches();
+
+    QJsonObject result;
+    result["font"] = family;
+    result["inserts"] = inserts;
+    result["insertedKb"] = insertedKb;
+    result["peakPages"] = peakPages;
+    result["peakCostKb"] = peakCostKb;
+    result["pageBound"] = pageBound;
+    result["costBoundKb"] = costBoundKb;
+    result["passed"] = peakPages <= pageBound && peakCostKb <= costBoundKb;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("MouffetteTextBenchmark");
+
+    const QString defaultFonts = QStringList{
+        QFontDatabase::systemFont(QFontDatabase::GeneralFont).family(),
+        QFontDatabase::systemFont(QFontDatabase::FixedFont).family()}.join(',');
+    const QString defaultThreads = QStringLiteral("1,%1").arg(std::max(2, QThread::idealThreadCount()));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless text rendering micro-benchmark");
+    parser.addHelpOption();
+    QCommandLineOption lengthsOpt("lengths", "Text lengths in characters.", "list", "16,256,2048");
+    QCommandLineOption fontsOpt("fonts", "Font families.", "list", defaultFonts);
+    QCommandLineOption fontPxOpt("font-px", "Font pixel size.", "px", "32");
+    QCommandLineOption strokesOpt("strokes", "Outline widths in percent.", "list", "0,10,30");
+    QCommandLineOption scalesOpt("scales", "Raster scale factors.", "list", "0.5,1,2,4,12");
+    QCommandLineOption cacheOpt("cache", "Cache states: cold, warm.", "list", "cold,warm");
+    QCommandLineOption threadsOpt("threads", "Concurrent painting threads.", "list", defaultThreads);
+    QCommandLineOption roundsOpt("rounds", "Timed rounds per case.", "count", "10");
+    QCommandLineOption maxMpOpt("max-megapixels", "Skip cases whose rasters exceed this in total.", "mp", "64");
+    QCommandLineOption churnOpt("churn-check", "Also check that glyph churn keeps atlas pages within budget.");
+    QCommandLineOption outputOpt("output", "Write JSON results to this file instead of stdout.", "path");
+    parser.addOptions({lengthsOpt, fontsOpt, fontPxOpt, strokesOpt, scalesOpt, cacheOpt, threadsOpt,
+                       roundsOpt, maxMpOpt, churnOpt, outputOpt});
+    parser.process(app);
+
+    BenchConfig config;
+    config.fontPx = std::clamp(parser.value(fontPxOpt).toInt(), 4, 512);
+    config.rounds = std::max(1, parser.value(roundsOpt).toInt());
+    config.maxMegapixels = std::max(1.0, parser.value(maxMpOpt).toDouble());
+
+    const QVector<int> lengths = parseList<int>(parser.value(lengthsOpt), &toInt);
+    const QStringList fonts = parser.value(fontsOpt).split(',', Qt::SkipEmptyParts);
+    const QVector<qreal> strokes = parseList<qreal>(parser.value(strokesOpt), &toReal);
+    const QVector<qreal> scales = parseList<qreal>(parser.value(scalesOpt), &toReal);
+    const QStringList cacheStates = parser.value(cacheOpt).toLower().split(',', Qt::SkipEmptyParts);
+    const QVector<int> threads = parseList<int>(parser.value(threadsOpt), &toInt);
+
+    QJsonArray cases;
+    for (const QString& family : fonts) {
+        for (int length : lengths) {
+            for (qreal stroke : strokes) {
+                for (qreal scale : scales) {
+                    for (const QString& state : cacheStates) {
+                        for (int threadCount : threads) {
+                            BenchCase c;
+                            c.length = std::max(1, length);
+                            c.family = family.trimmed();
+                            c.outlinePercent = std::max<qreal>(0.0, stroke);
+                            c.scale = std::max<qreal>(0.01, scale);
+                            c.cold = state.trimmed() == QLatin1String("cold");
+                            c.threads = std::clamp(threadCount, 1, 64);
+                            cases.append(runCase(c, config));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    QJsonObject churn;
+    if (parser.isSet(churnOpt) && !fonts.isEmpty()) {
+        churn = runChurnCheck(fonts.first().trimmed(), config.fontPx);
+    }
+
+    QJsonObject root;
+    root["benchmark"] = "text-render";
+    root["qtVersion"] = QString::fromLatin1(qVersion());
+    root["platform"] = QGuiApplication::platformName();
+    root["fontPx"] = config.fontPx;
+    root["glyphCacheMaxCostKb"] = GlyphBitmapCache::instance().maxCostKb();
+    root["cases"] = cases;
+    if (!churn.isEmpty()) {
+        root["churnCheck"] = churn;
+    }
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOpt)) {
+        QFile out(parser.value(outputOpt));
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Cannot write benchmark results to" << out.fileName();
+            return 1;
+        }
+        out.write(json);
+    } else {
+        QTextStream(stdout) << json;
+    }
+    if (!churn.isEmpty() && !churn.value("passed").toBool()) {
+        qCritical() << "Glyph atlas grew past its budget under churn:" << churn;
+        return 1;
+    }
+    return cases.isEmpty() ? 2 : 0;
+}
@@ -5,6 +5,7 @@
 #include "frontend/rendering/navigation/ScreenNavigationManager.h"
 #include "backend/network/UploadManager.h"
 #include "backend/network/WatchManager.h"
+#include "backend/network/EmbeddedHub.h"
 #include "backend/files/FileWatcher.h"
 #include "frontend/ui/widgets/SpinnerWidget.h"
 #include "frontend/rendering/canvas/ScreenCanvas.h"
@@ -27,6 +28,7 @@
 #include "frontend/managers/ui/TopBarManager.h"
 #include "backend/managers/app/SystemTrayManager.h"
 #include "backend/managers/app/MenuBarManager.h"
+#include "backend/files/SceneDocument.h"
 #include "backend/handlers/WebSocketMessageHandler.h"
 #include "backend/handlers/ScreenEventHandler.h"
 #include "backend/handlers/ClientListEventHandler.h"
@@ -385,6 +387,8 @@ MainWindow::MainWindow(QWidget* parent)
         m_menuBarManager->setup();
         connect(m_menuBarManager, &MenuBarManager::quitRequested, this, &MainWindow::onMenuQuitRequested);
         connect(m_menuBarManager, &MenuBarManager::aboutRequested, this, &MainWindow::onMenuAboutRequested);
+        connect(m_menuBarManager, &MenuBarManager::openCanvasRequested, this, &MainWindow::onMenuOpenCanvasRequested);
+        connect(m_menuBarManager, &MenuBarManager::saveCanvasRequested, this, &MainWindow::onMenuSaveCanvasRequested);
     }
 #endif
     
@@ -397,12 +401,14 @@ MainWindow::MainWindow(QWidget* parent)
     // [PHASE 3] Start system monitoring
     if (m_systemMonitor) {
         m_systemMonitor->startVolumeMonitoring();
-        // Connect volume changes to sync with server when watched
-        connect(m_systemMonitor, &SystemMonitor::volumeChanged, this, [this](int) {
-            if (m_webSocketClient && m_webSocketClient->isConnected() && m_isWatched) {
-                syncRegistration();
-            }
-        });
+        m_systemMonitor->startScreenMonitoring();
+        // Publish only what changed to watchers (state_delta); no-op while not watched
+        if (m_screenEventHandler) {
+            connect(m_systemMonitor, &SystemMonitor::volumeChanged,
+                    m_screenEventHandler, &ScreenEventHandler::publishStateIfChanged);
+            connect(m_systemMonitor, &SystemMonitor::screenConfigurationChanged,
+                    m_screenEventHandler, &ScreenEventHandler::publishStateIfChanged);
+        }
     }
 
     // [PHASE 7.1] Setup WebSocket message handler connections
@@ -585,6 +591,7 @@ MainWindow::MainWindow(QWidget* parent)
     m_toastSystem = new ToastNotificationSystem(this, this);
     ToastNotificationSystem::setInstance(m_toastSystem);
 
+    setupLanHub();
     connectToServer();
 }
 
@@ -1373,6 +1380,16 @@ void MainWindow::setupUI() {
                     m_screenCanvas->updateRemoteCursor(x, y);
                 }
             });
+    connect(m_webSocketClient, &WebSocketClient::cursorSamplesReceived, this,
+            [this](const QString& targetId, const QVector<CursorSample>& samples) {
+                if (!m_screenCanvas) return;
+                if (m_stackedWidget->currentWidget() != m_canvasViewPage) return;
+                bool matchWatch = (m_watchManager && targetId == m_watchManager->watchedClientId());
+                bool matchSelected = (!m_selectedClient.getId().isEmpty() && targetId == m_selectedClient.getId());
+                if (matchWatch || matchSelected) {
+                    m_screenCanvas->pushRemoteCursorSamples(samples);
+                }
+            });
 
     // Initialize responsive layout
     QTimer::singleShot(0, this, [this]() {
@@ -1411,6 +1428,43 @@ void MainWindow::onMenuAboutRequested() {
     qDebug() << "About dialog suppressed (no popup mode).";
 }
 
+// Handle canvas document open request from menu
+void MainWindow::onMenuOpenCanvasRequested() {
+    if (!m_screenCanvas) {
+        TOAST_WARNING("No canvas is open", 3000);
+        return;
+    }
+    const QString filter = QString("Mouffette canvas (*.%1)").arg(SceneDocument::kFileSuffix);
+    const QString path = QFileDialog::getOpenFileName(this, "Open Canvas", QString(), filter);
+    if (path.isEmpty()) return;
+    QString error;
+    if (!m_screenCanvas->openDocumentFromFile(path, &error)) {
+        TOAST_ERROR(QString("Could not open canvas: %1").arg(error), 4000);
+        return;
+    }
+    TOAST_SUCCESS(QString("Opened %1").arg(QFileInfo(path).fileName()), 2500);
+}
+
+// Handle canvas document save request from menu
+void MainWindow::onMenuSaveCanvasRequested() {
+    if (!m_screenCanvas) {
+        TOAST_WARNING("No canvas is open", 3000);
+        return;
+    }
+    const QString filter = QString("Mouffette canvas (*.%1)").arg(SceneDocument::kFileSuffix);
+    QString path = QFileDialog::getSaveFileName(this, "Save Canvas", QString(), filter);
+    if (path.isEmpty()) return;
+    if (QFileInfo(path).suffix().isEmpty()) {
+        path += QStringLiteral(".") + SceneDocument::kFileSuffix;
+    }
+    QString error;
+    if (!m_screenCanvas->saveDocumentToFile(path, &error)) {
+        TOAST_ERROR(QString("Could not save canvas: %1").arg(error), 4000);
+        return;
+    }
+    TOAST_SUCCESS(QString("Saved %1").arg(QFileInfo(path).fileName()), 2500);
+}
+
 // [PHASE 6.2] Delegate to SystemTrayManager
 void MainWindow::setupSystemTray() {
     if (m_systemTrayManager) {
@@ -1586,6 +1640,12 @@ void MainWindow::syncRegistration() {
     }
 }
 
+void MainWindow::publishStateHeartbeat() {
+    if (m_screenEventHandler) {
+        m_screenEventHandler->sendStateHeartbeat();
+    }
+}
+
 void MainWindow::onScreensInfoReceived(const ClientInfo& clientInfo) {
     // [PHASE 7.2] Delegate to ScreenEventHandler
     if (m_screenEventHandler) {
@@ -1626,11 +1686,47 @@ QList<ScreenInfo> MainWindow::getLocalScreenInfo() {
 void MainWindow::connectToServer() {
     if (!m_webSocketClient) return;
     // [Phase 12] Get server URL from SettingsManager
-    const QString url = m_settingsManager ? m_settingsManager->getServerUrl() : DEFAULT_SERVER_URL;
+    QString url = m_settingsManager ? m_settingsManager->getServerUrl() : DEFAULT_SERVER_URL;
+    // A LAN hub (our own, or one announced by another client) replaces the configured relay
+    if (m_embeddedHub && m_embeddedHub->isListening()) {
+        url = m_embeddedHub->localUrl().toString();
+    } else if (m_hubLocator && m_hubLocator->hubUrl().isValid()) {
+        url = m_hubLocator->hubUrl().toString();
+    }
     qDebug() << "Connecting to server:" << url;
     m_webSocketClient->connectToServer(url);
 }
 
+void MainWindow::setupLanHub() {
+    if (EmbeddedHub::enabled()) {
+        m_embeddedHub = new EmbeddedHub(this);
+        if (m_embeddedHub->start()) {
+            qInfo() << "Hosting LAN hub on port" << m_embeddedHub->port();
+            return;
+        }
+        // Port taken (e.g. server.js on the same machine): fall back to the configured relay
+        delete m_embeddedHub;
+        m_embeddedHub = nullptr;
+    }
+    if (HubLocator::enabled()) {
+        m_hubLocator = new HubLocator(this);
+        if (!m_hubLocator->start()) {
+            delete m_hubLocator;
+            m_hubLocator = nullptr;
+            return;
+        }
+        connect(m_hubLocator, &HubLocator::hubFound, this, [this](const QUrl& url, const QString& machineName) {
+            Q_UNUSED(url);
+            qInfo() << "Switching to LAN hub hosted by" << machineName;
+            if (m_userDisconnected) return;
+            if (m_webSocketClient->isConnected()) {
+                m_webSocketClient->disconnect();
+            }
+            connectToServer();
+        });
+    }
+}
+
 // [PHASE 3] Delegate to SystemMonitor
 QString MainWindow::getMachineName() {
     return m_systemMonitor ? m_systemMonitor->getMachineName() : "Unknown Machine";
@@ -71,6 +71,8 @@ class UploadButtonStyleManager; // Phase 11: manages upload button styling
 class SettingsManager; // Phase 12: manages application settings and persistence
 class UploadSignalConnector; // Phase 15: manages upload signal connections
 class ClientListBuilder; // Phase 16: builds display client list from connected + offline clients
+class EmbeddedHub; // in-process LAN relay (MOUFFETTE_HUB)
+class HubLocator; // finds an EmbeddedHub on the LAN (MOUFFETTE_HUB_DISCOVERY)
 // using QStackedWidget for canvas container switching
 class QFrame; // forward declare for separators in remote info container
 
@@ -119,6 +121,7 @@ public:
     void setUIEnabled(bool enabled);
     void setLocalNetworkStatus(const QString& status);
     void syncRegistration();
+    void publishStateHeartbeat();
     void removeVolumeIndicatorFromLayout();
     void addRemoteStatusToLayout();
     void setRemoteConnectionStatus(const QString& status, bool propagateLoss = true);
@@ -271,6 +274,8 @@ private slots:
     // Menu bar slots [Phase 6.3]
     void onMenuQuitRequested();
     void onMenuAboutRequested();
+    void onMenuOpenCanvasRequested();
+    void onMenuSaveCanvasRequested();
     
     void showSettingsDialog();
 
@@ -294,6 +299,7 @@ private:
     void setupMenuBar();
     void setupSystemTray();
     // connectToServer() moved to public (Phase 12)
+    void setupLanHub();
     // [Phase 7.1] scheduleReconnect, syncRegistration, setUIEnabled, setLocalNetworkStatus moved to public
     // [Phase 7.2] getLocalScreenInfo, getMachineName, getPlatformName, getSystemVolumePercent moved to public
     void setupVolumeMonitoring();
@@ -436,6 +442,10 @@ private:
     // [Phase 15] Upload signal connector
     UploadSignalConnector* m_uploadSignalConnector = nullptr;
     
+    // LAN hub mode: hosting a relay, or following one found on the LAN
+    EmbeddedHub* m_embeddedHub = nullptr;
+    HubLocator* m_hubLocator = nullptr;
+    
     int m_lastConnectedClientCount = 0;
     QString m_activeSessionIdentity;
     ClientInfo m_thisClient;
@@ -24,7 +24,7 @@ void TimerController::setupTimers() {
     // Periodic connection status refresh no longer needed (now event-driven); keep timer disabled
     statusUpdateTimer->stop();
 
-    // Periodic display sync only when watched
+    // Periodic state hash heartbeat only when watched
     displaySyncTimer->setInterval(3000);
     connect(displaySyncTimer, &QTimer::timeout, this, &TimerController::onDisplaySyncTimeout);
     // Don't start automatically - will be started when watched
@@ -114,6 +114,7 @@ void TimerController::setWatchedState(bool watched) {
         if (cursorTimer) {
             cursorTimer->stop();
         }
+        m_cursorBatch.clear();
     }
 }
 
@@ -129,7 +130,8 @@ void TimerController::onDisplaySyncTimeout() {
     if (m_mainWindow->isWatched()) {
         WebSocketClient* client = m_mainWindow->getWebSocketClient();
         if (client && client->isConnected()) {
-            m_mainWindow->syncRegistration();
+            // Hash heartbeat only; changes themselves are published as they happen
+            m_mainWindow->publishStateHeartbeat();
         }
     }
 }
@@ -143,20 +145,37 @@ void TimerController::onCursorTimeout() {
     const int gy = ok ? static_cast<int>(pt.y) : QCursor::pos().y();
     if (gx != lastX || gy != lastY) {
         lastX = gx; lastY = gy;
-        WebSocketClient* client = m_mainWindow->getWebSocketClient();
-        if (client && client->isConnected() && m_mainWindow->isWatched()) {
-            client->sendCursorUpdate(gx, gy);
-        }
+        recordCursorSample(gx, gy);
     }
 #else
     const QPoint p = QCursor::pos();
     if (p.x() != lastX || p.y() != lastY) {
         lastX = p.x();
         lastY = p.y();
-        WebSocketClient* client = m_mainWindow->getWebSocketClient();
-        if (client && client->isConnected() && m_mainWindow->isWatched()) {
-            client->sendCursorUpdate(p.x(), p.y());
-        }
+        recordCursorSample(p.x(), p.y());
     }
 #endif
+    // Idle ticks still deliver a pending batch once it is old enough
+    if (!m_cursorBatch.isEmpty() &&
+        m_cursorClock.elapsed() - m_cursorBatch.first().timeMs >= CursorStream::kBatchIntervalMs) {
+        flushCursorBatch();
+    }
+}
+
+void TimerController::recordCursorSample(int x, int y) {
+    if (!m_cursorClock.isValid()) {
+        m_cursorClock.start();
+    }
+    m_cursorBatch.append(CursorSample{m_cursorClock.elapsed(), x, y});
+    if (m_cursorBatch.size() >= CursorStream::kMaxBatchSamples) {
+        flushCursorBatch();
+    }
+}
+
+void TimerController::flushCursorBatch() {
+    WebSocketClient* client = m_mainWindow->getWebSocketClient();
+    if (client && client->isConnected() && m_mainWindow->isWatched()) {
+        client->sendCursorSamples(m_cursorBatch);
+    }
+    m_cursorBatch.clear();
 }
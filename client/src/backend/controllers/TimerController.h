@@ -1,8 +1,11 @@
 #ifndef TIMERCONTROLLER_H
 #define TIMERCONTROLLER_H
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QTimer>
+#include <QVector>
+#include "backend/network/CursorStream.h"
 
 class MainWindow;
 
@@ -10,6 +13,7 @@ class MainWindow;
  * [PHASE 10] TimerController
  * Manages all timer setup, configuration, and callbacks for MainWindow.
  * Handles: status update timer, display sync timer, reconnect timer, cursor update timer.
+ * Cursor positions are sampled at the configured interval but sent in CursorStream batches.
  */
 class TimerController : public QObject {
     Q_OBJECT
@@ -38,6 +42,11 @@ private:
     // Timer callbacks
     void onDisplaySyncTimeout();
     void onCursorTimeout();
+    void recordCursorSample(int x, int y);
+    void flushCursorBatch();
+
+    QElapsedTimer m_cursorClock;
+    QVector<CursorSample> m_cursorBatch;
 };
 
 #endif // TIMERCONTROLLER_H
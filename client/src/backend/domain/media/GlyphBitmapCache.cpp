@@ -0,0 +1,654 @@
+// GlyphBitmapCache.cpp - Sharded glyph coverage atlas shared by editor and remote text renderers
+#include "GlyphBitmapCache.h"
+#include <QMutexLocker>
+#include <QPainter>
+#include <QPen>
+#include <QRawFont>
+#include <QTransform>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr int kDefaultGlyphBitmapCacheMaxCostKb = 32768;
+constexpr int kAtlasGutterPx = 1;          // keeps bilinear sampling from bleeding into neighbours
+constexpr int kMaxTintLayerSidePx = 16384;
+
+int glyphBitmapCacheMaxCostKbFromEnv() {
+    const QByteArray raw = qgetenv("MOUFFETTE_TEXT_GLYPH_CACHE_MAX_COST_KB");
+    if (!raw.isEmpty()) {
+        bool ok = false;
+        const int parsed = raw.trimmed().toInt(&ok);
+        if (ok) {
+            return std::clamp(parsed, 1024, 262144);
+        }
+    }
+    return kDefaultGlyphBitmapCacheMaxCostKb;
+}
+
+std::shared_ptr<GlyphAtlasPage> makeAtlasPage(const QSize& size) {
+    auto page = std::make_shared<GlyphAtlasPage>();
+    page->image = QImage(size, QImage::Format_Alpha8);
+    page->image.fill(0);
+    page->pixels = page->image.bits();
+    page->bytesPerLine = page->image.bytesPerLine();
+    return page;
+}
+
+// Rasterise one layer in ARGB and keep only its alpha channel
+QImage rasterizeCoverage(const QPainterPath& glyphPath, const QSize& size, const QRectF& renderBounds,
+                         qreal rasterScale, qreal strokeWidth) {
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.scale(rasterScale, rasterScale);
+    painter.translate(-renderBounds.left(), -renderBounds.top());
+    if (strokeWidth > 0.0) {
+        painter.setPen(QPen(Qt::black, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        painter.setBrush(Qt::NoBrush);
+    } else {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+    }
+    painter.drawPath(glyphPath);
+    painter.end();
+    return image.convertToFormat(QImage::Format_Alpha8);
+}
+
+constexpr qint32 kDistanceFieldScaleBucket = -1;  // bitmap entries always have a positive bucket
+
+struct DistanceOffset {
+    int dx = 0;
+    int dy = 0;
+
+    int dist2() const { return dx * dx + dy * dy; }
+};
+
+constexpr int kFarOffset = 1 << 14;
+
+// Two-pass 8SSEDT: after the sweeps every cell holds the offset to its nearest seed cell
+void sweepDistanceOffsets(std::vector<DistanceOffset>& grid, int w, int h) {
+    auto relax = [&](DistanceOffset& cell, int x, int y, int ox, int oy) {
+        const int nx = x + ox;
+        const int ny = y + oy;
+        DistanceOffset other{kFarOffset, kFarOffset};
+        if (nx >= 0 && ny >= 0 && nx < w && ny < h) {
+            other = grid[static_cast<size_t>(ny) * w + nx];
+        }
+        other.dx += ox;
+        other.dy += oy;
+        if (other.dist2() < cell.dist2()) {
+            cell = other;
+        }
+    };
+
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            DistanceOffset& cell = grid[static_cast<size_t>(y) * w + x];
+            relax(cell, x, y, -1, 0);
+            relax(cell, x, y, 0, -1);
+            relax(cell, x, y, -1, -1);
+            relax(cell, x, y, 1, -1);
+        }
+        for (int x = w - 1; x >= 0; --x) {
+            relax(grid[static_cast<size_t>(y) * w + x], x, y, 1, 0);
+        }
+    }
+    for (int y = h - 1; y >= 0; --y) {
+        for (int x = w - 1; x >= 0; --x) {
+            DistanceOffset& cell = grid[static_cast<size_t>(y) * w + x];
+            relax(cell, x, y, 1, 0);
+            relax(cell, x, y, 0, 1);
+            relax(cell, x, y, -1, 1);
+            relax(cell, x, y, 1, 1);
+        }
+        for (int x = 0; x < w; ++x) {
+            relax(grid[static_cast<size_t>(y) * w + x], x, y, -1, 0);
+        }
+    }
+}
+
+// Alpha8 coverage -> Alpha8 signed distance field (see GlyphDistanceField for the encoding)
+QImage buildDistanceField(const QImage& coverage) {
+    const int w = coverage.width();
+    const int h = coverage.height();
+    std::vector<DistanceOffset> toOutside(static_cast<size_t>(w) * h);
+    std::vector<DistanceOffset> toInside(static_cast<size_t>(w) * h);
+    for (int y = 0; y < h; ++y) {
+        const uchar* row = coverage.constScanLine(y);
+        for (int x = 0; x < w; ++x) {
+            const bool inside = row[x] >= 128;
+            const size_t i = static_cast<size_t>(y) * w + x;
+            toOutside[i] = inside ? DistanceOffset{kFarOffset, kFarOffset} : DistanceOffset{};
+            toInside[i] = inside ? DistanceOffset{} : DistanceOffset{kFarOffset, kFarOffset};
+        }
+    }
+    sweepDistanceOffsets(toOutside, w, h);
+    sweepDistanceOffsets(toInside, w, h);
+
+    // Cell centres are half a pixel from the edge between an inside and an outside cell
+    const float unitsPerStep = 127.0f / static_cast<float>(GlyphBitmapCache::kDistanceFieldSpreadPx);
+    QImage field(w, h, QImage::Format_Alpha8);
+    for (int y = 0; y < h; ++y) {
+        const uchar* row = coverage.constScanLine(y);
+        uchar* out = field.scanLine(y);
+        for (int x = 0; x < w; ++x) {
+            const size_t i = static_cast<size_t>(y) * w + x;
+            const float distance = row[x] >= 128
+                ? std::sqrt(static_cast<float>(toOutside[i].dist2())) - 0.5f
+                : 0.5f - std::sqrt(static_cast<float>(toInside[i].dist2()));
+            out[x] = static_cast<uchar>(std::clamp(std::lround(128.0f + distance * unitsPerStep), 0L, 255L));
+        }
+    }
+    return field;
+}
+
+} // anonymous namespace
+
+size_t qHash(const GlyphBitmapKey& key, size_t seed) {
+    seed = ::qHash(key.family, seed);
+    seed = ::qHash(key.style, seed);
+    seed = ::qHash(static_cast<quint64>(key.pixelSizeScaled), seed);
+    seed = ::qHash(key.glyphIndex, seed);
+    seed = ::qHash(key.strokeWidthScaled, seed);
+    return ::qHash(key.scaleBucket, seed);
+}
+
+void drawTintedGlyphMasks(QPainter* painter, const QVector<GlyphMaskDraw>& draws,
+                          GlyphMaskLayer layer, const QColor& color) {
+    if (!painter || draws.isEmpty() || color.alpha() == 0) {
+        return;
+    }
+
+    auto slotFor = [layer](const GlyphCoverage& coverage) -> const GlyphMaskSlot& {
+        return layer == GlyphMaskLayer::Stroke ? coverage.stroke : coverage.fill;
+    };
+    auto targetRectFor = [&](const GlyphMaskDraw& draw) {
+        const GlyphMaskSlot& slot = slotFor(draw.coverage);
+        const qreal scale = std::max(draw.coverage.rasterScale, 1e-4);
+        return QRectF(draw.glyphPos + draw.coverage.originOffset, QSizeF(slot.rect.size()) / scale);
+    };
+
+    QRectF bounds;
+    for (const GlyphMaskDraw& draw : draws) {
+        if (!slotFor(draw.coverage).isNull()) {
+            bounds |= targetRectFor(draw);
+        }
+    }
+    if (painter->hasClipping()) {
+        bounds &= painter->clipBoundingRect();
+    }
+    if (bounds.isEmpty()) {
+        return;
+    }
+
+    const QTransform deviceTransform = painter->deviceTransform();
+    const QRect deviceRect = deviceTransform.mapRect(bounds).toAlignedRect();
+    if (deviceRect.isEmpty() || deviceRect.width() > kMaxTintLayerSidePx || deviceRect.height() > kMaxTintLayerSidePx) {
+        return;
+    }
+
+    QImage tintLayer(deviceRect.size(), QImage::Format_ARGB32_Premultiplied);
+    tintLayer.fill(Qt::transparent);
+    {
+        QPainter layerPainter(&tintLayer);
+        layerPainter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        layerPainter.setTransform(deviceTransform * QTransform::fromTranslate(-deviceRect.left(), -deviceRect.top()));
+        for (const GlyphMaskDraw& draw : draws) {
+            const GlyphMaskSlot& slot = slotFor(draw.coverage);
+            if (slot.isNull()) {
+                continue;
+            }
+            const QRectF target = targetRectFor(draw);
+            if (!bounds.intersects(target)) {
+                continue;
+            }
+            // Alpha8 sources composite as black with the mask as alpha
+            layerPainter.drawImage(target, slot.page->image, QRectF(slot.rect));
+        }
+        layerPainter.resetTransform();
+        layerPainter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+        layerPainter.fillRect(tintLayer.rect(), color);
+    }
+
+    // deviceTransform already includes the device pixel ratio; undo it for the final blit
+    const qreal dpr = painter->device() ? std::max<qreal>(painter->device()->devicePixelRatio(), 1e-4) : 1.0;
+    painter->save();
+    painter->resetTransform();
+    painter->drawImage(QRectF(QPointF(deviceRect.topLeft()) / dpr, QSizeF(deviceRect.size()) / dpr), tintLayer);
+    painter->restore();
+}
+
+bool drawDistanceFieldGlyphs(QPainter* painter, const QVector<GlyphFieldDraw>& draws, qreal strokeWidth,
+                             const QColor& fillColor, const QColor& outlineColor) {
+    if (!painter) {
+        return false;
+    }
+    const QTransform deviceTransform = painter->deviceTransform();
+    if (deviceTransform.type() > QTransform::TxScale || deviceTransform.m11() <= 0.0 || deviceTransform.m22() <= 0.0) {
+        return false;
+    }
+    if (draws.isEmpty()) {
+        return true;
+    }
+
+    auto targetRectFor = [](const GlyphFieldDraw& draw) {
+        return QRectF(draw.glyphPos + draw.field.originOffset,
+                      QSizeF(draw.field.slot.rect.size()) / std::max(draw.field.fieldScale, 1e-4));
+    };
+    QRectF bounds;
+    for (const GlyphFieldDraw& draw : draws) {
+        if (!draw.field.isNull()) {
+            bounds |= targetRectFor(draw);
+        }
+    }
+    if (painter->hasClipping()) {
+        bounds &= painter->clipBoundingRect();
+    }
+    if (bounds.isEmpty()) {
+        return true;
+    }
+    const QRect deviceRect = deviceTransform.mapRect(bounds).toAlignedRect();
+    if (deviceRect.isEmpty() || deviceRect.width() > kMaxTintLayerSidePx || deviceRect.height() > kMaxTintLayerSidePx) {
+        return true;
+    }
+
+    // Coverage of both layers over the device rect; overlapping glyphs merge by max (union)
+    const int layerW = deviceRect.width();
+    const int layerH = deviceRect.height();
+    const bool drawOutline = strokeWidth > 0.0 && outlineColor.alpha() > 0;
+    std::vector<float> fillCoverage(static_cast<size_t>(layerW) * layerH, 0.0f);
+    std::vector<float> outlineCoverage(drawOutline ? fillCoverage.size() : 0, 0.0f);
+
+    const float scaleX = static_cast<float>(deviceTransform.m11());
+    const float scaleY = static_cast<float>(deviceTransform.m22());
+    const float translateX = static_cast<float>(deviceTransform.dx());
+    const float translateY = static_cast<float>(deviceTransform.dy());
+    const float devicePerUnit = 0.5f * (scaleX + scaleY);
+    const float fieldPerStep = static_cast<float>(GlyphBitmapCache::kDistanceFieldSpreadPx) / 127.0f;
+
+    for (const GlyphFieldDraw& draw : draws) {
+        const GlyphDistanceField& field = draw.field;
+        if (field.isNull()) {
+            continue;
+        }
+        const QRect glyphRect = deviceTransform.mapRect(targetRectFor(draw)).toAlignedRect().intersected(deviceRect);
+        if (glyphRect.isEmpty()) {
+            continue;
+        }
+
+        const uchar* texels = field.slot.page->image.constBits();
+        const qsizetype stride = field.slot.page->image.bytesPerLine();
+        const QRect slot = field.slot.rect;
+        auto texel = [&](int x, int y) -> float {
+            if (x < 0 || y < 0 || x >= slot.width() || y >= slot.height()) {
+                return 0.0f;
+            }
+            return static_cast<float>(texels[(slot.y() + y) * stride + slot.x() + x]);
+        };
+
+        const float fieldScale = static_cast<float>(field.fieldScale);
+        const float originX = static_cast<float>(draw.glyphPos.x() + field.originOffset.x());
+        const float originY = static_cast<float>(draw.glyphPos.y() + field.originOffset.y());
+        const float devicePerField = devicePerUnit / fieldScale;
+        const float outlineField = static_cast<float>(strokeWidth) * fieldScale;
+        const float stepX = fieldScale / scaleX;
+
+        for (int y = glyphRect.top(); y <= glyphRect.bottom(); ++y) {
+            const float fy = ((static_cast<float>(y) + 0.5f - translateY) / scaleY - originY) * fieldScale - 0.5f;
+            const int y0 = static_cast<int>(std::floor(fy));
+            const float ty = fy - static_cast<float>(y0);
+            float fx = ((static_cast<float>(glyphRect.left()) + 0.5f - translateX) / scaleX - originX) * fieldScale - 0.5f;
+            const size_t rowBase = static_cast<size_t>(y - deviceRect.top()) * layerW - deviceRect.left();
+            for (int x = glyphRect.left(); x <= glyphRect.right(); ++x, fx += stepX) {
+                const int x0 = static_cast<int>(std::floor(fx));
+                const float tx = fx - static_cast<float>(x0);
+                const float top = texel(x0, y0) + (texel(x0 + 1, y0) - texel(x0, y0)) * tx;
+                const float bottom = texel(x0, y0 + 1) + (texel(x0 + 1, y0 + 1) - texel(x0, y0 + 1)) * tx;
+                const float distance = ((top + (bottom - top) * ty) - 128.0f) * fieldPerStep;  // field px
+
+                float& fill = fillCoverage[rowBase + x];
+                fill = std::max(fill, std::clamp(distance * devicePerField + 0.5f, 0.0f, 1.0f));
+                if (drawOutline) {
+                    float& outline = outlineCoverage[rowBase + x];
+                    outline = std::max(outline, std::clamp((distance + outlineField) * devicePerField + 0.5f, 0.0f, 1.0f));
+                }
+            }
+        }
+    }
+
+    // Tint: fill over outline, premultiplied
+    const QRgb fillPremultiplied = qPremultiply(fillColor.rgba());
+    const QRgb outlinePremultiplied = qPremultiply(outlineColor.rgba());
+    const float fillA = static_cast<float>(qAlpha(fillPremultiplied));
+    QImage tintLayer(deviceRect.size(), QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < layerH; ++y) {
+        QRgb* out = reinterpret_cast<QRgb*>(tintLayer.scanLine(y));
+        const size_t rowBase = static_cast<size_t>(y) * layerW;
+        for (int x = 0; x < layerW; ++x) {
+            const float cf = fillCoverage[rowBase + x];
+            const float co = drawOutline ? outlineCoverage[rowBase + x] * (1.0f - cf * fillA / 255.0f) : 0.0f;
+            auto channel = [&](int f, int o) {
+                return std::min(255, static_cast<int>(static_cast<float>(f) * cf + static_cast<float>(o) * co + 0.5f));
+            };
+            out[x] = qRgba(channel(qRed(fillPremultiplied), qRed(outlinePremultiplied)),
+                           channel(qGreen(fillPremultiplied), qGreen(outlinePremultiplied)),
+                           channel(qBlue(fillPremultiplied), qBlue(outlinePremultiplied)),
+                           channel(qAlpha(fillPremultiplied), qAlpha(outlinePremultiplied)));
+        }
+    }
+
+    const qreal dpr = painter->device() ? std::max<qreal>(painter->device()->devicePixelRatio(), 1e-4) : 1.0;
+    painter->save();
+    painter->resetTransform();
+    painter->drawImage(QRectF(QPointF(deviceRect.topLeft()) / dpr, QSizeF(deviceRect.size()) / dpr), tintLayer);
+    painter->restore();
+    return true;
+}
+
+GlyphBitmapCache& GlyphBitmapCache::instance() {
+    static GlyphBitmapCache* cache = new GlyphBitmapCache(); // intentionally leaked: raster jobs may outlive statics
+    return *cache;
+}
+
+GlyphBitmapCache::GlyphBitmapCache()
+    : m_maxCostKb(glyphBitmapCacheMaxCostKbFromEnv())
+    , m_shardCostKb(std::max(1, m_maxCostKb / kShardCount)) {
+    // Small budgets get smaller pages so each shard can still hold a couple of them
+    while (m_atlasPageSize > 128 && 2 * (m_atlasPageSize * m_atlasPageSize / 1024) > m_shardCostKb) {
+        m_atlasPageSize /= 2;
+    }
+    for (Shard& shard : m_shards) {
+        // Memory is bounded by trimPages(); the QCache is only the key index
+        shard.cache.setMaxCost(std::numeric_limits<int>::max());
+    }
+}
+
+GlyphBitmapCache::Shard& GlyphBitmapCache::shardFor(const GlyphBitmapKey& key) {
+    // Fold the high bits in so shard selection does not depend only on the weakest hash bits
+    const size_t h = qHash(key);
+    return m_shards[(h ^ (h >> 17)) % kShardCount];
+}
+
+GlyphMaskSlot GlyphBitmapCache::packMask(Shard& shard, const QImage& mask) {
+    GlyphMaskSlot slot;
+    if (mask.isNull()) {
+        return slot;
+    }
+
+    const int w = mask.width();
+    const int h = mask.height();
+    std::shared_ptr<GlyphAtlasPage> target;
+    QPoint origin;
+    if (w + kAtlasGutterPx > m_atlasPageSize || h + kAtlasGutterPx > m_atlasPageSize) {
+        target = allocatePage(shard, QSize(w, h));
+    } else {
+        if (shard.page && shard.shelfX + w + kAtlasGutterPx > m_atlasPageSize) {
+            shard.shelfX = 0;
+            shard.shelfY += shard.shelfHeight + kAtlasGutterPx;
+            shard.shelfHeight = 0;
+        }
+        if (!shard.page || shard.shelfY + h + kAtlasGutterPx > m_atlasPageSize) {
+            shard.page = allocatePage(shard, QSize(m_atlasPageSize, m_atlasPageSize));
+            shard.shelfX = 0;
+            shard.shelfY = 0;
+            shard.shelfHeight = 0;
+        }
+        target = shard.page;
+        origin = QPoint(shard.shelfX, shard.shelfY);
+        shard.shelfX += w + kAtlasGutterPx;
+        shard.shelfHeight = std::max(shard.shelfHeight, h);
+    }
+
+    for (int y = 0; y < h; ++y) {
+        std::memcpy(target->pixels + (origin.y() + y) * target->bytesPerLine + origin.x(),
+                    mask.constScanLine(y),
+                    static_cast<size_t>(w));
+    }
+    slot.page = target;
+    slot.rect = QRect(origin, QSize(w, h));
+    return slot;
+}
+
+std::shared_ptr<GlyphAtlasPage> GlyphBitmapCache::allocatePage(Shard& shard, const QSize& size) {
+    AtlasPageRecord record;
+    record.page = makeAtlasPage(size);
+    record.costKb = std::max<int>(1, static_cast<int>(record.page->bytesPerLine * size.height() / 1024));
+    shard.pagesCostKb += record.costKb;
+    m_totalCostKb.fetch_add(record.costKb, std::memory_order_relaxed);
+    shard.pages.push_back(record);
+    return record.page;
+}
+
+void GlyphBitmapCache::recordKeyOnPage(Shard& shard, const GlyphMaskSlot& slot, const GlyphBitmapKey& key) {
+    if (slot.isNull()) {
+        return;
+    }
+    // The slot was just packed, so its page is one of the newest records
+    for (auto it = shard.pages.rbegin(); it != shard.pages.rend(); ++it) {
+        if (it->page == slot.page) {
+            it->keys.append(key);
+            return;
+        }
+    }
+}
+
+bool GlyphBitmapCache::trimPages(Shard& shard) {
+    bool dropped = false;
+    // The newest page always stays, even when a single oversized glyph exceeds the slice
+    while (shard.pagesCostKb > m_shardCostKb && shard.pages.size() > 1) {
+        const AtlasPageRecord& oldest = shard.pages.front();
+        for (const GlyphBitmapKey& key : oldest.keys) {
+            // A key may have been re-inserted into a newer page since it was recorded here
+            const GlyphCoverage* entry = shard.cache.object(key);
+            if (entry && (entry->fill.page == oldest.page || entry->stroke.page == oldest.page)) {
+                shard.cache.remove(key);
+            }
+        }
+        if (shard.page == oldest.page) {
+            shard.page.reset();
+            shard.shelfX = 0;
+            shard.shelfY = 0;
+            shard.shelfHeight = 0;
+        }
+        shard.pagesCostKb -= oldest.costKb;
+        m_totalCostKb.fetch_sub(oldest.costKb, std::memory_order_relaxed);
+        shard.pages.pop_front();
+        dropped = true;
+    }
+    return dropped;
+}
+
+GlyphBitmapKey GlyphBitmapCache::makeKey(const QRawFont& font, quint32 glyphIndex,
+                                         qreal strokeWidth, qreal scaleFactor) {
+    GlyphBitmapKey key;
+    key.family = font.familyName();
+    key.style = font.styleName();
+    key.pixelSizeScaled = static_cast<qint64>(std::llround(font.pixelSize() * 1024.0));
+    key.glyphIndex = glyphIndex;
+    key.strokeWidthScaled = static_cast<qint32>(std::llround(strokeWidth * 1024.0));
+    // Quantize scale to 1/256 increments for better cache hits
+    key.scaleBucket = static_cast<qint32>(std::llround(std::max(std::abs(scaleFactor), 1e-4) * 256.0));
+    return key;
+}
+
+GlyphCoverage GlyphBitmapCache::fetchOrRender(const QRawFont& font, quint32 glyphIndex,
+                                              qreal strokeWidth, qreal scaleFactor,
+                                              GlyphPathProvider pathProvider, Consumer consumer,
+                                              bool* cacheHit, InsertInfo* insertInfo) {
+    if (cacheHit) {
+        *cacheHit = false;
+    }
+    if (!font.isValid() || strokeWidth < 0.0 || !pathProvider) {
+        return GlyphCoverage();
+    }
+
+    const GlyphBitmapKey key = makeKey(font, glyphIndex, strokeWidth, scaleFactor);
+    return fetchOrInsert(key, [&]() {
+        RenderedMasks masks;
+        const QPainterPath glyphPath = pathProvider(font, glyphIndex);
+        if (glyphPath.isEmpty()) {
+            return masks;
+        }
+
+        // Calculate tight bounds with stroke overflow
+        const QRectF pathBounds = glyphPath.boundingRect();
+        const qreal padding = std::ceil(strokeWidth * 2.0) + 2.0;
+        const QRectF renderBounds = pathBounds.adjusted(-padding, -padding, padding, padding);
+        const qreal rasterScale = std::max(std::abs(scaleFactor), 1e-4);
+        const QSize maskSize(std::max(1, static_cast<int>(std::ceil(renderBounds.width() * rasterScale))),
+                             std::max(1, static_cast<int>(std::ceil(renderBounds.height() * rasterScale))));
+
+        masks.fill = rasterizeCoverage(glyphPath, maskSize, renderBounds, rasterScale, 0.0);
+        if (strokeWidth > 0.0) {
+            masks.stroke = rasterizeCoverage(glyphPath, maskSize, renderBounds, rasterScale, strokeWidth);
+        }
+        masks.originOffset = renderBounds.topLeft();
+        masks.rasterScale = rasterScale;
+        return masks;
+    }, consumer, cacheHit, insertInfo);
+}
+
+GlyphDistanceField GlyphBitmapCache::fetchOrRenderDistanceField(const QRawFont& font, quint32 glyphIndex,
+                                                                GlyphPathProvider pathProvider, Consumer consumer,
+                                                                bool* cacheHit, InsertInfo* insertInfo) {
+    if (cacheHit) {
+        *cacheHit = false;
+    }
+    if (!font.isValid() || font.pixelSize() <= 0.0 || !pathProvider) {
+        return GlyphDistanceField();
+    }
+
+    GlyphBitmapKey key = makeKey(font, glyphIndex, 0.0, 1.0);
+    key.scaleBucket = kDistanceFieldScaleBucket;
+    const GlyphCoverage coverage = fetchOrInsert(key, [&]() {
+        RenderedMasks masks;
+        const QPainterPath glyphPath = pathProvider(font, glyphIndex);
+        if (glyphPath.isEmpty()) {
+            return masks;
+        }
+
+        const qreal fieldScale = static_cast<qreal>(kDistanceFieldEmPx) / font.pixelSize();
+        const qreal padding = static_cast<qreal>(kDistanceFieldSpreadPx + 1) / fieldScale;
+        const QRectF renderBounds = glyphPath.boundingRect().adjusted(-padding, -padding, padding, padding);
+        const QSize fieldSize(std::max(1, static_cast<int>(std::ceil(renderBounds.width() * fieldScale))),
+                              std::max(1, static_cast<int>(std::ceil(renderBounds.height() * fieldScale))));
+
+        masks.fill = buildDistanceField(rasterizeCoverage(glyphPath, fieldSize, renderBounds, fieldScale, 0.0));
+        masks.originOffset = renderBounds.topLeft();
+        masks.rasterScale = fieldScale;
+        return masks;
+    }, consumer, cacheHit, insertInfo);
+
+    GlyphDistanceField field;
+    field.slot = coverage.fill;
+    field.originOffset = coverage.originOffset;
+    field.fieldScale = coverage.rasterScale;
+    return field;
+}
+
+bool GlyphBitmapCache::distanceFieldCoversStroke(const QRawFont& font, qreal strokeWidth) {
+    if (!font.isValid() || font.pixelSize() <= 0.0) {
+        return false;
+    }
+    // Keep a pixel of the spread for the antialiased edge beyond the outline
+    const qreal strokeFieldPx = strokeWidth * static_cast<qreal>(kDistanceFieldEmPx) / font.pixelSize();
+    return strokeFieldPx <= static_cast<qreal>(kDistanceFieldSpreadPx - 1);
+}
+
+GlyphCoverage GlyphBitmapCache::fetchOrInsert(const GlyphBitmapKey& key, const MaskRenderer& render, Consumer consumer,
+                                              bool* cacheHit, InsertInfo* insertInfo) {
+    ConsumerCounters& counters = m_counters[static_cast<int>(consumer)];
+    Shard& shard = shardFor(key);
+
+    {
+        QMutexLocker locker(&shard.mutex);
+        if (const GlyphCoverage* cached = shard.cache.object(key)) {
+            counters.hits.fetch_add(1, std::memory_order_relaxed);
+            if (cacheHit) {
+                *cacheHit = true;
+            }
+            return *cached;
+        }
+    }
+    counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+    // Cache miss - rasterise without holding the shard lock
+    const RenderedMasks masks = render();
+    if (masks.fill.isNull() && masks.stroke.isNull()) {
+        return GlyphCoverage();
+    }
+
+    GlyphCoverage result;
+    bool inserted = false;
+    bool evictionHint = false;
+    {
+        QMutexLocker locker(&shard.mutex);
+        if (const GlyphCoverage* raced = shard.cache.object(key)) {
+            result = *raced;
+        } else {
+            result.fill = packMask(shard, masks.fill);
+            result.stroke = packMask(shard, masks.stroke);
+            result.originOffset = masks.originOffset;
+            result.rasterScale = masks.rasterScale;
+            if (!result.isNull()) {
+                shard.cache.insert(key, new GlyphCoverage(result), 1);
+                recordKeyOnPage(shard, result.fill, key);
+                recordKeyOnPage(shard, result.stroke, key);
+                evictionHint = trimPages(shard);
+                inserted = true;
+            }
+        }
+    }
+
+    if (inserted) {
+        counters.inserts.fetch_add(1, std::memory_order_relaxed);
+        if (evictionHint) {
+            counters.evictionHints.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (insertInfo) {
+        insertInfo->inserted = inserted;
+        insertInfo->evictionHint = evictionHint;
+        insertInfo->totalCostKb = m_totalCostKb.load(std::memory_order_relaxed);
+        insertInfo->maxCostKb = m_maxCostKb;
+    }
+    return result;
+}
+
+GlyphBitmapCache::Stats GlyphBitmapCache::stats() const {
+    Stats result;
+    for (int i = 0; i < kConsumerCount; ++i) {
+        const ConsumerCounters& c = m_counters[i];
+        result.consumers[i].hits = c.hits.load(std::memory_order_relaxed);
+        result.consumers[i].misses = c.misses.load(std::memory_order_relaxed);
+        result.consumers[i].inserts = c.inserts.load(std::memory_order_relaxed);
+        result.consumers[i].evictionHints = c.evictionHints.load(std::memory_order_relaxed);
+    }
+    for (const Shard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        result.entryCount += shard.cache.count();
+        result.pageCount += static_cast<int>(shard.pages.size());
+        result.totalCostKb += shard.pagesCostKb;
+    }
+    result.maxCostKb = m_maxCostKb;
+    return result;
+}
+
+void GlyphBitmapCache::clear() {
+    for (Shard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        m_totalCostKb.fetch_sub(shard.pagesCostKb, std::memory_order_relaxed);
+        shard.cache.clear();
+        shard.pages.clear();
+        shard.pagesCostKb = 0;
+        shard.page.reset();
+        shard.shelfX = 0;
+        shard.shelfY = 0;
+        shard.shelfHeight = 0;
+    }
+}
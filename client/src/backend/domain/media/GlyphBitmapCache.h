@@ -0,0 +1,244 @@
+// GlyphBitmapCache.h - Process-wide glyph coverage atlas shared by all text renderers
+#pragma once
+
+#include <QCache>
+#include <QColor>
+#include <QImage>
+#include <QMutex>
+#include <QPainterPath>
+#include <QPointF>
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+class QPainter;
+class QRawFont;
+
+// Identity of one rasterised glyph: outline (font + size + glyph) plus the geometry inputs that
+// change its coverage. Colours are deliberately absent; they are applied when compositing.
+// Stroke width and raster scale are quantised so nearby values share entries.
+struct GlyphBitmapKey {
+    QString family;
+    QString style;
+    qint64 pixelSizeScaled = 0;  // pixel size * 1024
+    quint32 glyphIndex = 0;
+    qint32 strokeWidthScaled = 0; // stroke width * 1024
+    qint32 scaleBucket = 0;       // raster scale * 256
+
+    friend bool operator==(const GlyphBitmapKey& a, const GlyphBitmapKey& b) {
+        return a.glyphIndex == b.glyphIndex &&
+               a.pixelSizeScaled == b.pixelSizeScaled &&
+               a.strokeWidthScaled == b.strokeWidthScaled &&
+               a.scaleBucket == b.scaleBucket &&
+               a.family == b.family &&
+               a.style == b.style;
+    }
+};
+
+size_t qHash(const GlyphBitmapKey& key, size_t seed = 0);
+
+// One Format_Alpha8 atlas page. Pixels are written once per slot through 'pixels' while the
+// owning shard is locked and never change afterwards, so readers only use const QImage access.
+struct GlyphAtlasPage {
+    QImage image;
+    uchar* pixels = nullptr;
+    qsizetype bytesPerLine = 0;
+};
+
+struct GlyphMaskSlot {
+    std::shared_ptr<const GlyphAtlasPage> page;
+    QRect rect;
+
+    bool isNull() const { return !page || rect.isEmpty(); }
+};
+
+// 8-bit coverage of a glyph's fill and (optional) stroke layers. originOffset is in glyph units;
+// slot rects are in raster pixels at rasterScale.
+struct GlyphCoverage {
+    GlyphMaskSlot fill;
+    GlyphMaskSlot stroke;
+    QPointF originOffset;
+    qreal rasterScale = 1.0;
+
+    bool isNull() const { return fill.isNull() && stroke.isNull(); }
+};
+
+enum class GlyphMaskLayer {
+    Fill,
+    Stroke
+};
+
+struct GlyphMaskDraw {
+    QPointF glyphPos;
+    GlyphCoverage coverage;
+};
+
+// Signed distance field of one glyph outline, rendered once at a reference em size. Each texel
+// stores 128 + distance * 127 / GlyphBitmapCache::kDistanceFieldSpreadPx (inside positive, in
+// field pixels), so fill and any outline up to the spread can be thresholded out at any scale.
+struct GlyphDistanceField {
+    GlyphMaskSlot slot;
+    QPointF originOffset;    // glyph units
+    qreal fieldScale = 1.0;  // field pixels per glyph unit
+
+    bool isNull() const { return slot.isNull(); }
+};
+
+struct GlyphFieldDraw {
+    QPointF glyphPos;
+    GlyphDistanceField field;
+};
+
+// Composite the given layer of every glyph in colour. Masks are accumulated into a device-aligned
+// ARGB layer which is tinted once (SourceIn) and then drawn, so overlapping glyph edges blend as a
+// single coverage union.
+void drawTintedGlyphMasks(QPainter* painter, const QVector<GlyphMaskDraw>& draws,
+                          GlyphMaskLayer layer, const QColor& color);
+
+// Threshold distance fields into outline and fill coverage at the painter's current scale and
+// composite both (outline under fill) in one device-aligned layer. Returns false without drawing
+// when the painter's transform is not an axis-aligned scale/translate.
+bool drawDistanceFieldGlyphs(QPainter* painter, const QVector<GlyphFieldDraw>& draws, qreal strokeWidth,
+                             const QColor& fillColor, const QColor& outlineColor);
+
+/**
+ * @brief GlyphBitmapCache - One glyph coverage atlas for the editor and the remote display
+ *
+ * Entries are spread over kShardCount shards by key hash; each shard has its own mutex and an
+ * equal slice of the memory budget, so concurrent raster jobs only contend when they touch the
+ * same shard. Rasterisation on a miss happens outside any lock.
+ *
+ * Each shard shelf-packs its masks into Alpha8 pages of up to kAtlasPageSize (oversized glyphs
+ * get a dedicated page) and the budget is charged per allocated page, not per slot. When a new
+ * page would push the shard over its slice, the oldest pages are dropped together with every
+ * entry that points into them; glyphs still in use are re-rasterised into the current page, so
+ * hot glyphs migrate forward and resident atlas memory stays within the budget. In-flight draws
+ * keep a dropped page alive until they finish.
+ *
+ * Distance fields (fetchOrRenderDistanceField) share the shards and budget. They are keyed by
+ * outline only, so one entry serves every zoom level and outline width up to the spread.
+ *
+ * The budget comes from MOUFFETTE_TEXT_GLYPH_CACHE_MAX_COST_KB (default 32768, clamped to
+ * 1024..262144) and covers every consumer. Hit/miss/insert counters are kept per consumer so
+ * stats() can still tell editor and remote traffic apart.
+ */
+class GlyphBitmapCache {
+public:
+    enum class Consumer {
+        Editor = 0,
+        Remote = 1
+    };
+    static constexpr int kConsumerCount = 2;
+    static constexpr int kShardCount = 16;
+    static constexpr int kAtlasPageSize = 512;
+    static constexpr int kDistanceFieldEmPx = 64;      // reference em size fields are rendered at
+    static constexpr int kDistanceFieldSpreadPx = 16;  // distance range encoded around the outline
+
+    using GlyphPathProvider = QPainterPath (*)(const QRawFont&, quint32);
+
+    struct InsertInfo {
+        bool inserted = false;
+        bool evictionHint = false; // the insert pushed older entries out of its shard
+        int totalCostKb = 0;
+        int maxCostKb = 0;
+    };
+
+    struct ConsumerStats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 inserts = 0;
+        quint64 evictionHints = 0;
+    };
+
+    struct Stats {
+        std::array<ConsumerStats, kConsumerCount> consumers{};
+        int entryCount = 0;
+        int pageCount = 0;
+        int totalCostKb = 0; // bytes of allocated atlas pages
+        int maxCostKb = 0;
+    };
+
+    static GlyphBitmapCache& instance();
+
+    static GlyphBitmapKey makeKey(const QRawFont& font, quint32 glyphIndex,
+                                  qreal strokeWidth, qreal scaleFactor);
+
+    // Look up a glyph; on a miss fetch its outline from pathProvider, rasterise and insert it.
+    // Safe to call from any thread.
+    GlyphCoverage fetchOrRender(const QRawFont& font, quint32 glyphIndex,
+                                qreal strokeWidth, qreal scaleFactor,
+                                GlyphPathProvider pathProvider, Consumer consumer,
+                                bool* cacheHit = nullptr, InsertInfo* insertInfo = nullptr);
+
+    // Distance-field variant of fetchOrRender; independent of stroke width and scale
+    GlyphDistanceField fetchOrRenderDistanceField(const QRawFont& font, quint32 glyphIndex,
+                                                  GlyphPathProvider pathProvider, Consumer consumer,
+                                                  bool* cacheHit = nullptr, InsertInfo* insertInfo = nullptr);
+    // Whether an outline of strokeWidth (glyph units) still fits inside the encoded spread
+    static bool distanceFieldCoversStroke(const QRawFont& font, qreal strokeWidth);
+
+    Stats stats() const;
+    int maxCostKb() const { return m_maxCostKb; }
+    void clear();
+
+private:
+    GlyphBitmapCache();
+    GlyphBitmapCache(const GlyphBitmapCache&) = delete;
+    GlyphBitmapCache& operator=(const GlyphBitmapCache&) = delete;
+
+    // An allocated atlas page and the keys packed into it, so dropping the page can drop them too
+    struct AtlasPageRecord {
+        std::shared_ptr<GlyphAtlasPage> page;
+        QVector<GlyphBitmapKey> keys;
+        int costKb = 0;
+    };
+
+    struct alignas(64) Shard {
+        mutable QMutex mutex;
+        QCache<GlyphBitmapKey, GlyphCoverage> cache;
+        std::deque<AtlasPageRecord> pages; // oldest first
+        int pagesCostKb = 0;
+        std::shared_ptr<GlyphAtlasPage> page; // shelf page currently being filled
+        int shelfX = 0;
+        int shelfY = 0;
+        int shelfHeight = 0;
+    };
+
+    struct alignas(64) ConsumerCounters {
+        std::atomic<quint64> hits{0};
+        std::atomic<quint64> misses{0};
+        std::atomic<quint64> inserts{0};
+        std::atomic<quint64> evictionHints{0};
+    };
+
+    struct RenderedMasks {
+        QImage fill;
+        QImage stroke;
+        QPointF originOffset;
+        qreal rasterScale = 1.0;
+    };
+    using MaskRenderer = std::function<RenderedMasks()>;
+
+    // Shared lookup / render-outside-the-lock / insert sequence behind both fetch variants
+    GlyphCoverage fetchOrInsert(const GlyphBitmapKey& key, const MaskRenderer& render, Consumer consumer,
+                                bool* cacheHit, InsertInfo* insertInfo);
+    Shard& shardFor(const GlyphBitmapKey& key);
+    // Copy a standalone mask into the shard's atlas; caller holds shard.mutex
+    GlyphMaskSlot packMask(Shard& shard, const QImage& mask);
+    std::shared_ptr<GlyphAtlasPage> allocatePage(Shard& shard, const QSize& size);
+    static void recordKeyOnPage(Shard& shard, const GlyphMaskSlot& slot, const GlyphBitmapKey& key);
+    // Drop the oldest pages until the shard fits its budget; returns whether anything was dropped
+    bool trimPages(Shard& shard);
+
+    int m_maxCostKb = 0;
+    int m_shardCostKb = 0;
+    int m_atlasPageSize = kAtlasPageSize;
+    std::array<Shard, kShardCount> m_shards;
+    std::array<ConsumerCounters, kConsumerCount> m_counters;
+    std::atomic<int> m_totalCostKb{0};
+};
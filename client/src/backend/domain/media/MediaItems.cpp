@@ -30,6 +30,8 @@
 #include <QUrl>
 #include "frontend/ui/theme/AppColors.h"
 #include <QDateTime>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 // ---------------- ResizableMediaBase -----------------
 
@@ -37,6 +39,7 @@ int ResizableMediaBase::heightOfMediaOverlays = -1; // default auto
 int ResizableMediaBase::cornerRadiusOfMediaOverlays = 6;
 
 double ResizableMediaBase::s_sceneGridUnit = 1.0; // default: 1 scene unit == 1 pixel
+int ResizableMediaBase::s_batchedTransformDepth = 0;
 std::function<QPointF(const QPointF&, const QRectF&, bool, ResizableMediaBase*)> ResizableMediaBase::s_screenSnapCallback;
 std::function<ResizableMediaBase::ResizeSnapFeedback(qreal, const QPointF&, const QPointF&, const QSize&, bool, ResizableMediaBase*)> ResizableMediaBase::s_resizeSnapCallback;
 std::function<void()> ResizableMediaBase::s_uploadChangedNotifier = nullptr;
@@ -431,8 +434,9 @@ QVariant ResizableMediaBase::itemChange(GraphicsItemChange change, const QVarian
         
         // Disable movement screen-border snapping (Shift) during ANY active resize (corner or midpoint)
         // to prevent the opposite/fixed corner from being repositioned while scaling.
+        // Batched group transforms run a single snap query for the whole selection upstream.
         bool anyResizeActive = (m_activeHandle != None);
-        if (s_screenSnapCallback && !anyResizeActive) {
+        if (s_screenSnapCallback && !anyResizeActive && !isBatchedTransformActive()) {
             const bool shiftPressed = QGuiApplication::keyboardModifiers().testFlag(Qt::ShiftModifier);
             if (shiftPressed) {
                 const QRectF mediaBounds(0, 0, m_baseSize.width() * scale(), m_baseSize.height() * scale());
@@ -449,7 +453,7 @@ QVariant ResizableMediaBase::itemChange(GraphicsItemChange change, const QVarian
         updateOverlayLayout();
         updateOverlayVisibility();
     }
-    if (change == ItemTransformHasChanged || change == ItemPositionHasChanged) {
+    if ((change == ItemTransformHasChanged || change == ItemPositionHasChanged) && !isBatchedTransformActive()) {
         updateOverlayLayout();
     }
     return QGraphicsItem::itemChange(change, value);
@@ -1083,8 +1087,41 @@ void ResizableMediaBase::updateOverlayLayout() {
 ResizablePixmapItem::ResizablePixmapItem(const QPixmap& pm, int visualSizePx, int selectionSizePx, const QString& filename)
     : ResizableMediaBase(pm.size(), visualSizePx, selectionSizePx, filename), m_pix(pm) {}
 
+ResizablePixmapItem::ResizablePixmapItem(const QSize& baseSizePx, const QPixmap& placeholder, const QString& deferredSourcePath,
+                                         int visualSizePx, int selectionSizePx, const QString& filename)
+    : ResizableMediaBase(baseSizePx, visualSizePx, selectionSizePx, filename), m_pix(placeholder), m_deferredSourcePath(deferredSourcePath) {}
+
+void ResizablePixmapItem::startDeferredLoad() {
+    if (m_deferredLoadStarted || m_deferredSourcePath.isEmpty()) return;
+    m_deferredLoadStarted = true;
+    const QString path = m_deferredSourcePath;
+    auto* watcher = new QFutureWatcher<QImage>();
+    QObject::connect(watcher, &QFutureWatcher<QImage>::finished, watcher, [this, watcher, guard = lifetimeGuard()]() {
+        const QImage img = watcher->result();
+        watcher->deleteLater();
+        if (guard.expired()) return;
+        m_deferredSourcePath.clear();
+        if (img.isNull()) {
+            qWarning() << "ResizablePixmapItem: deferred load failed for" << sourcePath();
+            notifyFileError();
+            return;
+        }
+        m_pix = QPixmap::fromImage(img);
+        update();
+    });
+    watcher->setFuture(QtConcurrent::run([path]() { return QImage(path); }));
+}
+
+void ResizablePixmapItem::setDocumentPoster(const QImage& poster) {
+    if (poster.isNull() || m_deferredSourcePath.isEmpty()) return;
+    m_pix = QPixmap::fromImage(poster);
+    update();
+}
+
 void ResizablePixmapItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
     Q_UNUSED(option); Q_UNUSED(widget);
+    // Painting means the item is inside a viewport: hydrate the full-resolution image now
+    if (!m_deferredSourcePath.isEmpty()) startDeferredLoad();
     if (isContentVisible() || m_contentDisplayOpacity > 0.0) {
         qreal effective = contentOpacity() * m_contentDisplayOpacity;
         if (!m_pix.isNull() && effective > 0.0) {
@@ -1133,7 +1170,7 @@ qint64 frameTimestampMs(const QVideoFrame& frame) {
 }
 }
 
-ResizableVideoItem::ResizableVideoItem(const QString& filePath, int visualSizePx, int selectionSizePx, const QString& filename, int controlsFadeMs)
+ResizableVideoItem::ResizableVideoItem(const QString& filePath, int visualSizePx, int selectionSizePx, const QString& filename, int controlsFadeMs, bool deferSourceLoad)
     : ResizableMediaBase(QSize(640,360), visualSizePx, selectionSizePx, filename)
 {
     m_controlsFadeMs = std::max(0, controlsFadeMs);
@@ -1142,7 +1179,12 @@ ResizableVideoItem::ResizableVideoItem(const QString& filePath, int visualSizePx
     m_sink = new QVideoSink();
     m_player->setAudioOutput(m_audio);
     m_player->setVideoSink(m_sink);
-    m_player->setSource(QUrl::fromLocalFile(filePath));
+    if (deferSourceLoad) {
+        m_deferredSourceUrl = QUrl::fromLocalFile(filePath);
+        m_sourceLoadDeferred = true;
+    } else {
+        m_player->setSource(QUrl::fromLocalFile(filePath));
+    }
 
     const qreal initialVolume = m_audio ? std::clamp<qreal>(m_audio->volume(), 0.0, 1.0) : 1.0;
     m_effectiveMuted = m_audio ? m_audio->isMuted() : false;
@@ -1431,7 +1473,16 @@ ResizableVideoItem::~ResizableVideoItem() {
     delete m_player; delete m_audio; delete m_sink; delete m_controlsFadeAnim;
 }
 
+void ResizableVideoItem::ensureSourceLoaded() {
+    if (!m_sourceLoadDeferred || !m_player) return;
+    m_sourceLoadDeferred = false;
+    m_sourceLoadScheduled = false;
+    m_player->setSource(m_deferredSourceUrl);
+    m_deferredSourceUrl.clear();
+}
+
 void ResizableVideoItem::togglePlayPause() {
+    ensureSourceLoaded();
     if (!m_player) return;
     stopWarmupKeepAlive();
     if (m_warmupActive) {
@@ -1574,6 +1625,7 @@ void ResizableVideoItem::setMuted(bool muted, bool skipFade) {
 }
 
 void ResizableVideoItem::stopToBeginning() {
+    ensureSourceLoaded();
     if (!m_player) return;
     m_seamlessLoopJumpPending = false;
     m_lastSeamlessLoopTriggerMs = 0;
@@ -1588,6 +1640,7 @@ void ResizableVideoItem::stopToBeginning() {
 }
 
 void ResizableVideoItem::seekToRatio(qreal r) {
+    ensureSourceLoaded();
     if (!m_player || m_durationMs <= 0) return;
     m_seamlessLoopJumpPending = false;
     m_lastSeamlessLoopTriggerMs = 0;
@@ -1607,6 +1660,7 @@ void ResizableVideoItem::seekToRatio(qreal r) {
 }
 
 void ResizableVideoItem::pauseAndSetPosition(qint64 posMs) {
+    ensureSourceLoaded();
     if (!m_player) return;
     if (posMs < 0) posMs = 0;
     if (m_durationMs > 0 && posMs > m_durationMs) posMs = m_durationMs;
@@ -1625,6 +1679,35 @@ void ResizableVideoItem::pauseAndSetPosition(qint64 posMs) {
     startWarmupKeepAlive();
 }
 
+void ResizableVideoItem::setDocumentPlaceholder(const QImage& poster, const QSize& nativeSize) {
+    if (nativeSize.isEmpty()) {
+        setExternalPosterImage(poster);
+        return;
+    }
+    if (!poster.isNull()) {
+        m_posterImage = poster;
+        m_posterImageSet = true;
+    }
+    m_lastFrameDisplaySize = QSizeF(nativeSize);
+    m_displaySizeLocked = true;
+    adoptBaseSize(nativeSize, true);
+    update();
+}
+
+void ResizableVideoItem::setDocumentPoster(const QImage& poster) {
+    if (poster.isNull() || m_posterImageSet || !m_lastFrameImage.isNull()) {
+        return;
+    }
+    if (!m_displaySizeLocked) {
+        // No native size was saved: the poster also provides the aspect ratio
+        setExternalPosterImage(poster);
+        return;
+    }
+    m_posterImage = poster;
+    m_posterImageSet = true;
+    update();
+}
+
 void ResizableVideoItem::setExternalPosterImage(const QImage& img) {
     if (img.isNull()) {
         return;
@@ -1717,6 +1800,11 @@ void ResizableVideoItem::resetFrameStats() {
 
 void ResizableVideoItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
     Q_UNUSED(option); Q_UNUSED(widget);
+    // First paint means the item entered a viewport: attach the source outside of paint()
+    if (m_sourceLoadDeferred && !m_sourceLoadScheduled && m_player) {
+        m_sourceLoadScheduled = true;
+        QTimer::singleShot(0, m_player, [this]() { ensureSourceLoaded(); });
+    }
     QRectF br(0,0, baseWidth(), baseHeight());
     auto fitRect = [&](const QRectF& bounds, const QSize& imgSz) -> QRectF {
         if (m_fillContentWithoutAspect) {
@@ -2157,7 +2245,7 @@ QVariant ResizableVideoItem::itemChange(QGraphicsItem::GraphicsItemChange change
                 }
             }
         }
-    } else if (change == ItemPositionHasChanged || change == ItemTransformHasChanged) {
+    } else if ((change == ItemPositionHasChanged || change == ItemTransformHasChanged) && !isBatchedTransformActive()) {
         updateControlsLayout();
     }
 
@@ -17,6 +17,7 @@
 #include <QSet>
 #include <QTimer>
 #include <QVariantAnimation>
+#include <QUrl>
 #include <memory>
 #include <cmath>
 #include <functional>
@@ -79,6 +80,9 @@ public:
     QString sourcePath() const { return m_sourcePath; }
     // Stable unique identifier for this media item (persists across uploads)
     QString mediaId() const { return m_mediaId; }
+    // Restore a persisted identifier (document load). Call before setSourcePath so FileManager
+    // associations are recorded under the restored id.
+    void setMediaId(const QString& mediaId) { if (!mediaId.isEmpty()) m_mediaId = mediaId; }
     // Shared file identifier (multiple media items can have same fileId)
     QString fileId() const { return m_fileId; }
     void setFileId(const QString& fileId) { m_fileId = fileId; }
@@ -129,6 +133,12 @@ public:
     // Grid unit control: 1 scene "pixel" in view coordinates (e.g., ScreenCanvas scale)
     static void setSceneGridUnit(double u);
     static double sceneGridUnit();
+
+    // Batched group transforms (driven by ScreenCanvas): while active, itemChange skips per-item
+    // snap callbacks and overlay relayout; the canvas relayouts the whole batch once afterwards.
+    static void beginBatchedTransform() { ++s_batchedTransformDepth; }
+    static void endBatchedTransform() { if (s_batchedTransformDepth > 0) --s_batchedTransformDepth; }
+    static bool isBatchedTransformActive() { return s_batchedTransformDepth > 0; }
     
     // Snap-to-screen integration (set by ScreenCanvas)
     static void setScreenSnapCallback(std::function<QPointF(const QPointF&, const QRectF&, bool, ResizableMediaBase*)> callback);
@@ -265,6 +275,7 @@ private:
     UploadState m_uploadState = UploadState::NotUploaded;
     int m_uploadProgress = 0;
     static double s_sceneGridUnit;
+    static int s_batchedTransformDepth;
     static std::function<QPointF(const QPointF&, const QRectF&, bool, ResizableMediaBase*)> s_screenSnapCallback;
     static std::function<ResizeSnapFeedback(qreal, const QPointF&, const QPointF&, const QSize&, bool, ResizableMediaBase*)> s_resizeSnapCallback;
     static inline double snapToGrid(double v) { const double u = (s_sceneGridUnit > 1e-9 ? s_sceneGridUnit : 1.0); return std::round(v / u) * u; }
@@ -290,16 +301,31 @@ protected:
 class ResizablePixmapItem : public ResizableMediaBase {
 public:
     explicit ResizablePixmapItem(const QPixmap& pm, int visualSizePx, int selectionSizePx, const QString& filename = QString());
+    // Lazy variant (document load): shows the placeholder at baseSizePx and decodes the full-resolution
+    // image from deferredSourcePath off the GUI thread the first time the item is painted.
+    ResizablePixmapItem(const QSize& baseSizePx, const QPixmap& placeholder, const QString& deferredSourcePath,
+                        int visualSizePx, int selectionSizePx, const QString& filename = QString());
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+    const QPixmap& pixmap() const { return m_pix; }
+    bool isFullResolutionPending() const { return !m_deferredSourcePath.isEmpty(); }
+    // Document poster decoded after construction; ignored once the full-resolution image is in
+    void setDocumentPoster(const QImage& poster);
 private:
+    void startDeferredLoad();
     QPixmap m_pix;
+    QString m_deferredSourcePath;
+    bool m_deferredLoadStarted = false;
 };
 
 // Video media item with in-item controls overlays & performance instrumentation
 class ResizableVideoItem : public ResizableMediaBase {
 public:
-    explicit ResizableVideoItem(const QString& filePath, int visualSizePx, int selectionSizePx, const QString& filename = QString(), int controlsFadeMs = 140);
+    // deferSourceLoad: create the player without opening the file; the source is attached the first
+    // time the item is painted (i.e. enters a viewport) or a playback control is used.
+    explicit ResizableVideoItem(const QString& filePath, int visualSizePx, int selectionSizePx, const QString& filename = QString(), int controlsFadeMs = 140, bool deferSourceLoad = false);
     ~ResizableVideoItem() override;
+    void ensureSourceLoaded();
+    bool isSourceLoadDeferred() const { return m_sourceLoadDeferred; }
 
     // Public control helpers used by ScreenCanvas (drag gestures etc.)
     void togglePlayPause();
@@ -314,6 +340,12 @@ public:
     void pauseAndSetPosition(qint64 posMs);
     void setInitialScaleFactor(qreal f) { m_initialScaleFactor = f; }
     void setExternalPosterImage(const QImage& img);
+    // Document load: show a cached (possibly downscaled) poster at a known native size without probing the file
+    void setDocumentPlaceholder(const QImage& poster, const QSize& nativeSize);
+    // Poster decoded after setDocumentPlaceholder(); ignored once a real poster or frame exists
+    void setDocumentPoster(const QImage& poster);
+    // Best still image for persistence: last decoded frame, else poster
+    QImage posterFrameImage() const { return m_lastFrameImage.isNull() ? m_posterImage : m_lastFrameImage; }
     bool isDraggingProgress() const { return m_draggingProgress; }
     bool isDraggingVolume() const { return m_draggingVolume; }
     void requestOverlayRelayout() { updateControlsLayout(); }
@@ -329,6 +361,8 @@ public:
     // Audio state accessors for scene serialization
     bool isMuted() const { return m_effectiveMuted; }
     qreal volume() const { return m_userVolumeRatio; }
+    // Restore a saved volume without turning on the settings volume override
+    void setVolume(qreal ratio) { applyVolumeRatio(ratio); }
     
     // Repeat session management (public for host scene automation)
     void initializeSettingsRepeatSessionForPlaybackStart();
@@ -438,5 +472,8 @@ private:
     QTimer* m_warmupKeepAliveTimer = nullptr;
     qint64 m_lastWarmupCompletionMs = 0;
     bool m_keepAlivePulseActive = false;
+    QUrl m_deferredSourceUrl;
+    bool m_sourceLoadDeferred = false;
+    bool m_sourceLoadScheduled = false;
 };
 
@@ -0,0 +1,244 @@
+// TextLayoutPayload.cpp - Packing and font resolution for pre-shaped text layouts
+#include "TextLayoutPayload.h"
+#include <QByteArray>
+#include <QFont>
+#include <QJsonArray>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+
+namespace TextLayoutPayload {
+
+namespace {
+
+constexpr qreal kMetricTolerance = 0.01;
+
+bool envFlagValue(const char* name, bool defaultValue) {
+    const QByteArray lowered = qgetenv(name).trimmed().toLower();
+    if (lowered.isEmpty()) {
+        return defaultValue;
+    }
+    return lowered == "1" || lowered == "true" || lowered == "yes" || lowered == "on";
+}
+
+QJsonArray rectToJson(const QRectF& r) {
+    return QJsonArray{r.x(), r.y(), r.width(), r.height()};
+}
+
+QRectF rectFromJson(const QJsonValue& v) {
+    const QJsonArray a = v.toArray();
+    if (a.size() != 4) {
+        return QRectF();
+    }
+    return QRectF(a.at(0).toDouble(), a.at(1).toDouble(), a.at(2).toDouble(), a.at(3).toDouble());
+}
+
+QByteArray packGlyphIndexes(const QVector<quint32>& indexes) {
+    QByteArray bytes(indexes.size() * 4, Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(bytes.data());
+    for (quint32 index : indexes) {
+        qToLittleEndian<quint32>(index, out);
+        out += 4;
+    }
+    return bytes.toBase64();
+}
+
+QByteArray packPositions(const QVector<QPointF>& positions) {
+    QByteArray bytes(positions.size() * 8, Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(bytes.data());
+    for (const QPointF& p : positions) {
+        qToLittleEndian<float>(static_cast<float>(p.x()), out);
+        qToLittleEndian<float>(static_cast<float>(p.y()), out + 4);
+        out += 8;
+    }
+    return bytes.toBase64();
+}
+
+bool unpackGlyphIndexes(const QString& encoded, QVector<quint32>* indexes) {
+    const QByteArray bytes = QByteArray::fromBase64(encoded.toLatin1());
+    if (bytes.size() % 4 != 0) {
+        return false;
+    }
+    const uchar* in = reinterpret_cast<const uchar*>(bytes.constData());
+    indexes->resize(bytes.size() / 4);
+    for (quint32& index : *indexes) {
+        index = qFromLittleEndian<quint32>(in);
+        in += 4;
+    }
+    return true;
+}
+
+bool unpackPositions(const QString& encoded, QVector<QPointF>* positions) {
+    const QByteArray bytes = QByteArray::fromBase64(encoded.toLatin1());
+    if (bytes.size() % 8 != 0) {
+        return false;
+    }
+    const uchar* in = reinterpret_cast<const uchar*>(bytes.constData());
+    positions->resize(bytes.size() / 8);
+    for (QPointF& p : *positions) {
+        p.setX(qFromLittleEndian<float>(in));
+        p.setY(qFromLittleEndian<float>(in + 4));
+        in += 8;
+    }
+    return true;
+}
+
+bool metricsMatch(qreal a, qreal b) {
+    return std::abs(a - b) <= kMetricTolerance;
+}
+
+} // anonymous namespace
+
+bool enabled() {
+    static const bool on = envFlagValue("MOUFFETTE_TEXT_LAYOUT_PAYLOAD", true);
+    return on;
+}
+
+ShapedTextLayout::FontIdentity identityOf(const QRawFont& font) {
+    ShapedTextLayout::FontIdentity identity;
+    identity.family = font.familyName();
+    identity.style = font.styleName();
+    identity.pixelSize = font.pixelSize();
+    identity.unitsPerEm = font.unitsPerEm();
+    identity.ascent = font.ascent();
+    identity.descent = font.descent();
+    return identity;
+}
+
+QJsonObject encode(const ShapedTextLayout& layout) {
+    QJsonArray fonts;
+    for (const ShapedTextLayout::FontIdentity& font : layout.fonts) {
+        QJsonObject f;
+        f["family"] = font.family;
+        f["style"] = font.style;
+        f["px"] = font.pixelSize;
+        f["upem"] = font.unitsPerEm;
+        f["ascent"] = font.ascent;
+        f["descent"] = font.descent;
+        fonts.append(f);
+    }
+
+    QJsonArray lines;
+    for (const ShapedTextLayout::Line& line : layout.lines) {
+        QJsonArray runs;
+        for (const ShapedTextLayout::Run& run : line.runs) {
+            QJsonObject r;
+            r["f"] = run.fontIndex;
+            r["g"] = QString::fromLatin1(packGlyphIndexes(run.glyphIndexes));
+            r["p"] = QString::fromLatin1(packPositions(run.positions));
+            runs.append(r);
+        }
+        QJsonObject l;
+        l["o"] = QJsonArray{line.origin.x(), line.origin.y()};
+        l["hl"] = rectToJson(line.highlightRect);
+        l["runs"] = runs;
+        lines.append(l);
+    }
+
+    QJsonObject payload;
+    payload["v"] = kVersion;
+    payload["wrapWidth"] = layout.wrapWidth;
+    payload["docSize"] = QJsonArray{layout.docSize.width(), layout.docSize.height()};
+    payload["docBounds"] = rectToJson(layout.docBounds);
+    payload["fonts"] = fonts;
+    payload["lines"] = lines;
+    return payload;
+}
+
+bool decode(const QJsonObject& payload, ShapedTextLayout* layout, QString* errorMessage) {
+    auto fail = [errorMessage](const QString& message) {
+        if (errorMessage) *errorMessage = message;
+        return false;
+    };
+    if (!layout) {
+        return fail(QStringLiteral("no output layout"));
+    }
+    if (payload.value("v").toInt() != kVersion) {
+        return fail(QStringLiteral("unsupported layout version %1").arg(payload.value("v").toInt()));
+    }
+
+    ShapedTextLayout decoded;
+    decoded.wrapWidth = payload.value("wrapWidth").toDouble();
+    const QJsonArray docSize = payload.value("docSize").toArray();
+    if (docSize.size() == 2) {
+        decoded.docSize = QSizeF(docSize.at(0).toDouble(), docSize.at(1).toDouble());
+    }
+    decoded.docBounds = rectFromJson(payload.value("docBounds"));
+
+    for (const QJsonValue& v : payload.value("fonts").toArray()) {
+        const QJsonObject f = v.toObject();
+        ShapedTextLayout::FontIdentity font;
+        font.family = f.value("family").toString();
+        font.style = f.value("style").toString();
+        font.pixelSize = f.value("px").toDouble();
+        font.unitsPerEm = f.value("upem").toDouble();
+        font.ascent = f.value("ascent").toDouble();
+        font.descent = f.value("descent").toDouble();
+        if (font.family.isEmpty() || font.pixelSize <= 0.0) {
+            return fail(QStringLiteral("invalid font entry"));
+        }
+        decoded.fonts.append(font);
+    }
+
+    for (const QJsonValue& v : payload.value("lines").toArray()) {
+        const QJsonObject l = v.toObject();
+        ShapedTextLayout::Line line;
+        const QJsonArray origin = l.value("o").toArray();
+        if (origin.size() == 2) {
+            line.origin = QPointF(origin.at(0).toDouble(), origin.at(1).toDouble());
+        }
+        line.highlightRect = rectFromJson(l.value("hl"));
+        for (const QJsonValue& rv : l.value("runs").toArray()) {
+            const QJsonObject r = rv.toObject();
+            ShapedTextLayout::Run run;
+            run.fontIndex = r.value("f").toInt(-1);
+            if (run.fontIndex < 0 || run.fontIndex >= decoded.fonts.size()) {
+                return fail(QStringLiteral("run references unknown font %1").arg(run.fontIndex));
+            }
+            if (!unpackGlyphIndexes(r.value("g").toString(), &run.glyphIndexes) ||
+                !unpackPositions(r.value("p").toString(), &run.positions) ||
+                run.glyphIndexes.size() != run.positions.size()) {
+                return fail(QStringLiteral("malformed glyph run"));
+            }
+            line.runs.append(std::move(run));
+        }
+        decoded.lines.append(std::move(line));
+    }
+
+    *layout = std::move(decoded);
+    return true;
+}
+
+bool resolveFonts(const ShapedTextLayout& layout, QVector<QRawFont>* fonts, QString* errorMessage) {
+    QVector<QRawFont> resolved;
+    resolved.reserve(layout.fonts.size());
+    for (const ShapedTextLayout::FontIdentity& identity : layout.fonts) {
+        QFont font(identity.family);
+        if (!identity.style.isEmpty()) {
+            font.setStyleName(identity.style);
+        }
+        font.setPixelSize(std::max(1, static_cast<int>(std::lround(identity.pixelSize))));
+        QRawFont raw = QRawFont::fromFont(font);
+        if (raw.isValid()) {
+            raw.setPixelSize(identity.pixelSize);
+        }
+        if (!raw.isValid() ||
+            raw.familyName() != identity.family ||
+            raw.styleName() != identity.style ||
+            !metricsMatch(raw.unitsPerEm(), identity.unitsPerEm) ||
+            !metricsMatch(raw.ascent(), identity.ascent) ||
+            !metricsMatch(raw.descent(), identity.descent)) {
+            if (errorMessage) {
+                *errorMessage = QStringLiteral("font %1 %2 not available locally").arg(identity.family, identity.style);
+            }
+            return false;
+        }
+        resolved.append(raw);
+    }
+    if (fonts) {
+        *fonts = std::move(resolved);
+    }
+    return true;
+}
+
+} // namespace TextLayoutPayload
@@ -0,0 +1,68 @@
+// TextLayoutPayload.h - Pre-shaped text layout exchanged between host and remote display
+#pragma once
+
+#include <QJsonObject>
+#include <QPointF>
+#include <QRawFont>
+#include <QRectF>
+#include <QSizeF>
+#include <QString>
+#include <QVector>
+
+// Line breaks, glyph indices and glyph positions of one text item as laid out on the host, in the
+// item's logical (unscaled) document coordinates. Glyph positions are relative to their line origin.
+struct ShapedTextLayout {
+    // Identifies a QRawFont; the metrics let the receiver detect a different file behind the same name
+    struct FontIdentity {
+        QString family;
+        QString style;
+        qreal pixelSize = 0.0;
+        qreal unitsPerEm = 0.0;
+        qreal ascent = 0.0;
+        qreal descent = 0.0;
+    };
+
+    struct Run {
+        int fontIndex = 0;
+        QVector<quint32> glyphIndexes;
+        QVector<QPointF> positions;
+    };
+
+    struct Line {
+        QPointF origin;
+        QRectF highlightRect;
+        QVector<Run> runs;
+    };
+
+    QVector<FontIdentity> fonts;
+    qreal wrapWidth = 0.0;
+    QSizeF docSize;
+    QRectF docBounds;
+    QVector<Line> lines;
+
+    bool isEmpty() const { return lines.isEmpty(); }
+};
+
+/**
+ * @brief TextLayoutPayload - Compact JSON encoding of ShapedTextLayout for the remote scene
+ *
+ * Glyph indices (uint32) and positions (float32 x/y pairs) are packed little-endian and base64
+ * encoded per run; fonts are listed once and referenced by index. The payload is optional: the
+ * receiver renders from it through the shared glyph cache only when every font resolves to an
+ * identical QRawFont locally, and otherwise falls back to laying the text out itself.
+ *
+ * Sending is enabled by default and can be turned off with MOUFFETTE_TEXT_LAYOUT_PAYLOAD=0.
+ */
+namespace TextLayoutPayload {
+
+constexpr int kVersion = 1;
+
+bool enabled();
+
+ShapedTextLayout::FontIdentity identityOf(const QRawFont& font);
+QJsonObject encode(const ShapedTextLayout& layout);
+bool decode(const QJsonObject& payload, ShapedTextLayout* layout, QString* errorMessage = nullptr);
+// Resolve every font of the layout on this machine; fails if any is missing or differs
+bool resolveFonts(const ShapedTextLayout& layout, QVector<QRawFont>* fonts, QString* errorMessage = nullptr);
+
+} // namespace TextLayoutPayload
@@ -1,5 +1,10 @@
 // TextMediaItem.cpp - Implementation of text media item
 #include "TextMediaItem.h"
+#include "GlyphBitmapCache.h"
+#include "TextRasterScheduler.h"
+#include "TextLayoutPayload.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
 #include <QGraphicsSceneMouseEvent>
@@ -129,24 +134,9 @@ constexpr qreal kMaxOutlineStrokePx = 14.0;
 constexpr qreal kMinOutlineStrokePx = 0.25;
 constexpr qreal kBorderWidthQuantizationStepPercent = 1.0;
 constexpr int kMaxCachedGlyphPaths = 60000;
-constexpr int kDefaultRenderedGlyphCacheMaxCostKb = 32768;
+constexpr int kMaxGlyphLayoutsPerThread = 32;
 constexpr int kFallbackFontPixelSize = 12;
 
-int renderedGlyphCacheMaxCostKb() {
-    static const int maxCostKb = []() {
-        const QByteArray raw = qgetenv("MOUFFETTE_TEXT_GLYPH_CACHE_MAX_COST_KB");
-        if (!raw.isEmpty()) {
-            bool ok = false;
-            const int parsed = raw.trimmed().toInt(&ok);
-            if (ok) {
-                return std::clamp(parsed, 1024, 262144);
-            }
-        }
-        return kDefaultRenderedGlyphCacheMaxCostKb;
-    }();
-    return maxCostKb;
-}
-
 bool textProfilingEnabled() {
     static const bool enabled = envFlagEnabled("MOUFFETTE_TEXT_PROFILING");
     return enabled;
@@ -177,6 +167,21 @@ bool textGlyphAtlasV1Enabled() {
     return enabled;
 }
 
+bool textRasterTilesEnabled() {
+    static const bool enabled = envFlagValue("MOUFFETTE_TEXT_RASTER_TILES", "text.renderer.raster_tiles", true);
+    return enabled;
+}
+
+bool textIncrementalBaseRasterEnabled() {
+    static const bool enabled = envFlagValue("MOUFFETTE_TEXT_INCREMENTAL_BASE_RASTER", "text.renderer.incremental_base_raster", true);
+    return enabled;
+}
+
+bool textSdfGlyphsEnabled() {
+    static const bool enabled = envFlagValue("MOUFFETTE_TEXT_SDF_GLYPHS", "text.renderer.sdf_glyphs", false);
+    return enabled;
+}
+
 QString alignmentPanelStyleSignature(const OverlayStyle& style) {
     return QStringLiteral("%1|%2|%3|%4|%5|%6|%7|%8|%9|%10")
         .arg(style.cornerRadius)
@@ -207,7 +212,15 @@ TextPerfStats& textPerfStats() {
     return stats;
 }
 
+TextMediaItem::RasterJobTotals& textRasterJobTotals() {
+    static TextMediaItem::RasterJobTotals totals;
+    return totals;
+}
+
 void recordTextRasterStart(quint64 queueDepth) {
+    ++textRasterJobTotals().started;
+    MOUFFETTE_METRIC_COUNT("text.raster.started", 1);
+    MOUFFETTE_METRIC_GAUGE("text.raster.queueDepth", queueDepth);
     if (!textProfilingEnabled()) {
         return;
     }
@@ -221,6 +234,18 @@ void recordTextRasterStart(quint64 queueDepth) {
 }
 
 void recordTextRasterResult(qint64 durationMs, bool stale, bool dropped) {
+    TextMediaItem::RasterJobTotals& totals = textRasterJobTotals();
+    if (stale) ++totals.stale;
+    if (dropped) ++totals.dropped;
+    if (!stale && !dropped) {
+        ++totals.completed;
+        totals.totalDurationMs += std::max<qint64>(0, durationMs);
+        MOUFFETTE_METRIC_HISTOGRAM("text.raster.durationMs", durationMs);
+    }
+    if (!stale && !dropped) MOUFFETTE_METRIC_COUNT("text.raster.completed", 1);
+    if (stale) MOUFFETTE_METRIC_COUNT("text.raster.stale", 1);
+    if (dropped) MOUFFETTE_METRIC_COUNT("text.raster.dropped", 1);
+
     if (!textProfilingEnabled()) {
         return;
     }
@@ -297,6 +322,10 @@ TextGlyphCacheStats& textGlyphCacheStats() {
 }
 
 void recordTextGlyphCacheInsert(bool evictionHint, int currentCostKb, int maxCostKb) {
+    MOUFFETTE_METRIC_COUNT("text.glyphCache.inserts", 1);
+    if (evictionHint) MOUFFETTE_METRIC_COUNT("text.glyphCache.evictionHints", 1);
+    MOUFFETTE_METRIC_GAUGE("text.glyphCache.costKb", currentCostKb);
+    MOUFFETTE_METRIC_GAUGE("text.glyphCache.maxCostKb", maxCostKb);
     if (!textProfilingEnabled()) {
         return;
     }
@@ -311,6 +340,10 @@ void recordTextGlyphCacheInsert(bool evictionHint, int currentCostKb, int maxCos
 }
 
 void recordTextGlyphCacheResult(quint64 hits, quint64 misses, quint64 glyphsDrawn, qint64 durationMs) {
+    MOUFFETTE_METRIC_COUNT("text.glyphCache.hits", hits);
+    MOUFFETTE_METRIC_COUNT("text.glyphCache.misses", misses);
+    MOUFFETTE_METRIC_COUNT("text.glyphCache.glyphsDrawn", glyphsDrawn);
+    MOUFFETTE_METRIC_HISTOGRAM("text.glyphCache.renderMs", durationMs);
     if (!textProfilingEnabled()) {
         return;
     }
@@ -572,6 +605,10 @@ quint64 makeGlyphCacheKey(const QRawFont& rawFont, quint32 glyphIndex) {
     return static_cast<quint64>(qHash(descriptor));
 }
 
+// Bumped by TextMediaItem::clearTextCaches(); every process-wide or per-thread text cache drops
+// its entries the next time it sees a newer value.
+std::atomic<quint64> g_textCacheEpoch{0};
+
 QPainterPath cachedGlyphPath(const QRawFont& rawFont, quint32 glyphIndex) {
     if (!rawFont.isValid()) {
         return QPainterPath();
@@ -579,11 +616,17 @@ QPainterPath cachedGlyphPath(const QRawFont& rawFont, quint32 glyphIndex) {
 
     static QCache<quint64, QPainterPath> s_glyphPathCache(kMaxCachedGlyphPaths);
     static QMutex s_glyphPathCacheMutex;
+    static quint64 s_glyphPathCacheEpoch = 0;
 
     const quint64 cacheKey = makeGlyphCacheKey(rawFont, glyphIndex);
 
     {
         QMutexLocker locker(&s_glyphPathCacheMutex);
+        const quint64 epoch = g_textCacheEpoch.load(std::memory_order_relaxed);
+        if (s_glyphPathCacheEpoch != epoch) {
+            s_glyphPathCache.clear();
+            s_glyphPathCacheEpoch = epoch;
+        }
         if (const QPainterPath* cached = s_glyphPathCache.object(cacheKey)) {
             return *cached;
         }
@@ -624,6 +667,7 @@ const CachedGlyphGeometry& cachedGlyphGeometry(const QRawFont& rawFont, quint32
     
     static QCache<quint64, CachedGlyphGeometry> s_geometryCache(kMaxCachedGlyphPaths); // Reuse existing size limit or define new
     static QMutex s_geomCacheMutex;
+    static quint64 s_geomCacheEpoch = 0;
 
     // specialized key generation for geometry
     const quint64 baseKey = makeGlyphCacheKey(rawFont, glyphIndex);
@@ -631,6 +675,11 @@ const CachedGlyphGeometry& cachedGlyphGeometry(const QRawFont& rawFont, quint32
 
     {
         QMutexLocker locker(&s_geomCacheMutex);
+        const quint64 epoch = g_textCacheEpoch.load(std::memory_order_relaxed);
+        if (s_geomCacheEpoch != epoch) {
+            s_geometryCache.clear();
+            s_geomCacheEpoch = epoch;
+        }
         if (const CachedGlyphGeometry* cached = s_geometryCache.object(combinedKey)) {
             return *cached;
         }
@@ -658,192 +707,97 @@ const CachedGlyphGeometry& cachedGlyphGeometry(const QRawFont& rawFont, quint32
 }
 
 
-// Phase 2: Rendered Glyph Cache - caches pre-rendered glyph layers (stroke + fill)
-struct RenderedGlyphKey {
-    quint64 outlinePathKey;      // Reuse outline cache key
-    QRgb fillColor;              // Packed ARGB
-    QRgb strokeColor;            // Packed ARGB
-    QRgb highlightColor;         // Highlight signature for strict style key invariants
-    quint8 highlightEnabled;     // 1 if highlight active
-    qint32 strokeWidthScaled;    // Fixed-point: width * 1024
-    qint32 scaleFactorScaled;    // Fixed-point: scale * 256 (coarser for better cache hits)
-    
-    bool operator==(const RenderedGlyphKey& other) const {
-        return outlinePathKey == other.outlinePathKey &&
-               fillColor == other.fillColor &&
-               strokeColor == other.strokeColor &&
-                highlightColor == other.highlightColor &&
-                highlightEnabled == other.highlightEnabled &&
-               strokeWidthScaled == other.strokeWidthScaled &&
-               scaleFactorScaled == other.scaleFactorScaled;
+// Glyph coverage masks (stroke + fill) live in the process-wide GlyphBitmapCache shared with the
+// remote display; this wrapper keeps the editor's insert stats wired up.
+GlyphCoverage cachedGlyphCoverage(const QRawFont& rawFont, quint32 glyphIndex,
+                                  qreal strokeWidth, qreal scaleFactor,
+                                  bool* cacheHit = nullptr) {
+    GlyphBitmapCache::InsertInfo insertInfo;
+    GlyphCoverage coverage = GlyphBitmapCache::instance().fetchOrRender(rawFont,
+                                                                        glyphIndex,
+                                                                        strokeWidth,
+                                                                        scaleFactor,
+                                                                        &cachedGlyphPath,
+                                                                        GlyphBitmapCache::Consumer::Editor,
+                                                                        cacheHit,
+                                                                        &insertInfo);
+    if (insertInfo.inserted) {
+        recordTextGlyphCacheInsert(insertInfo.evictionHint, insertInfo.totalCostKb, insertInfo.maxCostKb);
     }
-};
+    return coverage;
+}
 
-inline uint qHash(const RenderedGlyphKey& key, uint seed = 0) {
-    seed = ::qHash(key.outlinePathKey, seed);
-    seed = ::qHash(key.fillColor, seed);
-    seed = ::qHash(key.strokeColor, seed);
-    seed = ::qHash(key.highlightColor, seed);
-    seed = ::qHash(key.highlightEnabled, seed);
-    seed = ::qHash(key.strokeWidthScaled, seed);
-    return ::qHash(key.scaleFactorScaled, seed);
+// Distance fields are keyed by outline only, so one entry serves every zoom level and outline width
+GlyphDistanceField cachedGlyphDistanceField(const QRawFont& rawFont, quint32 glyphIndex, bool* cacheHit = nullptr) {
+    GlyphBitmapCache::InsertInfo insertInfo;
+    GlyphDistanceField field = GlyphBitmapCache::instance().fetchOrRenderDistanceField(rawFont,
+                                                                                      glyphIndex,
+                                                                                      &cachedGlyphPath,
+                                                                                      GlyphBitmapCache::Consumer::Editor,
+                                                                                      cacheHit,
+                                                                                      &insertInfo);
+    if (insertInfo.inserted) {
+        recordTextGlyphCacheInsert(insertInfo.evictionHint, insertInfo.totalCostKb, insertInfo.maxCostKb);
+    }
+    return field;
 }
 
-struct RenderedGlyphBitmap {
-    QPixmap strokePixmap;
-    QPixmap fillPixmap;
-    QPointF originOffset;
-};
+} // anonymous namespace
 
-RenderedGlyphKey makeRenderedGlyphKey(const QRawFont& rawFont, quint32 glyphIndex,
-                                      const QColor& fillColor, const QColor& strokeColor,
-                                      const QColor& highlightColor, bool highlightEnabled,
-                                      qreal strokeWidth, qreal scaleFactor) {
-    RenderedGlyphKey key;
-    key.outlinePathKey = makeGlyphCacheKey(rawFont, glyphIndex);
-    key.fillColor = fillColor.rgba();
-    key.strokeColor = strokeColor.rgba();
-    key.highlightColor = highlightColor.rgba();
-    key.highlightEnabled = highlightEnabled ? 1 : 0;
-    key.strokeWidthScaled = static_cast<qint32>(std::round(strokeWidth * 1024.0));
-    // Quantize scale to 1/256 increments for better cache hits
-    key.scaleFactorScaled = static_cast<qint32>(std::round(scaleFactor * 256.0));
-    return key;
+TextMediaItem::RasterJobTotals TextMediaItem::rasterJobTotals() {
+    return textRasterJobTotals();
 }
 
-RenderedGlyphBitmap renderGlyphToPixmap(const QPainterPath& glyphPath, const QColor& fillColor,
-                                        const QColor& strokeColor, qreal strokeWidth,
-                                        qreal scaleFactor) {
-    RenderedGlyphBitmap result;
-    if (glyphPath.isEmpty()) {
-        return result;
-    }
-    
-    // Calculate tight bounds with stroke overflow
-    const QRectF pathBounds = glyphPath.boundingRect();
-    const qreal padding = std::ceil(strokeWidth * 2.0) + 2.0;
-    const QRectF renderBounds = pathBounds.adjusted(-padding, -padding, padding, padding);
-    
-    const qreal rasterScale = std::max(std::abs(scaleFactor), 1e-4);
-    const int width = std::max(1, static_cast<int>(std::ceil(renderBounds.width() * rasterScale)));
-    const int height = std::max(1, static_cast<int>(std::ceil(renderBounds.height() * rasterScale)));
-    
-    QImage fillImage(width, height, QImage::Format_ARGB32_Premultiplied);
-    fillImage.fill(Qt::transparent);
-
-    if (strokeWidth > 0.0) {
-        QImage strokeImage(width, height, QImage::Format_ARGB32_Premultiplied);
-        strokeImage.fill(Qt::transparent);
-        QPainter strokePainter(&strokeImage);
-        strokePainter.setRenderHint(QPainter::Antialiasing, true);
-        strokePainter.scale(rasterScale, rasterScale);
-        strokePainter.translate(-renderBounds.left(), -renderBounds.top());
-        strokePainter.setPen(QPen(strokeColor, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        strokePainter.setBrush(Qt::NoBrush);
-        strokePainter.drawPath(glyphPath);
-        strokePainter.end();
-        result.strokePixmap = QPixmap::fromImage(strokeImage);
-        result.strokePixmap.setDevicePixelRatio(rasterScale);
-    }
-
-    QPainter fillPainter(&fillImage);
-    fillPainter.setRenderHint(QPainter::Antialiasing, true);
-    fillPainter.scale(rasterScale, rasterScale);
-    fillPainter.translate(-renderBounds.left(), -renderBounds.top());
-    fillPainter.setPen(Qt::NoPen);
-    fillPainter.setBrush(fillColor);
-    fillPainter.drawPath(glyphPath);
-    fillPainter.end();
-
-    result.fillPixmap = QPixmap::fromImage(fillImage);
-    result.fillPixmap.setDevicePixelRatio(rasterScale);
-    result.originOffset = renderBounds.topLeft();
-    return result;
+void TextMediaItem::resetRasterJobTotals() {
+    textRasterJobTotals() = RasterJobTotals{};
 }
 
-    RenderedGlyphBitmap cachedRenderedGlyph(const QRawFont& rawFont, quint32 glyphIndex,
-                                            const QColor& fillColor, const QColor& strokeColor,
-                                            const QColor& highlightColor, bool highlightEnabled,
-                                            qreal strokeWidth, qreal scaleFactor,
-                                            bool* cacheHit = nullptr) {
-        RenderedGlyphBitmap result;
-        if (!rawFont.isValid() || strokeWidth < 0.0) {
-            if (cacheHit) {
-                *cacheHit = false;
-            }
-            return result;
-        }
-    
-        static QCache<RenderedGlyphKey, RenderedGlyphBitmap> s_renderedGlyphCache(renderedGlyphCacheMaxCostKb());
-        static QMutex s_renderedCacheMutex;
-    
-        const RenderedGlyphKey cacheKey = makeRenderedGlyphKey(rawFont,
-                                       glyphIndex,
-                                       fillColor,
-                                       strokeColor,
-                                       highlightColor,
-                                       highlightEnabled,
-                                       strokeWidth,
-                                       scaleFactor);
-    
-        {
-            QMutexLocker locker(&s_renderedCacheMutex);
-            if (const RenderedGlyphBitmap* cached = s_renderedGlyphCache.object(cacheKey)) {
-                if (cacheHit) {
-                    *cacheHit = true;
-                }
-                return *cached;
-            }
-        }
-    
-        // Cache miss - render the glyph
-        const QPainterPath glyphPath = cachedGlyphPath(rawFont, glyphIndex);
-        if (glyphPath.isEmpty()) {
-            return result;
-        }
-    
-        RenderedGlyphBitmap rendered = renderGlyphToPixmap(glyphPath,
-                                   fillColor,
-                                   strokeColor,
-                                   strokeWidth,
-                                   scaleFactor);
-        if (rendered.fillPixmap.isNull() && rendered.strokePixmap.isNull()) {
-            if (cacheHit) {
-                *cacheHit = false;
-            }
-            return rendered;
-        }
-    
-        {
-            QMutexLocker locker(&s_renderedCacheMutex);
-            const int countBefore = s_renderedGlyphCache.count();
-            const int totalCostBefore = s_renderedGlyphCache.totalCost();
-            if (!s_renderedGlyphCache.object(cacheKey)) {
-                const int strokeCostKB = rendered.strokePixmap.isNull()
-                    ? 0
-                    : (rendered.strokePixmap.width() * rendered.strokePixmap.height() * 4) / 1024;
-                const int fillCostKB = rendered.fillPixmap.isNull()
-                    ? 0
-                    : (rendered.fillPixmap.width() * rendered.fillPixmap.height() * 4) / 1024;
-                const int costKB = strokeCostKB + fillCostKB;
-                s_renderedGlyphCache.insert(cacheKey, new RenderedGlyphBitmap(rendered), std::max(1, costKB));
-                const int countAfter = s_renderedGlyphCache.count();
-                const int totalCostAfter = s_renderedGlyphCache.totalCost();
-                const int insertedCost = std::max(1, costKB);
-                const bool evictionHint = (countAfter <= countBefore) ||
-                    (totalCostAfter < (totalCostBefore + insertedCost));
-                recordTextGlyphCacheInsert(evictionHint, totalCostAfter, s_renderedGlyphCache.maxCost());
-            }
-        }
+int TextMediaItem::paintBenchmarkSnapshot(const BenchmarkPaintRequest& request, QImage* target) {
+    if (!target || request.baseSize.isEmpty()) {
+        return 0;
+    }
+    VectorDrawSnapshot snapshot;
+    snapshot.text = request.text;
+    snapshot.font = ensureRenderableFont(request.font, QStringLiteral("benchmark"), "benchmark");
+    snapshot.fillColor = request.fillColor;
+    snapshot.outlineColor = request.outlineColor;
+    snapshot.outlineWidthPercent = request.outlineWidthPercent;
+    snapshot.contentPaddingPx = kContentPadding;
+    snapshot.horizontalAlignment = HorizontalAlignment::Left;
+    snapshot.verticalAlignment = VerticalAlignment::Top;
+
+    const qreal scale = std::max(std::abs(request.scaleFactor), 1e-4);
+    const QSize targetSize(std::max(1, static_cast<int>(std::ceil(request.baseSize.width() * scale))),
+                           std::max(1, static_cast<int>(std::ceil(request.baseSize.height() * scale))));
+    if (target->size() != targetSize || target->format() != QImage::Format_ARGB32_Premultiplied) {
+        *target = QImage(targetSize, QImage::Format_ARGB32_Premultiplied);
+    }
+    target->fill(Qt::transparent);
 
-        if (cacheHit) {
-            *cacheHit = false;
+    {
+        QPainter painter(target);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setRenderHint(QPainter::TextAntialiasing, true);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        paintVectorSnapshot(&painter, snapshot, targetSize, scale);
+    }
+
+    // Same width paintVectorSnapshot shaped at, so this is a layout cache hit on this thread
+    const qreal availableWidth = std::max<qreal>(1.0, targetSize.width() / scale - 2.0 * snapshot.contentPaddingPx);
+    const GlyphLayoutCache shaped = glyphLayoutFor(snapshot, availableWidth);
+    int glyphs = 0;
+    for (const GlyphLayoutCache::Line& line : shaped.lines) {
+        for (const QGlyphRun& run : line.glyphRuns) {
+            glyphs += run.glyphIndexes().size();
         }
-    
-        return rendered;
     }
+    return glyphs;
+}
 
-} // anonymous namespace
+void TextMediaItem::clearTextCaches() {
+    g_textCacheEpoch.fetch_add(1, std::memory_order_relaxed);
+    GlyphBitmapCache::instance().clear();
+}
 
 namespace {
 
@@ -1277,39 +1231,205 @@ static InlineTextEditor* toInlineEditor(QGraphicsTextItem* item) {
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
 // Phase 6: Glyph Layout Pre-computation
-quint64 TextMediaItem::computeLayoutFingerprint(const QString& text, const QFont& font, qreal width) const {
-    // Generate stable hash from text content + font properties + layout width
+quint64 TextMediaItem::computeLayoutFingerprint(const QString& text, const QFont& font, bool fitToText, HorizontalAlignment alignment) {
+    // Stable hash of everything that shapes or breaks lines; the wrap width is validated separately
     quint64 h = qHash(text);
-    h ^= qHash(font.family()) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    h ^= static_cast<quint64>(font.pointSizeF() * 1000.0) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    h ^= static_cast<quint64>(font.weight()) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    h ^= static_cast<quint64>(font.italic() ? 1 : 0) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    h ^= static_cast<quint64>(width * 100.0) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= qHash(font.toString()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= static_cast<quint64>(fitToText ? 1 : 0) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= static_cast<quint64>(alignment) + 0x9e3779b9 + (h << 6) + (h >> 2);
     return h;
 }
 
-void TextMediaItem::updateGlyphLayoutCache(const VectorDrawSnapshot& snapshot, const QSize& targetSize) {
-    // Phase 6: Simplified - just track fingerprint for future optimization
-    // Full glyph position caching deferred to avoid QRawFont storage complexity
-    if (snapshot.outlineWidthPercent <= 0.0) {
-        m_glyphLayoutCache.valid = false;
-        return;
+void TextMediaItem::configureSnapshotDocument(QTextDocument& doc, const VectorDrawSnapshot& snapshot) {
+    doc.setDocumentMargin(0.0);
+    doc.setDefaultFont(snapshot.font);
+    doc.setPlainText(snapshot.text);
+
+    Qt::Alignment qtHAlign = Qt::AlignCenter;
+    switch (snapshot.horizontalAlignment) {
+        case HorizontalAlignment::Left:
+            qtHAlign = Qt::AlignLeft;
+            break;
+        case HorizontalAlignment::Center:
+            qtHAlign = Qt::AlignHCenter;
+            break;
+        case HorizontalAlignment::Right:
+            qtHAlign = Qt::AlignRight;
+            break;
     }
-    
-    const quint64 fingerprint = computeLayoutFingerprint(snapshot.text, snapshot.font, static_cast<qreal>(targetSize.width()));
-    if (m_glyphLayoutCache.valid && m_glyphLayoutCache.fingerprint == fingerprint) {
-        return; // Already cached
+
+    QTextOption option;
+    option.setWrapMode(snapshot.fitToTextEnabled ? QTextOption::NoWrap : QTextOption::WordWrap);
+    option.setAlignment(qtHAlign);
+    doc.setDefaultTextOption(option);
+}
+
+TextMediaItem::GlyphLayoutCache TextMediaItem::glyphLayoutFor(const VectorDrawSnapshot& snapshot, qreal availableWidth) {
+    // QGlyphRun holds QRawFont, which must stay on the thread that created it, so each raster
+    // thread keeps its own cache. Pool threads are long-lived, so zoom sequences still hit.
+    thread_local QCache<quint64, GlyphLayoutCache> t_layoutCache(kMaxGlyphLayoutsPerThread);
+    thread_local quint64 t_layoutCacheEpoch = 0;
+    const quint64 epoch = g_textCacheEpoch.load(std::memory_order_relaxed);
+    if (t_layoutCacheEpoch != epoch) {
+        t_layoutCache.clear();
+        t_layoutCacheEpoch = epoch;
+    }
+
+    const quint64 fingerprint = computeLayoutFingerprint(snapshot.text,
+                                                         snapshot.font,
+                                                         snapshot.fitToTextEnabled,
+                                                         snapshot.horizontalAlignment);
+    if (const GlyphLayoutCache* cached = t_layoutCache.object(fingerprint)) {
+        // Any width between the widest line and the original wrap width produces the same greedy
+        // line breaks. Nothing wider: even a fraction of a pixel can let a wrapped word fit.
+        const bool widthCompatible = snapshot.fitToTextEnabled ||
+            (availableWidth + 1e-3 >= cached->maxNaturalWidth &&
+             availableWidth <= cached->wrapWidth);
+        if (widthCompatible && cached->text == snapshot.text && cached->fontKey == snapshot.font.toString()) {
+            MOUFFETTE_METRIC_COUNT("text.layoutCache.hits", 1);
+            return *cached;
+        }
     }
-    
-    m_glyphLayoutCache.clear();
-    m_glyphLayoutCache.fingerprint = fingerprint;
-    m_glyphLayoutCache.valid = true;
+    MOUFFETTE_METRIC_COUNT("text.layoutCache.misses", 1);
+    MOUFFETTE_TRACE_SCOPE("text.layoutShape");
+
+    QTextDocument doc;
+    configureSnapshotDocument(doc, snapshot);
+    if (snapshot.fitToTextEnabled) {
+        doc.setTextWidth(-1.0);
+        qreal maxLineWidth = 1.0;
+        if (QAbstractTextDocumentLayout* docLayout = doc.documentLayout()) {
+            for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
+                if (QTextLayout* textLayout = block.layout()) {
+                    for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
+                        const QTextLine line = textLayout->lineAt(lineIndex);
+                        if (!line.isValid()) {
+                            continue;
+                        }
+                        maxLineWidth = std::max(maxLineWidth, line.naturalTextWidth());
+                    }
+                }
+            }
+            maxLineWidth = std::max(maxLineWidth, docLayout->documentSize().width());
+        }
+        doc.setTextWidth(std::max<qreal>(1.0, maxLineWidth));
+    } else {
+        doc.setTextWidth(availableWidth);
+    }
+
+    GlyphLayoutCache shaped;
+    QAbstractTextDocumentLayout* layout = doc.documentLayout();
+    if (!layout) {
+        return shaped;
+    }
+
+    shaped.fingerprint = fingerprint;
+    shaped.text = snapshot.text;
+    shaped.fontKey = snapshot.font.toString();
+    shaped.wrapWidth = doc.textWidth();
+    shaped.docSize = layout->documentSize();
+    shaped.docBounds = computeDocumentTextBounds(doc, layout);
+
+    const qreal docWidth = std::max<qreal>(shaped.docSize.width(), 1.0);
+    for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
+        QTextLayout* textLayout = block.layout();
+        if (!textLayout) {
+            continue;
+        }
+
+        const QRectF blockRect = layout->blockBoundingRect(block);
+        for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
+            const QTextLine line = textLayout->lineAt(lineIndex);
+            if (!line.isValid()) {
+                continue;
+            }
+
+            GlyphLayoutCache::Line shapedLine;
+            shapedLine.blockRect = blockRect;
+            shapedLine.origin = blockRect.topLeft() + QPointF(line.x(), line.y());
+            shapedLine.lineX = line.x();
+            shapedLine.naturalWidth = line.naturalTextWidth();
+            shapedLine.height = line.height();
+            shapedLine.lineRect = QRectF(shapedLine.origin,
+                                         QSizeF(std::max<qreal>(shapedLine.naturalWidth, 1.0),
+                                                std::max<qreal>(shapedLine.height, 1.0)));
+
+            QRectF highlightRect = line.naturalTextRect();
+            if (highlightRect.isValid() && highlightRect.width() > 0.0 && highlightRect.height() > 0.0) {
+                highlightRect.translate(blockRect.topLeft());
+            } else {
+                const qreal width = std::max<qreal>(shapedLine.naturalWidth, 1.0);
+                qreal alignedX = line.x();
+                if (std::abs(alignedX) < 1e-4 && width < docWidth - 1e-4) {
+                    const qreal horizontalSpace = std::max<qreal>(0.0, docWidth - width);
+                    if (snapshot.horizontalAlignment == HorizontalAlignment::Right) {
+                        alignedX += horizontalSpace;
+                    } else if (snapshot.horizontalAlignment == HorizontalAlignment::Center) {
+                        alignedX += horizontalSpace * 0.5;
+                    }
+                }
+                highlightRect = QRectF(blockRect.topLeft() + QPointF(alignedX, line.y()),
+                                       QSizeF(width, std::max<qreal>(line.height(), 1.0)));
+            }
+            shapedLine.highlightRect = highlightRect;
+            shapedLine.glyphRuns = line.glyphRuns();
+
+            shaped.maxNaturalWidth = std::max(shaped.maxNaturalWidth, shapedLine.naturalWidth);
+            shaped.lines.append(std::move(shapedLine));
+        }
+    }
+    shaped.valid = true;
+
+    t_layoutCache.insert(fingerprint, new GlyphLayoutCache(shaped), 1);
+    return shaped;
 }
 
-bool TextMediaItem::isGlyphLayoutCacheValid(const VectorDrawSnapshot& snapshot, const QSize& targetSize) const {
-    if (!m_glyphLayoutCache.valid) return false;
-    const quint64 fingerprint = computeLayoutFingerprint(snapshot.text, snapshot.font, static_cast<qreal>(targetSize.width()));
-    return m_glyphLayoutCache.fingerprint == fingerprint;
+QJsonObject TextMediaItem::shapedLayoutPayload() const {
+    if (!TextLayoutPayload::enabled()) {
+        return QJsonObject();
+    }
+
+    // Same logical wrap width as the inline editor, which is what the host shows
+    const VectorDrawSnapshot snapshot = captureVectorSnapshot();
+    const qreal uniformScale = std::max(std::abs(m_uniformScaleFactor), 1e-4);
+    const qreal availableWidth = std::max<qreal>(1.0, (m_baseSize.width() - 2.0 * contentPaddingPx()) / uniformScale);
+    const GlyphLayoutCache layout = glyphLayoutFor(snapshot, availableWidth);
+    if (!layout.valid || layout.lines.isEmpty()) {
+        return QJsonObject();
+    }
+
+    ShapedTextLayout shaped;
+    shaped.wrapWidth = layout.wrapWidth;
+    shaped.docSize = layout.docSize;
+    shaped.docBounds = layout.docBounds;
+    QHash<QString, int> fontIndexes;
+    for (const GlyphLayoutCache::Line& line : layout.lines) {
+        ShapedTextLayout::Line shapedLine;
+        shapedLine.origin = line.origin;
+        shapedLine.highlightRect = line.highlightRect;
+        for (const QGlyphRun& glyphRun : line.glyphRuns) {
+            const QRawFont rawFont = glyphRun.rawFont();
+            if (!rawFont.isValid()) {
+                return QJsonObject();
+            }
+            const ShapedTextLayout::FontIdentity identity = TextLayoutPayload::identityOf(rawFont);
+            const QString fontKey = identity.family + QLatin1Char('|') + identity.style + QLatin1Char('|') +
+                                    QString::number(identity.pixelSize, 'f', 3);
+            auto it = fontIndexes.find(fontKey);
+            if (it == fontIndexes.end()) {
+                it = fontIndexes.insert(fontKey, shaped.fonts.size());
+                shaped.fonts.append(identity);
+            }
+
+            ShapedTextLayout::Run run;
+            run.fontIndex = it.value();
+            run.glyphIndexes = glyphRun.glyphIndexes();
+            run.positions = glyphRun.positions();
+            shapedLine.runs.append(std::move(run));
+        }
+        shaped.lines.append(std::move(shapedLine));
+    }
+    return TextLayoutPayload::encode(shaped);
 }
 
 // Phase 7: Viewport Culling
@@ -1705,8 +1825,7 @@ void TextMediaItem::applyTextDiff(const TextEditDiff& diff) {
     
     // Invalidate affected caches
     if (diff.geometryChanged) {
-        // Full invalidation
-        m_glyphLayoutCache.clear();
+        // Full invalidation (shaped glyph layouts are keyed by content and need no reset)
         m_blockVisibilityCacheValid = false;
         m_baseRasterValid = false;
         m_incrementalRenderValid = false;
@@ -1916,11 +2035,7 @@ bool TextMediaItem::cacheKeyMatches(const TextRenderCacheKey& lhs, const TextRen
     return lhs == rhs;
 }
 
-void TextMediaItem::enforceCacheBudget() {
-    if (!textCachePolicyV2Enabled()) {
-        return;
-    }
-
+qint64 TextMediaItem::rasterCacheBytes() const {
     auto imageBytes = [](const QImage& image) -> qint64 {
         if (image.isNull()) {
             return 0;
@@ -1928,48 +2043,89 @@ void TextMediaItem::enforceCacheBudget() {
         return static_cast<qint64>(image.bytesPerLine()) * static_cast<qint64>(image.height());
     };
 
-    auto currentTotalBytes = [&]() -> qint64 {
-        return imageBytes(m_scaledRasterizedText) +
-               imageBytes(m_rasterizedText) +
-               imageBytes(m_baseRaster) +
-               imageBytes(m_dirtyOverlay);
-    };
+    return imageBytes(m_scaledRasterizedText) +
+           imageBytes(m_rasterizedText) +
+           imageBytes(m_baseRaster) +
+           imageBytes(m_dirtyOverlay) +
+           m_rasterTiles.bytes();
+}
 
-    qint64 total = currentTotalBytes();
-    if (total <= kPerItemCacheBudgetBytes) {
+void TextMediaItem::releaseDirtyOverlay() {
+    if (m_dirtyOverlay.isNull()) {
+        return;
+    }
+    m_dirtyOverlay = QImage();
+    m_dirtyBounds = QRect();
+    m_incrementalRenderValid = false;
+}
+
+void TextMediaItem::releaseScaledRaster() {
+    m_rasterTiles.clear();
+    if (!m_scaledRasterPixmapValid) {
+        return;
+    }
+    m_scaledRasterPixmapValid = false;
+    m_scaledRasterPixmap = QPixmap();
+    m_scaledRasterizedText = QImage();
+    m_scaledRasterContentRevision = 0;
+    m_scaledRasterVisibleRegion = QRectF();
+    m_activeHighResCacheKeyValid = false;
+    m_renderState = RenderState::Idle;
+}
+
+void TextMediaItem::releaseIncrementalBaseRaster() {
+    // Intentionally preserve m_rasterizedText (the 1:1 base raster, ~320 KB).
+    // Evicting it causes a blank-text flash when returning to 1× zoom because
+    // the non-zoomed paint path has no other fallback until a new base raster
+    // is computed. Only release the (re-computable) incremental compositing base.
+    if (m_baseRaster.isNull()) {
+        return;
+    }
+    m_baseRaster = QImage();
+    m_baseRasterValid = false;
+    m_baseRasterContentRevision = 0;
+}
+
+TextRasterScheduler* TextMediaItem::rasterScheduler() const {
+    return TextRasterScheduler::forScene(scene());
+}
+
+void TextMediaItem::enforceCacheBudget() {
+    if (TextRasterScheduler* scheduler = rasterScheduler()) {
+        // On a canvas the shared budget replaces the per-item limit: items that were painted
+        // least recently give up their re-computable rasters first.
+        std::weak_ptr<bool> guard = lifetimeGuard();
+        scheduler->reportRasterBytes(this, rasterCacheBytes(), guard, [this, guard]() -> qint64 {
+            if (guard.expired()) {
+                return 0;
+            }
+            releaseDirtyOverlay();
+            releaseScaledRaster();
+            releaseIncrementalBaseRaster();
+            update();
+            return rasterCacheBytes();
+        });
+        return;
+    }
+
+    if (!textCachePolicyV2Enabled()) {
+        return;
+    }
+
+    if (rasterCacheBytes() <= kPerItemCacheBudgetBytes) {
         return;
     }
 
     // Deterministic eviction order (least critical first):
     // 1) incremental overlay, 2) scaled raster, 3) base layers.
-    if (!m_dirtyOverlay.isNull()) {
-        m_dirtyOverlay = QImage();
-        m_dirtyBounds = QRect();
-        m_incrementalRenderValid = false;
-        total = currentTotalBytes();
-    }
+    releaseDirtyOverlay();
 
-    if (total > kPerItemCacheBudgetBytes && m_scaledRasterPixmapValid) {
-        m_scaledRasterPixmapValid = false;
-        m_scaledRasterPixmap = QPixmap();
-        m_scaledRasterizedText = QImage();
-        m_scaledRasterContentRevision = 0;
-        m_scaledRasterVisibleRegion = QRectF();
-        m_activeHighResCacheKeyValid = false;
-        m_renderState = RenderState::Idle;
-        total = currentTotalBytes();
+    if (rasterCacheBytes() > kPerItemCacheBudgetBytes) {
+        releaseScaledRaster();
     }
 
-    if (total > (kPerItemCacheBudgetBytes * 2)) {
-        // Intentionally preserve m_rasterizedText (the 1:1 base raster, ~320 KB).
-        // Evicting it causes a blank-text flash when returning to 1× zoom because
-        // the non-zoomed paint path has no other fallback until a new base raster
-        // is computed. Only release the (re-computable) incremental compositing base.
-        if (!m_baseRaster.isNull()) {
-            m_baseRaster = QImage();
-            m_baseRasterValid = false;
-            m_baseRasterContentRevision = 0;
-        }
+    if (rasterCacheBytes() > (kPerItemCacheBudgetBytes * 2)) {
+        releaseIncrementalBaseRaster();
     }
 }
 
@@ -2111,62 +2267,30 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
     const qreal epsilon = 1e-4;
     const qreal effectiveScale = std::max(std::abs(scaleFactor), epsilon);
 
-    QTextDocument doc;
-    doc.setDocumentMargin(0.0);
-    doc.setDefaultFont(snapshot.font);
-    doc.setPlainText(snapshot.text);
-
-    Qt::Alignment qtHAlign = Qt::AlignCenter;
-    switch (snapshot.horizontalAlignment) {
-        case HorizontalAlignment::Left:
-            qtHAlign = Qt::AlignLeft;
-            break;
-        case HorizontalAlignment::Center:
-            qtHAlign = Qt::AlignHCenter;
-            break;
-        case HorizontalAlignment::Right:
-            qtHAlign = Qt::AlignRight;
-            break;
-    }
-
-    QTextOption option;
-    option.setWrapMode(snapshot.fitToTextEnabled ? QTextOption::NoWrap : QTextOption::WordWrap);
-    option.setAlignment(qtHAlign);
-    doc.setDefaultTextOption(option);
-
     const qreal logicalWidth = static_cast<qreal>(targetWidth) / effectiveScale;
     const qreal logicalHeight = static_cast<qreal>(targetHeight) / effectiveScale;
     const qreal margin = snapshot.contentPaddingPx;
     const qreal availableWidth = std::max<qreal>(1.0, logicalWidth - 2.0 * margin);
 
-    if (snapshot.fitToTextEnabled) {
-        doc.setTextWidth(-1.0);
-        qreal maxLineWidth = 1.0;
-        if (QAbstractTextDocumentLayout* docLayout = doc.documentLayout()) {
-            for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
-                if (QTextLayout* textLayout = block.layout()) {
-                    for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
-                        const QTextLine line = textLayout->lineAt(lineIndex);
-                        if (!line.isValid()) {
-                            continue;
-                        }
-                        maxLineWidth = std::max(maxLineWidth, line.naturalTextWidth());
-                    }
-                }
-            }
-            maxLineWidth = std::max(maxLineWidth, docLayout->documentSize().width());
-        }
-        doc.setTextWidth(std::max<qreal>(1.0, maxLineWidth));
-    } else {
-        doc.setTextWidth(availableWidth);
-    }
-
-    QAbstractTextDocumentLayout* layout = doc.documentLayout();
-    if (!layout) {
+    // Phase 6: shaping and line breaking come from the glyph layout cache, so zoom-only and
+    // style-only jobs skip QTextDocument layout. A layout reused at a slightly different wrap
+    // width keeps its line breaks and only shifts horizontally by the alignment delta.
+    const GlyphLayoutCache shaped = glyphLayoutFor(snapshot, availableWidth);
+    if (!shaped.valid) {
         return;
     }
-    const QSizeF docSize = layout->documentSize();
-    const QRectF docBounds = computeDocumentTextBounds(doc, layout);
+    const qreal layoutWidth = snapshot.fitToTextEnabled ? shaped.wrapWidth : availableWidth;
+    const qreal layoutWidthDelta = layoutWidth - shaped.wrapWidth;
+    qreal layoutShiftX = 0.0;
+    if (snapshot.horizontalAlignment == HorizontalAlignment::Center) {
+        layoutShiftX = layoutWidthDelta * 0.5;
+    } else if (snapshot.horizontalAlignment == HorizontalAlignment::Right) {
+        layoutShiftX = layoutWidthDelta;
+    }
+    const QPointF layoutShift(layoutShiftX, 0.0);
+
+    const QSizeF docSize(shaped.docSize.width() + layoutWidthDelta, shaped.docSize.height());
+    const QRectF docBounds = shaped.docBounds;
     const qreal availableHeight = std::max<qreal>(1.0, logicalHeight - 2.0 * margin);
     const qreal docVisualTop = docBounds.top();
     const qreal docVisualHeight = std::max<qreal>(1.0, docBounds.height());
@@ -2244,13 +2368,22 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
                               preview);
     };
 
-    {
-        QTextCursor cursor(&doc);
-        QTextCharFormat format;
-        format.setForeground(fillColor);
-        format.clearProperty(QTextFormat::TextOutline);
-        cursor.mergeCharFormat(format);
-    }
+    // The QTextDocument renderer is only needed when the glyph atlas path is disabled
+    QTextDocument fallbackDoc;
+    QAbstractTextDocumentLayout* fallbackLayout = nullptr;
+    auto ensureFallbackLayout = [&]() -> QAbstractTextDocumentLayout* {
+        if (!fallbackLayout) {
+            configureSnapshotDocument(fallbackDoc, snapshot);
+            fallbackDoc.setTextWidth(layoutWidth);
+            QTextCursor cursor(&fallbackDoc);
+            QTextCharFormat format;
+            format.setForeground(fillColor);
+            format.clearProperty(QTextFormat::TextOutline);
+            cursor.mergeCharFormat(format);
+            fallbackLayout = fallbackDoc.documentLayout();
+        }
+        return fallbackLayout;
+    };
 
     auto drawDocumentWithStrokeBehindFill = [&](qint64* outlineMsOut,
                                                 int* glyphCountOut,
@@ -2263,6 +2396,11 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
             *glyphCountOut = 0;
         }
 
+        QAbstractTextDocumentLayout* layout = ensureFallbackLayout();
+        if (!layout) {
+            return;
+        }
+
         if (strokeWidth <= 0.0) {
             QAbstractTextDocumentLayout::PaintContext ctx;
             ctx.cursorPosition = -1;
@@ -2279,7 +2417,7 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
 
         // Pass 1: fill only
         {
-            QTextCursor cursor(&doc);
+            QTextCursor cursor(&fallbackDoc);
             cursor.select(QTextCursor::Document);
             QTextCharFormat fillFormat;
             fillFormat.setForeground(fillColor);
@@ -2299,7 +2437,7 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
 
         // Pass 2: outline only, drawn behind fill so it appears outside
         {
-            QTextCursor cursor(&doc);
+            QTextCursor cursor(&fallbackDoc);
             cursor.select(QTextCursor::Document);
             QTextCharFormat strokeFormat;
             QColor transparentFill = fillColor;
@@ -2374,65 +2512,42 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
             const qreal renderStrokeWidth = strokeWidth * 2.0; // stroke is drawn centered, so geometry width is 2x
 
             int glyphDrawn = 0;
-            for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
+            for (const GlyphLayoutCache::Line& shapedLine : shaped.lines) {
                 if (cancelled && cancelled->load(std::memory_order_relaxed)) {
                     return false;
                 }
 
-                QTextLayout* textLayout = block.layout();
-                if (!textLayout) {
+                if (hasViewport && !visibleDocRect.intersects(shapedLine.lineRect.translated(layoutShift))) {
                     continue;
                 }
 
-                const QRectF blockRect = layout->blockBoundingRect(block);
-                if (hasViewport && !visibleDocRect.intersects(blockRect)) {
-                    continue;
-                }
-
-                for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
-                    const QTextLine line = textLayout->lineAt(lineIndex);
-                    if (!line.isValid()) {
+                const QPointF lineOrigin = shapedLine.origin + layoutShift;
+                for (const QGlyphRun& run : shapedLine.glyphRuns) {
+                    const QVector<quint32> indexes = run.glyphIndexes();
+                    const QVector<QPointF> positions = run.positions();
+                    if (indexes.size() != positions.size()) {
                         continue;
                     }
 
-                    const QRectF lineRect(blockRect.left() + line.x(),
-                                          blockRect.top() + line.y(),
-                                          std::max<qreal>(line.naturalTextWidth(), 1.0),
-                                          std::max<qreal>(line.height(), 1.0));
-                    if (hasViewport && !visibleDocRect.intersects(lineRect)) {
+                    const QRawFont rawFont = run.rawFont();
+                    if (!rawFont.isValid()) {
                         continue;
                     }
 
-                    const qreal lineOffsetX = line.x();
-                    const QList<QGlyphRun> glyphRuns = line.glyphRuns();
-                    for (const QGlyphRun& run : glyphRuns) {
-                        const QVector<quint32> indexes = run.glyphIndexes();
-                        const QVector<QPointF> positions = run.positions();
-                        if (indexes.size() != positions.size()) {
-                            continue;
-                        }
-
-                        const QRawFont rawFont = run.rawFont();
-                        if (!rawFont.isValid()) {
+                    for (int gi = 0; gi < indexes.size(); ++gi) {
+                        // Retrieve both fill and pre-stroked geometric paths
+                        const auto& geom = cachedGlyphGeometry(rawFont, indexes[gi], renderStrokeWidth);
+                        
+                        if (geom.fillPath.isEmpty()) {
                             continue;
                         }
 
-                        for (int gi = 0; gi < indexes.size(); ++gi) {
-                            // Retrieve both fill and pre-stroked geometric paths
-                            const auto& geom = cachedGlyphGeometry(rawFont, indexes[gi], renderStrokeWidth);
-                            
-                            if (geom.fillPath.isEmpty()) {
-                                continue;
-                            }
-
-                            const QPointF glyphPos = blockRect.topLeft() + QPointF(lineOffsetX, line.y()) + positions[gi];
-                            BufferedGlyph bg;
-                            bg.fillPath = &geom.fillPath;
-                            bg.strokePath = (strokeWidth > 0.0) ? &geom.strokePath : nullptr;
-                            bg.position = glyphPos;
-                            visibleGlyphs.append(bg);
-                            ++glyphDrawn;
-                        }
+                        BufferedGlyph bg;
+                        bg.fillPath = &geom.fillPath;
+                        bg.strokePath = (strokeWidth > 0.0) ? &geom.strokePath : nullptr;
+                        bg.position = lineOrigin + positions[gi];
+                        visibleGlyphs.append(bg);
+                        ++glyphDrawn;
                     }
                 }
             }
@@ -2488,124 +2603,106 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
         quint64 cacheHits = 0;
         quint64 cacheMisses = 0;
         quint64 glyphDrawn = 0;
-        struct GlyphDrawCommand {
-            QPointF glyphPos;
-            RenderedGlyphBitmap rendered;
-            QPainterPath fallbackPath;
-            bool useFallbackPath = false;
-        };
-        QVector<GlyphDrawCommand> glyphCommands;
-
-        for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
+        // Coverage masks are colour-independent; fill and outline colours are applied once per
+        // layer when compositing. Glyphs whose mask could not be produced fall back to vector paths.
+        QVector<GlyphMaskDraw> glyphMasks;
+        QVector<QPainterPath> fallbackPaths;
+        // Optional distance-field route: needs an axis-aligned painter and an outline within the spread
+        QVector<GlyphFieldDraw> glyphFields;
+        const bool sdfAvailable = textSdfGlyphsEnabled() &&
+                                  painter->deviceTransform().type() <= QTransform::TxScale;
+
+        for (const GlyphLayoutCache::Line& shapedLine : shaped.lines) {
             // Cooperatively yield if the job has been superseded by a newer request.
             if (cancelled && cancelled->load(std::memory_order_relaxed)) {
                 return false;
             }
 
-            QTextLayout* textLayout = block.layout();
-            if (!textLayout) {
+            if (hasViewport && !visibleDocRect.intersects(shapedLine.lineRect.translated(layoutShift))) {
                 continue;
             }
 
-            const QRectF blockRect = layout->blockBoundingRect(block);
-            if (hasViewport && !visibleDocRect.intersects(blockRect)) {
-                continue;
-            }
-
-            for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
-                QTextLine line = textLayout->lineAt(lineIndex);
-                if (!line.isValid()) {
+            const QPointF lineOrigin = shapedLine.origin + layoutShift;
+            for (const QGlyphRun& run : shapedLine.glyphRuns) {
+                const QVector<quint32> indexes = run.glyphIndexes();
+                const QVector<QPointF> positions = run.positions();
+                if (indexes.size() != positions.size()) {
                     continue;
                 }
 
-                const QRectF lineRect(blockRect.left() + line.x(),
-                                      blockRect.top() + line.y(),
-                                      std::max<qreal>(line.naturalTextWidth(), 1.0),
-                                      std::max<qreal>(line.height(), 1.0));
-                if (hasViewport && !visibleDocRect.intersects(lineRect)) {
+                const QRawFont rawFont = run.rawFont();
+                if (!rawFont.isValid()) {
                     continue;
                 }
 
-                const qreal lineOffsetX = line.x();
-                const QList<QGlyphRun> glyphRuns = line.glyphRuns();
-                for (const QGlyphRun& run : glyphRuns) {
-                    const QVector<quint32> indexes = run.glyphIndexes();
-                    const QVector<QPointF> positions = run.positions();
-                    if (indexes.size() != positions.size()) {
-                        continue;
+                const bool useDistanceField = sdfAvailable &&
+                                              GlyphBitmapCache::distanceFieldCoversStroke(rawFont, strokeWidth);
+                for (int gi = 0; gi < indexes.size(); ++gi) {
+                    const QPointF glyphPos = lineOrigin + positions[gi];
+                    bool cacheHit = false;
+                    if (useDistanceField) {
+                        const GlyphDistanceField field = cachedGlyphDistanceField(rawFont, indexes[gi], &cacheHit);
+                        if (!field.isNull()) {
+                            if (cacheHit) {
+                                ++cacheHits;
+                            } else {
+                                ++cacheMisses;
+                            }
+                            glyphFields.append(GlyphFieldDraw{glyphPos, field});
+                            ++glyphDrawn;
+                            continue;
+                        }
                     }
-
-                    const QRawFont rawFont = run.rawFont();
-                    if (!rawFont.isValid()) {
-                        continue;
+                    const GlyphCoverage coverage = cachedGlyphCoverage(rawFont,
+                                                                       indexes[gi],
+                                                                       strokeWidth,
+                                                                       cacheScale,
+                                                                       &cacheHit);
+                    if (cacheHit) {
+                        ++cacheHits;
+                    } else {
+                        ++cacheMisses;
                     }
 
-                    for (int gi = 0; gi < indexes.size(); ++gi) {
-                        const QPointF glyphPos = blockRect.topLeft() + QPointF(lineOffsetX, line.y()) + positions[gi];
-                        bool cacheHit = false;
-                        const RenderedGlyphBitmap rendered = cachedRenderedGlyph(rawFont,
-                                                                                 indexes[gi],
-                                                                                 fillColor,
-                                                                                 outlineColor,
-                                                                                  highlightColor,
-                                                                                  highlightEnabled,
-                                                                                 strokeWidth,
-                                                                                 cacheScale,
-                                                                                 &cacheHit);
-                        if (cacheHit) {
-                            ++cacheHits;
-                        } else {
-                            ++cacheMisses;
-                        }
-
-                        GlyphDrawCommand command;
-                        command.glyphPos = glyphPos;
-                        command.rendered = rendered;
-
-                        if (rendered.fillPixmap.isNull() && rendered.strokePixmap.isNull()) {
-                            const QPainterPath glyphPath = cachedGlyphPath(rawFont, indexes[gi]);
-                            if (glyphPath.isEmpty()) {
-                                continue;
-                            }
-                            command.useFallbackPath = true;
-                            command.fallbackPath = glyphPath.translated(glyphPos);
+                    if (coverage.isNull()) {
+                        const QPainterPath glyphPath = cachedGlyphPath(rawFont, indexes[gi]);
+                        if (glyphPath.isEmpty()) {
+                            continue;
                         }
-
-                        glyphCommands.append(std::move(command));
-                        ++glyphDrawn;
+                        fallbackPaths.append(glyphPath.translated(glyphPos));
+                    } else {
+                        glyphMasks.append(GlyphMaskDraw{glyphPos, coverage});
                     }
+                    ++glyphDrawn;
                 }
             }
         }
 
         if (strokeWidth > 0.0) {
-            for (const GlyphDrawCommand& command : std::as_const(glyphCommands)) {
-                if (command.useFallbackPath) {
-                    painter->save();
-                    painter->setPen(QPen(outlineColor, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-                    painter->setBrush(Qt::NoBrush);
-                    painter->drawPath(command.fallbackPath);
-                    painter->restore();
-                    continue;
-                }
-                if (!command.rendered.strokePixmap.isNull()) {
-                    painter->drawPixmap(command.glyphPos + command.rendered.originOffset, command.rendered.strokePixmap);
+            if (!fallbackPaths.isEmpty()) {
+                painter->save();
+                painter->setPen(QPen(outlineColor, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+                painter->setBrush(Qt::NoBrush);
+                for (const QPainterPath& path : std::as_const(fallbackPaths)) {
+                    painter->drawPath(path);
                 }
+                painter->restore();
             }
+            drawTintedGlyphMasks(painter, glyphMasks, GlyphMaskLayer::Stroke, outlineColor);
         }
 
-        for (const GlyphDrawCommand& command : std::as_const(glyphCommands)) {
-            if (command.useFallbackPath) {
-                painter->save();
-                painter->setPen(Qt::NoPen);
-                painter->setBrush(fillColor);
-                painter->drawPath(command.fallbackPath);
-                painter->restore();
-                continue;
-            }
-            if (!command.rendered.fillPixmap.isNull()) {
-                painter->drawPixmap(command.glyphPos + command.rendered.originOffset, command.rendered.fillPixmap);
+        if (!fallbackPaths.isEmpty()) {
+            painter->save();
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(fillColor);
+            for (const QPainterPath& path : std::as_const(fallbackPaths)) {
+                painter->drawPath(path);
             }
+            painter->restore();
+        }
+        drawTintedGlyphMasks(painter, glyphMasks, GlyphMaskLayer::Fill, fillColor);
+        if (!glyphFields.isEmpty()) {
+            drawDistanceFieldGlyphs(painter, glyphFields, strokeWidth, fillColor, outlineColor);
         }
 
         const qint64 durationMs = atlasTimer.elapsed();
@@ -2632,42 +2729,14 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
             painter->setPen(Qt::NoPen);
             painter->setBrush(highlightColor);
 
-            const qreal docWidth = std::max<qreal>(docSize.width(), 1.0);
-            for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
-                QTextLayout* textLayout = block.layout();
-                if (!textLayout) continue;
-
-                const QRectF blockRect = layout->blockBoundingRect(block);
+            for (const GlyphLayoutCache::Line& shapedLine : shaped.lines) {
                 if (hasViewport) {
-                    const QRectF blockInItemCoords = blockRect.translated(offsetX, offsetY);
+                    const QRectF blockInItemCoords = shapedLine.blockRect.translated(offsetX + layoutShiftX, offsetY);
                     if (!viewport.intersects(blockInItemCoords)) {
                         continue;
                     }
                 }
-                for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
-                    QTextLine line = textLayout->lineAt(lineIndex);
-                    if (!line.isValid()) continue;
-
-                    QRectF lineRect = line.naturalTextRect();
-                    if (lineRect.isValid() && lineRect.width() > 0.0 && lineRect.height() > 0.0) {
-                        lineRect.translate(blockRect.topLeft());
-                    } else {
-                        const qreal lineWidth = line.naturalTextWidth();
-                        const qreal width = std::max<qreal>(lineWidth, 1.0);
-                        qreal alignedX = line.x();
-                        if (std::abs(alignedX) < 1e-4 && width < docWidth - 1e-4) {
-                            const qreal horizontalSpace = std::max<qreal>(0.0, docWidth - width);
-                            if (snapshot.horizontalAlignment == HorizontalAlignment::Right) {
-                                alignedX += horizontalSpace;
-                            } else if (snapshot.horizontalAlignment == HorizontalAlignment::Center) {
-                                alignedX += horizontalSpace * 0.5;
-                            }
-                        }
-                        const qreal height = std::max<qreal>(line.height(), 1.0);
-                        lineRect = QRectF(blockRect.topLeft() + QPointF(alignedX, line.y()), QSizeF(width, height));
-                    }
-                    painter->drawRect(lineRect);
-                }
+                painter->drawRect(shapedLine.highlightRect.translated(layoutShift));
             }
 
             painter->restore();
@@ -2676,7 +2745,7 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
         int glyphCount = 0;
         qint64 outlineMs = 0;
         const bool drewWithAtlas = drawGlyphAtlasWithFallback(&outlineMs, &glyphCount, offsetX, offsetY);
-        if (!drewWithAtlas) {
+        if (!drewWithAtlas && !(cancelled && cancelled->load(std::memory_order_relaxed))) {
             drawDocumentWithStrokeBehindFill(&outlineMs, &glyphCount, offsetX, offsetY);
         }
 
@@ -2689,35 +2758,23 @@ void TextMediaItem::paintVectorSnapshot(QPainter* painter, const VectorDrawSnaps
     int glyphCount = 0;
     qint64 outlineMs = 0;
 
-    for (QTextBlock block = doc.begin(); block.isValid(); block = block.next()) {
-        QTextLayout* textLayout = block.layout();
-        if (!textLayout) continue;
-
-        const QRectF blockRect = layout->blockBoundingRect(block);
-        if (hasViewport) {
-            const QRectF blockInItemCoords = blockRect.translated(offsetX, offsetY);
-            if (!viewport.intersects(blockInItemCoords)) {
-                continue;
-            }
-        }
-        for (int lineIndex = 0; lineIndex < textLayout->lineCount(); ++lineIndex) {
-            QTextLine line = textLayout->lineAt(lineIndex);
-            if (!line.isValid()) continue;
-
-            const qreal lineWidth = line.naturalTextWidth();
-            const qreal lineOffsetX = line.x();
-
-            if (highlightEnabled && highlightColor.alpha() > 0) {
-                const qreal highlightWidth = std::max<qreal>(lineWidth > 0.0 ? lineWidth : availableWidth, 1.0);
-                const qreal highlightHeight = std::max<qreal>(line.height(), 1.0);
-                const QRectF highlightRect(QPointF(lineOffsetX, blockRect.top() + line.y()), QSizeF(highlightWidth, highlightHeight));
-                painter->fillRect(highlightRect, highlightColor);
+    if (highlightEnabled && highlightColor.alpha() > 0) {
+        for (const GlyphLayoutCache::Line& shapedLine : shaped.lines) {
+            if (hasViewport) {
+                const QRectF blockInItemCoords = shapedLine.blockRect.translated(offsetX, offsetY);
+                if (!viewport.intersects(blockInItemCoords)) {
+                    continue;
+                }
             }
+            const qreal highlightWidth = std::max<qreal>(shapedLine.naturalWidth > 0.0 ? shapedLine.naturalWidth : availableWidth, 1.0);
+            const qreal highlightHeight = std::max<qreal>(shapedLine.height, 1.0);
+            const QRectF highlightRect(QPointF(shapedLine.lineX, shapedLine.origin.y()), QSizeF(highlightWidth, highlightHeight));
+            painter->fillRect(highlightRect, highlightColor);
         }
     }
 
     const bool drewWithAtlas = drawGlyphAtlasWithFallback(&outlineMs, &glyphCount, offsetX, offsetY);
-    if (!drewWithAtlas) {
+    if (!drewWithAtlas && !(cancelled && cancelled->load(std::memory_order_relaxed))) {
         drawDocumentWithStrokeBehindFill(&outlineMs, &glyphCount, offsetX, offsetY);
     }
 
@@ -2937,6 +2994,15 @@ void TextMediaItem::setFont(const QFont& font) {
     applyFontChange(adjustedFont);
 }
 
+void TextMediaItem::setUniformScaleFactor(qreal factor) {
+    if (!std::isfinite(factor) || std::abs(factor) < 1e-4 || std::abs(factor - m_uniformScaleFactor) < 1e-6) {
+        return;
+    }
+    m_uniformScaleFactor = factor;
+    invalidateRenderPipeline(InvalidationReason::Geometry, true);
+    update();
+}
+
 void TextMediaItem::setTextColor(const QColor& color) {
     if (m_textColor == color) {
         return;
@@ -3523,6 +3589,12 @@ void TextMediaItem::handleInlineEditorTextChanged(const QString& newText) {
 
     m_editorRenderingText = newText;
     invalidateRenderPipeline(InvalidationReason::Content, false);
+    if (!m_rasterizedText.isNull() && m_baseRasterLayout.valid) {
+        // Cheap when only a few blocks changed; keeps the 1x raster current for zoom-out
+        m_pendingBaseRasterRequest = QSize(std::max(1, m_baseSize.width()), std::max(1, m_baseSize.height()));
+        queueBaseRasterDispatch();
+        m_needsRasterization = false;
+    }
     update();
 }
 
@@ -3991,6 +4063,14 @@ void TextMediaItem::ensureScaledRaster(qreal visualScaleFactor, qreal geometrySc
     int targetWidth = std::max(1, static_cast<int>(std::ceil(static_cast<qreal>(m_baseSize.width()) * boundedGeometryScale * boundedUniformScale * boundedCanvasZoom * boundedDpr)));
     int targetHeight = std::max(1, static_cast<int>(std::ceil(static_cast<qreal>(m_baseSize.height()) * boundedGeometryScale * boundedUniformScale * boundedCanvasZoom * boundedDpr)));
     qreal rasterScale = effectiveScale * boundedDpr;
+
+    // Interactive uniform resizes change the base size every frame, so they keep the single
+    // full-item raster; everything else is served from viewport tiles.
+    if (textRasterTilesEnabled() && !disableViewportOptimization) {
+        ensureRasterTiles(visibleRegion, rasterScale, boundedCanvasZoom);
+        return;
+    }
+
     const QSize targetSize(targetWidth, targetHeight);
     const VectorDrawSnapshot cacheSnapshot = captureVectorSnapshot();
     const TextRenderCacheKey targetCacheKey = makeCacheKey(cacheSnapshot, targetSize, rasterScale, boundedDpr);
@@ -4118,10 +4198,69 @@ void TextMediaItem::ensureScaledRaster(qreal visualScaleFactor, qreal geometrySc
     }
 }
 
+quint64 TextMediaItem::rasterTileGeneration() const {
+    quint64 generation = m_contentRevision;
+    generation = generation * 1000003ULL + m_rasterSupersessionToken;
+    generation = generation * 1000003ULL + static_cast<quint64>(std::max(0, m_baseSize.width()));
+    generation = generation * 1000003ULL + static_cast<quint64>(std::max(0, m_baseSize.height()));
+    return generation;
+}
+
+void TextMediaItem::ensureRasterTiles(const QRectF& visibleRegion, qreal rasterScale, qreal canvasZoom) {
+    m_rasterTiles.setGeneration(rasterTileGeneration());
+
+    const int level = TextRasterTileCache::levelForScale(rasterScale);
+    m_rasterTileLevel = level;
+    const QRect visibleTiles = TextRasterTileCache::tileRangeFor(visibleRegion, level);
+    if (m_rasterTiles.reserveForViewport(visibleTiles.width() * visibleTiles.height())) {
+        m_rasterTilesLostLevel = TextRasterTileCache::kNoLevel;
+    }
+    const QRect missing = m_rasterTiles.missingTiles(visibleTiles, level);
+    if (missing.isEmpty()) {
+        // Pan inside already rendered tiles: nothing to raster
+        MOUFFETTE_METRIC_COUNT("text.tiles.reused", visibleTiles.width() * visibleTiles.height());
+        m_scaledRasterDirty = false;
+        m_forceScaledRasterRefresh = false;
+        return;
+    }
+    if (level == m_rasterTilesLostLevel && m_rasterTilesLostGeneration == rasterTileGeneration() &&
+        m_rasterTilesLostRange.contains(missing)) {
+        // Rendering them again would only evict them again; paint() keeps using the document path
+        MOUFFETTE_METRIC_COUNT("text.tiles.rerequestSkipped", 1);
+        return;
+    }
+
+    // One job renders the bounding range of the missing tiles; it is sliced on completion.
+    const qreal levelScale = TextRasterTileCache::scaleForLevel(level);
+    const QSize targetSize(std::max(1, static_cast<int>(std::ceil(m_baseSize.width() * levelScale))),
+                           std::max(1, static_cast<int>(std::ceil(m_baseSize.height() * levelScale))));
+    MOUFFETTE_METRIC_COUNT("text.tiles.requested", missing.width() * missing.height());
+    ++m_rasterRequestId;
+    startRasterJob(targetSize, levelScale, canvasZoom, TextRasterTileCache::itemRectForRange(missing, level),
+                   m_rasterRequestId, level, missing);
+}
+
+bool TextMediaItem::paintRasterTiles(QPainter* painter, const QRectF& visibleRegion) {
+    if (!textRasterTilesEnabled() || m_activeHandle != None || m_rasterTileLevel == TextRasterTileCache::kNoLevel) {
+        return false;
+    }
+    // Stale tiles (content, style or size changed since) are dropped here rather than drawn
+    m_rasterTiles.setGeneration(rasterTileGeneration());
+    const QRectF region = visibleRegion.intersected(boundingRect());
+    if (m_rasterTiles.isEmpty() || !m_rasterTiles.covers(region, m_rasterTileLevel)) {
+        return false;
+    }
+    m_rasterTiles.paint(painter, region, m_rasterTileLevel);
+    MOUFFETTE_METRIC_COUNT("text.tiles.presented", 1);
+    return true;
+}
 
-void TextMediaItem::startRasterJob(const QSize& targetSize, qreal effectiveScale, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId) {
+void TextMediaItem::startRasterJob(const QSize& targetSize, qreal effectiveScale, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId,
+                                   int tileLevel, const QRect& tileRange) {
     const QSize sanitizedSize(std::max(1, targetSize.width()), std::max(1, targetSize.height()));
     AsyncRasterRequest request{sanitizedSize, m_baseSize, visibleRegion, effectiveScale, canvasZoom, m_contentRevision, requestId, 0, m_rasterSupersessionToken};
+    request.tileLevel = tileLevel;
+    request.tileRange = tileRange;
 
     if (m_asyncRasterInProgress) {
         if (m_activeAsyncRasterRequest && m_activeAsyncRasterRequest->isEquivalentTo(sanitizedSize,
@@ -4181,8 +4320,11 @@ void TextMediaItem::startRasterJob(const QSize& targetSize, qreal effectiveScale
     queueRasterJobDispatch();
 }
 
-void TextMediaItem::startAsyncRasterRequest(const QSize& targetSize, qreal effectiveScale, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId) {
+void TextMediaItem::startAsyncRasterRequest(const QSize& targetSize, qreal effectiveScale, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId,
+                                            int tileLevel, const QRect& tileRange) {
     AsyncRasterRequest request{targetSize, m_baseSize, visibleRegion, effectiveScale, canvasZoom, m_contentRevision, requestId, 0, m_rasterSupersessionToken};
+    request.tileLevel = tileLevel;
+    request.tileRange = tileRange;
     request.generation = ++m_rasterJobGeneration;
     request.startedAt = std::chrono::steady_clock::now();
 
@@ -4208,14 +4350,30 @@ void TextMediaItem::startAsyncRasterRequest(const QSize& targetSize, qreal effec
 
     ensureTextRenderer();
     const std::shared_ptr<ITextRenderer> renderer = m_textRenderer;
+    std::weak_ptr<bool> guard = lifetimeGuard();
+    if (TextRasterScheduler* scheduler = rasterScheduler()) {
+        scheduler->submit(this, TextRasterScheduler::JobKind::HighRes,
+                          TextRasterScheduler::JobHints{sceneBoundingRect(), m_isEditing},
+                          [renderer, job]() { return renderer ? renderer->render(job) : job.execute(); },
+                          job.cancellationToken,
+                          [this, guard, request](QImage result) {
+                              if (guard.expired()) {
+                                  return;
+                              }
+                              handleRasterJobFinished(request.generation, std::move(result), request.targetSize, request.scale, request.canvasZoom, request.visibleRegionAtRequest);
+                          },
+                          guard);
+        return;
+    }
+
     auto future = QtConcurrent::run([renderer, job]() {
+        MOUFFETTE_TRACE_SCOPE("text.rasterJob");
         if (renderer) {
             return renderer->render(job);
         }
         return job.execute();
     });
 
-    std::weak_ptr<bool> guard = lifetimeGuard();
     auto* watcher = new QFutureWatcher<QImage>();
     QObject::connect(watcher, &QFutureWatcher<QImage>::finished, watcher, [this, guard, watcher, request]() mutable {
         if (guard.expired()) {
@@ -4267,7 +4425,88 @@ void TextMediaItem::dispatchPendingRasterRequest() {
         return;
     }
 
-    startAsyncRasterRequest(request.targetSize, request.scale, request.canvasZoom, request.visibleRegionAtRequest, request.requestId);
+    // Tiles may have landed while this request waited; only render what is still missing
+    if (request.tileLevel != TextRasterTileCache::kNoLevel) {
+        m_rasterTiles.setGeneration(rasterTileGeneration());
+        const QRect missing = m_rasterTiles.missingTiles(request.tileRange, request.tileLevel);
+        if (missing.isEmpty()) {
+            return;
+        }
+        request.tileRange = missing;
+        request.visibleRegionAtRequest = TextRasterTileCache::itemRectForRange(missing, request.tileLevel);
+    }
+
+    startAsyncRasterRequest(request.targetSize, request.scale, request.canvasZoom, request.visibleRegionAtRequest, request.requestId,
+                            request.tileLevel, request.tileRange);
+}
+
+TextMediaItem::BaseRasterLayoutState TextMediaItem::captureBaseRasterLayout(const QSize& targetSize) const {
+    BaseRasterLayoutState state;
+    if (!textIncrementalBaseRasterEnabled() || !m_inlineEditor) {
+        return state;
+    }
+    QTextDocument* doc = m_inlineEditor->document();
+    QAbstractTextDocumentLayout* layout = doc ? doc->documentLayout() : nullptr;
+    if (!layout) {
+        return state;
+    }
+
+    // The editor shows the same text and wrap width the raster job paints, so its (already
+    // computed) layout locates each block without shaping anything here.
+    state.blocks.reserve(doc->blockCount());
+    for (QTextBlock block = doc->begin(); block.isValid(); block = block.next()) {
+        BaseRasterLayoutState::Block entry;
+        entry.contentHash = qHash(block.text());
+        entry.itemRect = m_inlineEditor->mapRectToParent(layout->blockBoundingRect(block));
+        state.blocks.append(entry);
+    }
+    state.styleKey = makeCacheKey(captureVectorSnapshot(), targetSize, 1.0, 1.0);
+    state.styleKey.textHash = 0;
+    state.valid = true;
+    return state;
+}
+
+std::optional<QRect> TextMediaItem::baseRasterPatchRect(const BaseRasterLayoutState& next, const QSize& targetSize) const {
+    const BaseRasterLayoutState& current = m_baseRasterLayout;
+    if (!next.valid || !current.valid || m_rasterizedText.size() != targetSize ||
+        !(current.styleKey == next.styleKey)) {
+        return std::nullopt;
+    }
+
+    // Blocks outside the common prefix and suffix changed text, wrapping or position
+    const int oldCount = current.blocks.size();
+    const int newCount = next.blocks.size();
+    int prefix = 0;
+    while (prefix < oldCount && prefix < newCount && current.blocks[prefix] == next.blocks[prefix]) {
+        ++prefix;
+    }
+    int suffix = 0;
+    while (suffix < oldCount - prefix && suffix < newCount - prefix &&
+           current.blocks[oldCount - 1 - suffix] == next.blocks[newCount - 1 - suffix]) {
+        ++suffix;
+    }
+
+    QRectF dirty;
+    for (int i = prefix; i < oldCount - suffix; ++i) {
+        dirty |= current.blocks[i].itemRect;
+    }
+    for (int i = prefix; i < newCount - suffix; ++i) {
+        dirty |= next.blocks[i].itemRect;
+    }
+    if (dirty.isEmpty()) {
+        return QRect();
+    }
+
+    // Outline and highlight spill past the block box; the margin keeps their edges inside the patch
+    const qreal margin = std::ceil(borderStrokeWidthPx() * 2.0) + 2.0;
+    const QRect patch = dirty.adjusted(-margin, -margin, margin, margin).toAlignedRect()
+                             .intersected(QRect(QPoint(0, 0), targetSize));
+    const qint64 patchArea = static_cast<qint64>(patch.width()) * patch.height();
+    const qint64 fullArea = static_cast<qint64>(targetSize.width()) * targetSize.height();
+    if (patch.isEmpty() || patchArea * 2 > fullArea) {
+        return std::nullopt;  // Not worth a partial pass
+    }
+    return patch;
 }
 
 void TextMediaItem::startBaseRasterRequest(const QSize& targetSize) {
@@ -4276,6 +4515,18 @@ void TextMediaItem::startBaseRasterRequest(const QSize& targetSize) {
     }
 
     const QSize sanitized(std::max(1, targetSize.width()), std::max(1, targetSize.height()));
+    BaseRasterLayoutState layoutState = captureBaseRasterLayout(sanitized);
+    const std::optional<QRect> patch = baseRasterPatchRect(layoutState, sanitized);
+    if (patch.has_value() && patch->isEmpty()) {
+        // The edit did not change anything the base raster shows (e.g. trailing whitespace)
+        m_baseRasterLayout = std::move(layoutState);
+        m_baseRasterContentRevision = m_contentRevision;
+        m_needsRasterization = false;
+        startNextPendingBaseRasterRequest();
+        return;
+    }
+    const QRect patchRect = patch.value_or(QRect());
+
     m_baseRasterInProgress = true;
     m_activeBaseRasterSize = sanitized;
     const quint64 generation = ++m_baseRasterGeneration;
@@ -4286,19 +4537,44 @@ void TextMediaItem::startBaseRasterRequest(const QSize& targetSize) {
     job.targetSize = sanitized;
     job.scaleFactor = 1.0;
     job.canvasZoom = 1.0;  // Tier 2: Base raster always at 1.0 zoom
+    job.targetRect = QRectF(patchRect);
+    // Separate literal names: each macro call site binds its counter once
+    if (patchRect.isEmpty()) {
+        MOUFFETTE_METRIC_COUNT("text.baseRaster.full", 1);
+    } else {
+        MOUFFETTE_METRIC_COUNT("text.baseRaster.partial", 1);
+    }
 
     ensureTextRenderer();
     const std::shared_ptr<ITextRenderer> renderer = m_textRenderer;
+    std::weak_ptr<bool> guard = lifetimeGuard();
+    if (TextRasterScheduler* scheduler = rasterScheduler()) {
+        scheduler->submit(this, TextRasterScheduler::JobKind::Base,
+                          TextRasterScheduler::JobHints{sceneBoundingRect(), m_isEditing},
+                          [renderer, job]() { return renderer ? renderer->render(job) : job.execute(); },
+                          nullptr,
+                          [this, guard, generation, contentRevision, sanitized, patchRect, layoutState](QImage result) {
+                              if (guard.expired()) {
+                                  return;
+                              }
+                              handleBaseRasterJobFinished(generation, contentRevision, std::move(result), sanitized,
+                                                          patchRect, layoutState);
+                          },
+                          guard);
+        return;
+    }
+
     auto future = QtConcurrent::run([renderer, job]() {
+        MOUFFETTE_TRACE_SCOPE("text.rasterJob");
         if (renderer) {
             return renderer->render(job);
         }
         return job.execute();
     });
 
-    std::weak_ptr<bool> guard = lifetimeGuard();
     auto* watcher = new QFutureWatcher<QImage>();
-    QObject::connect(watcher, &QFutureWatcher<QImage>::finished, watcher, [this, guard, watcher, generation, contentRevision, sanitized]() mutable {
+    QObject::connect(watcher, &QFutureWatcher<QImage>::finished, watcher,
+                     [this, guard, watcher, generation, contentRevision, sanitized, patchRect, layoutState]() mutable {
         if (guard.expired()) {
             watcher->deleteLater();
             return;
@@ -4307,7 +4583,7 @@ void TextMediaItem::startBaseRasterRequest(const QSize& targetSize) {
         QImage result = watcher->result();
         watcher->deleteLater();
 
-        handleBaseRasterJobFinished(generation, contentRevision, std::move(result), sanitized);
+        handleBaseRasterJobFinished(generation, contentRevision, std::move(result), sanitized, patchRect, std::move(layoutState));
     });
 
     watcher->setFuture(future);
@@ -4357,8 +4633,10 @@ void TextMediaItem::startNextPendingBaseRasterRequest() {
     queueBaseRasterDispatch();
 }
 
-void TextMediaItem::handleBaseRasterJobFinished(quint64 generation, quint64 contentRevision, QImage&& raster, const QSize& size) {
-    if (generation != m_baseRasterGeneration || contentRevision != m_contentRevision) {
+void TextMediaItem::handleBaseRasterJobFinished(quint64 generation, quint64 contentRevision, QImage&& raster, const QSize& size,
+                                                const QRect& patchRect, BaseRasterLayoutState layoutState) {
+    // A null result means the job was replaced or dropped by the raster scheduler
+    if (generation != m_baseRasterGeneration || contentRevision != m_contentRevision || raster.isNull()) {
         m_baseRasterInProgress = false;
         startNextPendingBaseRasterRequest();
         return;
@@ -4397,10 +4675,25 @@ void TextMediaItem::handleBaseRasterJobFinished(quint64 generation, quint64 cont
         return;
     }
 
-    m_rasterizedText = std::move(raster);
+    if (patchRect.isEmpty()) {
+        m_rasterizedText = std::move(raster);
+    } else if (m_rasterizedText.size() == size) {
+        QPainter patchPainter(&m_rasterizedText);
+        patchPainter.setCompositionMode(QPainter::CompositionMode_Source);
+        patchPainter.drawImage(patchRect.topLeft(), raster);
+    } else {
+        // The raster the patch was cut for is gone (released or resized); redo it in full
+        m_baseRasterLayout = BaseRasterLayoutState();
+        m_needsRasterization = true;
+        m_pendingBaseRasterRequest = expectedSize;
+        queueBaseRasterDispatch();
+        return;
+    }
+    m_baseRasterLayout = std::move(layoutState);
     m_baseRasterContentRevision = contentRevision;
     m_lastRasterizedSize = m_baseSize;
     m_needsRasterization = false;
+    enforceCacheBudget();
     // Do NOT reset m_lastRasterizedScale or set m_scaledRasterDirty here.
     // The base raster is a secondary 1× cache; its completion has no bearing on
     // the validity of the currently-displayed zoom-level scaled raster.
@@ -4433,12 +4726,16 @@ void TextMediaItem::handleRasterJobFinished(quint64 generation, QImage&& raster,
     quint64 completedSupersessionToken = 0;
     QSize completedBaseSize;
     QRectF completedVisibleRegion;
+    int completedTileLevel = TextRasterTileCache::kNoLevel;
+    QRect completedTileRange;
     if (m_activeAsyncRasterRequest.has_value()) {
         durationMs = static_cast<qint64>(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_activeAsyncRasterRequest->startedAt).count());
         completedContentRevision = m_activeAsyncRasterRequest->contentRevision;
         completedSupersessionToken = m_activeAsyncRasterRequest->supersessionToken;
         completedBaseSize = m_activeAsyncRasterRequest->baseSizeAtRequest;
         completedVisibleRegion = m_activeAsyncRasterRequest->visibleRegionAtRequest;
+        completedTileLevel = m_activeAsyncRasterRequest->tileLevel;
+        completedTileRange = m_activeAsyncRasterRequest->tileRange;
     }
 
     if (m_activeAsyncRasterRequest && m_activeAsyncRasterRequest->generation == generation) {
@@ -4454,6 +4751,13 @@ void TextMediaItem::handleRasterJobFinished(quint64 generation, QImage&& raster,
         return;
     }
 
+    // Dropped by the raster scheduler or cancelled mid-run: keep presenting the current raster
+    if (raster.isNull()) {
+        recordTextRasterResult(durationMs, true, false);
+        startNextPendingAsyncRasterRequest();
+        return;
+    }
+
     // Geometry gate: do not present a raster produced for a different base size.
     // This avoids a brief stale-frame swap right after handle release.
     if (completedBaseSize.isValid() && completedBaseSize != m_baseSize) {
@@ -4464,6 +4768,36 @@ void TextMediaItem::handleRasterJobFinished(quint64 generation, QImage&& raster,
         return;
     }
 
+    if (completedTileLevel != TextRasterTileCache::kNoLevel) {
+        m_rasterTiles.setGeneration(rasterTileGeneration());
+        const int stored = m_rasterTiles.insertFromRaster(raster, completedTileRange, completedTileLevel);
+        MOUFFETTE_METRIC_COUNT("text.tiles.rendered", stored);
+        const QRect lost = m_rasterTiles.missingTiles(completedTileRange, completedTileLevel);
+        if (!lost.isEmpty()) {
+            MOUFFETTE_METRIC_COUNT("text.tiles.evictedOnInsert", lost.width() * lost.height());
+            m_rasterTilesLostLevel = completedTileLevel;
+            m_rasterTilesLostRange = lost;
+            m_rasterTilesLostGeneration = rasterTileGeneration();
+        } else if (completedTileLevel == m_rasterTilesLostLevel) {
+            m_rasterTilesLostLevel = TextRasterTileCache::kNoLevel;
+        }
+        m_lastRasterizedScale = scale;
+        m_lastCanvasZoomForRaster = canvasZoom;
+        m_lastViewportRect = visibleRegion;
+        m_lastViewportScale = canvasZoom;
+        m_scaledRasterDirty = false;
+        m_forceScaledRasterRefresh = false;
+        m_asyncRasterInProgress = false;
+        m_pendingRasterRequestId = 0;
+        m_lastScaledRasterUpdate = std::chrono::steady_clock::now();
+        m_renderState = RenderState::HighResReady;
+        enforceCacheBudget();
+        recordTextRasterResult(durationMs, false, false);
+        update();
+        startNextPendingAsyncRasterRequest();
+        return;
+    }
+
     m_scaledRasterizedText = std::move(raster);
     m_scaledRasterPixmap = QPixmap::fromImage(m_scaledRasterizedText);
     m_scaledRasterPixmap.setDevicePixelRatio(1.0);
@@ -4521,6 +4855,10 @@ void TextMediaItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         return;
     }
 
+    if (TextRasterScheduler* scheduler = rasterScheduler()) {
+        scheduler->touch(this);
+    }
+
     if (!m_inlineEditor) {
         ensureInlineEditor();
     }
@@ -4543,8 +4881,18 @@ void TextMediaItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         updateInlineEditorGeometry();
 
         const bool showContent = m_contentVisible && (m_contentOpacity > 0.0) && (m_contentDisplayOpacity > 0.0);
-        m_inlineEditor->setVisible(showContent);
-        m_inlineEditor->setOpacity(showContent ? (m_contentOpacity * m_contentDisplayOpacity) : 0.0);
+        const qreal contentOpacity = showContent ? (m_contentOpacity * m_contentDisplayOpacity) : 0.0;
+        // Zoomed and not editing: present the viewport tiles (coarser levels fill pending tiles).
+        // The editor draws instead until the tiles cover the visible region.
+        bool presentedTiles = false;
+        if (showContent && !m_isEditing) {
+            painter->save();
+            painter->setOpacity(painter->opacity() * contentOpacity);
+            presentedTiles = paintRasterTiles(painter, computeVisibleRegion());
+            painter->restore();
+        }
+        m_inlineEditor->setVisible(showContent && !presentedTiles);
+        m_inlineEditor->setOpacity(contentOpacity);
     }
 
     paintSelectionAndLabel(painter);
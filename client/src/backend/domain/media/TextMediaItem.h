@@ -2,6 +2,7 @@
 #pragma once
 
 #include "MediaItems.h"
+#include "TextRasterTileCache.h"
 #include <QString>
 #include <QFont>
 #include <QColor>
@@ -14,6 +15,9 @@
 #include <atomic>
 #include <QPixmap>
 #include <QVector>
+#include <QList>
+#include <QGlyphRun>
+#include <QRectF>
 #include <memory>
 
 class QGraphicsTextItem;
@@ -22,6 +26,9 @@ class RoundedRectItem;
 class QAbstractTextDocumentLayout;
 class QAbstractTextDocumentLayout;
 class QRawFont;
+class QTextDocument;
+class TextRasterScheduler;
+class QJsonObject;
 
 // Global configuration namespace for text media defaults
 namespace TextMediaDefaults {
@@ -109,9 +116,40 @@ public:
     void setUppercaseEnabled(bool enabled);
 
     qreal uniformScaleFactor() const { return m_uniformScaleFactor; }
+    // Document restore: re-apply a previously baked uniform scale
+    void setUniformScaleFactor(qreal factor);
 
     static void setMaxRasterDimension(int pixels);
     static int maxRasterDimension();
+
+    // Cumulative async raster job counters across all text items. Unlike [TextPerf] these are
+    // collected regardless of MOUFFETTE_TEXT_PROFILING and never reset by the log window.
+    struct RasterJobTotals {
+        quint64 started = 0;
+        quint64 completed = 0;
+        quint64 dropped = 0;
+        quint64 stale = 0;
+        qint64 totalDurationMs = 0;
+    };
+    static RasterJobTotals rasterJobTotals();
+    static void resetRasterJobTotals();
+
+    // Headless micro-benchmark entry points (benchmarks/TextRenderBenchmark.cpp); safe from any thread
+    struct BenchmarkPaintRequest {
+        QString text;
+        QFont font;
+        QColor fillColor = Qt::white;
+        QColor outlineColor = Qt::black;
+        qreal outlineWidthPercent = 0.0;
+        QSize baseSize;
+        qreal scaleFactor = 1.0;
+    };
+    // Paint the request through the raster-job path into *target (resized to baseSize * scale as
+    // needed); returns the number of glyphs laid out
+    static int paintBenchmarkSnapshot(const BenchmarkPaintRequest& request, QImage* target);
+    // Drop the shaping, glyph outline and glyph coverage caches so the next paint starts cold.
+    // Per-thread layout caches are cleared lazily on their next lookup.
+    static void clearTextCaches();
     
     // Text alignment
     enum class HorizontalAlignment { Left, Center, Right };
@@ -124,6 +162,8 @@ public:
     void setVerticalAlignment(VerticalAlignment align);
 
     bool fitToTextEnabled() const { return m_fitToTextEnabled; }
+    // Host line breaks and glyph runs for the remote scene payload; empty when disabled or unavailable
+    QJsonObject shapedLayoutPayload() const;
     void setFitToTextEnabled(bool enabled);
 
     // Inline editing lifecycle
@@ -274,6 +314,24 @@ private:
         bool valid = false;
     };
 
+    // Per-block geometry a base raster was produced from. Comparing it with the editor's current
+    // layout tells which block rectangles an edit touched, including blocks shifted by a change
+    // in wrapping further up, so only those are re-rasterised into the existing base raster.
+    struct BaseRasterLayoutState {
+        struct Block {
+            quint64 contentHash = 0;
+            QRectF itemRect;
+
+            bool operator==(const Block& other) const {
+                return contentHash == other.contentHash && itemRect == other.itemRect;
+            }
+        };
+
+        QVector<Block> blocks;
+        TextRenderCacheKey styleKey;   // textHash is left at zero; text is compared per block
+        bool valid = false;
+    };
+
     struct TextRasterJob;
 
     struct ITextRenderer {
@@ -292,6 +350,7 @@ private:
     
     // Rasterization cache for performance
     QImage m_rasterizedText;
+    BaseRasterLayoutState m_baseRasterLayout;  // Layout m_rasterizedText currently shows
     bool m_needsRasterization = true;
     QSize m_lastRasterizedSize;
     QImage m_scaledRasterizedText;
@@ -329,6 +388,8 @@ private:
         quint64 generation = 0;
         quint64 supersessionToken = 0;
         std::chrono::steady_clock::time_point startedAt{};
+        int tileLevel = TextRasterTileCache::kNoLevel; // tiled request: level and tiles rendered
+        QRect tileRange;
 
         bool isEquivalentTo(const QSize& size,
                             qreal scaleFactor,
@@ -374,6 +435,13 @@ private:
     bool m_scaledRasterPixmapValid = false;
     quint64 m_scaledRasterContentRevision = 0;
     QRectF m_scaledRasterVisibleRegion;  // Region of item that was rasterized (for viewport optimization)
+    TextRasterTileCache m_rasterTiles;   // Tiled replacement for the single scaled raster
+    int m_rasterTileLevel = TextRasterTileCache::kNoLevel;  // Level last requested for the viewport
+    // Tiles a finished job could not keep (evicted by its own batch); not requested again for this
+    // level and generation until the tile budget grows
+    int m_rasterTilesLostLevel = TextRasterTileCache::kNoLevel;
+    QRect m_rasterTilesLostRange;
+    quint64 m_rasterTilesLostGeneration = 0;
     enum class RenderState {
         Idle,
         HighResPending,
@@ -394,18 +462,35 @@ private:
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
     // Phase 6: Glyph Layout Pre-computation Cache
-    // Note: Simplified to avoid QRawFont storage complexity
-    // Actual Phase 6 optimization deferred - cache infrastructure ready but not used
+    // Shaped lines (glyph runs + line geometry) of one text/font/wrap-mode/alignment layout.
+    // Built by glyphLayoutFor() on the rasterising thread and reused by later jobs on that
+    // thread when only zoom, colour or outline changed.
     struct GlyphLayoutCache {
-        quint64 fingerprint = 0;           // Hash of text + font + size + width
+        struct Line {
+            QRectF blockRect;          // Owning block bounds (document coords)
+            QRectF lineRect;           // Line box used for viewport culling
+            QRectF highlightRect;      // Highlight box in wrapped (non fit-to-text) mode
+            QPointF origin;            // Block top-left + line position; glyph positions are relative to it
+            qreal lineX = 0.0;
+            qreal naturalWidth = 0.0;
+            qreal height = 0.0;
+            QList<QGlyphRun> glyphRuns;
+        };
+
+        quint64 fingerprint = 0;           // Hash of text + font + wrap mode + alignment
+        QString text;
+        QString fontKey;
+        qreal wrapWidth = 0.0;             // Text width the lines were broken at
+        qreal maxNaturalWidth = 0.0;
+        QSizeF docSize;
+        QRectF docBounds;
+        QVector<Line> lines;
         bool valid = false;
         
         void clear() {
-            fingerprint = 0;
-            valid = false;
+            *this = GlyphLayoutCache();
         }
     };
-    GlyphLayoutCache m_glyphLayoutCache;
     
     // Phase 7: Per-Block Viewport Culling
     struct BlockVisibility {
@@ -566,6 +651,11 @@ private:
     TextRenderCacheKey makeCacheKey(const VectorDrawSnapshot& snapshot, const QSize& targetSize, qreal scaleFactor, qreal dpr) const;
     bool cacheKeyMatches(const TextRenderCacheKey& lhs, const TextRenderCacheKey& rhs) const;
     void enforceCacheBudget();
+    qint64 rasterCacheBytes() const;
+    void releaseDirtyOverlay();
+    void releaseScaledRaster();
+    void releaseIncrementalBaseRaster();
+    TextRasterScheduler* rasterScheduler() const;
     quint64 computeLayoutSnapshotKey(const QString& text, const QFont& font, qreal wrapWidth) const;
     bool canReuseLayoutSnapshot(const QString& text, const QFont& font, qreal wrapWidth) const;
     void updateLayoutSnapshot(const QString& text, const QFont& font, qreal wrapWidth, const QSizeF& docSize, qreal idealWidth, int lineCount);
@@ -574,14 +664,24 @@ private:
 
     QRectF computeVisibleRegion() const;
     void ensureScaledRaster(qreal visualScaleFactor, qreal geometryScale, qreal canvasZoom);
-    void startRasterJob(const QSize& targetSize, qreal visualScaleFactor, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId);
+    void ensureRasterTiles(const QRectF& visibleRegion, qreal rasterScale, qreal canvasZoom);
+    quint64 rasterTileGeneration() const;
+    // Draws the viewport from cached tiles; false (and nothing drawn) unless they cover it
+    bool paintRasterTiles(QPainter* painter, const QRectF& visibleRegion);
+    void startRasterJob(const QSize& targetSize, qreal visualScaleFactor, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId,
+                        int tileLevel = TextRasterTileCache::kNoLevel, const QRect& tileRange = QRect());
     void handleRasterJobFinished(quint64 generation, QImage&& raster, const QSize& size, qreal scale, qreal canvasZoom, const QRectF& visibleRegion = QRectF());
-    void startAsyncRasterRequest(const QSize& targetSize, qreal visualScaleFactor, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId);
+    void startAsyncRasterRequest(const QSize& targetSize, qreal visualScaleFactor, qreal canvasZoom, const QRectF& visibleRegion, quint64 requestId,
+                                 int tileLevel = TextRasterTileCache::kNoLevel, const QRect& tileRange = QRect());
     void startNextPendingAsyncRasterRequest();
     void queueRasterJobDispatch();
     void dispatchPendingRasterRequest();
     void startBaseRasterRequest(const QSize& targetSize);
-    void handleBaseRasterJobFinished(quint64 generation, quint64 contentRevision, QImage&& raster, const QSize& size);
+    void handleBaseRasterJobFinished(quint64 generation, quint64 contentRevision, QImage&& raster, const QSize& size,
+                                     const QRect& patchRect, BaseRasterLayoutState layoutState);
+    BaseRasterLayoutState captureBaseRasterLayout(const QSize& targetSize) const;
+    // Pixel rect of the base raster that differs from 'next'; nullopt when a full raster is needed
+    std::optional<QRect> baseRasterPatchRect(const BaseRasterLayoutState& next, const QSize& targetSize) const;
     void queueBaseRasterDispatch();
     void dispatchPendingBaseRasterRequest();
     void startNextPendingBaseRasterRequest();
@@ -606,9 +706,9 @@ private:
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     
     // Phase 6: Glyph Layout Pre-computation
-    quint64 computeLayoutFingerprint(const QString& text, const QFont& font, qreal width) const;
-    void updateGlyphLayoutCache(const VectorDrawSnapshot& snapshot, const QSize& targetSize);
-    bool isGlyphLayoutCacheValid(const VectorDrawSnapshot& snapshot, const QSize& targetSize) const;
+    static quint64 computeLayoutFingerprint(const QString& text, const QFont& font, bool fitToText, HorizontalAlignment alignment);
+    static void configureSnapshotDocument(QTextDocument& doc, const VectorDrawSnapshot& snapshot);
+    static GlyphLayoutCache glyphLayoutFor(const VectorDrawSnapshot& snapshot, qreal availableWidth);
     
     // Phase 7: Viewport Culling
     void updateBlockVisibilityCache(const QRectF& viewport, QTextDocument& doc, QAbstractTextDocumentLayout* layout);
@@ -0,0 +1,297 @@
+// TextRasterScheduler.cpp - Prioritised text raster dispatch and shared raster memory budget
+#include "TextRasterScheduler.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
+#include <QFutureWatcher>
+#include <QGraphicsScene>
+#include <QMetaObject>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr int kMaxRasterThreads = 4;
+constexpr qint64 kDefaultRasterBudgetMb = 256;
+
+int rasterThreadCountFromEnv() {
+    const QByteArray raw = qgetenv("MOUFFETTE_TEXT_RASTER_THREADS");
+    if (!raw.isEmpty()) {
+        bool ok = false;
+        const int parsed = raw.trimmed().toInt(&ok);
+        if (ok) {
+            return std::clamp(parsed, 1, 16);
+        }
+    }
+    return std::clamp(QThread::idealThreadCount() / 2, 1, kMaxRasterThreads);
+}
+
+qint64 rasterBudgetBytesFromEnv() {
+    qint64 megabytes = kDefaultRasterBudgetMb;
+    const QByteArray raw = qgetenv("MOUFFETTE_TEXT_RASTER_BUDGET_MB");
+    if (!raw.isEmpty()) {
+        bool ok = false;
+        const qint64 parsed = raw.trimmed().toLongLong(&ok);
+        if (ok) {
+            megabytes = std::clamp<qint64>(parsed, 16, 4096);
+        }
+    }
+    return megabytes * 1024LL * 1024LL;
+}
+
+QHash<const QGraphicsScene*, TextRasterScheduler*>& schedulerRegistry() {
+    static QHash<const QGraphicsScene*, TextRasterScheduler*> registry; // GUI thread only
+    return registry;
+}
+
+qreal squaredDistance(const QPointF& a, const QPointF& b) {
+    const QPointF d = a - b;
+    return d.x() * d.x() + d.y() * d.y();
+}
+
+} // anonymous namespace
+
+TextRasterScheduler::TextRasterScheduler(QGraphicsScene* scene, QObject* parent)
+    : QObject(parent)
+    , m_scene(scene)
+    , m_budgetBytes(rasterBudgetBytesFromEnv()) {
+    m_pool.setMaxThreadCount(rasterThreadCountFromEnv());
+    m_pool.setObjectName(QStringLiteral("TextRasterPool"));
+    if (m_scene) {
+        schedulerRegistry().insert(m_scene, this);
+    }
+    qInfo() << "[TextRasterScheduler] workers" << m_pool.maxThreadCount()
+            << "budgetMb" << (m_budgetBytes / (1024LL * 1024LL));
+}
+
+TextRasterScheduler::~TextRasterScheduler() {
+    if (m_scene) {
+        auto& registry = schedulerRegistry();
+        auto it = registry.find(m_scene);
+        if (it != registry.end() && it.value() == this) {
+            registry.erase(it);
+        }
+    }
+    // Pending jobs are discarded; running ones finish before the pool is destroyed and their
+    // watchers (children of this object) are gone by then, so no completion is delivered.
+    m_pending.clear();
+    for (QFutureWatcherBase* watcher : findChildren<QFutureWatcherBase*>()) {
+        watcher->disconnect(this);
+    }
+    m_pool.waitForDone();
+}
+
+TextRasterScheduler* TextRasterScheduler::forScene(const QGraphicsScene* scene) {
+    if (!scene) {
+        return nullptr;
+    }
+    return schedulerRegistry().value(scene, nullptr);
+}
+
+void TextRasterScheduler::submit(const void* owner, JobKind kind, const JobHints& hints, Work work,
+                                 std::shared_ptr<std::atomic<bool>> cancellationToken, Completion completion,
+                                 std::weak_ptr<bool> guard) {
+    PendingJob job;
+    job.owner = owner;
+    job.kind = kind;
+    job.hints = hints;
+    job.work = std::move(work);
+    job.cancellationToken = std::move(cancellationToken);
+    job.completion = std::move(completion);
+    job.guard = std::move(guard);
+    job.sequence = ++m_nextSequence;
+
+    // Coalesce: a newer request from the same owner supersedes the one still waiting.
+    // It keeps the original queue position so repeated resubmission cannot starve it.
+    for (PendingJob& pending : m_pending) {
+        if (pending.owner == owner && pending.kind == kind) {
+            PendingJob replaced = std::move(pending);
+            job.sequence = replaced.sequence;
+            pending = std::move(job);
+            MOUFFETTE_METRIC_COUNT("text.scheduler.coalesced", 1);
+            complete(replaced, QImage());
+            publishQueueMetrics();
+            return;
+        }
+    }
+
+    m_pending.push_back(std::move(job));
+    pump();
+}
+
+void TextRasterScheduler::dropCancelledJobs() {
+    for (int i = m_pending.size() - 1; i >= 0; --i) {
+        const PendingJob& job = m_pending.at(i);
+        const bool cancelled = job.cancellationToken && job.cancellationToken->load(std::memory_order_relaxed);
+        if (!cancelled && !job.guard.expired()) {
+            continue;
+        }
+        PendingJob dropped = std::move(m_pending[i]);
+        m_pending.remove(i);
+        MOUFFETTE_METRIC_COUNT("text.scheduler.dropped", 1);
+        complete(dropped, QImage());
+    }
+}
+
+int TextRasterScheduler::takeNextJobIndex(const QRectF& viewport) const {
+    const QPointF viewportCenter = viewport.center();
+    int best = -1;
+    int bestTier = std::numeric_limits<int>::max();
+    qreal bestDistance = 0.0;
+    quint64 bestSequence = 0;
+    for (int i = 0; i < m_pending.size(); ++i) {
+        const PendingJob& job = m_pending.at(i);
+        int tier = 2;
+        qreal distance = 0.0;
+        if (job.hints.editing) {
+            tier = 0;
+        } else if (viewport.isValid() && viewport.intersects(job.hints.sceneRect)) {
+            tier = 1;
+            distance = squaredDistance(job.hints.sceneRect.center(), viewportCenter);
+        }
+        const bool better = best < 0 ||
+                            tier < bestTier ||
+                            (tier == bestTier && distance < bestDistance) ||
+                            (tier == bestTier && distance == bestDistance && job.sequence < bestSequence);
+        if (better) {
+            best = i;
+            bestTier = tier;
+            bestDistance = distance;
+            bestSequence = job.sequence;
+        }
+    }
+    return best;
+}
+
+void TextRasterScheduler::pump() {
+    dropCancelledJobs();
+    if (m_running < m_pool.maxThreadCount() && !m_pending.isEmpty()) {
+        const QRectF viewport = m_viewportProvider ? m_viewportProvider() : QRectF();
+        while (m_running < m_pool.maxThreadCount() && !m_pending.isEmpty()) {
+            const int index = takeNextJobIndex(viewport);
+            PendingJob job = std::move(m_pending[index]);
+            m_pending.remove(index);
+            run(std::move(job));
+        }
+    }
+    publishQueueMetrics();
+}
+
+void TextRasterScheduler::run(PendingJob job) {
+    ++m_running;
+    Work work = std::move(job.work);
+    auto future = QtConcurrent::run(&m_pool, [work = std::move(work)]() {
+        MOUFFETTE_TRACE_SCOPE("text.rasterJob");
+        return work();
+    });
+
+    auto* watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, job = std::move(job)]() {
+        QImage result = watcher->result();
+        watcher->deleteLater();
+        --m_running;
+        complete(job, std::move(result));
+        pump();
+    });
+    watcher->setFuture(future);
+}
+
+void TextRasterScheduler::complete(const PendingJob& job, QImage image) {
+    if (!job.completion || job.guard.expired()) {
+        return;
+    }
+    if (!image.isNull()) {
+        job.completion(std::move(image));
+        return;
+    }
+    // Replaced and dropped jobs are completed from inside submit()/pump(); deliver every null
+    // result on the next event loop turn so the owner never re-enters its own dispatch code.
+    Completion completion = job.completion;
+    std::weak_ptr<bool> guard = job.guard;
+    QMetaObject::invokeMethod(this, [completion, guard]() {
+        if (!guard.expired()) {
+            completion(QImage());
+        }
+    }, Qt::QueuedConnection);
+}
+
+void TextRasterScheduler::reportRasterBytes(const void* owner, qint64 bytes, std::weak_ptr<bool> guard, Evictor evictor) {
+    BudgetEntry& entry = m_budget[owner];
+    m_totalRasterBytes += std::max<qint64>(0, bytes) - entry.bytes;
+    entry.bytes = std::max<qint64>(0, bytes);
+    entry.lastUse = ++m_useClock;
+    entry.guard = std::move(guard);
+    entry.evictor = std::move(evictor);
+    enforceBudget(owner);
+}
+
+void TextRasterScheduler::touch(const void* owner) {
+    auto it = m_budget.find(owner);
+    if (it != m_budget.end()) {
+        it->lastUse = ++m_useClock;
+    }
+}
+
+void TextRasterScheduler::enforceBudget(const void* keepOwner) {
+    if (m_enforcingBudget) {
+        return;
+    }
+    m_enforcingBudget = true;
+
+    // Forget owners that were destroyed since they last reported
+    for (auto it = m_budget.begin(); it != m_budget.end();) {
+        if (it->guard.expired()) {
+            m_totalRasterBytes -= it->bytes;
+            it = m_budget.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (m_totalRasterBytes > m_budgetBytes) {
+        QVector<const void*> candidates;
+        candidates.reserve(m_budget.size());
+        for (auto it = m_budget.cbegin(); it != m_budget.cend(); ++it) {
+            if (it.key() != keepOwner && it->bytes > 0 && it->evictor) {
+                candidates.push_back(it.key());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](const void* a, const void* b) {
+            return m_budget.value(a).lastUse < m_budget.value(b).lastUse;
+        });
+
+        int evictions = 0;
+        for (const void* owner : candidates) {
+            if (m_totalRasterBytes <= m_budgetBytes) {
+                break;
+            }
+            auto it = m_budget.find(owner);
+            if (it == m_budget.end()) {
+                continue;
+            }
+            Evictor evictor = it->evictor;
+            const qint64 remaining = std::max<qint64>(0, evictor());
+            it = m_budget.find(owner);
+            if (it == m_budget.end()) {
+                continue;
+            }
+            m_totalRasterBytes += remaining - it->bytes;
+            it->bytes = remaining;
+            ++evictions;
+        }
+        if (evictions > 0) {
+            MOUFFETTE_METRIC_COUNT("text.rasterBudget.evictions", evictions);
+        }
+    }
+
+    MOUFFETTE_METRIC_GAUGE("text.rasterBudget.bytes", m_totalRasterBytes);
+    MOUFFETTE_METRIC_GAUGE("text.rasterBudget.items", m_budget.size());
+    m_enforcingBudget = false;
+}
+
+void TextRasterScheduler::publishQueueMetrics() const {
+    MOUFFETTE_METRIC_GAUGE("text.scheduler.queueDepth", m_pending.size());
+    MOUFFETTE_METRIC_GAUGE("text.scheduler.running", m_running);
+}
@@ -0,0 +1,115 @@
+// TextRasterScheduler.h - Canvas-wide text raster job queue and raster memory budget
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QRectF>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class QGraphicsScene;
+
+/**
+ * @brief TextRasterScheduler - Shared worker pool, priority queue and memory budget for text items
+ *
+ * One scheduler is owned by each ScreenCanvas and registered for its scene; text items look it up
+ * with forScene(scene()) and fall back to the global QtConcurrent pool when none exists.
+ *
+ * Jobs run on a dedicated QThreadPool sized by MOUFFETTE_TEXT_RASTER_THREADS (default: half the
+ * ideal thread count, clamped to 1..4). Only as many jobs as there are workers are handed to the
+ * pool; the rest wait here and are picked by priority when a worker frees up:
+ *   1) the item being edited, 2) items intersecting the viewport, nearest to its centre first,
+ *   3) off-screen items; ties keep submission order.
+ * A pending job is replaced when the same owner submits another job of the same kind, and is
+ * dropped without running once its cancellation token is set. Replaced and dropped jobs complete
+ * with a null image.
+ *
+ * Raster memory of all items is tracked against one budget (MOUFFETTE_TEXT_RASTER_BUDGET_MB,
+ * default 256). When it is exceeded the least recently painted items are asked to release their
+ * re-computable rasters until the total fits again.
+ *
+ * All methods must be called from the GUI thread; completions are delivered there as well.
+ */
+class TextRasterScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    enum class JobKind {
+        HighRes = 0,
+        Base = 1
+    };
+
+    struct JobHints {
+        QRectF sceneRect;     // item bounds in scene coordinates
+        bool editing = false; // item has keyboard focus for inline editing
+    };
+
+    using Work = std::function<QImage()>;
+    using Completion = std::function<void(QImage)>;
+    // Release what can be recomputed and return the bytes still held
+    using Evictor = std::function<qint64()>;
+    using ViewportProvider = std::function<QRectF()>;
+
+    explicit TextRasterScheduler(QGraphicsScene* scene, QObject* parent = nullptr);
+    ~TextRasterScheduler() override;
+
+    static TextRasterScheduler* forScene(const QGraphicsScene* scene);
+
+    void setViewportProvider(ViewportProvider provider) { m_viewportProvider = std::move(provider); }
+
+    // owner is an identity only; guard expiring marks the owner as destroyed
+    void submit(const void* owner, JobKind kind, const JobHints& hints, Work work,
+                std::shared_ptr<std::atomic<bool>> cancellationToken, Completion completion,
+                std::weak_ptr<bool> guard);
+
+    void reportRasterBytes(const void* owner, qint64 bytes, std::weak_ptr<bool> guard, Evictor evictor);
+    void touch(const void* owner);
+
+    int workerCount() const { return m_pool.maxThreadCount(); }
+    qint64 budgetBytes() const { return m_budgetBytes; }
+    qint64 rasterBytes() const { return m_totalRasterBytes; }
+
+private:
+    struct PendingJob {
+        const void* owner = nullptr;
+        JobKind kind = JobKind::HighRes;
+        JobHints hints;
+        Work work;
+        std::shared_ptr<std::atomic<bool>> cancellationToken;
+        Completion completion;
+        std::weak_ptr<bool> guard;
+        quint64 sequence = 0;
+    };
+
+    struct BudgetEntry {
+        qint64 bytes = 0;
+        quint64 lastUse = 0;
+        std::weak_ptr<bool> guard;
+        Evictor evictor;
+    };
+
+    void pump();
+    void dropCancelledJobs();
+    int takeNextJobIndex(const QRectF& viewport) const;
+    void run(PendingJob job);
+    void complete(const PendingJob& job, QImage image);
+    void enforceBudget(const void* keepOwner);
+    void publishQueueMetrics() const;
+
+    QGraphicsScene* m_scene = nullptr;
+    QThreadPool m_pool;
+    ViewportProvider m_viewportProvider;
+    QVector<PendingJob> m_pending;
+    int m_running = 0;
+    quint64 m_nextSequence = 0;
+
+    QHash<const void*, BudgetEntry> m_budget;
+    qint64 m_budgetBytes = 0;
+    qint64 m_totalRasterBytes = 0;
+    quint64 m_useClock = 0;
+    bool m_enforcingBudget = false;
+};
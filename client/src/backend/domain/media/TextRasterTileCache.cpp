@@ -0,0 +1,184 @@
+// TextRasterTileCache.cpp - Tile slicing, lookup and placeholder drawing for text rasters
+#include "TextRasterTileCache.h"
+#include <QHashFunctions>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+size_t qHash(const TextRasterTileKey& key, size_t seed) {
+    seed = ::qHash(key.level, seed);
+    seed = ::qHash(key.x, seed);
+    return ::qHash(key.y, seed);
+}
+
+int TextRasterTileCache::levelForScale(qreal rasterScale) {
+    const qreal bounded = std::max<qreal>(rasterScale, 1e-4);
+    // Round up so tiles are only ever drawn at or below their native resolution
+    const int level = static_cast<int>(std::ceil(std::log2(bounded) - 1e-6));
+    return std::clamp(level, kMinLevel, kMaxLevel);
+}
+
+qreal TextRasterTileCache::scaleForLevel(int level) {
+    return std::ldexp(1.0, level);
+}
+
+qreal TextRasterTileCache::tileItemSize(int level) {
+    return static_cast<qreal>(kTileSizePx) / scaleForLevel(level);
+}
+
+QRect TextRasterTileCache::tileRangeFor(const QRectF& itemRect, int level) {
+    if (itemRect.isEmpty()) {
+        return QRect();
+    }
+    const qreal size = tileItemSize(level);
+    const int left = static_cast<int>(std::floor(itemRect.left() / size));
+    const int top = static_cast<int>(std::floor(itemRect.top() / size));
+    const int right = static_cast<int>(std::ceil(itemRect.right() / size)) - 1;
+    const int bottom = static_cast<int>(std::ceil(itemRect.bottom() / size)) - 1;
+    return QRect(QPoint(left, top), QPoint(std::max(left, right), std::max(top, bottom)));
+}
+
+QRectF TextRasterTileCache::itemRectForRange(const QRect& range, int level) {
+    const qreal size = tileItemSize(level);
+    return QRectF(range.left() * size, range.top() * size, range.width() * size, range.height() * size);
+}
+
+TextRasterTileCache::TextRasterTileCache(int maxCostKb) {
+    m_tiles.setMaxCost(std::max(1, maxCostKb));
+}
+
+bool TextRasterTileCache::reserveForViewport(int viewportTiles) {
+    const qint64 neededKb = static_cast<qint64>(std::max(0, viewportTiles)) * kTileCostKb * kViewportsRetained;
+    const int boundedKb = static_cast<int>(std::min<qint64>(neededKb, std::numeric_limits<int>::max()));
+    if (boundedKb <= m_tiles.maxCost()) {
+        return false;
+    }
+    m_tiles.setMaxCost(boundedKb);
+    return true;
+}
+
+QRect TextRasterTileCache::missingTiles(const QRect& range, int level) const {
+    QRect missing;
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+        for (int x = range.left(); x <= range.right(); ++x) {
+            if (!m_tiles.contains(TextRasterTileKey{level, x, y})) {
+                missing |= QRect(x, y, 1, 1);
+            }
+        }
+    }
+    return missing;
+}
+
+int TextRasterTileCache::insertFromRaster(const QImage& raster, const QRect& range, int level) {
+    if (raster.isNull() || range.isEmpty()) {
+        return 0;
+    }
+    int inserted = 0;
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+        for (int x = range.left(); x <= range.right(); ++x) {
+            const QRect source = QRect((x - range.left()) * kTileSizePx,
+                                       (y - range.top()) * kTileSizePx,
+                                       kTileSizePx, kTileSizePx).intersected(raster.rect());
+            if (source.isEmpty()) {
+                continue;
+            }
+            auto* tile = new QPixmap(QPixmap::fromImage(raster.copy(source)));
+            const int costKb = std::max(1, (source.width() * source.height() * 4) / 1024);
+            if (m_tiles.insert(TextRasterTileKey{level, x, y}, tile, costKb)) {
+                ++inserted;
+            }
+        }
+    }
+    return inserted;
+}
+
+bool TextRasterTileCache::covers(const QRectF& itemRect, int level) const {
+    if (level == kNoLevel || itemRect.isEmpty()) {
+        return false;
+    }
+    const QRect range = tileRangeFor(itemRect, level);
+    const qreal size = tileItemSize(level);
+    const int coarsest = std::max(kMinLevel, level - kPlaceholderLevels);
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+        for (int x = range.left(); x <= range.right(); ++x) {
+            if (m_tiles.contains(TextRasterTileKey{level, x, y})) {
+                continue;
+            }
+            const QRectF tileRect(x * size, y * size, size, size);
+            bool placeholder = false;
+            for (int coarse = level - 1; coarse >= coarsest && !placeholder; --coarse) {
+                placeholder = m_tiles.contains(placeholderKey(tileRect, coarse));
+            }
+            if (!placeholder) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TextRasterTileKey TextRasterTileCache::placeholderKey(const QRectF& tileRect, int coarseLevel) const {
+    const qreal coarseSize = tileItemSize(coarseLevel);
+    return TextRasterTileKey{coarseLevel,
+                             static_cast<int>(std::floor(tileRect.center().x() / coarseSize)),
+                             static_cast<int>(std::floor(tileRect.center().y() / coarseSize))};
+}
+
+void TextRasterTileCache::paint(QPainter* painter, const QRectF& itemRect, int level) {
+    if (!painter || level == kNoLevel || itemRect.isEmpty()) {
+        return;
+    }
+    const QRect range = tileRangeFor(itemRect, level);
+    const qreal size = tileItemSize(level);
+    const qreal scale = scaleForLevel(level);
+
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    for (int y = range.top(); y <= range.bottom(); ++y) {
+        for (int x = range.left(); x <= range.right(); ++x) {
+            const QPointF origin(x * size, y * size);
+            if (const QPixmap* tile = m_tiles.object(TextRasterTileKey{level, x, y})) {
+                painter->drawPixmap(QRectF(origin, QSizeF(tile->size()) / scale), *tile, QRectF(tile->rect()));
+                continue;
+            }
+            paintPlaceholder(painter, QRectF(origin, QSizeF(size, size)), level);
+        }
+    }
+    painter->restore();
+}
+
+bool TextRasterTileCache::paintPlaceholder(QPainter* painter, const QRectF& tileRect, int level) {
+    const int coarsest = std::max(kMinLevel, level - kPlaceholderLevels);
+    for (int coarse = level - 1; coarse >= coarsest; --coarse) {
+        const qreal coarseSize = tileItemSize(coarse);
+        const TextRasterTileKey key = placeholderKey(tileRect, coarse);
+        const QPixmap* tile = m_tiles.object(key);
+        if (!tile) {
+            continue;
+        }
+        const qreal coarseScale = scaleForLevel(coarse);
+        const QPointF coarseOrigin(key.x * coarseSize, key.y * coarseSize);
+        const QRectF source = QRectF((tileRect.topLeft() - coarseOrigin) * coarseScale,
+                                     tileRect.size() * coarseScale).intersected(QRectF(tile->rect()));
+        if (source.isEmpty()) {
+            continue;
+        }
+        const QRectF target(coarseOrigin + source.topLeft() / coarseScale, source.size() / coarseScale);
+        painter->drawPixmap(target, *tile, source);
+        return true;
+    }
+    return false;
+}
+
+void TextRasterTileCache::setGeneration(quint64 generation) {
+    if (generation == m_generation) {
+        return;
+    }
+    m_tiles.clear();
+    m_generation = generation;
+}
+
+void TextRasterTileCache::clear() {
+    m_tiles.clear();
+}
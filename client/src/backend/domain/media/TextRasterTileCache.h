@@ -0,0 +1,84 @@
+// TextRasterTileCache.h - Zoom-bucketed raster tiles of one text item
+#pragma once
+
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QRectF>
+
+class QPainter;
+
+// Tile address: power-of-two zoom level plus column/row in that level's grid. The grid origin is
+// the item's local origin, so a tile covers kTileSizePx / 2^level item units on each side.
+struct TextRasterTileKey {
+    int level = 0;
+    int x = 0;
+    int y = 0;
+
+    friend bool operator==(const TextRasterTileKey& a, const TextRasterTileKey& b) {
+        return a.level == b.level && a.x == b.x && a.y == b.y;
+    }
+};
+
+size_t qHash(const TextRasterTileKey& key, size_t seed = 0);
+
+/**
+ * @brief TextRasterTileCache - LRU of fixed-size raster tiles for one text item
+ *
+ * Raster scales are bucketed to powers of two (rounded up, so tiles are never upscaled) and each
+ * level is cut into kTileSizePx square tiles. Panning only renders the tiles that scrolled into
+ * view; zooming within a bucket reuses the same tiles scaled down slightly. While sharp tiles are
+ * pending, paint() fills the gaps from cached tiles of coarser levels.
+ *
+ * The LRU budget starts at kDefaultMaxCostKb and grows with reserveForViewport() to hold
+ * kViewportsRetained viewports of full tiles at the current level, so inserting one viewport never
+ * evicts tiles of the same batch. The canvas raster budget still releases the whole cache.
+ *
+ * Tiles belong to one content generation (text, style and base size); setGeneration() drops them
+ * when it changes. GUI thread only.
+ */
+class TextRasterTileCache {
+public:
+    static constexpr int kTileSizePx = 256;
+    static constexpr int kMinLevel = -4;
+    static constexpr int kMaxLevel = 6;
+    static constexpr int kNoLevel = kMinLevel - 1;
+    static constexpr int kPlaceholderLevels = 3;      // coarser levels searched for placeholders
+    static constexpr int kDefaultMaxCostKb = 16384;   // per item floor; see reserveForViewport()
+    static constexpr int kTileCostKb = kTileSizePx * kTileSizePx * 4 / 1024;
+    static constexpr int kViewportsRetained = 2;
+
+    static int levelForScale(qreal rasterScale);
+    static qreal scaleForLevel(int level);
+    static qreal tileItemSize(int level);
+    // Tiles (columns x rows) intersecting an item-local rectangle
+    static QRect tileRangeFor(const QRectF& itemRect, int level);
+    static QRectF itemRectForRange(const QRect& range, int level);
+
+    explicit TextRasterTileCache(int maxCostKb = kDefaultMaxCostKb);
+
+    // Grow the budget to kViewportsRetained x viewportTiles full tiles; returns whether it grew
+    bool reserveForViewport(int viewportTiles);
+    int maxCostKb() const { return static_cast<int>(m_tiles.maxCost()); }
+    // Bounding range of the tiles in 'range' that are not cached (empty when all are present)
+    QRect missingTiles(const QRect& range, int level) const;
+    // Slice a raster rendered for itemRectForRange(range, level) into tiles; returns tiles stored
+    int insertFromRaster(const QImage& raster, const QRect& range, int level);
+    // True when every tile of 'level' covering itemRect is cached, or has a coarser placeholder
+    bool covers(const QRectF& itemRect, int level) const;
+    // Draw the tiles of 'level' covering itemRect, using coarser tiles where sharp ones are missing
+    void paint(QPainter* painter, const QRectF& itemRect, int level);
+
+    void setGeneration(quint64 generation);
+    void clear();
+    bool isEmpty() const { return m_tiles.isEmpty(); }
+    qint64 bytes() const { return static_cast<qint64>(m_tiles.totalCost()) * 1024LL; }
+
+private:
+    bool paintPlaceholder(QPainter* painter, const QRectF& tileRect, int level);
+    TextRasterTileKey placeholderKey(const QRectF& tileRect, int coarseLevel) const;
+
+    QCache<TextRasterTileKey, QPixmap> m_tiles;
+    quint64 m_generation = 0;
+};
@@ -0,0 +1,91 @@
+#include "backend/files/SceneDocument.h"
+#include <QBuffer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QSaveFile>
+#include <QDebug>
+
+namespace SceneDocument {
+
+bool writeToFile(const QJsonObject& document, const QString& filePath, QString* errorMessage) {
+    QJsonObject root = document;
+    root["format"] = kFormatTag;
+    root["version"] = kFormatVersion;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+    const QByteArray bytes = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    if (file.write(bytes) != bytes.size()) {
+        if (errorMessage) *errorMessage = file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QJsonObject readFromFile(const QString& filePath, QString* errorMessage) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return QJsonObject();
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (errorMessage) *errorMessage = QStringLiteral("Invalid canvas document: %1").arg(parseError.errorString());
+        return QJsonObject();
+    }
+
+    const QJsonObject root = doc.object();
+    if (root.value("format").toString() != kFormatTag) {
+        if (errorMessage) *errorMessage = QStringLiteral("Not a Mouffette canvas document");
+        return QJsonObject();
+    }
+    const int version = root.value("version").toInt(0);
+    if (version <= 0 || version > kFormatVersion) {
+        if (errorMessage) *errorMessage = QStringLiteral("Unsupported canvas document version %1").arg(version);
+        return QJsonObject();
+    }
+    return root;
+}
+
+QString encodePoster(const QImage& image, int maxDimension) {
+    if (image.isNull()) {
+        return QString();
+    }
+    QImage scaled = image;
+    if (maxDimension > 0 && (image.width() > maxDimension || image.height() > maxDimension)) {
+        scaled = image.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    // Keep alpha for images that use it; JPEG is far smaller for opaque frames/photos
+    const char* format = scaled.hasAlphaChannel() ? "PNG" : "JPG";
+    if (!scaled.save(&buffer, format, 80)) {
+        qWarning() << "SceneDocument: failed to encode poster";
+        return QString();
+    }
+    return QString::fromLatin1(bytes.toBase64());
+}
+
+QImage decodePoster(const QString& encoded) {
+    if (encoded.isEmpty()) {
+        return QImage();
+    }
+    QImage image;
+    image.loadFromData(QByteArray::fromBase64(encoded.toLatin1()));
+    return image;
+}
+
+} // namespace SceneDocument
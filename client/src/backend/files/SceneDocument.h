@@ -0,0 +1,38 @@
+#ifndef SCENEDOCUMENT_H
+#define SCENEDOCUMENT_H
+
+#include <QString>
+#include <QJsonObject>
+#include <QImage>
+
+/**
+ * SceneDocument
+ *
+ * Persistent canvas document ("show file") I/O.
+ * The document itself is assembled by ScreenCanvas (screens + media keyed by mediaId,
+ * file table keyed by fileId); this module owns the container format only.
+ *
+ * Responsibilities:
+ * - Validate format tag and version on read
+ * - Atomic write (QSaveFile) of the compact JSON container
+ * - Encode/decode the small cached posters that let items appear before heavy
+ *   resources (full-res pixmaps, media players) are hydrated
+ */
+namespace SceneDocument {
+    inline constexpr int kFormatVersion = 1;
+    inline constexpr int kPosterMaxDimension = 256;
+    inline const QString kFormatTag = QStringLiteral("mouffette-canvas");
+    inline const QString kFileSuffix = QStringLiteral("mouffette");
+
+    // Write document to disk; returns false and fills errorMessage on failure
+    bool writeToFile(const QJsonObject& document, const QString& filePath, QString* errorMessage = nullptr);
+
+    // Read and validate a document; returns an empty object and fills errorMessage on failure
+    QJsonObject readFromFile(const QString& filePath, QString* errorMessage = nullptr);
+
+    // Downscale + JPEG/PNG encode a poster (base64) for the file table; empty string if image is null
+    QString encodePoster(const QImage& image, int maxDimension = kPosterMaxDimension);
+    QImage decodePoster(const QString& encoded);
+}
+
+#endif // SCENEDOCUMENT_H
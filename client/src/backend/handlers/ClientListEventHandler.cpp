@@ -7,6 +7,7 @@
 #include "frontend/rendering/navigation/ScreenNavigationManager.h"
 #include "backend/network/UploadManager.h"
 #include "backend/network/WatchManager.h"
+#include "backend/managers/network/ClientListBuilder.h"
 #include "frontend/ui/pages/ClientListPage.h"
 #include <QDebug>
 #include <optional>
@@ -23,6 +24,7 @@ void ClientListEventHandler::setupConnections(WebSocketClient* client)
     if (!client) return;
     
     connect(client, &WebSocketClient::clientListReceived, this, &ClientListEventHandler::onClientListReceived);
+    connect(client, &WebSocketClient::clientDirectoryChanged, this, &ClientListEventHandler::onClientDirectoryChanged);
 }
 
 void ClientListEventHandler::onClientListReceived(const QList<ClientInfo>& clients)
@@ -46,6 +48,61 @@ void ClientListEventHandler::onClientListReceived(const QList<ClientInfo>& clien
         clientListPage->updateClientList(displayList);
     }
 
+    // Show notification if new connected clients appeared
+    if (clients.size() > previousConnectedCount && previousConnectedCount >= 0) {
+        int newClients = clients.size() - previousConnectedCount;
+        if (newClients > 0) {
+            QString message = QString("%1 new client%2 available for sharing")
+                .arg(newClients)
+                .arg(newClients == 1 ? "" : "s");
+            qDebug() << "New clients available:" << message;
+        }
+    }
+
+    reconcileActiveSession(clients);
+}
+
+void ClientListEventHandler::onClientDirectoryChanged(ClientDirectory::ChangeKind kind, const ClientInfo& client)
+{
+    const QList<ClientInfo> clients = m_webSocketClient ? m_webSocketClient->connectedClients() : QList<ClientInfo>();
+    qDebug() << "Client directory change" << static_cast<int>(kind) << client.getId() << "now" << clients.size() << "clients";
+
+    ClientListPage* clientListPage = m_mainWindow->getClientListPage();
+    if (kind == ClientDirectory::ChangeKind::Left) {
+        // Clients we have a canvas session with stay listed as offline
+        if (std::optional<ClientInfo> offline = ClientListBuilder::applyDisconnectedClient(m_mainWindow, client)) {
+            if (clientListPage) clientListPage->upsertClient(*offline);
+        } else if (clientListPage) {
+            clientListPage->removeClient(client.clientId());
+        }
+    } else {
+        ScreenCanvas* screenCanvas = m_mainWindow->getScreenCanvas();
+        if (screenCanvas) {
+            screenCanvas->updateRemoteSceneTargetFromClientList({client});
+        }
+        if (std::optional<ClientInfo> display = ClientListBuilder::applyConnectedClient(m_mainWindow, client)) {
+            if (clientListPage) clientListPage->upsertClient(*display);
+        }
+    }
+    m_mainWindow->setLastConnectedClientCount(clients.size());
+
+    // The reconnect / disconnect handling below only concerns the active session's machine
+    const QString activeSessionIdentity = m_mainWindow->getActiveSessionIdentity();
+    if (activeSessionIdentity.isEmpty()) return;
+    const MainWindow::CanvasSession* activeSession = m_mainWindow->findCanvasSession(activeSessionIdentity);
+    if (!activeSession) return;
+    const bool concernsActiveSession =
+        client.getId() == activeSession->serverAssignedId ||
+        (!client.clientId().isEmpty() && client.clientId() == activeSession->persistentClientId) ||
+        (kind != ClientDirectory::ChangeKind::Left &&
+         client.getMachineName().compare(activeSession->lastClientInfo.getMachineName(), Qt::CaseInsensitive) == 0);
+    if (concernsActiveSession) {
+        reconcileActiveSession(clients);
+    }
+}
+
+void ClientListEventHandler::reconcileActiveSession(const QList<ClientInfo>& clients)
+{
     QString activeSessionIdentity = m_mainWindow->getActiveSessionIdentity();
     if (!activeSessionIdentity.isEmpty()) {
         MainWindow::CanvasSession* activeSession = m_mainWindow->findCanvasSession(activeSessionIdentity);
@@ -57,16 +114,6 @@ void ClientListEventHandler::onClientListReceived(const QList<ClientInfo>& clien
         }
     }
 
-    // Show notification if new connected clients appeared
-    if (clients.size() > previousConnectedCount && previousConnectedCount >= 0) {
-        int newClients = clients.size() - previousConnectedCount;
-        if (newClients > 0) {
-            QString message = QString("%1 new client%2 available for sharing")
-                .arg(newClients)
-                .arg(newClients == 1 ? "" : "s");
-            qDebug() << "New clients available:" << message;
-        }
-    }
 
     // Update remote status and canvas behavior if we're on screen view:
     // Handle remote reconnect where the server assigns a NEW clientId.
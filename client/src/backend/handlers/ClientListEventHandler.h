@@ -4,10 +4,10 @@
 #include <QObject>
 #include <QList>
 #include <QString>
+#include "backend/network/ClientDirectory.h"
 
 class MainWindow;
 class WebSocketClient;
-class ClientInfo;
 
 /**
  * @brief Handler for client list events and connection state management
@@ -37,7 +37,18 @@ public slots:
      */
     void onClientListReceived(const QList<ClientInfo>& clients);
 
+    /**
+     * @brief Applies one client directory delta (joined/updated/left)
+     *
+     * Updates only the affected canvas session and list row; the reconnect handling
+     * runs only when the change concerns the active session's machine
+     */
+    void onClientDirectoryChanged(ClientDirectory::ChangeKind kind, const ClientInfo& client);
+
 private:
+    // Re-targets or disconnects the active canvas session against the current connected clients
+    void reconcileActiveSession(const QList<ClientInfo>& clients);
+
     MainWindow* m_mainWindow;
     WebSocketClient* m_webSocketClient;
 };
@@ -2,6 +2,7 @@
 #include "MainWindow.h"
 #include "frontend/managers/ui/RemoteClientState.h"
 #include "backend/network/WebSocketClient.h"
+#include "backend/network/ClientStateSync.h"
 #include "backend/managers/system/SystemMonitor.h"
 #include "frontend/rendering/canvas/ScreenCanvas.h"
 #include "frontend/ui/pages/CanvasViewPage.h"
@@ -67,6 +68,104 @@ static BOOL CALLBACK ScreenEventEnumMonProc(HMONITOR hMon, HDC, LPRECT, LPARAM l
 } // namespace
 #endif
 
+namespace {
+
+// Per-screen uiZones (taskbar/menu/dock) derived from the work area of each monitor
+void appendSystemUiZones(QList<ScreenInfo>& screens) {
+#if defined(Q_OS_WIN)
+    // Build a list of physical monitors (rcMonitor/rcWork) to align with ScreenInfo (physical px)
+    MonitorEnumContext ctx;
+    EnumDisplayMonitors(nullptr, nullptr, ScreenEventEnumMonProc, reinterpret_cast<LPARAM>(&ctx));
+    
+    auto findMatchingMon = [&](const ScreenInfo& s) -> const WinMonRect* {
+        for (size_t idx = 0; idx < ctx.count; ++idx) {
+            const auto &m = ctx.monitors[idx];
+            const int mw = m.rc.right - m.rc.left;
+            const int mh = m.rc.bottom - m.rc.top;
+            if (m.rc.left == s.x && m.rc.top == s.y && mw == s.width && mh == s.height) {
+                return &m;
+            }
+        }
+        return nullptr;
+    };
+    
+    for (auto &screen : screens) {
+        const WinMonRect* mp = findMatchingMon(screen);
+        if (!mp) continue;
+        const auto &m = *mp;
+        const int screenW = m.rc.right - m.rc.left;
+        const int screenH = m.rc.bottom - m.rc.top;
+        const int workW = m.rcWork.right - m.rcWork.left;
+        const int workH = m.rcWork.bottom - m.rcWork.top;
+        
+        // Compute taskbar thickness and side by comparing rcMonitor and rcWork
+        if (workH < screenH) {
+            const int h = screenH - workH; 
+            if (h > 0) {
+                if (m.rcWork.top > m.rc.top) {
+                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), 0, 0, screenW, h});
+                } else {
+                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), 0, screenH - h, screenW, h});
+                }
+            }
+        } else if (workW < screenW) {
+            const int w = screenW - workW; 
+            if (w > 0) {
+                if (m.rcWork.left > m.rc.left) {
+                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), 0, 0, w, screenH});
+                } else {
+                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), screenW - w, 0, w, screenH});
+                }
+            }
+        }
+    }
+#elif defined(Q_OS_MACOS)
+    QList<QScreen*> qScreens = QGuiApplication::screens();
+    for (auto &screen : screens) {
+        if (screen.id < 0 || screen.id >= qScreens.size()) continue;
+        QScreen* qs = qScreens[screen.id]; 
+        if (!qs) continue;
+        
+        const qreal dpr = std::max<qreal>(1.0, qs->devicePixelRatio());
+        QRect geom = qs->geometry();
+        QRect avail = qs->availableGeometry();
+
+        const int geomWidthPx = static_cast<int>(std::lround(static_cast<qreal>(geom.width()) * dpr));
+        const int geomHeightPx = static_cast<int>(std::lround(static_cast<qreal>(geom.height()) * dpr));
+        
+        // Menu bar
+        if (avail.y() > geom.y()) {
+            int h = static_cast<int>(std::lround(static_cast<qreal>(avail.y() - geom.y()) * dpr)); 
+            if (h > 0) {
+                screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("menu_bar"), 0, 0, geomWidthPx, h});
+            }
+        }
+        
+        // Dock: one differing edge
+        if (avail.bottom() < geom.bottom()) { // bottom dock
+            int h = static_cast<int>(std::lround(static_cast<qreal>(geom.bottom() - avail.bottom()) * dpr)); 
+            if (h > 0) {
+                screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("dock"), 0, geomHeightPx - h, geomWidthPx, h});
+            }
+        } else if (avail.x() > geom.x()) { // left dock
+            int w = static_cast<int>(std::lround(static_cast<qreal>(avail.x() - geom.x()) * dpr)); 
+            if (w > 0) {
+                screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("dock"), 0, 0, w, geomHeightPx});
+            }
+        } else if (avail.right() < geom.right()) { // right dock
+            int w = static_cast<int>(std::lround(static_cast<qreal>(geom.right() - avail.right()) * dpr)); 
+            if (w > 0) {
+                screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("dock"), geomWidthPx - w, 0, w, geomHeightPx});
+            }
+        }
+    }
+#else
+    Q_UNUSED(screens);
+#endif
+}
+
+} // namespace
+
 ScreenEventHandler::ScreenEventHandler(MainWindow* mainWindow, QObject* parent)
     : QObject(parent)
     , m_mainWindow(mainWindow)
@@ -86,6 +185,8 @@ void ScreenEventHandler::setupConnections(WebSocketClient* client)
     // Connect to screen-related signals
     connect(client, &WebSocketClient::screensInfoReceived, this, &ScreenEventHandler::onScreensInfoReceived);
     connect(client, &WebSocketClient::dataRequestReceived, this, &ScreenEventHandler::onDataRequestReceived);
+    connect(client, &WebSocketClient::remoteStateDeltaReceived, this, &ScreenEventHandler::onRemoteStateDelta);
+    connect(client, &WebSocketClient::remoteStateHashReceived, this, &ScreenEventHandler::onRemoteStateHash);
 
     qDebug() << "ScreenEventHandler: Connections established";
 }
@@ -101,106 +202,19 @@ void ScreenEventHandler::syncRegistration()
 
     // Only include screens/volume when actively watched; otherwise identity-only
     if (m_mainWindow->isWatched()) {
-        screens = m_mainWindow->getLocalScreenInfo();
+        screens = collectLocalScreens();
         volumePercent = m_mainWindow->getSystemVolumePercent();
     }
-
-    // Build per-screen uiZones (taskbar/menu/dock)
-    if (!screens.isEmpty()) {
-#if defined(Q_OS_WIN)
-        // Build a list of physical monitors (rcMonitor/rcWork) to align with ScreenInfo (physical px)
-        MonitorEnumContext ctx;
-        EnumDisplayMonitors(nullptr, nullptr, ScreenEventEnumMonProc, reinterpret_cast<LPARAM>(&ctx));
-        
-        auto findMatchingMon = [&](const ScreenInfo& s) -> const WinMonRect* {
-            for (size_t idx = 0; idx < ctx.count; ++idx) {
-                const auto &m = ctx.monitors[idx];
-                const int mw = m.rc.right - m.rc.left;
-                const int mh = m.rc.bottom - m.rc.top;
-                if (m.rc.left == s.x && m.rc.top == s.y && mw == s.width && mh == s.height) {
-                    return &m;
-                }
-            }
-            return nullptr;
-        };
-        
-        for (auto &screen : screens) {
-            const WinMonRect* mp = findMatchingMon(screen);
-            if (!mp) continue;
-            const auto &m = *mp;
-            const int screenW = m.rc.right - m.rc.left;
-            const int screenH = m.rc.bottom - m.rc.top;
-            const int workW = m.rcWork.right - m.rcWork.left;
-            const int workH = m.rcWork.bottom - m.rcWork.top;
-            
-            // Compute taskbar thickness and side by comparing rcMonitor and rcWork
-            if (workH < screenH) {
-                const int h = screenH - workH; 
-                if (h > 0) {
-                    if (m.rcWork.top > m.rc.top) {
-                        screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), 0, 0, screenW, h});
-                    } else {
-                        screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), 0, screenH - h, screenW, h});
-                    }
-                }
-            } else if (workW < screenW) {
-                const int w = screenW - workW; 
-                if (w > 0) {
-                    if (m.rcWork.left > m.rc.left) {
-                        screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), 0, 0, w, screenH});
-                    } else {
-                        screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("taskbar"), screenW - w, 0, w, screenH});
-                    }
-                }
-            }
-        }
-#elif defined(Q_OS_MACOS)
-        QList<QScreen*> qScreens = QGuiApplication::screens();
-        for (auto &screen : screens) {
-            if (screen.id < 0 || screen.id >= qScreens.size()) continue;
-            QScreen* qs = qScreens[screen.id]; 
-            if (!qs) continue;
-            
-            const qreal dpr = std::max<qreal>(1.0, qs->devicePixelRatio());
-            QRect geom = qs->geometry();
-            QRect avail = qs->availableGeometry();
-
-            const int geomWidthPx = static_cast<int>(std::lround(static_cast<qreal>(geom.width()) * dpr));
-            const int geomHeightPx = static_cast<int>(std::lround(static_cast<qreal>(geom.height()) * dpr));
-            
-            // Menu bar
-            if (avail.y() > geom.y()) {
-                int h = static_cast<int>(std::lround(static_cast<qreal>(avail.y() - geom.y()) * dpr)); 
-                if (h > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("menu_bar"), 0, 0, geomWidthPx, h});
-                }
-            }
-            
-            // Dock: one differing edge
-            if (avail.bottom() < geom.bottom()) { // bottom dock
-                int h = static_cast<int>(std::lround(static_cast<qreal>(geom.bottom() - avail.bottom()) * dpr)); 
-                if (h > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("dock"), 0, geomHeightPx - h, geomWidthPx, h});
-                }
-            } else if (avail.x() > geom.x()) { // left dock
-                int w = static_cast<int>(std::lround(static_cast<qreal>(avail.x() - geom.x()) * dpr)); 
-                if (w > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("dock"), 0, 0, w, geomHeightPx});
-                }
-            } else if (avail.right() < geom.right()) { // right dock
-                int w = static_cast<int>(std::lround(static_cast<qreal>(geom.right() - avail.right()) * dpr)); 
-                if (w > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{QStringLiteral("dock"), geomWidthPx - w, 0, w, geomHeightPx});
-                }
-            }
-        }
-#endif
-    }
     
     qDebug() << "ScreenEventHandler: Sync registration:" << machineName << "on" << platform 
              << "with" << screens.size() << "screens";
     
     m_webSocketClient->registerClient(machineName, platform, screens, volumePercent);
+    if (!screens.isEmpty() && m_webSocketClient->isConnected()) {
+        rememberPublishedState(screens, volumePercent);
+    } else {
+        m_publishedHash.clear();
+    }
 }
 
 void ScreenEventHandler::onScreensInfoReceived(const ClientInfo& clientInfo)
@@ -310,98 +324,100 @@ void ScreenEventHandler::onDataRequestReceived()
     }
 
     // Target-side: server asked us to send fresh state now (screens + volume)
+    const QList<ScreenInfo> screens = collectLocalScreens();
+    const int volumePercent = m_mainWindow->getSystemVolumePercent();
+
+    m_webSocketClient->sendStateSnapshot(screens, volumePercent);
+    rememberPublishedState(screens, volumePercent);
+}
+
+QList<ScreenInfo> ScreenEventHandler::collectLocalScreens() const
+{
     QList<ScreenInfo> screens = m_mainWindow->getLocalScreenInfo();
-    int volumePercent = m_mainWindow->getSystemVolumePercent();
+    appendSystemUiZones(screens);
+    return screens;
+}
 
-    // Build uiZones immediately for snapshot
-#if defined(Q_OS_WIN)
-    {
-        MonitorEnumContext ctx;
-        EnumDisplayMonitors(nullptr, nullptr, ScreenEventEnumMonProc, reinterpret_cast<LPARAM>(&ctx));
-        
-        auto findMatchingMon = [&](const ScreenInfo& s) -> const WinMonRect* {
-            for (size_t idx = 0; idx < ctx.count; ++idx) {
-                const auto &m = ctx.monitors[idx];
-                const int mw = m.rc.right - m.rc.left;
-                const int mh = m.rc.bottom - m.rc.top;
-                if (m.rc.left == s.x && m.rc.top == s.y && mw == s.width && mh == s.height) {
-                    return &m;
-                }
-            }
-            return nullptr;
-        };
-        
-        for (auto &screen : screens) {
-            const WinMonRect* mp = findMatchingMon(screen);
-            if (!mp) continue;
-            const auto &m = *mp;
-            const int screenW = m.rc.right - m.rc.left;
-            const int screenH = m.rc.bottom - m.rc.top;
-            const int workW = m.rcWork.right - m.rcWork.left;
-            const int workH = m.rcWork.bottom - m.rcWork.top;
-            
-            if (workH < screenH) {
-                const int h = screenH - workH; 
-                if (h > 0) {
-                    if (m.rcWork.top > m.rc.top) {
-                        screen.uiZones.append(ScreenInfo::UIZone{"taskbar", 0, 0, screenW, h});
-                    } else {
-                        screen.uiZones.append(ScreenInfo::UIZone{"taskbar", 0, screenH - h, screenW, h});
-                    }
-                }
-            } else if (workW < screenW) {
-                const int w = screenW - workW; 
-                if (w > 0) {
-                    if (m.rcWork.left > m.rc.left) {
-                        screen.uiZones.append(ScreenInfo::UIZone{"taskbar", 0, 0, w, screenH});
-                    } else {
-                        screen.uiZones.append(ScreenInfo::UIZone{"taskbar", screenW - w, 0, w, screenH});
-                    }
-                }
-            }
-        }
+void ScreenEventHandler::rememberPublishedState(const QList<ScreenInfo>& screens, int volumePercent)
+{
+    m_publishedScreens = screens;
+    m_publishedVolume = volumePercent;
+    m_publishedHash = ClientStateSync::stateHash(screens, volumePercent);
+}
+
+void ScreenEventHandler::publishStateIfChanged()
+{
+    if (!m_mainWindow || !m_webSocketClient || !m_webSocketClient->isConnected()) {
+        return;
     }
-#elif defined(Q_OS_MACOS)
-    {
-        QList<QScreen*> qScreens = QGuiApplication::screens();
-        for (auto &screen : screens) {
-            if (screen.id < 0 || screen.id >= qScreens.size()) continue; 
-            QScreen* qs = qScreens[screen.id]; 
-            if (!qs) continue;
-            
-            const qreal dpr = std::max<qreal>(1.0, qs->devicePixelRatio());
-            QRect geom = qs->geometry(); 
-            QRect avail = qs->availableGeometry();
-
-            const int geomWidthPx = static_cast<int>(std::lround(static_cast<qreal>(geom.width()) * dpr));
-            const int geomHeightPx = static_cast<int>(std::lround(static_cast<qreal>(geom.height()) * dpr));
-            
-            if (avail.y() > geom.y()) { 
-                int h = static_cast<int>(std::lround(static_cast<qreal>(avail.y() - geom.y()) * dpr)); 
-                if (h > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{"menu_bar", 0, 0, geomWidthPx, h}); 
-                }
-            }
-            
-            if (avail.bottom() < geom.bottom()) { 
-                int h = static_cast<int>(std::lround(static_cast<qreal>(geom.bottom() - avail.bottom()) * dpr)); 
-                if (h > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{"dock", 0, geomHeightPx - h, geomWidthPx, h}); 
-                }
-            } else if (avail.x() > geom.x()) { 
-                int w = static_cast<int>(std::lround(static_cast<qreal>(avail.x() - geom.x()) * dpr)); 
-                if (w > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{"dock", 0, 0, w, geomHeightPx}); 
-                }
-            } else if (avail.right() < geom.right()) { 
-                int w = static_cast<int>(std::lround(static_cast<qreal>(geom.right() - avail.right()) * dpr)); 
-                if (w > 0) {
-                    screen.uiZones.append(ScreenInfo::UIZone{"dock", geomWidthPx - w, 0, w, geomHeightPx}); 
-                }
-            }
-        }
+    if (!m_mainWindow->isWatched()) {
+        // The next watch starts from a full snapshot (data_request)
+        m_publishedHash.clear();
+        return;
     }
-#endif
 
-    m_webSocketClient->sendStateSnapshot(screens, volumePercent);
+    const QList<ScreenInfo> screens = collectLocalScreens();
+    const int volumePercent = m_mainWindow->getSystemVolumePercent();
+    const QString hash = ClientStateSync::stateHash(screens, volumePercent);
+    if (hash == m_publishedHash) {
+        return;
+    }
+    if (m_publishedHash.isEmpty()) {
+        m_webSocketClient->sendStateSnapshot(screens, volumePercent);
+    } else {
+        const QJsonObject delta = ClientStateSync::diff(m_publishedScreens, m_publishedVolume, screens, volumePercent);
+        m_webSocketClient->sendStateDelta(delta, m_publishedHash, hash);
+    }
+    rememberPublishedState(screens, volumePercent);
+}
+
+void ScreenEventHandler::sendStateHeartbeat()
+{
+    publishStateIfChanged();
+    if (m_webSocketClient && !m_publishedHash.isEmpty()) {
+        m_webSocketClient->sendStateHash(m_publishedHash);
+    }
+}
+
+void ScreenEventHandler::onRemoteStateDelta(const QString& targetClientId, const QJsonObject& delta)
+{
+    if (!m_mainWindow) return;
+    MainWindow::CanvasSession* session = m_mainWindow->findCanvasSessionByServerClientId(targetClientId);
+    if (!session) return;
+
+    QList<ScreenInfo> screens = session->lastClientInfo.getScreens();
+    int volumePercent = session->lastClientInfo.getVolumePercent();
+    if (ClientStateSync::stateHash(screens, volumePercent) != delta.value("baseHash").toString()) {
+        requestStateResync(targetClientId, "delta base mismatch");
+        return;
+    }
+    ClientStateSync::apply(delta, &screens, &volumePercent);
+    if (ClientStateSync::stateHash(screens, volumePercent) != delta.value("hash").toString()) {
+        requestStateResync(targetClientId, "delta result mismatch");
+        return;
+    }
+
+    ClientInfo updated = session->lastClientInfo;
+    updated.setScreens(screens);
+    updated.setVolumePercent(volumePercent);
+    onScreensInfoReceived(updated);
+}
+
+void ScreenEventHandler::onRemoteStateHash(const QString& targetClientId, const QString& hash)
+{
+    if (!m_mainWindow) return;
+    const MainWindow::CanvasSession* session = m_mainWindow->findCanvasSessionByServerClientId(targetClientId);
+    if (!session) return;
+    const ClientInfo& info = session->lastClientInfo;
+    if (ClientStateSync::stateHash(info.getScreens(), info.getVolumePercent()) != hash) {
+        requestStateResync(targetClientId, "heartbeat mismatch");
+    }
+}
+
+void ScreenEventHandler::requestStateResync(const QString& targetClientId, const char* reason)
+{
+    qDebug() << "ScreenEventHandler: State of" << targetClientId << "diverged (" << reason << ") - requesting screens";
+    if (m_webSocketClient) {
+        m_webSocketClient->requestScreens(targetClientId);
+    }
 }
@@ -1,6 +1,7 @@
 #ifndef SCREENEVENTHANDLER_H
 #define SCREENEVENTHANDLER_H
 
+#include <QJsonObject>
 #include <QObject>
 #include "backend/domain/models/ClientInfo.h"
 
@@ -16,6 +17,7 @@ class SystemMonitor;
  * - Process incoming screen information from remote clients
  * - Handle data request events from server
  * - Coordinate screen info collection with SystemMonitor
+ * - Publish screen/volume changes as hashed deltas while watched (see ClientStateSync)
  * 
  * This handler extracts screen event processing logic from MainWindow
  */
@@ -52,9 +54,40 @@ public slots:
      */
     void onDataRequestReceived();
 
+    /**
+     * @brief Send watchers a state_delta if screens or volume changed since the last publish
+     * Driven by SystemMonitor change signals; no-op when not watched or when the hash is unchanged
+     */
+    void publishStateIfChanged();
+
+    /**
+     * @brief Periodic heartbeat while watched
+     * Catches changes no signal reported, then sends only the current state hash
+     */
+    void sendStateHeartbeat();
+
+    /**
+     * @brief Watcher side: apply a target's state_delta, or resync if it does not fit
+     */
+    void onRemoteStateDelta(const QString& targetClientId, const QJsonObject& delta);
+
+    /**
+     * @brief Watcher side: compare a target's heartbeat hash with the local copy
+     */
+    void onRemoteStateHash(const QString& targetClientId, const QString& hash);
+
 private:
+    QList<ScreenInfo> collectLocalScreens() const;
+    void rememberPublishedState(const QList<ScreenInfo>& screens, int volumePercent);
+    void requestStateResync(const QString& targetClientId, const char* reason);
+
     MainWindow* m_mainWindow = nullptr;
     WebSocketClient* m_webSocketClient = nullptr;
+
+    // Target side: last state sent to watchers; hash is empty until a full snapshot went out
+    QList<ScreenInfo> m_publishedScreens;
+    int m_publishedVolume = -1;
+    QString m_publishedHash;
 };
 
 #endif // SCREENEVENTHANDLER_H
@@ -26,6 +26,18 @@ void MenuBarManager::setup()
 
     // Create File menu
     m_fileMenu = menuBar->addMenu("File");
+
+    // Canvas document actions
+    m_openCanvasAction = new QAction("Open Canvas...", this);
+    m_openCanvasAction->setShortcut(QKeySequence::Open);
+    connect(m_openCanvasAction, &QAction::triggered, this, &MenuBarManager::openCanvasRequested);
+    m_fileMenu->addAction(m_openCanvasAction);
+
+    m_saveCanvasAction = new QAction("Save Canvas...", this);
+    m_saveCanvasAction->setShortcut(QKeySequence::Save);
+    connect(m_saveCanvasAction, &QAction::triggered, this, &MenuBarManager::saveCanvasRequested);
+    m_fileMenu->addAction(m_saveCanvasAction);
+    m_fileMenu->addSeparator();
     
     // Create Quit action with standard keyboard shortcut
     m_exitAction = new QAction("Quit Mouffette", this);
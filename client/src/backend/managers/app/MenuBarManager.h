@@ -12,7 +12,7 @@ class QMainWindow;
  * @brief MenuBarManager handles the creation and management of the application's menu bar
  * 
  * Responsibilities:
- * - Create and configure File menu with Quit action
+ * - Create and configure File menu with Open/Save Canvas and Quit actions
  * - Create and configure Help menu with About action
  * - Manage menu bar lifecycle
  * 
@@ -67,12 +67,24 @@ signals:
      */
     void aboutRequested();
 
+    /**
+     * @brief Signal emitted when the user triggers the Open Canvas action
+     */
+    void openCanvasRequested();
+
+    /**
+     * @brief Signal emitted when the user triggers the Save Canvas action
+     */
+    void saveCanvasRequested();
+
 private:
     QMainWindow* m_mainWindow = nullptr;
     QMenu* m_fileMenu = nullptr;
     QMenu* m_helpMenu = nullptr;
     QAction* m_exitAction = nullptr;
     QAction* m_aboutAction = nullptr;
+    QAction* m_openCanvasAction = nullptr;
+    QAction* m_saveCanvasAction = nullptr;
 };
 
 #endif // MENUBARMANAGER_H
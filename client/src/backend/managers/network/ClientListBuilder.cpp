@@ -18,40 +18,13 @@ QList<ClientInfo> ClientListBuilder::buildDisplayClientList(
     QSet<QString> identitiesSeen;
 
     // Process connected clients and update their sessions
-    for (ClientInfo client : connectedClients) {
-        QString persistentId = client.clientId();
-        if (persistentId.isEmpty()) {
-            qWarning() << "ClientListBuilder::buildDisplayClientList: client has no persistentClientId";
+    for (const ClientInfo& client : connectedClients) {
+        std::optional<ClientInfo> display = applyConnectedClient(mainWindow, client);
+        if (!display) {
             continue;
         }
-        client.setClientId(persistentId);
-        client.setOnline(true);
-
-        // Find existing session for this client
-        if (MainWindow::CanvasSession* session = mainWindow->findCanvasSession(persistentId)) {
-            session->serverAssignedId = client.getId(); // Keep for local lookup
-            session->lastClientInfo = client;
-            session->lastClientInfo.setClientId(persistentId);
-            session->lastClientInfo.setFromMemory(true);
-            session->lastClientInfo.setOnline(true);
-            session->remoteContentClearedOnDisconnect = false;
-            
-            // Update remote scene target if canvas exists
-            if (session->canvas && !session->persistentClientId.isEmpty()) {
-                session->canvas->setRemoteSceneTarget(
-                    session->persistentClientId,
-                    session->lastClientInfo.getMachineName()
-                );
-            }
-            
-            client.setFromMemory(true);
-            client.setId(session->serverAssignedId);
-        } else {
-            client.setFromMemory(false);
-        }
-
-        identitiesSeen.insert(persistentId);
-        result.append(client);
+        identitiesSeen.insert(display->clientId());
+        result.append(*display);
     }
 
     // Add offline clients from session history
@@ -74,3 +47,61 @@ QList<ClientInfo> ClientListBuilder::buildDisplayClientList(
 
     return result;
 }
+
+std::optional<ClientInfo> ClientListBuilder::applyConnectedClient(MainWindow* mainWindow, ClientInfo client)
+{
+    if (!mainWindow) return std::nullopt;
+
+    QString persistentId = client.clientId();
+    if (persistentId.isEmpty()) {
+        qWarning() << "ClientListBuilder::applyConnectedClient: client has no persistentClientId";
+        return std::nullopt;
+    }
+    client.setClientId(persistentId);
+    client.setOnline(true);
+
+    // Find existing session for this client
+    if (MainWindow::CanvasSession* session = mainWindow->findCanvasSession(persistentId)) {
+        session->serverAssignedId = client.getId(); // Keep for local lookup
+        session->lastClientInfo = client;
+        session->lastClientInfo.setClientId(persistentId);
+        session->lastClientInfo.setFromMemory(true);
+        session->lastClientInfo.setOnline(true);
+        session->remoteContentClearedOnDisconnect = false;
+        
+        // Update remote scene target if canvas exists
+        if (session->canvas && !session->persistentClientId.isEmpty()) {
+            session->canvas->setRemoteSceneTarget(
+                session->persistentClientId,
+                session->lastClientInfo.getMachineName()
+            );
+        }
+        
+        client.setFromMemory(true);
+        client.setId(session->serverAssignedId);
+    } else {
+        client.setFromMemory(false);
+    }
+    return client;
+}
+
+std::optional<ClientInfo> ClientListBuilder::applyDisconnectedClient(MainWindow* mainWindow, const ClientInfo& client)
+{
+    if (!mainWindow) return std::nullopt;
+
+    MainWindow::CanvasSession* session = client.clientId().isEmpty()
+        ? mainWindow->findCanvasSessionByServerClientId(client.getId())
+        : mainWindow->findCanvasSession(client.clientId());
+    if (!session) {
+        return std::nullopt;
+    }
+    session->lastClientInfo.setClientId(session->persistentClientId);
+    session->lastClientInfo.setFromMemory(true);
+    session->lastClientInfo.setOnline(false);
+
+    ClientInfo info = session->lastClientInfo;
+    if (!session->serverAssignedId.isEmpty()) {
+        info.setId(session->serverAssignedId);
+    }
+    return info;
+}
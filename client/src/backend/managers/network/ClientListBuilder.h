@@ -4,6 +4,7 @@
 #include <QList>
 #include <QSet>
 #include <QString>
+#include <optional>
 #include "backend/domain/models/ClientInfo.h"
 
 class MainWindow;
@@ -35,6 +36,18 @@ public:
         MainWindow* mainWindow,
         const QList<ClientInfo>& connectedClients
     );
+
+    /**
+     * @brief Apply one connected client (directory join/update) to its canvas session
+     * @return The entry to display, or nullopt if the client has no persistentClientId
+     */
+    static std::optional<ClientInfo> applyConnectedClient(MainWindow* mainWindow, ClientInfo client);
+
+    /**
+     * @brief Mark the session of a client that left the directory offline
+     * @return The offline entry to keep displaying, or nullopt if no session remembers the client
+     */
+    static std::optional<ClientInfo> applyDisconnectedClient(MainWindow* mainWindow, const ClientInfo& client);
 };
 
 #endif // CLIENTLISTBUILDER_H
@@ -0,0 +1,272 @@
+#include "backend/managers/system/MetricsRegistry.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+
+namespace Metrics {
+
+namespace {
+
+bool envFlagEnabled(const char* name) {
+    const QByteArray lowered = qgetenv(name).trimmed().toLower();
+    return lowered == "1" || lowered == "true" || lowered == "yes" || lowered == "on";
+}
+
+// Each thread picks a shard once; up to kShardCount threads accumulate without sharing a line.
+int currentShard() {
+    static std::atomic<int> nextShard{0};
+    thread_local const int shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    return shard;
+}
+
+int bucketForValue(double valueMs) {
+    for (int i = 0; i < kHistogramBucketCount - 1; ++i) {
+        if (valueMs <= Histogram::bucketUpperBoundMs(i)) {
+            return i;
+        }
+    }
+    return kHistogramBucketCount - 1;
+}
+
+struct Registry {
+    QMutex mutex;
+    // std::map keeps snapshot output sorted and unique_ptr keeps addresses stable
+    std::map<QString, std::unique_ptr<Counter>> counters;
+    std::map<QString, std::unique_ptr<Gauge>> gauges;
+    std::map<QString, std::unique_ptr<Histogram>> histograms;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry(); // intentionally leaked: metrics may be touched during shutdown
+    return *instance;
+}
+
+template <typename T>
+T& lookup(std::map<QString, std::unique_ptr<T>>& map, const char* name) {
+    const QString key = QString::fromLatin1(name);
+    auto it = map.find(key);
+    if (it == map.end()) {
+        it = map.emplace(key, std::make_unique<T>(key)).first;
+    }
+    return *it->second;
+}
+
+} // namespace
+
+bool enabled() {
+    static const bool on = envFlagEnabled("MOUFFETTE_METRICS")
+        || qEnvironmentVariableIsSet("MOUFFETTE_METRICS_FILE")
+        || qEnvironmentVariableIsSet("MOUFFETTE_METRICS_SOCKET");
+    return on;
+}
+
+void Counter::add(quint64 n) {
+    m_shards[currentShard()].value.fetch_add(n, std::memory_order_relaxed);
+}
+
+quint64 Counter::total() const {
+    quint64 sum = 0;
+    for (const Shard& shard : m_shards) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+double Histogram::bucketUpperBoundMs(int bucket) {
+    if (bucket >= kHistogramBucketCount - 1) {
+        return INFINITY;
+    }
+    return 0.25 * std::ldexp(1.0, bucket); // 0.25, 0.5, 1, 2 ... 4096
+}
+
+void Histogram::record(double valueMs) {
+    valueMs = std::max(0.0, valueMs);
+    Shard& shard = m_shards[currentShard()];
+    shard.buckets[bucketForValue(valueMs)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sumMicros.fetch_add(static_cast<quint64>(std::llround(valueMs * 1000.0)), std::memory_order_relaxed);
+}
+
+QJsonObject Histogram::toJson() const {
+    std::array<quint64, kHistogramBucketCount> buckets{};
+    quint64 count = 0;
+    quint64 sumMicros = 0;
+    for (const Shard& shard : m_shards) {
+        for (int i = 0; i < kHistogramBucketCount; ++i) {
+            buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+        count += shard.count.load(std::memory_order_relaxed);
+        sumMicros += shard.sumMicros.load(std::memory_order_relaxed);
+    }
+
+    // Percentile estimate: upper bound of the bucket containing the rank
+    auto percentile = [&](double q) -> double {
+        if (count == 0) return 0.0;
+        const quint64 rank = static_cast<quint64>(std::ceil(q * static_cast<double>(count)));
+        quint64 seen = 0;
+        for (int i = 0; i < kHistogramBucketCount; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                const double bound = bucketUpperBoundMs(i);
+                return std::isinf(bound) ? bucketUpperBoundMs(kHistogramBucketCount - 2) : bound;
+            }
+        }
+        return 0.0;
+    };
+
+    QJsonArray bucketArr;
+    for (int i = 0; i < kHistogramBucketCount; ++i) {
+        QJsonObject b;
+        const double bound = bucketUpperBoundMs(i);
+        b["le"] = std::isinf(bound) ? QJsonValue(QStringLiteral("+inf")) : QJsonValue(bound);
+        b["count"] = static_cast<qint64>(buckets[i]);
+        bucketArr.append(b);
+    }
+
+    QJsonObject o;
+    o["count"] = static_cast<qint64>(count);
+    o["sumMs"] = static_cast<double>(sumMicros) / 1000.0;
+    o["avgMs"] = count > 0 ? static_cast<double>(sumMicros) / 1000.0 / static_cast<double>(count) : 0.0;
+    o["p50Ms"] = percentile(0.50);
+    o["p95Ms"] = percentile(0.95);
+    o["p99Ms"] = percentile(0.99);
+    o["buckets"] = bucketArr;
+    return o;
+}
+
+Counter& counter(const char* name) {
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    return lookup(r.counters, name);
+}
+
+Gauge& gauge(const char* name) {
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    return lookup(r.gauges, name);
+}
+
+Histogram& histogram(const char* name) {
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    return lookup(r.histograms, name);
+}
+
+QJsonObject snapshot() {
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+
+    QJsonObject counters;
+    for (const auto& [name, metric] : r.counters) {
+        counters[name] = static_cast<qint64>(metric->total());
+    }
+    QJsonObject gauges;
+    for (const auto& [name, metric] : r.gauges) {
+        gauges[name] = metric->value();
+    }
+    QJsonObject histograms;
+    for (const auto& [name, metric] : r.histograms) {
+        histograms[name] = metric->toJson();
+    }
+
+    QJsonObject root;
+    root["timestampMs"] = QDateTime::currentMSecsSinceEpoch();
+    root["counters"] = counters;
+    root["gauges"] = gauges;
+    root["histograms"] = histograms;
+    return root;
+}
+
+Exporter::Exporter(QObject* parent)
+    : QObject(parent) {
+    m_timer = new QTimer(this);
+    connect(m_timer, &QTimer::timeout, this, &Exporter::publishNow);
+}
+
+Exporter::~Exporter() {
+    if (m_server) {
+        m_server->close();
+    }
+}
+
+bool Exporter::listen(const QString& socketName) {
+    if (!m_server) {
+        m_server = new QLocalServer(this);
+        connect(m_server, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket* client = m_server->nextPendingConnection()) {
+                m_clients.append(client);
+                connect(client, &QLocalSocket::disconnected, this, [this, client]() {
+                    m_clients.removeAll(client);
+                    client->deleteLater();
+                });
+            }
+        });
+    }
+    QLocalServer::removeServer(socketName); // clear a stale endpoint left by a crashed run
+    if (!m_server->listen(socketName)) {
+        qWarning() << "Metrics: failed to listen on local socket" << socketName << m_server->errorString();
+        return false;
+    }
+    return true;
+}
+
+void Exporter::start(int intervalMs) {
+    m_timer->start(std::max(50, intervalMs));
+}
+
+void Exporter::publishNow() {
+    if (m_filePath.isEmpty() && m_clients.isEmpty()) {
+        return;
+    }
+    const QByteArray compact = QJsonDocument(snapshot()).toJson(QJsonDocument::Compact);
+
+    if (!m_filePath.isEmpty()) {
+        QSaveFile file(m_filePath);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(compact);
+            if (!file.commit()) {
+                qWarning() << "Metrics: failed to write snapshot to" << m_filePath;
+            }
+        }
+    }
+    for (QLocalSocket* client : std::as_const(m_clients)) {
+        client->write(compact);
+        client->write("\n");
+    }
+}
+
+Exporter* startExporterFromEnvironment(QObject* parent) {
+    if (!enabled()) {
+        return nullptr;
+    }
+    const QString filePath = qEnvironmentVariable("MOUFFETTE_METRICS_FILE");
+    const QString socketName = qEnvironmentVariable("MOUFFETTE_METRICS_SOCKET");
+    if (filePath.isEmpty() && socketName.isEmpty()) {
+        return nullptr; // collection only; snapshot() can still be queried in-process
+    }
+
+    auto* exporter = new Exporter(parent);
+    exporter->setFilePath(filePath);
+    if (!socketName.isEmpty()) {
+        exporter->listen(socketName);
+    }
+    bool ok = false;
+    const int intervalMs = qEnvironmentVariableIntValue("MOUFFETTE_METRICS_INTERVAL_MS", &ok);
+    exporter->start(ok && intervalMs > 0 ? intervalMs : 1000);
+    qInfo() << "Metrics: exporting snapshots" << (filePath.isEmpty() ? QString() : filePath)
+            << (socketName.isEmpty() ? QString() : socketName);
+    return exporter;
+}
+
+} // namespace Metrics
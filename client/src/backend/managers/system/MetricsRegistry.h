@@ -0,0 +1,133 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QString>
+#include <QList>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+class QTimer;
+class QLocalServer;
+class QLocalSocket;
+
+/**
+ * @brief Metrics - Structured in-process performance metrics
+ *
+ * Replaces the formatted [TextPerf]/[CanvasPerf]/[RemoteTextGlyphCache] log lines as the
+ * machine-readable source of perf data. Three metric kinds are supported:
+ * - Counter: monotonically increasing count (raster jobs, relayouts, chunks sent)
+ * - Gauge: last written value (queue depth, cache occupancy)
+ * - Histogram: fixed exponential millisecond buckets + count/sum (durations)
+ *
+ * Counters and histograms accumulate into per-thread shards with relaxed atomics, so
+ * raster workers and the GUI thread never contend on a lock. Shards are summed only when a
+ * snapshot is taken.
+ *
+ * Collection is disabled unless MOUFFETTE_METRICS=1, MOUFFETTE_METRICS_FILE or
+ * MOUFFETTE_METRICS_SOCKET is set; the MOUFFETTE_METRIC_* macros then cost one cached bool
+ * check per call site.
+ */
+namespace Metrics {
+
+constexpr int kShardCount = 16;
+constexpr int kHistogramBucketCount = 16; // upper bounds 0.25ms .. 4096ms, last bucket is +inf
+
+bool enabled();
+
+class Counter {
+public:
+    explicit Counter(const QString& name) : m_name(name) {}
+    void add(quint64 n = 1);
+    quint64 total() const;
+    const QString& name() const { return m_name; }
+
+private:
+    struct alignas(64) Shard { std::atomic<quint64> value{0}; };
+    QString m_name;
+    std::array<Shard, kShardCount> m_shards;
+};
+
+class Gauge {
+public:
+    explicit Gauge(const QString& name) : m_name(name) {}
+    void set(qint64 value) { m_value.store(value, std::memory_order_relaxed); }
+    qint64 value() const { return m_value.load(std::memory_order_relaxed); }
+    const QString& name() const { return m_name; }
+
+private:
+    QString m_name;
+    std::atomic<qint64> m_value{0};
+};
+
+class Histogram {
+public:
+    explicit Histogram(const QString& name) : m_name(name) {}
+    void record(double valueMs);
+    QJsonObject toJson() const;
+    const QString& name() const { return m_name; }
+    static double bucketUpperBoundMs(int bucket);
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<quint64>, kHistogramBucketCount> buckets{};
+        std::atomic<quint64> count{0};
+        std::atomic<quint64> sumMicros{0};
+    };
+    QString m_name;
+    std::array<Shard, kShardCount> m_shards;
+};
+
+// Registry lookup. Metric objects live for the whole process, so references can be cached
+// in function-local statics at the call site (the macros below do this).
+Counter& counter(const char* name);
+Gauge& gauge(const char* name);
+Histogram& histogram(const char* name);
+
+// Aggregated view of every registered metric: { timestampMs, counters{}, gauges{}, histograms{} }
+QJsonObject snapshot();
+
+/**
+ * @brief Periodically publishes snapshots to a JSON file and/or local socket clients
+ *
+ * Configured from the environment:
+ * - MOUFFETTE_METRICS_FILE: path rewritten atomically with the latest snapshot
+ * - MOUFFETTE_METRICS_SOCKET: QLocalServer name; each client receives newline-delimited snapshots
+ * - MOUFFETTE_METRICS_INTERVAL_MS: publish interval (default 1000)
+ */
+class Exporter : public QObject {
+    Q_OBJECT
+
+public:
+    explicit Exporter(QObject* parent = nullptr);
+    ~Exporter() override;
+
+    void setFilePath(const QString& path) { m_filePath = path; }
+    bool listen(const QString& socketName);
+    void start(int intervalMs);
+    void publishNow();
+
+private:
+    QTimer* m_timer = nullptr;
+    QString m_filePath;
+    QLocalServer* m_server = nullptr;
+    QList<QLocalSocket*> m_clients;
+};
+
+// Creates an Exporter owned by parent when the environment requests one; returns nullptr otherwise.
+Exporter* startExporterFromEnvironment(QObject* parent);
+
+} // namespace Metrics
+
+#define MOUFFETTE_METRIC_COUNT(name, n) \
+    do { if (Metrics::enabled()) { static Metrics::Counter& mouffetteMetric_ = Metrics::counter(name); mouffetteMetric_.add(static_cast<quint64>(n)); } } while (0)
+
+#define MOUFFETTE_METRIC_GAUGE(name, v) \
+    do { if (Metrics::enabled()) { static Metrics::Gauge& mouffetteMetric_ = Metrics::gauge(name); mouffetteMetric_.set(static_cast<qint64>(v)); } } while (0)
+
+#define MOUFFETTE_METRIC_HISTOGRAM(name, ms) \
+    do { if (Metrics::enabled()) { static Metrics::Histogram& mouffetteMetric_ = Metrics::histogram(name); mouffetteMetric_.record(static_cast<double>(ms)); } } while (0)
+
+#endif // METRICSREGISTRY_H
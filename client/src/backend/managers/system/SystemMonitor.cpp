@@ -180,6 +180,39 @@ void SystemMonitor::stopVolumeMonitoring() {
 #endif
 }
 
+void SystemMonitor::startScreenMonitoring() {
+    if (m_screenChangeTimer) {
+        return;
+    }
+    m_screenChangeTimer = new QTimer(this);
+    m_screenChangeTimer->setSingleShot(true);
+    m_screenChangeTimer->setInterval(250);
+    connect(m_screenChangeTimer, &QTimer::timeout, this, [this]() {
+        emit screenConfigurationChanged(getLocalScreenInfo());
+    });
+
+    auto* app = qobject_cast<QGuiApplication*>(QGuiApplication::instance());
+    if (!app) {
+        return;
+    }
+    connect(app, &QGuiApplication::screenAdded, this, [this](QScreen* screen) {
+        watchScreen(screen);
+        m_screenChangeTimer->start();
+    });
+    connect(app, &QGuiApplication::screenRemoved, m_screenChangeTimer, qOverload<>(&QTimer::start));
+    connect(app, &QGuiApplication::primaryScreenChanged, m_screenChangeTimer, qOverload<>(&QTimer::start));
+    for (QScreen* screen : QGuiApplication::screens()) {
+        watchScreen(screen);
+    }
+}
+
+void SystemMonitor::watchScreen(QScreen* screen) {
+    if (!screen) return;
+    connect(screen, &QScreen::geometryChanged, m_screenChangeTimer, qOverload<>(&QTimer::start));
+    connect(screen, &QScreen::availableGeometryChanged, m_screenChangeTimer, qOverload<>(&QTimer::start));
+    connect(screen, &QScreen::physicalDotsPerInchChanged, m_screenChangeTimer, qOverload<>(&QTimer::start));
+}
+
 QList<ScreenInfo> SystemMonitor::getLocalScreenInfo() const {
     QList<ScreenInfo> screens;
     
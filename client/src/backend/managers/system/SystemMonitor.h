@@ -7,6 +7,7 @@
 
 class QTimer;
 class QProcess;
+class QScreen;
 class ScreenInfo;
 
 /**
@@ -49,6 +50,14 @@ public:
      * @brief Stop volume monitoring
      */
     void stopVolumeMonitoring();
+
+    /**
+     * @brief Start watching for display changes
+     *
+     * Screens added/removed, primary changes and geometry or work-area changes of any screen
+     * emit screenConfigurationChanged once the burst settles (~250ms).
+     */
+    void startScreenMonitoring();
     
     /**
      * @brief Get information about all local screens
@@ -82,8 +91,11 @@ signals:
     void screenConfigurationChanged(const QList<ScreenInfo>& screens);
     
 private:
+    void watchScreen(QScreen* screen);
+
     // Volume monitoring state
     int m_cachedSystemVolume = -1;  // Last known value (0-100), -1 = unknown
+    QTimer* m_screenChangeTimer = nullptr; // debounces bursts of QScreen notifications
     
 #ifdef Q_OS_MACOS
     QProcess* m_volProc = nullptr;  // For async osascript calls
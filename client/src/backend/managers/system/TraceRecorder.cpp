@@ -0,0 +1,183 @@
+#include "backend/managers/system/TraceRecorder.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Trace {
+
+namespace {
+
+struct Event {
+    const char* name = nullptr;
+    qint64 startNs = 0;
+    qint64 durationNs = 0;
+};
+
+// Single-writer ring: only the owning thread writes slots and publishes the head with release
+// ordering. A concurrent dump may observe a slot being overwritten at the wrap point; that costs
+// at most one garbled event, which is acceptable for diagnostics.
+struct ThreadBuffer {
+    int tid = 0;
+    QString name;
+    std::atomic<quint64> head{0};
+    std::unique_ptr<Event[]> events{new Event[kEventsPerThread]};
+};
+
+struct BufferRegistry {
+    QMutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers; // kept after thread exit so late dumps still see events
+    int nextTid = 1;
+};
+
+BufferRegistry& bufferRegistry() {
+    static BufferRegistry* instance = new BufferRegistry(); // intentionally leaked: threads may record during shutdown
+    return *instance;
+}
+
+const std::chrono::steady_clock::time_point& traceEpoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+ThreadBuffer& currentBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+        auto b = std::make_shared<ThreadBuffer>();
+        BufferRegistry& r = bufferRegistry();
+        QMutexLocker locker(&r.mutex);
+        b->tid = r.nextTid++;
+        QThread* thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            b->name = QStringLiteral("main");
+        } else if (thread && !thread->objectName().isEmpty()) {
+            b->name = thread->objectName();
+        } else {
+            b->name = QStringLiteral("thread-%1").arg(b->tid);
+        }
+        r.buffers.push_back(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+bool envFlagEnabled(const char* name) {
+    const QByteArray lowered = qgetenv(name).trimmed().toLower();
+    return lowered == "1" || lowered == "true" || lowered == "yes" || lowered == "on";
+}
+
+QByteArray jsonEscaped(const QString& s) {
+    QByteArray out;
+    const QByteArray utf8 = s.toUtf8();
+    out.reserve(utf8.size());
+    for (char c : utf8) {
+        if (c == '"' || c == '\\') { out.append('\\'); out.append(c); }
+        else if (static_cast<unsigned char>(c) < 0x20) { out.append(' '); }
+        else { out.append(c); }
+    }
+    return out;
+}
+
+} // namespace
+
+bool enabled() {
+    static const bool on = envFlagEnabled("MOUFFETTE_TRACE") || qEnvironmentVariableIsSet("MOUFFETTE_TRACE_FILE");
+    return on;
+}
+
+qint64 nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceEpoch()).count();
+}
+
+void recordComplete(const char* name, qint64 startNs, qint64 durationNs) {
+    ThreadBuffer& buffer = currentBuffer();
+    const quint64 index = buffer.head.load(std::memory_order_relaxed);
+    Event& slot = buffer.events[index % kEventsPerThread];
+    slot.name = name;
+    slot.startNs = startNs;
+    slot.durationNs = durationNs;
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void setCurrentThreadName(const QString& name) {
+    ThreadBuffer& buffer = currentBuffer();
+    QMutexLocker locker(&bufferRegistry().mutex);
+    buffer.name = name;
+}
+
+QString defaultTraceFilePath() {
+    const QString configured = qEnvironmentVariable("MOUFFETTE_TRACE_FILE");
+    if (!configured.isEmpty()) {
+        return configured;
+    }
+    return QDir(QDir::tempPath()).filePath(
+        QStringLiteral("mouffette-trace-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+}
+
+bool writeChromeTrace(const QString& filePath, QString* errorMessage) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        BufferRegistry& r = bufferRegistry();
+        QMutexLocker locker(&r.mutex);
+        buffers = r.buffers;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QByteArray out;
+    out.reserve(1 << 20);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    auto appendEvent = [&](const QByteArray& e) {
+        if (!first) out.append(",\n");
+        out.append(e);
+        first = false;
+    };
+
+    int eventCount = 0;
+    for (const auto& buffer : buffers) {
+        QString threadName;
+        {
+            QMutexLocker locker(&bufferRegistry().mutex);
+            threadName = buffer->name;
+        }
+        appendEvent(QByteArray("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":") + QByteArray::number(pid)
+                    + ",\"tid\":" + QByteArray::number(buffer->tid)
+                    + ",\"args\":{\"name\":\"" + jsonEscaped(threadName) + "\"}}");
+
+        const quint64 head = buffer->head.load(std::memory_order_acquire);
+        const quint64 begin = head > static_cast<quint64>(kEventsPerThread) ? head - kEventsPerThread : 0;
+        for (quint64 i = begin; i < head; ++i) {
+            const Event e = buffer->events[i % kEventsPerThread];
+            if (!e.name) continue;
+            // Chrome trace timestamps are microseconds
+            appendEvent(QByteArray("{\"ph\":\"X\",\"name\":\"") + jsonEscaped(QString::fromLatin1(e.name))
+                        + "\",\"pid\":" + QByteArray::number(pid)
+                        + ",\"tid\":" + QByteArray::number(buffer->tid)
+                        + ",\"ts\":" + QByteArray::number(static_cast<double>(e.startNs) / 1000.0, 'f', 3)
+                        + ",\"dur\":" + QByteArray::number(static_cast<double>(e.durationNs) / 1000.0, 'f', 3) + "}");
+            ++eventCount;
+        }
+    }
+    out.append("]}\n");
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+    file.write(out);
+    if (!file.commit()) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+    qInfo() << "Trace: wrote" << eventCount << "events from" << buffers.size() << "threads to" << filePath;
+    return true;
+}
+
+} // namespace Trace
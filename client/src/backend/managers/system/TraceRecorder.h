@@ -0,0 +1,59 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QString>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Trace - Low-overhead scoped trace events exportable to Chrome/Perfetto JSON
+ *
+ * MOUFFETTE_TRACE_SCOPE("name") records one complete event (start + duration) for the
+ * enclosing scope into a per-thread ring buffer. Each thread owns its buffer, so recording
+ * is a clock read plus a slot write with no locking; the oldest events are overwritten when a
+ * buffer wraps. Event names must be string literals (only the pointer is stored).
+ *
+ * Recording is enabled with MOUFFETTE_TRACE=1 (or by setting MOUFFETTE_TRACE_FILE); when
+ * disabled a scope costs one cached bool check. writeChromeTrace() dumps all buffers as a
+ * "traceEvents" JSON document loadable in chrome://tracing or ui.perfetto.dev.
+ */
+namespace Trace {
+
+constexpr int kEventsPerThread = 32768;
+
+bool enabled();
+qint64 nowNs();
+void recordComplete(const char* name, qint64 startNs, qint64 durationNs);
+// Label the calling thread in exported traces (defaults to QThread objectName or "thread-N")
+void setCurrentThreadName(const QString& name);
+
+// Snapshot every thread's ring buffer into a Chrome trace JSON file
+bool writeChromeTrace(const QString& filePath, QString* errorMessage = nullptr);
+// Path from MOUFFETTE_TRACE_FILE, or a timestamped file in the temp directory
+QString defaultTraceFilePath();
+
+class Scope {
+public:
+    explicit Scope(const char* name)
+        : m_name(enabled() ? name : nullptr)
+        , m_startNs(m_name ? nowNs() : 0) {}
+    ~Scope() {
+        if (m_name) {
+            recordComplete(m_name, m_startNs, nowNs() - m_startNs);
+        }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* m_name;
+    qint64 m_startNs;
+};
+
+} // namespace Trace
+
+#define MOUFFETTE_TRACE_CONCAT_INNER(a, b) a##b
+#define MOUFFETTE_TRACE_CONCAT(a, b) MOUFFETTE_TRACE_CONCAT_INNER(a, b)
+#define MOUFFETTE_TRACE_SCOPE(name) Trace::Scope MOUFFETTE_TRACE_CONCAT(mouffetteTraceScope_, __LINE__)(name)
+
+#endif // TRACERECORDER_H
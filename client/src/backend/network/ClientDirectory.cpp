@@ -0,0 +1,70 @@
+#include "backend/network/ClientDirectory.h"
+#include <algorithm>
+
+void ClientDirectory::resetFromSnapshot(const QList<ClientInfo>& clients, qint64 version) {
+    m_clients = clients;
+    m_version = std::max<qint64>(0, version);
+}
+
+ClientDirectory::ApplyResult ClientDirectory::applyUpsert(const ClientInfo& client, qint64 version) {
+    const ApplyResult result = checkVersion(version);
+    if (result != ApplyResult::Applied) {
+        return result;
+    }
+    m_version = version;
+    const int index = indexOf(client.getId());
+    if (index >= 0) {
+        m_clients[index] = client;
+    } else {
+        m_clients.append(client);
+    }
+    return ApplyResult::Applied;
+}
+
+ClientDirectory::ApplyResult ClientDirectory::applyRemoval(const QString& sessionId, qint64 version, ClientInfo* removed) {
+    const ApplyResult result = checkVersion(version);
+    if (result != ApplyResult::Applied) {
+        return result;
+    }
+    m_version = version;
+    const int index = indexOf(sessionId);
+    if (index >= 0) {
+        if (removed) {
+            *removed = m_clients.at(index);
+        }
+        m_clients.removeAt(index);
+    }
+    return ApplyResult::Applied;
+}
+
+ClientDirectory::ApplyResult ClientDirectory::skip(qint64 version) {
+    const ApplyResult result = checkVersion(version);
+    if (result == ApplyResult::Applied) {
+        m_version = version;
+    }
+    return result;
+}
+
+void ClientDirectory::clear() {
+    m_clients.clear();
+    m_version = -1;
+}
+
+ClientDirectory::ApplyResult ClientDirectory::checkVersion(qint64 version) const {
+    if (!hasSnapshot() || version > m_version + 1) {
+        return ApplyResult::Gap;
+    }
+    if (version <= m_version) {
+        return ApplyResult::Stale;
+    }
+    return ApplyResult::Applied;
+}
+
+int ClientDirectory::indexOf(const QString& sessionId) const {
+    for (int i = 0; i < m_clients.size(); ++i) {
+        if (m_clients.at(i).getId() == sessionId) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,42 @@
+#ifndef CLIENTDIRECTORY_H
+#define CLIENTDIRECTORY_H
+
+#include <QList>
+#include <QString>
+#include "backend/domain/models/ClientInfo.h"
+
+/**
+ * ClientDirectory
+ *
+ * Local mirror of the server's versioned client directory (other registered clients only).
+ * Seeded by a client_list snapshot, then kept current by client_joined / client_updated /
+ * client_left deltas. Each delta carries the directory version it produces; a delta that does
+ * not directly follow the local version is a gap and the caller must request a new snapshot.
+ */
+class ClientDirectory {
+public:
+    enum class ChangeKind { Joined, Updated, Left };
+    enum class ApplyResult { Applied, Stale, Gap };
+
+    void resetFromSnapshot(const QList<ClientInfo>& clients, qint64 version);
+    // Insert or replace by session id (joined and updated are both upserts)
+    ApplyResult applyUpsert(const ClientInfo& client, qint64 version);
+    // Remove by session id; *removed receives the last known entry when there was one
+    ApplyResult applyRemoval(const QString& sessionId, qint64 version, ClientInfo* removed = nullptr);
+    // Consume a version without changing entries (deltas about this client itself)
+    ApplyResult skip(qint64 version);
+    void clear();
+
+    bool hasSnapshot() const { return m_version >= 0; }
+    qint64 version() const { return m_version; }
+    const QList<ClientInfo>& clients() const { return m_clients; }
+
+private:
+    ApplyResult checkVersion(qint64 version) const;
+    int indexOf(const QString& sessionId) const;
+
+    QList<ClientInfo> m_clients; // server order, joins appended
+    qint64 m_version = -1;       // -1 until the first snapshot
+};
+
+#endif // CLIENTDIRECTORY_H
@@ -0,0 +1,89 @@
+#include "backend/network/ClientStateSync.h"
+#include <QCryptographicHash>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+
+namespace ClientStateSync {
+
+namespace {
+
+QList<ScreenInfo> sortedById(QList<ScreenInfo> screens) {
+    std::stable_sort(screens.begin(), screens.end(),
+                     [](const ScreenInfo& a, const ScreenInfo& b) { return a.id < b.id; });
+    return screens;
+}
+
+} // anonymous namespace
+
+QString stateHash(const QList<ScreenInfo>& screens, int volumePercent) {
+    QJsonArray arr;
+    for (const ScreenInfo& screen : sortedById(screens)) {
+        arr.append(screen.toJson());
+    }
+    QJsonObject canonical;
+    canonical["screens"] = arr;
+    canonical["volumePercent"] = volumePercent;
+    const QByteArray digest = QCryptographicHash::hash(QJsonDocument(canonical).toJson(QJsonDocument::Compact),
+                                                       QCryptographicHash::Sha1);
+    return QString::fromLatin1(digest.left(8).toHex());
+}
+
+QJsonObject diff(const QList<ScreenInfo>& before, int volumeBefore,
+                 const QList<ScreenInfo>& after, int volumeAfter) {
+    QHash<int, QJsonObject> previous;
+    for (const ScreenInfo& screen : before) {
+        previous.insert(screen.id, screen.toJson());
+    }
+
+    QJsonArray changed;
+    for (const ScreenInfo& screen : sortedById(after)) {
+        const QJsonObject current = screen.toJson();
+        auto it = previous.find(screen.id);
+        if (it == previous.end() || it.value() != current) {
+            changed.append(current);
+        }
+        if (it != previous.end()) {
+            previous.erase(it);
+        }
+    }
+    QList<int> removedIds = previous.keys();
+    std::sort(removedIds.begin(), removedIds.end());
+    QJsonArray removed;
+    for (int id : removedIds) {
+        removed.append(id);
+    }
+
+    QJsonObject delta;
+    if (!changed.isEmpty()) delta["screens"] = changed;
+    if (!removed.isEmpty()) delta["removedScreenIds"] = removed;
+    if (volumeAfter != volumeBefore) delta["volumePercent"] = volumeAfter;
+    return delta;
+}
+
+void apply(const QJsonObject& delta, QList<ScreenInfo>* screens, int* volumePercent) {
+    if (screens) {
+        for (const QJsonValue& v : delta.value("removedScreenIds").toArray()) {
+            const int id = v.toInt(-1);
+            screens->erase(std::remove_if(screens->begin(), screens->end(),
+                                          [id](const ScreenInfo& s) { return s.id == id; }),
+                           screens->end());
+        }
+        for (const QJsonValue& v : delta.value("screens").toArray()) {
+            const ScreenInfo screen = ScreenInfo::fromJson(v.toObject());
+            auto it = std::find_if(screens->begin(), screens->end(),
+                                   [&screen](const ScreenInfo& s) { return s.id == screen.id; });
+            if (it != screens->end()) {
+                *it = screen;
+            } else {
+                screens->append(screen);
+            }
+        }
+    }
+    if (volumePercent && delta.contains("volumePercent")) {
+        *volumePercent = delta.value("volumePercent").toInt(-1);
+    }
+}
+
+} // namespace ClientStateSync
@@ -0,0 +1,33 @@
+#ifndef CLIENTSTATESYNC_H
+#define CLIENTSTATESYNC_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include "backend/domain/models/ClientInfo.h"
+
+/**
+ * ClientStateSync - Content hash and field-level diffs of a watched client's screens and volume
+ *
+ * The watched target publishes a full snapshot once (register with "stateHash"), then only
+ * state_delta messages when its state actually changes. A delta names the hash it applies to
+ * ("baseHash") and the hash it produces ("hash") and carries changed screens by id,
+ * removed screen ids and/or the new volume. The target also sends a periodic state_hash heartbeat;
+ * a watcher whose local copy hashes differently requests a fresh screens_info.
+ *
+ * The hash is computed over a canonical form (screens ordered by id, compact JSON) so target and
+ * watchers agree regardless of the order screens arrive in.
+ */
+namespace ClientStateSync {
+
+QString stateHash(const QList<ScreenInfo>& screens, int volumePercent);
+
+// Empty object when nothing differs
+QJsonObject diff(const QList<ScreenInfo>& before, int volumeBefore,
+                 const QList<ScreenInfo>& after, int volumeAfter);
+// Applies the screens/removedScreenIds/volumePercent fields of a state_delta in place
+void apply(const QJsonObject& delta, QList<ScreenInfo>* screens, int* volumePercent);
+
+} // namespace ClientStateSync
+
+#endif // CLIENTSTATESYNC_H
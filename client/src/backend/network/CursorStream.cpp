@@ -0,0 +1,104 @@
+#include "backend/network/CursorStream.h"
+#include <QJsonValue>
+#include <algorithm>
+#include <limits>
+
+namespace CursorStream {
+
+namespace {
+
+void appendVarint(QByteArray* out, quint64 value) {
+    while (value >= 0x80) {
+        out->append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out->append(static_cast<char>(value));
+}
+
+bool readVarint(const QByteArray& in, int* pos, quint64* value) {
+    quint64 result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*pos >= in.size()) {
+            return false;
+        }
+        const quint8 byte = static_cast<quint8>(in.at((*pos)++));
+        result |= static_cast<quint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+quint64 zigzag(qint64 v) {
+    return (static_cast<quint64>(v) << 1) ^ static_cast<quint64>(v >> 63);
+}
+
+qint64 unzigzag(quint64 v) {
+    return static_cast<qint64>(v >> 1) ^ -static_cast<qint64>(v & 1);
+}
+
+int clampToInt(qint64 v) {
+    if (v > std::numeric_limits<int>::max()) return std::numeric_limits<int>::max();
+    if (v < std::numeric_limits<int>::min()) return std::numeric_limits<int>::min();
+    return static_cast<int>(v);
+}
+
+} // anonymous namespace
+
+QJsonObject encode(const QVector<CursorSample>& samples) {
+    QJsonObject payload;
+    if (samples.isEmpty()) {
+        return payload;
+    }
+    const CursorSample& first = samples.first();
+    QByteArray deltas;
+    deltas.reserve((samples.size() - 1) * 4);
+    for (int i = 1; i < samples.size(); ++i) {
+        const CursorSample& prev = samples.at(i - 1);
+        const CursorSample& cur = samples.at(i);
+        appendVarint(&deltas, static_cast<quint64>(std::max<qint64>(0, cur.timeMs - prev.timeMs)));
+        appendVarint(&deltas, zigzag(static_cast<qint64>(cur.x) - prev.x));
+        appendVarint(&deltas, zigzag(static_cast<qint64>(cur.y) - prev.y));
+    }
+    payload["v"] = kVersion;
+    payload["t0"] = static_cast<double>(first.timeMs);
+    payload["x0"] = first.x;
+    payload["y0"] = first.y;
+    if (!deltas.isEmpty()) {
+        payload["d"] = QString::fromLatin1(deltas.toBase64());
+    }
+    payload["x"] = samples.last().x;
+    payload["y"] = samples.last().y;
+    return payload;
+}
+
+bool decode(const QJsonObject& payload, QVector<CursorSample>* samples) {
+    if (!samples || payload.value("v").toInt() != kVersion) {
+        return false;
+    }
+    CursorSample current;
+    current.timeMs = static_cast<qint64>(payload.value("t0").toDouble());
+    current.x = payload.value("x0").toInt();
+    current.y = payload.value("y0").toInt();
+    QVector<CursorSample> decoded;
+    decoded.append(current);
+
+    const QByteArray deltas = QByteArray::fromBase64(payload.value("d").toString().toLatin1());
+    int pos = 0;
+    while (pos < deltas.size()) {
+        quint64 dt = 0, dx = 0, dy = 0;
+        if (!readVarint(deltas, &pos, &dt) || !readVarint(deltas, &pos, &dx) || !readVarint(deltas, &pos, &dy)) {
+            return false;
+        }
+        current.timeMs += static_cast<qint64>(dt);
+        current.x = clampToInt(static_cast<qint64>(current.x) + unzigzag(dx));
+        current.y = clampToInt(static_cast<qint64>(current.y) + unzigzag(dy));
+        decoded.append(current);
+    }
+    *samples = std::move(decoded);
+    return true;
+}
+
+} // namespace CursorStream
@@ -0,0 +1,37 @@
+#ifndef CURSORSTREAM_H
+#define CURSORSTREAM_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QVector>
+
+// One cursor position in remote global desktop coordinates, stamped with the sender's
+// monotonic clock (milliseconds)
+struct CursorSample {
+    qint64 timeMs = 0;
+    int x = 0;
+    int y = 0;
+};
+
+/**
+ * CursorStream - Batched, delta-encoded cursor samples (cursor_samples message)
+ *
+ * A watched client samples its cursor on every tick but only sends a batch every kBatchIntervalMs
+ * (or once kMaxBatchSamples accumulate). The first sample is absolute (t0/x0/y0); the rest are
+ * packed as zigzag varints of (dt, dx, dy) and base64 encoded in "d". "x"/"y" repeat the newest
+ * position so the server can down-convert to a legacy cursor_update without decoding.
+ *
+ * Watchers replay the samples through RemoteCursorInterpolator rather than snapping to them.
+ */
+namespace CursorStream {
+
+constexpr int kVersion = 1;
+constexpr int kBatchIntervalMs = 100;
+constexpr int kMaxBatchSamples = 32;
+
+QJsonObject encode(const QVector<CursorSample>& samples);
+bool decode(const QJsonObject& payload, QVector<CursorSample>* samples);
+
+} // namespace CursorStream
+
+#endif // CURSORSTREAM_H
@@ -0,0 +1,134 @@
+#include "backend/network/DirectTransferLink.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include <QWebSocket>
+#include <QJsonDocument>
+#include <QHostAddress>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QDebug>
+
+DirectTransferLink::DirectTransferLink(QObject* parent)
+    : QObject(parent)
+    , m_timeout(new QTimer(this)) {
+    m_timeout->setSingleShot(true);
+    connect(m_timeout, &QTimer::timeout, this, [this]() {
+        if (m_socket || m_attempts.isEmpty()) {
+            return;
+        }
+        abortAttempts();
+        MOUFFETTE_METRIC_COUNT("directTransfer.connectTimeouts", 1);
+        emit failed(QStringLiteral("no candidate address answered in time"));
+    });
+}
+
+DirectTransferLink::~DirectTransferLink() {
+    abortAttempts();
+    if (m_socket) {
+        m_socket->disconnect(this);
+        m_socket->abort();
+        delete m_socket;
+        m_socket = nullptr;
+    }
+}
+
+void DirectTransferLink::open(const QStringList& addresses, quint16 port, const QString& token, int timeoutMs) {
+    close();
+    for (const QString& address : addresses) {
+        const QHostAddress host(address);
+        if (host.isNull()) {
+            continue;
+        }
+        QUrl url;
+        url.setScheme(QStringLiteral("ws"));
+        url.setHost(host.toString());
+        url.setPort(port);
+        QUrlQuery query;
+        query.addQueryItem(QStringLiteral("token"), token);
+        url.setQuery(query);
+
+        auto* socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+        connect(socket, &QWebSocket::connected, this, [this, socket]() { onAttemptConnected(socket); });
+        connect(socket, &QWebSocket::errorOccurred, this, [this, socket]() { onAttemptFailed(socket); });
+        connect(socket, &QWebSocket::disconnected, this, [this, socket]() { onAttemptFailed(socket); });
+        m_attempts.append(socket);
+        socket->open(url);
+    }
+    if (m_attempts.isEmpty()) {
+        // Report asynchronously so callers see the same signal ordering as a real failure
+        QTimer::singleShot(0, this, [this]() { emit failed(QStringLiteral("no usable candidate address")); });
+        return;
+    }
+    m_timeout->start(timeoutMs);
+}
+
+void DirectTransferLink::close() {
+    m_timeout->stop();
+    abortAttempts();
+    if (!m_socket) {
+        return;
+    }
+    QWebSocket* socket = m_socket;
+    m_socket = nullptr;
+    socket->disconnect(this);
+    // Graceful close lets queued frames (e.g. upload_complete) drain first
+    socket->close();
+    socket->deleteLater();
+}
+
+bool DirectTransferLink::isOpen() const {
+    return m_socket && m_socket->state() == QAbstractSocket::ConnectedState;
+}
+
+bool DirectTransferLink::sendMessage(const QJsonObject& message) {
+    if (!isOpen()) {
+        return false;
+    }
+    m_socket->sendTextMessage(QString::fromUtf8(QJsonDocument(message).toJson(QJsonDocument::Compact)));
+    return true;
+}
+
+void DirectTransferLink::onAttemptConnected(QWebSocket* socket) {
+    if (m_socket || !m_attempts.contains(socket)) {
+        return;
+    }
+    m_attempts.removeAll(socket);
+    m_timeout->stop();
+    abortAttempts();
+    m_socket = socket;
+    socket->disconnect(this);
+    connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+        if (m_socket != socket) {
+            return;
+        }
+        qWarning() << "DirectTransferLink: Direct link to" << socket->peerAddress().toString() << "closed";
+        m_socket = nullptr;
+        socket->deleteLater();
+        emit closed();
+    });
+    qDebug() << "DirectTransferLink: Connected to" << socket->peerAddress().toString();
+    MOUFFETTE_METRIC_COUNT("directTransfer.linksOpened", 1);
+    emit opened();
+}
+
+void DirectTransferLink::onAttemptFailed(QWebSocket* socket) {
+    if (!m_attempts.removeOne(socket)) {
+        return;
+    }
+    socket->disconnect(this);
+    socket->deleteLater();
+    if (!m_socket && m_attempts.isEmpty()) {
+        m_timeout->stop();
+        emit failed(QStringLiteral("every candidate address refused the connection"));
+    }
+}
+
+void DirectTransferLink::abortAttempts() {
+    const QList<QWebSocket*> attempts = m_attempts;
+    m_attempts.clear();
+    for (QWebSocket* socket : attempts) {
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+}
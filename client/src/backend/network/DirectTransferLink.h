@@ -0,0 +1,47 @@
+#ifndef DIRECTTRANSFERLINK_H
+#define DIRECTTRANSFERLINK_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+
+class QTimer;
+class QWebSocket;
+
+/**
+ * DirectTransferLink
+ *
+ * Sender side of the LAN direct-transfer path: dials every candidate address a target advertised
+ * in parallel and keeps the first WebSocket that completes its handshake. failed() fires when no
+ * candidate answers within the timeout; closed() when an established link drops. The caller then
+ * falls back to the relay.
+ */
+class DirectTransferLink : public QObject {
+    Q_OBJECT
+public:
+    explicit DirectTransferLink(QObject* parent = nullptr);
+    ~DirectTransferLink() override;
+
+    void open(const QStringList& addresses, quint16 port, const QString& token, int timeoutMs);
+    void close();
+    bool isOpen() const;
+    // False when the link is not open; the message is dropped
+    bool sendMessage(const QJsonObject& message);
+
+signals:
+    void opened();
+    void failed(const QString& reason);
+    void closed();
+
+private:
+    void onAttemptConnected(QWebSocket* socket);
+    void onAttemptFailed(QWebSocket* socket);
+    void abortAttempts();
+
+    QList<QWebSocket*> m_attempts;
+    QWebSocket* m_socket = nullptr;
+    QTimer* m_timeout = nullptr;
+};
+
+#endif // DIRECTTRANSFERLINK_H
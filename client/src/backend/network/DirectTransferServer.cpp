@@ -0,0 +1,161 @@
+#include "backend/network/DirectTransferServer.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include <QNetworkInterface>
+#include <QJsonDocument>
+#include <QUrlQuery>
+#include <QUuid>
+#include <QDebug>
+
+namespace {
+bool envFlagEnabled(const char* name) {
+    const QByteArray lowered = qgetenv(name).trimmed().toLower();
+    return lowered == "1" || lowered == "true" || lowered == "yes" || lowered == "on";
+}
+}
+
+bool DirectTransferServer::enabled() {
+    static const bool on = envFlagEnabled("MOUFFETTE_DIRECT_TRANSFER");
+    return on;
+}
+
+DirectTransferServer::DirectTransferServer(QObject* parent)
+    : QObject(parent) {
+    m_clock.start();
+}
+
+DirectTransferServer::~DirectTransferServer() {
+    close();
+}
+
+bool DirectTransferServer::offer(const QString& senderClientId, QString* token, quint16* port, QStringList* addresses) {
+    if (!enabled() || senderClientId.isEmpty() || !ensureListening()) {
+        return false;
+    }
+    const QStringList candidates = candidateAddresses();
+    if (candidates.isEmpty()) {
+        return false;
+    }
+    dropExpiredTokens();
+    const QString issued = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    m_tokens.insert(issued, PendingToken{senderClientId, m_clock.elapsed() + TOKEN_TTL_MS});
+    if (token) *token = issued;
+    if (port) *port = m_server->serverPort();
+    if (addresses) *addresses = candidates;
+    return true;
+}
+
+void DirectTransferServer::close() {
+    for (auto it = m_peers.constBegin(); it != m_peers.constEnd(); ++it) {
+        it.key()->disconnect(this);
+        it.key()->abort();
+        it.key()->deleteLater();
+    }
+    m_peers.clear();
+    m_tokens.clear();
+    if (m_server) {
+        m_server->close();
+        m_server->deleteLater();
+        m_server = nullptr;
+    }
+}
+
+bool DirectTransferServer::ensureListening() {
+    if (m_server && m_server->isListening()) {
+        return true;
+    }
+    if (!m_server) {
+        m_server = new QWebSocketServer(QStringLiteral("Mouffette direct transfer"), QWebSocketServer::NonSecureMode, this);
+        connect(m_server, &QWebSocketServer::newConnection, this, &DirectTransferServer::onNewConnection);
+    }
+    if (!m_server->listen(QHostAddress::Any, 0)) {
+        qWarning() << "DirectTransferServer: Failed to listen:" << m_server->errorString();
+        return false;
+    }
+    qDebug() << "DirectTransferServer: Listening on port" << m_server->serverPort();
+    return true;
+}
+
+void DirectTransferServer::onNewConnection() {
+    while (m_server && m_server->hasPendingConnections()) {
+        QWebSocket* peer = m_server->nextPendingConnection();
+        if (!peer) {
+            continue;
+        }
+        dropExpiredTokens();
+        const QString token = QUrlQuery(peer->requestUrl()).queryItemValue("token");
+        const auto it = m_tokens.constFind(token);
+        if (token.isEmpty() || it == m_tokens.constEnd()) {
+            qWarning() << "DirectTransferServer: Rejecting peer" << peer->peerAddress().toString() << "with unknown token";
+            MOUFFETTE_METRIC_COUNT("directTransfer.rejected", 1);
+            peer->close(QWebSocketProtocol::CloseCodePolicyViolated);
+            peer->deleteLater();
+            continue;
+        }
+        const QString senderClientId = it->senderClientId;
+        m_tokens.remove(token);
+        m_peers.insert(peer, senderClientId);
+        MOUFFETTE_METRIC_COUNT("directTransfer.accepted", 1);
+        qDebug() << "DirectTransferServer: Accepted direct link from" << senderClientId << "at" << peer->peerAddress().toString();
+
+        connect(peer, &QWebSocket::textMessageReceived, this, [this, peer](const QString& message) {
+            onPeerMessage(peer, message);
+        });
+        connect(peer, &QWebSocket::disconnected, this, [this, peer]() {
+            m_peers.remove(peer);
+            peer->deleteLater();
+        });
+    }
+}
+
+void DirectTransferServer::onPeerMessage(QWebSocket* peer, const QString& message) {
+    const QString senderClientId = m_peers.value(peer);
+    if (senderClientId.isEmpty()) {
+        return;
+    }
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "DirectTransferServer: Failed to parse peer message:" << error.errorString();
+        return;
+    }
+    QJsonObject obj = doc.object();
+    const QString type = obj.value("type").toString();
+    if (type != "upload_start" && type != "upload_chunk" && type != "upload_complete") {
+        qWarning() << "DirectTransferServer: Ignoring" << type << "on direct link";
+        return;
+    }
+    // Same identity the relay would have stamped on the message
+    obj["senderClientId"] = senderClientId;
+    if (type == "upload_chunk") {
+        MOUFFETTE_METRIC_COUNT("directTransfer.chunksReceived", 1);
+    }
+    emit messageReceived(obj);
+}
+
+void DirectTransferServer::dropExpiredTokens() {
+    const qint64 now = m_clock.elapsed();
+    for (auto it = m_tokens.begin(); it != m_tokens.end();) {
+        if (it->expiresAtMs <= now) it = m_tokens.erase(it); else ++it;
+    }
+}
+
+QStringList DirectTransferServer::candidateAddresses() {
+    QStringList addresses;
+    const auto interfaces = QNetworkInterface::allInterfaces();
+    for (const QNetworkInterface& iface : interfaces) {
+        const auto flags = iface.flags();
+        if (!flags.testFlag(QNetworkInterface::IsUp) || !flags.testFlag(QNetworkInterface::IsRunning) ||
+            flags.testFlag(QNetworkInterface::IsLoopBack)) {
+            continue;
+        }
+        for (const QNetworkAddressEntry& entry : iface.addressEntries()) {
+            const QHostAddress ip = entry.ip();
+            if (ip.protocol() == QAbstractSocket::IPv4Protocol) {
+                addresses.append(ip.toString());
+            }
+        }
+    }
+    return addresses;
+}
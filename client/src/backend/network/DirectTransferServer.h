@@ -0,0 +1,59 @@
+#ifndef DIRECTTRANSFERSERVER_H
+#define DIRECTTRANSFERSERVER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QStringList>
+
+class QWebSocket;
+class QWebSocketServer;
+
+/**
+ * DirectTransferServer
+ *
+ * Target side of the LAN direct-transfer path. When a sender asks for it over the relay
+ * (direct_transfer_request), the target starts listening on an ephemeral port and answers with
+ * its candidate addresses and a one-shot token (direct_transfer_offer). The sender then opens a
+ * WebSocket straight to us and streams upload_start / upload_chunk / upload_complete over it.
+ *
+ * Incoming messages are stamped with the sender identity bound to the token (never the one the
+ * peer claims) and re-emitted so UploadManager handles them exactly like relayed ones. Only upload
+ * messages are accepted. Opt-in with MOUFFETTE_DIRECT_TRANSFER=1.
+ */
+class DirectTransferServer : public QObject {
+    Q_OBJECT
+public:
+    static bool enabled();
+
+    explicit DirectTransferServer(QObject* parent = nullptr);
+    ~DirectTransferServer() override;
+
+    // Listen if needed and issue a token for senderClientId; false when no endpoint can be offered
+    bool offer(const QString& senderClientId, QString* token, quint16* port, QStringList* addresses);
+    void close();
+
+signals:
+    void messageReceived(const QJsonObject& message);
+
+private:
+    struct PendingToken {
+        QString senderClientId;
+        qint64 expiresAtMs = 0;
+    };
+
+    bool ensureListening();
+    void onNewConnection();
+    void onPeerMessage(QWebSocket* peer, const QString& message);
+    void dropExpiredTokens();
+    static QStringList candidateAddresses();
+
+    QWebSocketServer* m_server = nullptr;
+    QHash<QString, PendingToken> m_tokens;  // token -> sender allowed to use it (single use)
+    QHash<QWebSocket*, QString> m_peers;    // accepted socket -> sender client id
+    QElapsedTimer m_clock;
+    static constexpr int TOKEN_TTL_MS = 30000;
+};
+
+#endif // DIRECTTRANSFERSERVER_H
@@ -0,0 +1,858 @@
+#include "backend/network/EmbeddedHub.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include <QDebug>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QNetworkDatagram>
+#include <QSysInfo>
+#include <QThread>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QUrlQuery>
+#include <QUuid>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include <cmath>
+
+namespace {
+constexpr int kBeaconIntervalMs = 2000;
+constexpr int kHubSilentAfterMs = 3 * kBeaconIntervalMs; // a few missed beacons before another hub may take over
+constexpr unsigned long kShutdownWaitMs = 2000;
+const QString kBeaconType = QStringLiteral("mouffette_hub");
+
+bool envFlagEnabled(const char* name) {
+    const QByteArray lowered = qgetenv(name).trimmed().toLower();
+    return lowered == "1" || lowered == "true" || lowered == "yes" || lowered == "on";
+}
+
+QString encode(const QJsonObject& message) {
+    return QString::fromUtf8(QJsonDocument(message).toJson(QJsonDocument::Compact));
+}
+
+QString newSocketId() {
+    return QUuid::createUuid().toString(QUuid::WithoutBraces);
+}
+
+// Same precedence as server.js: explicit persistent target first, legacy field second
+QString targetOf(const QJsonObject& message) {
+    const QString persistent = message.value("targetPersistentClientId").toString();
+    return persistent.isEmpty() ? message.value("targetClientId").toString() : persistent;
+}
+
+// Per-target copy of a fan-out control message, shaped like the single-target form
+QJsonObject fanOutMessageFor(QJsonObject message, const QString& targetClientId, const QString& canvasSessionId) {
+    message["targetClientId"] = targetClientId;
+    message["targetPersistentClientId"] = targetClientId;
+    message["canvasSessionId"] = canvasSessionId;
+    message.remove("fanOut");
+    message.remove("targetClientIds");
+    return message;
+}
+} // anonymous namespace
+
+HubRouter::HubRouter(QObject* parent)
+    : QObject(parent) {}
+
+HubRouter::~HubRouter() {
+    close();
+}
+
+bool HubRouter::listen(quint16 port, bool advertise) {
+    if (m_server && m_server->isListening()) {
+        return true;
+    }
+    if (!m_server) {
+        m_server = new QWebSocketServer(QStringLiteral("Mouffette hub"), QWebSocketServer::NonSecureMode, this);
+        connect(m_server, &QWebSocketServer::newConnection, this, &HubRouter::onNewConnection);
+    }
+    if (!m_server->listen(QHostAddress::Any, port)) {
+        qWarning() << "EmbeddedHub: Failed to listen on port" << port << ":" << m_server->errorString();
+        return false;
+    }
+    qInfo() << "EmbeddedHub: Listening on port" << m_server->serverPort();
+    if (!advertise) {
+        return true;
+    }
+
+    m_beaconSocket = new QUdpSocket(this);
+    m_beaconTimer = new QTimer(this);
+    m_beaconTimer->setInterval(kBeaconIntervalMs);
+    connect(m_beaconTimer, &QTimer::timeout, this, &HubRouter::sendBeacon);
+    m_beaconTimer->start();
+    sendBeacon();
+    return true;
+}
+
+void HubRouter::close() {
+    if (m_beaconTimer) {
+        m_beaconTimer->stop();
+        delete m_beaconTimer;
+        m_beaconTimer = nullptr;
+    }
+    delete m_beaconSocket;
+    m_beaconSocket = nullptr;
+    const QList<QWebSocket*> sockets = m_controlSockets.keys() + m_uploadSockets.values();
+    for (QWebSocket* socket : sockets) {
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+    m_controlSockets.clear();
+    m_uploadSockets.clear();
+    m_clients.clear();
+    m_watchersByTarget.clear();
+    m_watchingByWatcher.clear();
+    m_fanOutUploads.clear();
+    m_fanOutSenders.clear();
+    if (m_server) {
+        m_server->close();
+        delete m_server;
+        m_server = nullptr;
+    }
+}
+
+quint16 HubRouter::serverPort() const {
+    return (m_server && m_server->isListening()) ? m_server->serverPort() : 0;
+}
+
+QJsonObject HubRouter::stats() const {
+    int watchers = 0;
+    for (const QSet<QString>& set : m_watchersByTarget) {
+        watchers += set.size();
+    }
+    QJsonObject o;
+    o["clients"] = m_clients.size();
+    o["controlSockets"] = m_controlSockets.size();
+    o["uploadSockets"] = m_uploadSockets.size();
+    o["watchedTargets"] = m_watchersByTarget.size();
+    o["watchers"] = watchers;
+    o["watching"] = m_watchingByWatcher.size();
+    o["fanOutUploads"] = m_fanOutUploads.size();
+    return o;
+}
+
+void HubRouter::onNewConnection() {
+    while (m_server && m_server->hasPendingConnections()) {
+        QWebSocket* socket = m_server->nextPendingConnection();
+        if (!socket) {
+            continue;
+        }
+        const QString socketId = newSocketId();
+        if (QUrlQuery(socket->requestUrl()).queryItemValue("channel") == QLatin1String("upload")) {
+            // Upload channel: never registered, messages are attributed via senderClientId
+            m_uploadSockets.insert(socket);
+            connect(socket, &QWebSocket::textMessageReceived, this, &HubRouter::onUploadChannelMessage);
+            connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+                m_uploadSockets.remove(socket);
+                socket->deleteLater();
+            });
+            QJsonObject welcome;
+            welcome["type"] = "welcome";
+            welcome["clientId"] = socketId;
+            welcome["message"] = "Upload channel ready";
+            socket->sendTextMessage(encode(welcome));
+            continue;
+        }
+
+        Client client;
+        client.socket = socket;
+        client.id = socketId;
+        m_clients.insert(socketId, client);
+        m_controlSockets.insert(socket, socketId);
+        MOUFFETTE_METRIC_GAUGE("hub.clientsConnected", m_controlSockets.size());
+        connect(socket, &QWebSocket::textMessageReceived, this, [this, socket](const QString& text) {
+            onControlMessage(socket, text);
+        });
+        connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+            onControlDisconnected(socket);
+        });
+
+        QJsonObject welcome;
+        welcome["type"] = "welcome";
+        welcome["socketId"] = socketId;
+        welcome["clientId"] = socketId;
+        welcome["message"] = "Connected to Mouffette hub";
+        socket->sendTextMessage(encode(welcome));
+        sendClientList(socketId);
+    }
+}
+
+void HubRouter::onControlMessage(QWebSocket* socket, const QString& text) {
+    const QString clientId = m_controlSockets.value(socket);
+    if (clientId.isEmpty()) {
+        return;
+    }
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(text.toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        sendError(clientId, QStringLiteral("Invalid JSON format"));
+        return;
+    }
+    handleMessage(clientId, doc.object());
+}
+
+void HubRouter::onUploadChannelMessage(const QString& text) {
+    const QJsonDocument doc = QJsonDocument::fromJson(text.toUtf8());
+    if (!doc.isObject()) {
+        qWarning() << "EmbeddedHub: Failed to parse upload channel message";
+        return;
+    }
+    const QJsonObject message = doc.object();
+    const QString senderClientId = message.value("senderClientId").toString();
+    if (!senderClientId.isEmpty()) {
+        handleMessage(senderClientId, message);
+    }
+}
+
+void HubRouter::onControlDisconnected(QWebSocket* socket) {
+    socket->deleteLater();
+    // Empty when the session was taken over by a newer socket
+    const QString clientId = m_controlSockets.take(socket);
+    MOUFFETTE_METRIC_GAUGE("hub.clientsConnected", m_controlSockets.size());
+    if (clientId.isEmpty()) {
+        return;
+    }
+    qDebug() << "EmbeddedHub: Client disconnected:" << clientId;
+    removeWatcher(clientId, m_watchingByWatcher.take(clientId));
+    const QSet<QString> watchers = m_watchersByTarget.take(clientId);
+    for (const QString& watcherId : watchers) {
+        if (m_watchingByWatcher.value(watcherId) == clientId) {
+            m_watchingByWatcher.remove(watcherId);
+        }
+    }
+    m_clients.remove(clientId);
+    // Fan-out uploads from this client can no longer finish; abort them on their targets
+    for (auto it = m_fanOutSenders.begin(); it != m_fanOutSenders.end();) {
+        if (it.value() != clientId) {
+            ++it;
+            continue;
+        }
+        const QHash<QString, FanOutTarget> targets = m_fanOutUploads.take(it.key());
+        QJsonObject abort;
+        abort["type"] = "upload_abort";
+        abort["uploadId"] = it.key();
+        for (auto target = targets.cbegin(); target != targets.cend(); ++target) {
+            relayToTarget(clientId, target.key(), fanOutMessageFor(abort, target.key(), target->canvasSessionId));
+        }
+        it = m_fanOutSenders.erase(it);
+    }
+    scheduleDirectoryPublish();
+}
+
+void HubRouter::handleMessage(const QString& clientId, QJsonObject message) {
+    if (!m_clients.contains(clientId)) {
+        return;
+    }
+    const QString type = message.value("type").toString();
+    MOUFFETTE_METRIC_COUNT("hub.messagesIn", 1);
+
+    if (type == "register") {
+        handleRegister(clientId, message);
+    } else if (type == "request_client_list") {
+        sendClientList(clientId);
+    } else if (type == "request_screens") {
+        handleRequestScreens(clientId, message);
+    } else if (type == "watch_screens") {
+        handleWatchScreens(clientId, message);
+    } else if (type == "unwatch_screens") {
+        const QString targetId = resolveClientId(message.value("targetClientId").toString());
+        removeWatcher(clientId, targetId.isEmpty() ? m_watchingByWatcher.value(clientId) : targetId);
+        m_watchingByWatcher.remove(clientId);
+    } else if (type == "upload_start" || type == "upload_chunk" || type == "upload_complete" || type == "upload_abort") {
+        handleUpload(clientId, message);
+    } else if (type == "direct_transfer_request" || type == "direct_transfer_offer" ||
+               type == "remove_all_files" || type == "remove_file" ||
+               type.startsWith(QLatin1String("remote_scene_"))) {
+        relayToTarget(clientId, targetOf(message), message);
+    } else if (type == "upload_progress" || type == "upload_finished" || type == "all_files_removed") {
+        relayToSender(clientId, message.value("senderClientId").toString(), message);
+    } else if (type == "cursor_update" || type == "cursor_samples") {
+        handleCursor(clientId, message);
+    } else if (type == "state_delta") {
+        handleStateDelta(clientId, message);
+    } else if (type == "state_hash") {
+        handleStateHash(clientId, message);
+    } else if (type == "canvas_created" || type == "canvas_deleted") {
+        // Canvas lifecycle is only tracked by server.js
+    } else {
+        qDebug() << "EmbeddedHub: Ignoring message type" << type;
+    }
+}
+
+void HubRouter::handleRegister(const QString& clientId, const QJsonObject& message) {
+    QString persistentId = message.value("persistentClientId").toString().trimmed();
+    if (persistentId.isEmpty()) persistentId = message.value("clientId").toString().trimmed();
+    if (persistentId.isEmpty()) persistentId = m_clients.value(clientId).persistentId;
+    if (persistentId.isEmpty()) {
+        sendError(clientId, QStringLiteral("persistentClientId is required for registration"));
+        return;
+    }
+    QString sessionId = message.value("sessionId").toString().trimmed();
+    if (sessionId.isEmpty()) sessionId = clientId;
+
+    if (sessionId != clientId) {
+        auto existing = m_clients.find(sessionId);
+        if (existing != m_clients.end()) {
+            // Same logical session reconnecting on a new socket: keep what the old one published
+            qDebug() << "EmbeddedHub: Session" << sessionId << "reconnecting";
+            const Client previous = existing.value();
+            m_clients.erase(existing);
+            m_controlSockets.remove(previous.socket);
+            Client& current = m_clients[clientId];
+            current.machineName = previous.machineName;
+            current.platform = previous.platform;
+            current.screens = previous.screens;
+            current.systemUI = previous.systemUI;
+            current.volumePercent = previous.volumePercent;
+            if (previous.socket) previous.socket->close();
+        }
+        renameClient(clientId, sessionId);
+    }
+
+    Client& client = m_clients[sessionId];
+    client.persistentId = persistentId;
+    if (message.contains("machineName")) {
+        client.machineName = message.value("machineName").toString();
+    }
+    if (client.machineName.isEmpty()) {
+        client.machineName = QStringLiteral("Client-") + client.id.left(8);
+    }
+    if (message.contains("screens")) {
+        client.screens = message.value("screens").toArray();
+        // A full snapshot defines the hashed state that later state_delta messages build on
+        client.stateHash = message.value("stateHash").toString();
+        if (!client.stateHash.isEmpty() && !message.value("volumePercent").isDouble()) {
+            client.volumePercent = -1;
+        }
+    }
+    if (message.value("systemUI").isArray()) {
+        client.systemUI = message.value("systemUI").toArray();
+    }
+    if (message.value("volumePercent").isDouble()) {
+        client.volumePercent = qBound(0, static_cast<int>(std::lround(message.value("volumePercent").toDouble())), 100);
+    }
+    if (message.contains("platform")) {
+        client.platform = message.value("platform").toString();
+    }
+    if (client.platform.isEmpty()) {
+        client.platform = QStringLiteral("unknown");
+    }
+    if (message.value("capabilities").isArray()) {
+        const QJsonArray capabilities = message.value("capabilities").toArray();
+        client.supportsCursorSamples = capabilities.contains(QStringLiteral("cursor_samples"));
+        client.supportsStateDelta = capabilities.contains(QStringLiteral("state_delta"));
+    }
+    qInfo() << "EmbeddedHub: Client registered:" << client.machineName << "[session:" << client.id << "]";
+
+    QJsonObject info = clientEntry(client);
+    info.remove("status");
+    QJsonObject confirmed;
+    confirmed["type"] = "registration_confirmed";
+    confirmed["clientInfo"] = info;
+    sendTo(sessionId, confirmed);
+
+    scheduleDirectoryPublish();
+    sendClientList(sessionId);
+    notifyWatchers(sessionId, false);
+}
+
+void HubRouter::handleRequestScreens(const QString& requesterId, const QJsonObject& message) {
+    const QString targetId = resolveClientId(message.value("targetClientId").toString());
+    if (targetId.isEmpty() || !m_clients.value(targetId).registered()) {
+        sendError(requesterId, QStringLiteral("Target client not found or not registered"));
+        return;
+    }
+    QJsonObject info = clientEntry(m_clients.value(targetId));
+    info.remove("status");
+    QJsonObject reply;
+    reply["type"] = "screens_info";
+    reply["clientInfo"] = info;
+    sendTo(requesterId, reply);
+}
+
+void HubRouter::handleWatchScreens(const QString& watcherId, const QJsonObject& message) {
+    const QString targetId = resolveClientId(message.value("targetClientId").toString());
+    if (targetId.isEmpty()) {
+        return;
+    }
+    const QString previous = m_watchingByWatcher.value(watcherId);
+    if (!previous.isEmpty() && previous != targetId) {
+        removeWatcher(watcherId, previous);
+    }
+    m_watchingByWatcher.insert(watcherId, targetId);
+    m_watchersByTarget[targetId].insert(watcherId);
+
+    // Ask the target for fresh state; watchers get nothing cached
+    QJsonObject status;
+    status["type"] = "watch_status";
+    status["watched"] = true;
+    sendTo(targetId, status);
+    QJsonObject request;
+    request["type"] = "data_request";
+    request["fields"] = QJsonArray{QStringLiteral("screens"), QStringLiteral("volume")};
+    sendTo(targetId, request);
+}
+
+void HubRouter::removeWatcher(const QString& watcherId, const QString& targetId) {
+    auto it = m_watchersByTarget.find(targetId);
+    if (it == m_watchersByTarget.end()) {
+        return;
+    }
+    it->remove(watcherId);
+    if (it->isEmpty()) {
+        m_watchersByTarget.erase(it);
+        QJsonObject status;
+        status["type"] = "watch_status";
+        status["watched"] = false;
+        sendTo(targetId, status);
+    }
+}
+
+void HubRouter::handleUpload(const QString& senderId, QJsonObject message) {
+    const QString type = message.value("type").toString();
+    const QString uploadId = message.value("uploadId").toString();
+
+    if (type == "upload_start" && message.value("fanOut").isArray()) {
+        // Fan-out: one sender stream, split here into a regular upload_start per target
+        const QJsonArray manifest = message.value("files").toArray();
+        QHash<QString, FanOutTarget> targets;
+        for (const QJsonValue& v : message.value("fanOut").toArray()) {
+            const QJsonObject entry = v.toObject();
+            const QString targetClientId = entry.value("targetClientId").toString();
+            const QString canvasSessionId = entry.value("canvasSessionId").toString();
+            if (targetClientId.isEmpty() || canvasSessionId.isEmpty() || targets.contains(targetClientId)) continue;
+            const QJsonArray wanted = entry.value("fileIds").toArray();
+            FanOutTarget target;
+            target.canvasSessionId = canvasSessionId;
+            for (const QJsonValue& f : manifest) {
+                if (wanted.contains(f.toObject().value("fileId"))) target.manifest.append(f);
+            }
+            if (!target.manifest.isEmpty()) targets.insert(targetClientId, target);
+        }
+        if (uploadId.isEmpty() || targets.isEmpty()) {
+            sendError(senderId, QStringLiteral("Fan-out upload has no target needing files"));
+            return;
+        }
+        m_fanOutUploads.insert(uploadId, targets);
+        m_fanOutSenders.insert(uploadId, senderId);
+        for (auto it = targets.cbegin(); it != targets.cend(); ++it) {
+            QJsonObject perTarget = fanOutMessageFor(message, it.key(), it->canvasSessionId);
+            perTarget["files"] = it->manifest;
+            relayToTarget(senderId, it.key(), perTarget);
+        }
+        return;
+    }
+
+    if (type == "upload_chunk" && message.value("targetClientIds").isArray()) {
+        // Fan-out relay: serialized once, the same frame goes to every target still in the upload
+        if (message.value("senderClientId").toString().isEmpty()) message["senderClientId"] = senderId;
+        const auto upload = m_fanOutUploads.constFind(uploadId);
+        QString payload;
+        for (const QJsonValue& v : message.value("targetClientIds").toArray()) {
+            const QString targetClientId = v.toString();
+            if (upload != m_fanOutUploads.constEnd() && !upload->contains(targetClientId)) continue;
+            const QString resolvedId = resolveClientId(targetClientId);
+            QWebSocket* socket = m_clients.value(resolvedId).socket;
+            if (!socket) continue;
+            if (payload.isEmpty()) payload = encode(message);
+            socket->sendTextMessage(payload);
+            MOUFFETTE_METRIC_COUNT("hub.messagesRelayed", 1);
+        }
+        return;
+    }
+
+    if ((type == "upload_complete" || type == "upload_abort") && message.value("fanOut").toBool()) {
+        auto upload = m_fanOutUploads.find(uploadId);
+        if (upload == m_fanOutUploads.end()) {
+            return;
+        }
+        QStringList targetClientIds;
+        for (const QJsonValue& v : message.value("targetClientIds").toArray()) targetClientIds.append(v.toString());
+        // upload_complete and an untargeted abort end the upload for everyone
+        if (type == "upload_complete" || targetClientIds.isEmpty()) targetClientIds = upload->keys();
+        for (const QString& targetClientId : targetClientIds) {
+            const auto target = upload->constFind(targetClientId);
+            if (target == upload->constEnd()) continue;
+            relayToTarget(senderId, targetClientId, fanOutMessageFor(message, targetClientId, target->canvasSessionId));
+            upload->remove(targetClientId);
+        }
+        if (upload->isEmpty()) {
+            m_fanOutUploads.erase(upload);
+            m_fanOutSenders.remove(uploadId);
+        }
+        return;
+    }
+
+    // relay == false: tracking copy of a transfer streamed over a direct LAN link
+    if (message.value("relay").toBool(true) == false) {
+        return;
+    }
+    relayToTarget(senderId, targetOf(message), message);
+}
+
+void HubRouter::handleCursor(const QString& targetId, const QJsonObject& message) {
+    const QSet<QString> watchers = m_watchersByTarget.value(targetId);
+    if (watchers.isEmpty() || !message.value("x").isDouble() || !message.value("y").isDouble()) {
+        return;
+    }
+    QJsonObject latest;
+    latest["type"] = "cursor_update";
+    latest["targetClientId"] = targetId;
+    latest["x"] = static_cast<int>(std::lround(message.value("x").toDouble()));
+    latest["y"] = static_cast<int>(std::lround(message.value("y").toDouble()));
+    const bool isBatch = message.value("type").toString() == QLatin1String("cursor_samples");
+    QString batchPayload;
+    QString latestPayload;
+    for (const QString& watcherId : watchers) {
+        const Client watcher = m_clients.value(watcherId);
+        if (!watcher.socket) continue;
+        // Watchers without the capability get the newest position only
+        if (isBatch && watcher.supportsCursorSamples) {
+            if (batchPayload.isEmpty()) {
+                QJsonObject batch = message;
+                batch["targetClientId"] = targetId;
+                batchPayload = encode(batch);
+            }
+            watcher.socket->sendTextMessage(batchPayload);
+        } else {
+            if (latestPayload.isEmpty()) latestPayload = encode(latest);
+            watcher.socket->sendTextMessage(latestPayload);
+        }
+    }
+}
+
+void HubRouter::handleStateDelta(const QString& clientId, const QJsonObject& message) {
+    Client& client = m_clients[clientId];
+    if (!client.registered()) {
+        return;
+    }
+    if (client.stateHash.isEmpty() || message.value("baseHash").toString() != client.stateHash ||
+        !message.value("hash").isString()) {
+        // Our copy is not the state this delta was made against
+        requestStateSnapshot(client);
+        return;
+    }
+    QJsonArray screens;
+    const QJsonArray removed = message.value("removedScreenIds").toArray();
+    for (const QJsonValue& screen : client.screens) {
+        if (!removed.contains(screen.toObject().value("id"))) screens.append(screen);
+    }
+    for (const QJsonValue& changed : message.value("screens").toArray()) {
+        const QJsonValue id = changed.toObject().value("id");
+        bool replaced = false;
+        for (int i = 0; i < screens.size(); ++i) {
+            if (screens.at(i).toObject().value("id") == id) {
+                screens.replace(i, changed);
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) screens.append(changed);
+    }
+    int volumePercent = client.volumePercent;
+    if (message.value("volumePercent").isDouble()) {
+        const double volume = message.value("volumePercent").toDouble();
+        volumePercent = volume < 0 ? -1 : qMin(100, static_cast<int>(std::lround(volume)));
+    }
+    const bool directoryChanged = screens != client.screens || volumePercent != client.volumePercent;
+    client.screens = screens;
+    client.volumePercent = volumePercent;
+    client.stateHash = message.value("hash").toString();
+
+    QJsonObject delta;
+    delta["type"] = "state_delta";
+    delta["targetClientId"] = client.id;
+    delta["baseHash"] = message.value("baseHash");
+    delta["hash"] = client.stateHash;
+    if (message.value("screens").isArray()) delta["screens"] = message.value("screens");
+    if (message.value("removedScreenIds").isArray()) delta["removedScreenIds"] = message.value("removedScreenIds");
+    if (message.value("volumePercent").isDouble()) delta["volumePercent"] = client.volumePercent;
+    sendToStateDeltaWatchers(client.id, delta);
+    notifyWatchers(client.id, true);
+    // Client lists carry screens and volume too; they are resent whole, so only when those changed
+    if (directoryChanged) scheduleDirectoryPublish();
+}
+
+void HubRouter::handleStateHash(const QString& clientId, const QJsonObject& message) {
+    Client& client = m_clients[clientId];
+    if (!client.registered()) {
+        return;
+    }
+    if (client.stateHash.isEmpty() || message.value("hash").toString() != client.stateHash) {
+        requestStateSnapshot(client);
+        return;
+    }
+    QJsonObject hash;
+    hash["type"] = "state_hash";
+    hash["targetClientId"] = client.id;
+    hash["hash"] = client.stateHash;
+    sendToStateDeltaWatchers(client.id, hash);
+}
+
+QString HubRouter::resolveClientId(const QString& clientId) const {
+    if (clientId.isEmpty()) {
+        return QString();
+    }
+    if (m_clients.contains(clientId)) {
+        return clientId;
+    }
+    for (auto it = m_clients.cbegin(); it != m_clients.cend(); ++it) {
+        if (it->persistentId == clientId) {
+            return it.key();
+        }
+    }
+    return QString();
+}
+
+void HubRouter::relayToTarget(const QString& senderId, const QString& targetClientId, QJsonObject message) {
+    const QString resolvedId = resolveClientId(targetClientId);
+    if (resolvedId.isEmpty() || !m_clients.value(resolvedId).socket) {
+        sendError(senderId, QStringLiteral("Target client not found"));
+        return;
+    }
+    // Include senderId for correlation if not present
+    if (message.value("senderClientId").toString().isEmpty()) message["senderClientId"] = senderId;
+    sendTo(resolvedId, message);
+    MOUFFETTE_METRIC_COUNT("hub.messagesRelayed", 1);
+}
+
+void HubRouter::relayToSender(const QString& targetId, const QString& senderClientId, QJsonObject message) {
+    if (!m_clients.contains(senderClientId)) {
+        return;
+    }
+    if (message.value("targetClientId").toString().isEmpty()) message["targetClientId"] = targetId;
+    sendTo(senderClientId, message);
+    MOUFFETTE_METRIC_COUNT("hub.messagesRelayed", 1);
+}
+
+void HubRouter::sendTo(const QString& clientId, const QJsonObject& message) {
+    QWebSocket* socket = m_clients.value(clientId).socket;
+    if (socket && socket->state() == QAbstractSocket::ConnectedState) {
+        socket->sendTextMessage(encode(message));
+    }
+}
+
+void HubRouter::sendError(const QString& clientId, const QString& error) {
+    QJsonObject message;
+    message["type"] = "error";
+    message["message"] = error;
+    sendTo(clientId, message);
+}
+
+void HubRouter::renameClient(const QString& oldId, const QString& newId) {
+    Client client = m_clients.take(oldId);
+    client.id = newId;
+    m_controlSockets.insert(client.socket, newId);
+    m_clients.insert(newId, client);
+
+    const QSet<QString> watchers = m_watchersByTarget.take(oldId);
+    if (!watchers.isEmpty()) m_watchersByTarget[newId].unite(watchers);
+    for (auto it = m_watchersByTarget.begin(); it != m_watchersByTarget.end(); ++it) {
+        if (it->remove(oldId)) it->insert(newId);
+    }
+    if (m_watchingByWatcher.contains(oldId)) {
+        m_watchingByWatcher.insert(newId, m_watchingByWatcher.take(oldId));
+    }
+    for (auto it = m_watchingByWatcher.begin(); it != m_watchingByWatcher.end(); ++it) {
+        if (it.value() == oldId) it.value() = newId;
+    }
+    for (auto it = m_fanOutSenders.begin(); it != m_fanOutSenders.end(); ++it) {
+        if (it.value() == oldId) it.value() = newId;
+    }
+}
+
+void HubRouter::requestStateSnapshot(Client& client) {
+    client.stateHash.clear();
+    QJsonObject request;
+    request["type"] = "data_request";
+    request["fields"] = QJsonArray{QStringLiteral("screens"), QStringLiteral("volume")};
+    sendTo(client.id, request);
+}
+
+QJsonObject HubRouter::clientEntry(const Client& client) const {
+    QJsonObject entry;
+    entry["id"] = client.id;
+    entry["sessionId"] = client.id;
+    entry["persistentClientId"] = client.persistentId;
+    entry["machineName"] = client.machineName;
+    entry["screens"] = client.screens;
+    entry["platform"] = client.platform;
+    entry["systemUI"] = client.systemUI;
+    entry["volumePercent"] = client.volumePercent;
+    entry["status"] = "connected";
+    return entry;
+}
+
+void HubRouter::notifyWatchers(const QString& targetId, bool legacyOnly) {
+    const QSet<QString> watchers = m_watchersByTarget.value(targetId);
+    if (watchers.isEmpty() || !m_clients.contains(targetId)) {
+        return;
+    }
+    QString payload;
+    for (const QString& watcherId : watchers) {
+        const Client watcher = m_clients.value(watcherId);
+        if (!watcher.socket || (legacyOnly && watcher.supportsStateDelta)) continue;
+        if (payload.isEmpty()) {
+            QJsonObject info = clientEntry(m_clients.value(targetId));
+            info.remove("status");
+            QJsonObject message;
+            message["type"] = "screens_info";
+            message["clientInfo"] = info;
+            payload = encode(message);
+        }
+        watcher.socket->sendTextMessage(payload);
+    }
+}
+
+void HubRouter::sendToStateDeltaWatchers(const QString& targetId, const QJsonObject& message) {
+    QString payload;
+    for (const QString& watcherId : m_watchersByTarget.value(targetId)) {
+        const Client watcher = m_clients.value(watcherId);
+        if (!watcher.socket || !watcher.supportsStateDelta) continue;
+        if (payload.isEmpty()) payload = encode(message);
+        watcher.socket->sendTextMessage(payload);
+    }
+}
+
+void HubRouter::sendClientList(const QString& clientId) {
+    QJsonArray clients;
+    for (auto it = m_clients.cbegin(); it != m_clients.cend(); ++it) {
+        if (it.key() != clientId && it->registered()) clients.append(clientEntry(*it));
+    }
+    QJsonObject message;
+    message["type"] = "client_list";
+    message["version"] = m_directoryVersion;
+    message["clients"] = clients;
+    sendTo(clientId, message);
+}
+
+// Coalesce every change made during this event-loop pass into one snapshot per client
+void HubRouter::scheduleDirectoryPublish() {
+    if (m_directoryPublishScheduled) return;
+    m_directoryPublishScheduled = true;
+    QTimer::singleShot(0, this, [this]() {
+        m_directoryPublishScheduled = false;
+        ++m_directoryVersion;
+        for (auto it = m_clients.cbegin(); it != m_clients.cend(); ++it) {
+            if (it->registered()) sendClientList(it.key());
+        }
+    });
+}
+
+void HubRouter::sendBeacon() {
+    if (!m_beaconSocket || !m_server) return;
+    QJsonObject beacon;
+    beacon["type"] = kBeaconType;
+    beacon["port"] = m_server->serverPort();
+    beacon["machineName"] = QSysInfo::machineHostName();
+    m_beaconSocket->writeDatagram(QJsonDocument(beacon).toJson(QJsonDocument::Compact),
+                                  QHostAddress::Broadcast, EmbeddedHub::kDiscoveryPort);
+}
+
+bool EmbeddedHub::enabled() {
+    static const bool on = envFlagEnabled("MOUFFETTE_HUB");
+    return on;
+}
+
+quint16 EmbeddedHub::configuredPort() {
+    bool ok = false;
+    const int port = qEnvironmentVariableIntValue("MOUFFETTE_HUB_PORT", &ok);
+    return (ok && port >= 0 && port <= 65535) ? static_cast<quint16>(port) : kDefaultPort;
+}
+
+EmbeddedHub::EmbeddedHub(QObject* parent)
+    : QObject(parent)
+    , m_thread(new QThread(this))
+    , m_router(new HubRouter()) {
+    m_thread->setObjectName(QStringLiteral("MouffetteHub"));
+    m_router->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_router, &QObject::deleteLater);
+    m_thread->start();
+}
+
+EmbeddedHub::~EmbeddedHub() {
+    stop();
+    m_thread->quit();
+    if (!m_thread->wait(kShutdownWaitMs)) {
+        qWarning() << "EmbeddedHub: Hub thread did not stop in time";
+    }
+}
+
+bool EmbeddedHub::start(quint16 port, bool advertise) {
+    HubRouter* router = m_router;
+    quint16 listening = 0;
+    QMetaObject::invokeMethod(router, [router, port, advertise, &listening]() {
+        if (router->listen(port, advertise)) listening = router->serverPort();
+    }, Qt::BlockingQueuedConnection);
+    m_port = listening;
+    return m_port != 0;
+}
+
+void EmbeddedHub::stop() {
+    if (m_port == 0) return;
+    HubRouter* router = m_router;
+    QMetaObject::invokeMethod(router, [router]() { router->close(); }, Qt::BlockingQueuedConnection);
+    m_port = 0;
+}
+
+QUrl EmbeddedHub::localUrl() const {
+    return m_port ? QUrl(QStringLiteral("ws://127.0.0.1:%1").arg(m_port)) : QUrl();
+}
+
+QJsonObject EmbeddedHub::stats() const {
+    HubRouter* router = m_router;
+    QJsonObject result;
+    QMetaObject::invokeMethod(router, [router, &result]() { result = router->stats(); }, Qt::BlockingQueuedConnection);
+    return result;
+}
+
+bool HubLocator::enabled() {
+    static const bool on = envFlagEnabled("MOUFFETTE_HUB_DISCOVERY");
+    return on;
+}
+
+HubLocator::HubLocator(QObject* parent)
+    : QObject(parent) {}
+
+bool HubLocator::start() {
+    if (m_socket) return true;
+    m_socket = new QUdpSocket(this);
+    if (!m_socket->bind(QHostAddress::AnyIPv4, EmbeddedHub::kDiscoveryPort,
+                        QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+        qWarning() << "HubLocator: Cannot listen for hub beacons:" << m_socket->errorString();
+        delete m_socket;
+        m_socket = nullptr;
+        return false;
+    }
+    connect(m_socket, &QUdpSocket::readyRead, this, &HubLocator::onReadyRead);
+    return true;
+}
+
+void HubLocator::onReadyRead() {
+    while (m_socket && m_socket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = m_socket->receiveDatagram();
+        const QJsonObject beacon = QJsonDocument::fromJson(datagram.data()).object();
+        if (beacon.value("type").toString() != kBeaconType) continue;
+        const int port = beacon.value("port").toInt();
+        if (port <= 0 || port > 65535) continue;
+        QHostAddress address = datagram.senderAddress();
+        bool isV4 = false;
+        const quint32 v4 = address.toIPv4Address(&isV4);
+        if (isV4) address = QHostAddress(v4);
+        QUrl url;
+        url.setScheme(QStringLiteral("ws"));
+        url.setHost(address.toString());
+        url.setPort(port);
+        if (url == m_hubUrl) {
+            m_sinceHubBeacon.restart();
+            continue;
+        }
+        // Stay on the hub we joined while it is alive; two hosts advertising must not make us flap
+        if (m_sinceHubBeacon.isValid() && m_sinceHubBeacon.elapsed() < kHubSilentAfterMs) continue;
+        m_hubUrl = url;
+        m_sinceHubBeacon.start();
+        const QString machineName = beacon.value("machineName").toString();
+        qInfo() << "HubLocator: Found hub on" << machineName << "at" << url.toString();
+        emit hubFound(url, machineName);
+    }
+}
@@ -0,0 +1,171 @@
+#ifndef EMBEDDEDHUB_H
+#define EMBEDDEDHUB_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+class QThread;
+class QTimer;
+class QUdpSocket;
+class QWebSocket;
+class QWebSocketServer;
+
+// Owns the QWebSocketServer on the hub thread; driven only through EmbeddedHub
+class HubRouter : public QObject {
+    Q_OBJECT
+public:
+    explicit HubRouter(QObject* parent = nullptr);
+    ~HubRouter() override;
+
+    // Hub thread only
+    bool listen(quint16 port, bool advertise);
+    void close();
+    quint16 serverPort() const;
+    // Sizes of the routing tables, for soak runs
+    QJsonObject stats() const;
+
+private:
+    struct Client {
+        QWebSocket* socket = nullptr;
+        QString id;            // session id once registered, socket id before
+        QString persistentId;
+        QString machineName;
+        QString platform;
+        QJsonArray screens;
+        QJsonArray systemUI;
+        int volumePercent = -1;
+        QString stateHash;     // state the last state_delta / register snapshot describes
+        bool supportsCursorSamples = false;
+        bool supportsStateDelta = false;
+        bool registered() const { return !machineName.isEmpty() && !persistentId.isEmpty(); }
+    };
+    // Per-target part of a fan-out upload, as in server.js
+    struct FanOutTarget {
+        QString canvasSessionId;
+        QJsonArray manifest;
+    };
+
+    void onNewConnection();
+    void onControlMessage(QWebSocket* socket, const QString& text);
+    void onUploadChannelMessage(const QString& text);
+    void onControlDisconnected(QWebSocket* socket);
+    void handleMessage(const QString& clientId, QJsonObject message);
+
+    void handleRegister(const QString& clientId, const QJsonObject& message);
+    void handleRequestScreens(const QString& requesterId, const QJsonObject& message);
+    void handleWatchScreens(const QString& watcherId, const QJsonObject& message);
+    void handleUpload(const QString& senderId, QJsonObject message);
+    void handleCursor(const QString& targetId, const QJsonObject& message);
+    void handleStateDelta(const QString& clientId, const QJsonObject& message);
+    void handleStateHash(const QString& clientId, const QJsonObject& message);
+
+    QString resolveClientId(const QString& clientId) const;
+    void relayToTarget(const QString& senderId, const QString& targetClientId, QJsonObject message);
+    void relayToSender(const QString& targetId, const QString& senderClientId, QJsonObject message);
+    void sendTo(const QString& clientId, const QJsonObject& message);
+    void sendError(const QString& clientId, const QString& error);
+    void removeWatcher(const QString& watcherId, const QString& targetId);
+    void renameClient(const QString& oldId, const QString& newId);
+    void requestStateSnapshot(Client& client);
+    QJsonObject clientEntry(const Client& client) const;
+    void notifyWatchers(const QString& targetId, bool legacyOnly);
+    void sendToStateDeltaWatchers(const QString& targetId, const QJsonObject& message);
+    void sendClientList(const QString& clientId);
+    void scheduleDirectoryPublish();
+    void sendBeacon();
+
+    QWebSocketServer* m_server = nullptr;
+    QUdpSocket* m_beaconSocket = nullptr;
+    QTimer* m_beaconTimer = nullptr;
+    QHash<QString, Client> m_clients;            // session id -> client (control sockets only)
+    QHash<QWebSocket*, QString> m_controlSockets; // socket -> current key in m_clients
+    QSet<QWebSocket*> m_uploadSockets;
+    QHash<QString, QSet<QString>> m_watchersByTarget;
+    QHash<QString, QString> m_watchingByWatcher;
+    QHash<QString, QHash<QString, FanOutTarget>> m_fanOutUploads; // uploadId -> target id -> part
+    QHash<QString, QString> m_fanOutSenders;                      // uploadId -> sender id
+    qint64 m_directoryVersion = 0;
+    bool m_directoryPublishScheduled = false;
+};
+
+/**
+ * EmbeddedHub - In-process relay so one client can stand in for server.js on an isolated LAN
+ *
+ * Implements the routing subset the client relies on: welcome/register, client lists, screens
+ * requests and watching, state deltas, cursor streams, and relaying upload (including fan-out,
+ * direct-transfer negotiation and removals), progress and remote-scene messages. The hub host's
+ * own client connects over loopback. Server-side bookkeeping is not implemented: no state_sync
+ * after reconnect, no canvas tracking, no upload timeouts. Directory changes are published as
+ * full client_list snapshots.
+ *
+ * The server and its sockets live on a dedicated "MouffetteHub" thread, so relayed chunks never
+ * touch the GUI thread. While listening, the hub broadcasts a UDP beacon on kDiscoveryPort, which
+ * HubLocator picks up on other machines.
+ *
+ * Opt-in with MOUFFETTE_HUB=1. The port comes from MOUFFETTE_HUB_PORT (default kDefaultPort); 0
+ * picks a free port, which is useful when the hub is the relay for an automated run.
+ */
+class EmbeddedHub : public QObject {
+    Q_OBJECT
+public:
+    static constexpr quint16 kDefaultPort = 8080;
+    static constexpr quint16 kDiscoveryPort = 45454;
+
+    static bool enabled();
+    static quint16 configuredPort();
+
+    explicit EmbeddedHub(QObject* parent = nullptr);
+    ~EmbeddedHub() override;
+
+    // Blocks until the hub thread is listening (or failed to). advertise=false skips the LAN beacon.
+    bool start(quint16 port = configuredPort(), bool advertise = true);
+    void stop();
+    bool isListening() const { return m_port != 0; }
+    quint16 port() const { return m_port; }
+    // Loopback URL for the hosting client
+    QUrl localUrl() const;
+    // Blocks on the hub thread; see HubRouter::stats()
+    QJsonObject stats() const;
+
+private:
+    QThread* m_thread = nullptr;
+    HubRouter* m_router = nullptr;
+    quint16 m_port = 0;
+};
+
+/**
+ * HubLocator - Listens for EmbeddedHub beacons on the LAN
+ *
+ * Emits hubFound() for the first beacon it hears and then sticks to that hub: beacons from other
+ * hubs are ignored until the current one has been silent for a few beacon intervals. Opt-in with
+ * MOUFFETTE_HUB_DISCOVERY=1; the configured server URL is used until a hub has been seen.
+ */
+class HubLocator : public QObject {
+    Q_OBJECT
+public:
+    static bool enabled();
+
+    explicit HubLocator(QObject* parent = nullptr);
+
+    bool start();
+    QUrl hubUrl() const { return m_hubUrl; }
+
+signals:
+    void hubFound(const QUrl& url, const QString& machineName);
+
+private:
+    void onReadyRead();
+
+    QUdpSocket* m_socket = nullptr;
+    QUrl m_hubUrl;
+    QElapsedTimer m_sinceHubBeacon;
+};
+
+#endif // EMBEDDEDHUB_H
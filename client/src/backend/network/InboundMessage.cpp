@@ -0,0 +1,107 @@
+#include "backend/network/InboundMessage.h"
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+namespace {
+
+using Kind = InboundMessage::Kind;
+
+Kind kindForType(const QString& type) {
+    static const QHash<QString, Kind> kKinds = {
+        {QStringLiteral("welcome"), Kind::Welcome},
+        {QStringLiteral("error"), Kind::Error},
+        {QStringLiteral("registration_confirmed"), Kind::RegistrationConfirmed},
+        {QStringLiteral("client_list"), Kind::ClientList},
+        {QStringLiteral("client_joined"), Kind::ClientDirectoryDelta},
+        {QStringLiteral("client_updated"), Kind::ClientDirectoryDelta},
+        {QStringLiteral("client_left"), Kind::ClientDirectoryDelta},
+        {QStringLiteral("screens_info"), Kind::ScreensInfo},
+        {QStringLiteral("watch_status"), Kind::WatchStatus},
+        {QStringLiteral("data_request"), Kind::DataRequest},
+        {QStringLiteral("state_delta"), Kind::StateDelta},
+        {QStringLiteral("state_hash"), Kind::StateHash},
+        {QStringLiteral("cursor_update"), Kind::CursorUpdate},
+        {QStringLiteral("cursor_samples"), Kind::CursorSamples},
+        {QStringLiteral("upload_progress"), Kind::UploadProgress},
+        {QStringLiteral("upload_finished"), Kind::UploadFinished},
+        {QStringLiteral("all_files_removed"), Kind::AllFilesRemoved},
+        {QStringLiteral("upload_start"), Kind::UploadStart},
+        {QStringLiteral("upload_chunk"), Kind::UploadChunk},
+        {QStringLiteral("upload_complete"), Kind::UploadComplete},
+        {QStringLiteral("upload_abort"), Kind::UploadAbort},
+        {QStringLiteral("remote_scene_start"), Kind::RemoteSceneStart},
+        {QStringLiteral("remote_scene_stop"), Kind::RemoteSceneStop},
+        {QStringLiteral("remote_scene_stopped"), Kind::RemoteSceneStopped},
+        {QStringLiteral("remote_scene_validation"), Kind::RemoteSceneValidation},
+        {QStringLiteral("remote_scene_launched"), Kind::RemoteSceneLaunched},
+    };
+    return kKinds.value(type, Kind::Unknown);
+}
+
+} // anonymous namespace
+
+bool InboundMessage::parse(const QByteArray& utf8, InboundMessage* out, QString* errorMessage) {
+    auto fail = [errorMessage](const QString& message) {
+        if (errorMessage) *errorMessage = message;
+        return false;
+    };
+    if (!out) {
+        return fail(QStringLiteral("no output message"));
+    }
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(utf8, &error);
+    if (error.error != QJsonParseError::NoError) {
+        return fail(error.errorString());
+    }
+    if (!doc.isObject()) {
+        return fail(QStringLiteral("message is not a JSON object"));
+    }
+
+    InboundMessage message;
+    message.json = doc.object();
+    message.type = message.json.value("type").toString();
+    if (message.type.isEmpty()) {
+        return fail(QStringLiteral("message has no type"));
+    }
+    message.kind = kindForType(message.type);
+
+    switch (message.kind) {
+    case Kind::RegistrationConfirmed:
+    case Kind::ScreensInfo:
+        message.clientInfo = ClientInfo::fromJson(message.json.value("clientInfo").toObject());
+        break;
+    case Kind::ClientList: {
+        const QJsonArray clients = message.json.value("clients").toArray();
+        message.clients.reserve(clients.size());
+        for (const QJsonValue& v : clients) {
+            message.clients.append(ClientInfo::fromJson(v.toObject()));
+        }
+        break;
+    }
+    case Kind::ClientDirectoryDelta:
+        if (message.type != QLatin1String("client_left")) {
+            message.clientInfo = ClientInfo::fromJson(message.json.value("client").toObject());
+        }
+        break;
+    case Kind::CursorSamples:
+        if (!CursorStream::decode(message.json, &message.cursorSamples)) {
+            return fail(QStringLiteral("malformed cursor_samples batch"));
+        }
+        break;
+    case Kind::UploadChunk:
+        if (message.json.value("uploadId").toString().isEmpty() ||
+            message.json.value("fileId").toString().isEmpty() ||
+            !message.json.value("data").isString()) {
+            return fail(QStringLiteral("malformed upload_chunk"));
+        }
+        break;
+    default:
+        break;
+    }
+
+    *out = std::move(message);
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef INBOUNDMESSAGE_H
+#define INBOUNDMESSAGE_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+#include "backend/domain/models/ClientInfo.h"
+#include "backend/network/CursorStream.h"
+
+/**
+ * InboundMessage - A server message parsed, validated and classified off the GUI thread
+ *
+ * ThreadedWebSocket turns every text frame into one of these on the network thread. It parses the
+ * JSON, maps "type" to a Kind once, and decodes payloads that are costly to convert (client
+ * lists, client info, cursor batches) into their value types. WebSocketClient then dispatches
+ * with a switch and never parses JSON on the GUI thread.
+ *
+ * Frames that are not a JSON object with a "type", or whose typed payload fails to decode, are
+ * rejected by parse() and dropped on the network thread.
+ */
+struct InboundMessage {
+    enum class Kind {
+        Unknown, // forwarded as-is through WebSocketClient::messageReceived
+        Welcome,
+        Error,
+        RegistrationConfirmed,
+        ClientList,
+        ClientDirectoryDelta,
+        ScreensInfo,
+        WatchStatus,
+        DataRequest,
+        StateDelta,
+        StateHash,
+        CursorUpdate,
+        CursorSamples,
+        UploadProgress,
+        UploadFinished,
+        AllFilesRemoved,
+        // Target side of an upload; chunks are consumed by IncomingChunkWriter on the network thread
+        UploadStart,
+        UploadChunk,
+        UploadComplete,
+        UploadAbort,
+        RemoteSceneStart,
+        RemoteSceneStop,
+        RemoteSceneStopped,
+        RemoteSceneValidation,
+        RemoteSceneLaunched
+    };
+
+    Kind kind = Kind::Unknown;
+    QString type;     // raw "type", kept for logging and generic forwarding
+    QJsonObject json; // the full message
+    // Decoded payloads, filled according to kind
+    QList<ClientInfo> clients;          // ClientList
+    ClientInfo clientInfo;              // RegistrationConfirmed, ScreensInfo, client_joined/updated
+    QVector<CursorSample> cursorSamples; // CursorSamples
+
+    // Safe to call from any thread
+    static bool parse(const QByteArray& utf8, InboundMessage* out, QString* errorMessage = nullptr);
+};
+
+Q_DECLARE_METATYPE(InboundMessage)
+
+#endif // INBOUNDMESSAGE_H
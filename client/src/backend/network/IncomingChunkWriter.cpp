@@ -0,0 +1,190 @@
+#include "backend/network/IncomingChunkWriter.h"
+#include "backend/domain/session/SessionManager.h" // DEFAULT_IDEA_ID
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QStandardPaths>
+
+IncomingChunkWriter::IncomingChunkWriter(QObject* parent)
+    : QObject(parent), m_cacheRoot(defaultCacheRoot()) {}
+
+IncomingChunkWriter::~IncomingChunkWriter() {
+    QMutexLocker locker(&m_mutex);
+    closeFilesLocked();
+}
+
+QString IncomingChunkWriter::defaultCacheRoot() {
+    QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (base.isEmpty()) base = QDir::homePath() + "/.cache";
+    return base + "/Mouffette/Uploads";
+}
+
+void IncomingChunkWriter::setCacheRoot(const QString& root) {
+    QMutexLocker locker(&m_mutex);
+    m_cacheRoot = root;
+}
+
+QString IncomingChunkWriter::cacheRoot() const {
+    QMutexLocker locker(&m_mutex);
+    return m_cacheRoot;
+}
+
+QString IncomingChunkWriter::cacheDirFor(const QString& senderId) const {
+    return cacheRoot() + "/" + senderId;
+}
+
+QString IncomingChunkWriter::cacheFilePath(const QString& senderId, const QString& fileId, const QString& extension) const {
+    return filePathIn(cacheDirFor(senderId), fileId, extension);
+}
+
+QString IncomingChunkWriter::filePathIn(const QString& cacheDir, const QString& fileId, const QString& extension) {
+    // fileId as filename, with the original extension
+    QString filename = fileId;
+    if (!extension.isEmpty()) {
+        filename += "." + extension;
+    }
+    return cacheDir + "/" + filename;
+}
+
+bool IncomingChunkWriter::apply(const QJsonObject& message) {
+    const QString type = message.value("type").toString();
+    if (type == QLatin1String("upload_chunk")) {
+        writeChunk(message);
+        return true;
+    }
+    if (type == QLatin1String("upload_start")) {
+        begin(message);
+    } else if (type == QLatin1String("upload_complete")) {
+        finish(message.value("uploadId").toString());
+    } else if (type == QLatin1String("upload_abort")) {
+        discard(message.value("uploadId").toString());
+    }
+    return false;
+}
+
+QSet<QString> IncomingChunkWriter::openedFileIds(const QString& uploadId) const {
+    QMutexLocker locker(&m_mutex);
+    return uploadId == m_uploadId ? m_openedFileIds : QSet<QString>();
+}
+
+void IncomingChunkWriter::discard(const QString& uploadId) {
+    QMutexLocker locker(&m_mutex);
+    if (!uploadId.isEmpty() && uploadId != m_uploadId) return;
+    closeFilesLocked();
+    m_uploadId.clear();
+    m_canvasSessionId.clear();
+    m_openedFileIds.clear();
+}
+
+void IncomingChunkWriter::begin(const QJsonObject& message) {
+    const QString senderId = message.value("senderClientId").toString();
+    const QString cacheDir = cacheDirFor(senderId);
+    QDir().mkpath(cacheDir);
+
+    QMutexLocker locker(&m_mutex);
+    // A new upload_start replaces whatever was being received
+    closeFilesLocked();
+    m_openedFileIds.clear();
+    m_uploadId = message.value("uploadId").toString();
+    m_canvasSessionId = message.value("canvasSessionId").toString();
+    m_sinceProgress.invalidate();
+    for (const QJsonValue& v : message.value("files").toArray()) {
+        const QJsonObject f = v.toObject();
+        const QString fileId = f.value("fileId").toString();
+        if (fileId.isEmpty()) continue;
+        auto* file = new QFile(filePathIn(cacheDir, fileId, f.value("extension").toString()));
+        if (!file->open(QIODevice::WriteOnly)) {
+            qWarning() << "IncomingChunkWriter: Cannot create" << file->fileName() << ":" << file->errorString();
+            delete file;
+            continue;
+        }
+        OpenFile entry;
+        entry.file = file;
+        entry.expected = qMax<qint64>(0, static_cast<qint64>(f.value("sizeBytes").toDouble()));
+        m_files.insert(fileId, entry);
+        m_openedFileIds.insert(fileId);
+    }
+}
+
+void IncomingChunkWriter::writeChunk(const QJsonObject& message) {
+    MOUFFETTE_TRACE_SCOPE("upload.receiveChunk");
+    const QString uploadId = message.value("uploadId").toString();
+    const QString fileId = message.value("fileId").toString();
+    const QString canvasSessionId = message.value("canvasSessionId").toString();
+    const int chunkIndex = message.value("chunkIndex").toInt();
+    // Decoded before taking the lock; chunks for other uploads are rare
+    const QByteArray data = QByteArray::fromBase64(message.value("data").toString().toLatin1());
+
+    QHash<QString, qint64> snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (uploadId != m_uploadId) return;
+        if (!canvasSessionId.isEmpty() && m_canvasSessionId != DEFAULT_IDEA_ID && canvasSessionId != m_canvasSessionId) {
+            qWarning() << "IncomingChunkWriter: Ignoring chunk for mismatched idea" << canvasSessionId << "expected" << m_canvasSessionId;
+            return;
+        }
+        auto it = m_files.find(fileId);
+        if (it == m_files.end() || !it->file) return;
+        if (chunkIndex != it->nextChunk) {
+            qWarning() << "IncomingChunkWriter: Out-of-order chunk for" << fileId
+                       << "(upload" << uploadId << ") - expected" << it->nextChunk
+                       << "got" << chunkIndex << "- dropping to prevent corruption";
+            MOUFFETTE_METRIC_COUNT("upload.chunksDroppedOutOfOrder", 1);
+            return;
+        }
+        ++it->nextChunk;
+
+        const qint64 written = it->file->write(data);
+        if (written != data.size()) {
+            qWarning() << "IncomingChunkWriter: Partial write - expected" << data.size() << "wrote" << written;
+        }
+        // Remote scenes may open the file before the upload completes
+        it->file->flush();
+        it->received += data.size();
+        MOUFFETTE_METRIC_COUNT("upload.chunksReceived", 1);
+        MOUFFETTE_METRIC_COUNT("upload.bytesReceived", data.size());
+
+        const bool fileDone = it->expected > 0 && it->received >= it->expected;
+        if (!fileDone && m_sinceProgress.isValid() && m_sinceProgress.elapsed() < kProgressIntervalMs) {
+            return;
+        }
+        m_sinceProgress.start();
+        snapshot = receivedLocked();
+    }
+    emit progress(uploadId, snapshot);
+}
+
+void IncomingChunkWriter::finish(const QString& uploadId) {
+    QHash<QString, qint64> snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (uploadId.isEmpty() || uploadId != m_uploadId || m_files.isEmpty()) return;
+        snapshot = receivedLocked();
+        closeFilesLocked();
+        // m_uploadId and m_openedFileIds stay until the next upload for openedFileIds()
+    }
+    emit progress(uploadId, snapshot);
+}
+
+void IncomingChunkWriter::closeFilesLocked() {
+    for (OpenFile& entry : m_files) {
+        if (!entry.file) continue;
+        entry.file->flush();
+        entry.file->close();
+        delete entry.file;
+    }
+    m_files.clear();
+}
+
+QHash<QString, qint64> IncomingChunkWriter::receivedLocked() const {
+    QHash<QString, qint64> received;
+    received.reserve(m_files.size());
+    for (auto it = m_files.cbegin(); it != m_files.cend(); ++it) {
+        received.insert(it.key(), it->received);
+    }
+    return received;
+}
@@ -0,0 +1,79 @@
+#ifndef INCOMINGCHUNKWRITER_H
+#define INCOMINGCHUNKWRITER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+class QFile;
+
+/**
+ * IncomingChunkWriter - Target-side file writer for the upload currently being received
+ *
+ * Relayed upload_* messages are applied here by ThreadedWebSocket on the network thread, before
+ * anything is posted to the GUI thread. upload_start opens the cache files, upload_chunk payloads
+ * are base64-decoded and appended in chunk order, upload_complete closes the files and
+ * upload_abort drops them. Chunk data therefore never reaches the GUI thread; UploadManager only
+ * sees progress(), coalesced to one emission per kProgressIntervalMs plus one whenever a file
+ * completes.
+ *
+ * All methods are thread-safe. progress() is emitted from the calling thread without the lock
+ * held, so GUI-thread receivers get it queued from relayed frames and directly from the LAN
+ * direct-transfer path.
+ */
+class IncomingChunkWriter : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int kProgressIntervalMs = 50;
+
+    explicit IncomingChunkWriter(QObject* parent = nullptr);
+    ~IncomingChunkWriter() override;
+
+    // <CacheLocation>/Mouffette/Uploads, shared by every writer that keeps the default
+    static QString defaultCacheRoot();
+    // Root of the per-sender cache folders; set before the first upload (soak clients get one each)
+    void setCacheRoot(const QString& root);
+    QString cacheRoot() const;
+    QString cacheDirFor(const QString& senderId) const;
+    QString cacheFilePath(const QString& senderId, const QString& fileId, const QString& extension) const;
+
+    // Applies a target-side upload_* message; true when nothing else needs to see it (chunks)
+    bool apply(const QJsonObject& message);
+    // fileIds of uploadId whose cache file could be created
+    QSet<QString> openedFileIds(const QString& uploadId) const;
+    // Closes the files of uploadId (of any upload when empty); later chunks for it are dropped
+    void discard(const QString& uploadId = QString());
+
+signals:
+    // Absolute bytes received per fileId of uploadId
+    void progress(const QString& uploadId, const QHash<QString, qint64>& receivedByFile);
+
+private:
+    struct OpenFile {
+        QFile* file = nullptr;
+        qint64 expected = 0;
+        qint64 received = 0;
+        int nextChunk = 0;
+    };
+
+    static QString filePathIn(const QString& cacheDir, const QString& fileId, const QString& extension);
+    void begin(const QJsonObject& message);
+    void writeChunk(const QJsonObject& message);
+    void finish(const QString& uploadId);
+    void closeFilesLocked();
+    QHash<QString, qint64> receivedLocked() const;
+
+    mutable QMutex m_mutex;
+    QString m_cacheRoot;
+    QString m_uploadId;
+    QString m_canvasSessionId;
+    QHash<QString, OpenFile> m_files;
+    QSet<QString> m_openedFileIds;
+    QElapsedTimer m_sinceProgress;
+};
+
+#endif // INCOMINGCHUNKWRITER_H
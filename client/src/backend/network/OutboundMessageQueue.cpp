@@ -0,0 +1,54 @@
+#include "backend/network/OutboundMessageQueue.h"
+#include <algorithm>
+
+QString OutboundMessageQueue::coalesceKey(const QString& type, const QString& target, const QString& entity) {
+    return type + QLatin1Char('|') + target + QLatin1Char('|') + entity;
+}
+
+OutboundMessageQueue::OutboundMessageQueue() {
+    m_clock.start();
+}
+
+bool OutboundMessageQueue::enqueue(const QJsonObject& message, Priority priority, const QString& coalesceKey) {
+    const int lane = std::clamp(static_cast<int>(priority), 0, kPriorityCount - 1);
+    Entry entry{message, coalesceKey, m_clock.elapsed()};
+    bool superseded = false;
+    if (!coalesceKey.isEmpty()) {
+        const auto it = m_keyed.constFind(coalesceKey);
+        if (it != m_keyed.constEnd()) {
+            std::optional<Entry>& previous = m_lanes[it->first][it->second];
+            entry.enqueuedAtMs = previous->enqueuedAtMs;
+            previous.reset();
+            --m_size;
+            superseded = true;
+        }
+        m_keyed.insert(coalesceKey, qMakePair(lane, static_cast<int>(m_lanes[lane].size())));
+    }
+    m_lanes[lane].append(std::move(entry));
+    ++m_size;
+    return superseded;
+}
+
+QVector<OutboundMessageQueue::Entry> OutboundMessageQueue::takeAll() {
+    QVector<Entry> out;
+    out.reserve(m_size);
+    for (auto& lane : m_lanes) {
+        for (std::optional<Entry>& entry : lane) {
+            if (entry) {
+                out.append(std::move(*entry));
+            }
+        }
+        lane.clear();
+    }
+    m_keyed.clear();
+    m_size = 0;
+    return out;
+}
+
+void OutboundMessageQueue::clear() {
+    for (auto& lane : m_lanes) {
+        lane.clear();
+    }
+    m_keyed.clear();
+    m_size = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef OUTBOUNDMESSAGEQUEUE_H
+#define OUTBOUNDMESSAGEQUEUE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <optional>
+
+/**
+ * OutboundMessageQueue
+ *
+ * Pending control-channel messages, drained once per event-loop tick by WebSocketClient.
+ * Messages are grouped in priority lanes (Critical before Normal before Bulk, FIFO within a lane)
+ * so a scene stop never waits behind a burst of cursor or progress chatter.
+ *
+ * A message enqueued with a coalesce key replaces any queued message with the same key: the
+ * superseded one is dropped and the new one goes to the back of its lane, so the relative order
+ * of what is actually sent matches the order it was produced in. Build keys with coalesceKey().
+ */
+class OutboundMessageQueue {
+public:
+    enum class Priority { Critical = 0, Normal = 1, Bulk = 2 };
+    static constexpr int kPriorityCount = 3;
+
+    struct Entry {
+        QJsonObject message;
+        QString coalesceKey;
+        qint64 enqueuedAtMs = 0; // first enqueue of the key, so age reflects how long the slot waited
+    };
+
+    // (type, target, entity) identity of a last-value-wins message
+    static QString coalesceKey(const QString& type, const QString& target = QString(), const QString& entity = QString());
+
+    OutboundMessageQueue();
+
+    // Returns true when the message superseded a queued one
+    bool enqueue(const QJsonObject& message, Priority priority, const QString& coalesceKey = QString());
+    // Remove and return every queued message in send order
+    QVector<Entry> takeAll();
+    void clear();
+
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+    qint64 nowMs() const { return m_clock.elapsed(); }
+
+private:
+    // Lanes keep tombstones for superseded entries until the next takeAll()
+    QVector<std::optional<Entry>> m_lanes[kPriorityCount];
+    QHash<QString, QPair<int, int>> m_keyed; // coalesce key -> (lane, index)
+    QElapsedTimer m_clock;
+    int m_size = 0;
+};
+
+#endif // OUTBOUNDMESSAGEQUEUE_H
@@ -0,0 +1,170 @@
+#include "backend/network/ThreadedWebSocket.h"
+#include "backend/network/IncomingChunkWriter.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QThread>
+#include <QWebSocket>
+#include <atomic>
+
+namespace {
+constexpr unsigned long kShutdownWaitMs = 2000;
+// Set on the GUI thread before the I/O thread is asked to quit; its event loop is gone afterwards
+std::atomic<bool> g_ioThreadStopping{false};
+}
+
+SocketIoWorker::SocketIoWorker(std::shared_ptr<IncomingChunkWriter> chunkWriter)
+    : m_chunkWriter(std::move(chunkWriter)) {}
+
+void SocketIoWorker::open(const QUrl& url) {
+    if (!m_socket) {
+        m_socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+        connect(m_socket, &QWebSocket::stateChanged, this, &SocketIoWorker::stateChanged);
+        connect(m_socket, &QWebSocket::connected, this, &SocketIoWorker::connected);
+        connect(m_socket, &QWebSocket::disconnected, this, &SocketIoWorker::disconnected);
+        connect(m_socket, &QWebSocket::errorOccurred, this, [this](QAbstractSocket::SocketError error) {
+            // The GUI side decides on retries from state(); make sure it is current first
+            emit stateChanged(m_socket->state());
+            emit errorOccurred(error);
+        });
+        connect(m_socket, &QWebSocket::pong, this, &SocketIoWorker::pong);
+        connect(m_socket, &QWebSocket::textMessageReceived, this, &SocketIoWorker::onTextMessage);
+    }
+    m_socket->open(url);
+}
+
+void SocketIoWorker::close() {
+    if (m_socket && m_socket->state() != QAbstractSocket::UnconnectedState) {
+        m_socket->close();
+    }
+}
+
+void SocketIoWorker::abort() {
+    if (m_socket) m_socket->abort();
+}
+
+void SocketIoWorker::ping() {
+    if (m_socket && m_socket->state() == QAbstractSocket::ConnectedState) {
+        m_socket->ping();
+    }
+}
+
+void SocketIoWorker::sendJson(const QJsonObject& message) {
+    MOUFFETTE_TRACE_SCOPE("ws.encode");
+    if (!m_socket || m_socket->state() != QAbstractSocket::ConnectedState) {
+        MOUFFETTE_METRIC_COUNT("ws.outbound.droppedDisconnected", 1);
+        return;
+    }
+    m_socket->sendTextMessage(QString::fromUtf8(QJsonDocument(message).toJson(QJsonDocument::Compact)));
+}
+
+void SocketIoWorker::onTextMessage(const QString& text) {
+    MOUFFETTE_TRACE_SCOPE("ws.decode");
+    InboundMessage message;
+    QString error;
+    if (!InboundMessage::parse(text.toUtf8(), &message, &error)) {
+        qWarning() << "Dropping inbound message:" << error;
+        MOUFFETTE_METRIC_COUNT("ws.inbound.rejected", 1);
+        return;
+    }
+    switch (message.kind) {
+    case InboundMessage::Kind::UploadStart:
+    case InboundMessage::Kind::UploadChunk:
+    case InboundMessage::Kind::UploadComplete:
+    case InboundMessage::Kind::UploadAbort:
+        // Files are opened, written and closed here; chunks go no further
+        if (m_chunkWriter && m_chunkWriter->apply(message.json)) {
+            MOUFFETTE_METRIC_COUNT("ws.inbound.chunksWritten", 1);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    MOUFFETTE_METRIC_COUNT("ws.inbound.posted", 1);
+    emit messageReceived(message);
+}
+
+ThreadedWebSocket::ThreadedWebSocket(std::shared_ptr<IncomingChunkWriter> chunkWriter, QObject* parent)
+    : QObject(parent)
+    , m_worker(new SocketIoWorker(std::move(chunkWriter))) {
+    m_worker->moveToThread(ioThread());
+    connect(m_worker, &SocketIoWorker::stateChanged, this, [this](QAbstractSocket::SocketState state) {
+        m_state = state;
+    });
+    connect(m_worker, &SocketIoWorker::connected, this, [this]() {
+        m_state = QAbstractSocket::ConnectedState;
+        emit connected();
+    });
+    connect(m_worker, &SocketIoWorker::disconnected, this, [this]() {
+        m_state = QAbstractSocket::UnconnectedState;
+        emit disconnected();
+    });
+    connect(m_worker, &SocketIoWorker::errorOccurred, this, &ThreadedWebSocket::errorOccurred);
+    connect(m_worker, &SocketIoWorker::pong, this, &ThreadedWebSocket::pong);
+    connect(m_worker, &SocketIoWorker::messageReceived, this, &ThreadedWebSocket::messageReceived);
+}
+
+ThreadedWebSocket::~ThreadedWebSocket() {
+    // Already-queued calls still run first; the socket closes when the worker is destroyed
+    m_worker->disconnect(this);
+    SocketIoWorker* worker = m_worker;
+    QThread* thread = ioThread();
+    if (!g_ioThreadStopping.load() && thread->isRunning() && QThread::currentThread() != thread) {
+        QMetaObject::invokeMethod(worker, [worker]() { delete worker; }, Qt::BlockingQueuedConnection);
+    } else {
+        // No event loop left to run a deleteLater(); nothing else touches the worker any more
+        delete worker;
+    }
+    m_worker = nullptr;
+}
+
+void ThreadedWebSocket::open(const QUrl& url) {
+    m_state = QAbstractSocket::ConnectingState;
+    SocketIoWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, url]() { worker->open(url); }, Qt::QueuedConnection);
+}
+
+void ThreadedWebSocket::close() {
+    SocketIoWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->close(); }, Qt::QueuedConnection);
+}
+
+void ThreadedWebSocket::abort() {
+    SocketIoWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->abort(); }, Qt::QueuedConnection);
+}
+
+void ThreadedWebSocket::ping() {
+    SocketIoWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->ping(); }, Qt::QueuedConnection);
+}
+
+void ThreadedWebSocket::sendJson(const QJsonObject& message) {
+    SocketIoWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, message]() { worker->sendJson(message); }, Qt::QueuedConnection);
+}
+
+QThread* ThreadedWebSocket::ioThread() {
+    static QThread* thread = []() {
+        qRegisterMetaType<InboundMessage>();
+        qRegisterMetaType<QAbstractSocket::SocketState>();
+        qRegisterMetaType<QAbstractSocket::SocketError>();
+        auto* t = new QThread();
+        t->setObjectName(QStringLiteral("MouffetteNetworkIO"));
+        t->start();
+        if (QCoreApplication* app = QCoreApplication::instance()) {
+            QObject::connect(app, &QCoreApplication::aboutToQuit, app, [t]() {
+                g_ioThreadStopping.store(true);
+                t->quit();
+                if (!t->wait(kShutdownWaitMs)) {
+                    qWarning() << "Network I/O thread did not stop in time";
+                }
+            });
+        }
+        return t;
+    }();
+    return thread;
+}
@@ -0,0 +1,84 @@
+#ifndef THREADEDWEBSOCKET_H
+#define THREADEDWEBSOCKET_H
+
+#include <QAbstractSocket>
+#include <QJsonObject>
+#include <QObject>
+#include <QUrl>
+#include <memory>
+#include "backend/network/InboundMessage.h"
+
+class QThread;
+class QWebSocket;
+class IncomingChunkWriter;
+
+// Owns the QWebSocket on the network thread; driven only through ThreadedWebSocket
+class SocketIoWorker : public QObject {
+    Q_OBJECT
+public:
+    explicit SocketIoWorker(std::shared_ptr<IncomingChunkWriter> chunkWriter);
+
+    // Network thread only
+    void open(const QUrl& url);
+    void close();
+    void abort();
+    void ping();
+    void sendJson(const QJsonObject& message);
+
+signals:
+    void stateChanged(QAbstractSocket::SocketState state);
+    void connected();
+    void disconnected();
+    void errorOccurred(QAbstractSocket::SocketError error);
+    void pong(quint64 elapsedTime, const QByteArray& payload);
+    void messageReceived(const InboundMessage& message);
+
+private:
+    void onTextMessage(const QString& text);
+
+    QWebSocket* m_socket = nullptr; // created on first open(), on the network thread
+    std::shared_ptr<IncomingChunkWriter> m_chunkWriter;
+};
+
+/**
+ * ThreadedWebSocket - GUI-thread handle to a WebSocket that lives on the shared network thread
+ *
+ * The socket, its frame handling and JSON (de)serialization run on one "MouffetteNetworkIO"
+ * thread shared by the control and upload connections. Every text frame is parsed into an
+ * InboundMessage there. Relayed upload_* messages are applied to the IncomingChunkWriter
+ * first, and chunks stop at the writer. Only decoded messages are posted back as
+ * messageReceived(). Outbound messages are handed over as QJsonObject and serialized on the
+ * network thread.
+ *
+ * Calls are queued to the network thread in order. state() mirrors the socket state as last
+ * reported by the network thread, and is set to Connecting as soon as open() is called.
+ */
+class ThreadedWebSocket : public QObject {
+    Q_OBJECT
+public:
+    explicit ThreadedWebSocket(std::shared_ptr<IncomingChunkWriter> chunkWriter, QObject* parent = nullptr);
+    ~ThreadedWebSocket() override;
+
+    void open(const QUrl& url);
+    void close();
+    void abort();
+    void ping();
+    void sendJson(const QJsonObject& message);
+    QAbstractSocket::SocketState state() const { return m_state; }
+
+    // Started on first use and stopped when the application quits
+    static QThread* ioThread();
+
+signals:
+    void connected();
+    void disconnected();
+    void errorOccurred(QAbstractSocket::SocketError error);
+    void pong(quint64 elapsedTime, const QByteArray& payload);
+    void messageReceived(const InboundMessage& message);
+
+private:
+    SocketIoWorker* m_worker = nullptr;
+    QAbstractSocket::SocketState m_state = QAbstractSocket::UnconnectedState;
+};
+
+#endif // THREADEDWEBSOCKET_H
@@ -1,13 +1,17 @@
 #include "backend/network/UploadManager.h"
 #include "backend/network/WebSocketClient.h"
+#include "backend/network/DirectTransferLink.h"
+#include "backend/network/DirectTransferServer.h"
+#include "backend/network/IncomingChunkWriter.h"
 #include "backend/files/FileManager.h"
 #include "backend/domain/session/SessionManager.h"  // Phase 3: For DEFAULT_IDEA_ID constant
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
 #include <QGraphicsScene>
 #include <QGraphicsItem>
 #include <QFileInfo>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QStandardPaths>
 #include <QDir>
 #include <QCoreApplication>
 #include <QEventLoop>
@@ -42,12 +46,58 @@ UploadManager::UploadManager(FileManager* fileManager, QObject* parent)
     connect(m_actionDebounceTimer, &QTimer::timeout, this, [this]() {
         m_actionInProgress = false;
     });
+
+    // Bounds how long a queued upload waits for the upload channel before using the control channel
+    m_uploadChannelWaitTimer = new QTimer(this);
+    m_uploadChannelWaitTimer->setSingleShot(true);
+    connect(m_uploadChannelWaitTimer, &QTimer::timeout, this, [this]() {
+        if (!m_pendingUploadFiles.isEmpty()) {
+            qWarning() << "UploadManager: Upload channel not ready in time; streaming over control channel";
+            flushPendingUpload();
+        }
+    });
+
+    m_directOfferTimer = new QTimer(this);
+    m_directOfferTimer->setSingleShot(true);
+    connect(m_directOfferTimer, &QTimer::timeout, this, [this]() {
+        if (m_directState == DirectTransferState::Negotiating) {
+            qInfo() << "UploadManager: No direct transfer offer from target; using the relay";
+            finishDirectNegotiation(false);
+        }
+    });
+    m_directLink = new DirectTransferLink(this);
+    connect(m_directLink, &DirectTransferLink::opened, this, [this]() {
+        if (m_directState == DirectTransferState::Negotiating) finishDirectNegotiation(true);
+    });
+    connect(m_directLink, &DirectTransferLink::failed, this, [this](const QString& reason) {
+        if (m_directState != DirectTransferState::Negotiating) return;
+        qInfo() << "UploadManager: Direct link unavailable (" << reason << "); using the relay";
+        finishDirectNegotiation(false);
+    });
+    connect(m_directLink, &DirectTransferLink::closed, this, &UploadManager::onDirectLinkClosed);
 }
 
-void UploadManager::setWebSocketClient(WebSocketClient* client) { m_ws = client; }
+void UploadManager::setWebSocketClient(WebSocketClient* client) {
+    if (m_ws) {
+        disconnect(m_ws, &WebSocketClient::uploadChannelReadyChanged, this, &UploadManager::onUploadChannelReadyChanged);
+        disconnect(m_ws->chunkWriter(), &IncomingChunkWriter::progress, this, &UploadManager::onIncomingChunkProgress);
+    }
+    m_ws = client;
+    if (m_ws) {
+        connect(m_ws, &WebSocketClient::uploadChannelReadyChanged, this, &UploadManager::onUploadChannelReadyChanged);
+        // Emitted from the network thread for relayed uploads
+        connect(m_ws->chunkWriter(), &IncomingChunkWriter::progress, this, &UploadManager::onIncomingChunkProgress);
+    }
+}
 void UploadManager::setTargetClientId(const QString& id) { m_targetClientId = id; }
 
 void UploadManager::forceResetForClient(const QString& clientId) {
+    if (!clientId.isEmpty() && m_fanOutTargets.contains(clientId) && m_fanOutTargets.size() > 1) {
+        // One fan-out target went away; the remaining ones keep their stream
+        dropFanOutTarget(clientId, false);
+        emit uiStateChanged();
+        return;
+    }
     if (!clientId.isEmpty()) {
         const bool matchesUploadTarget = (!m_uploadTargetClientId.isEmpty() && m_uploadTargetClientId == clientId);
         const bool matchesCurrentTarget = (!m_targetClientId.isEmpty() && m_targetClientId == clientId);
@@ -61,7 +111,7 @@ void UploadManager::forceResetForClient(const QString& clientId) {
 }
 
 void UploadManager::toggleUpload(const QVector<UploadFileInfo>& files) {
-    if (!m_ws || !m_ws->isConnected() || m_targetClientId.isEmpty()) {
+    if (!m_ws || !m_ws->isConnected() || (m_targetClientId.isEmpty() && !isFanOutUpload())) {
         qWarning() << "UploadManager: Not connected or no target set";
         return;
     }
@@ -86,6 +136,15 @@ void UploadManager::toggleUpload(const QVector<UploadFileInfo>& files) {
     if (m_uploadActive) {
         // If active state but we are provided with additional files, start a new upload for them
         if (!files.isEmpty()) {
+            if (isFanOutUpload()) {
+                // Send the additions to the same set of targets
+                QVector<UploadTarget> targets;
+                for (auto it = m_fanOutTargets.cbegin(); it != m_fanOutTargets.cend(); ++it) {
+                    targets.append(UploadTarget{it.key(), it.value().canvasSessionId});
+                }
+                startFanOutUpload(files, targets);
+                return;
+            }
             startUpload(files);
             return;
         }
@@ -104,6 +163,149 @@ void UploadManager::toggleUpload(const QVector<UploadFileInfo>& files) {
     startUpload(files);
 }
 
+void UploadManager::startFanOutUpload(const QVector<UploadFileInfo>& files, const QVector<UploadTarget>& targets) {
+    if (!m_ws || !m_ws->isConnected()) {
+        qWarning() << "UploadManager: Not connected; fan-out upload ignored";
+        return;
+    }
+    if (m_uploadInProgress || m_finalizing || m_cancelFinalizePending) {
+        qWarning() << "UploadManager: Upload already in progress, ignoring fan-out start request";
+        return;
+    }
+
+    QHash<QString, FanOutTarget> plan;
+    int receivers = 0;
+    for (const UploadTarget& target : targets) {
+        if (target.clientId.isEmpty() || plan.contains(target.clientId)) continue;
+        FanOutTarget state;
+        state.canvasSessionId = target.canvasSessionId.isEmpty() ? DEFAULT_IDEA_ID : target.canvasSessionId;
+        for (const auto& f : files) {
+            if (m_fileManager->isFileUploadedToClient(f.fileId, target.clientId)) continue;
+            state.fileIds.insert(f.fileId);
+            if (f.size > 0) state.totalBytes += f.size;
+        }
+        // Kept even when it needs nothing so a later unload still reaches it
+        state.finished = state.fileIds.isEmpty();
+        if (state.finished) state.percent = 100;
+        else ++receivers;
+        plan.insert(target.clientId, state);
+    }
+    if (receivers == 0) {
+        qInfo() << "UploadManager: Every fan-out target already holds these files";
+        return;
+    }
+
+    // Only files at least one target still needs are streamed
+    QVector<UploadFileInfo> needed;
+    for (const auto& f : files) {
+        for (const FanOutTarget& state : std::as_const(plan)) {
+            if (state.fileIds.contains(f.fileId)) {
+                needed.append(f);
+                break;
+            }
+        }
+    }
+
+    m_fanOutTargets = plan;
+    m_fanOutRemovalsPending.clear();
+    MOUFFETTE_METRIC_COUNT("upload.fanOutTargets", receivers);
+    startUpload(needed);
+}
+
+void UploadManager::cancelFanOutTarget(const QString& clientId) {
+    auto it = m_fanOutTargets.constFind(clientId);
+    if (it == m_fanOutTargets.cend() || !m_ws || !m_ws->isConnected()) return;
+    if (!m_uploadInProgress || m_cancelRequested || it->finished) return;
+    if (m_fanOutTargets.size() == 1) {
+        // Last receiver: same as cancelling the whole upload
+        requestCancel();
+        return;
+    }
+    dropFanOutTarget(clientId, true);
+    emit uiStateChanged();
+}
+
+void UploadManager::dropFanOutTarget(const QString& clientId, bool notifyTarget) {
+    const FanOutTarget state = m_fanOutTargets.take(clientId);
+    if (notifyTarget && m_ws) {
+        if (!m_currentUploadId.isEmpty()) {
+            m_ws->sendFanOutUploadAbort(m_currentUploadId, QStringList{clientId}, "Target cancelled");
+        }
+        // Its all_files_removed is not in m_fanOutRemovalsPending and is ignored
+        m_ws->sendRemoveAllFiles(clientId, state.canvasSessionId);
+    }
+    m_fileManager->unmarkAllForClient(clientId);
+    emit targetUploadCanceled(clientId);
+    // Files only that target needed are skipped by the chunk loop from now on
+    updateFanOutRemoteProgress();
+    finishFanOutIfDone();
+}
+
+QStringList UploadManager::fanOutTargetsForFile(const QString& fileId) const {
+    QStringList ids;
+    for (auto it = m_fanOutTargets.cbegin(); it != m_fanOutTargets.cend(); ++it) {
+        if (it->fileIds.contains(fileId)) ids.append(it.key());
+    }
+    return ids;
+}
+
+QJsonArray UploadManager::fanOutTargetsJson() const {
+    QJsonArray arr;
+    for (auto it = m_fanOutTargets.cbegin(); it != m_fanOutTargets.cend(); ++it) {
+        if (it->fileIds.isEmpty()) continue;
+        QJsonObject target;
+        target["targetClientId"] = it.key();
+        target["canvasSessionId"] = it->canvasSessionId;
+        target["fileIds"] = QJsonArray::fromStringList(it->fileIds.values());
+        arr.append(target);
+    }
+    return arr;
+}
+
+void UploadManager::updateFanOutRemoteProgress() {
+    if (m_fanOutTargets.isEmpty()) return;
+    // Overall percent weighs each target by the bytes it receives
+    qint64 totalBytes = 0;
+    double receivedBytes = 0.0;
+    for (const FanOutTarget& state : std::as_const(m_fanOutTargets)) {
+        totalBytes += state.totalBytes;
+        receivedBytes += state.totalBytes * (state.percent / 100.0);
+    }
+    int percent = 0;
+    if (totalBytes > 0) {
+        percent = static_cast<int>(std::round(receivedBytes * 100.0 / static_cast<double>(totalBytes)));
+    } else {
+        int sum = 0;
+        for (const FanOutTarget& state : std::as_const(m_fanOutTargets)) sum += state.percent;
+        percent = sum / m_fanOutTargets.size();
+    }
+    // A file counts once every target that needs it has it
+    int filesCompleted = 0;
+    for (const auto& f : std::as_const(m_outgoingFiles)) {
+        const QStringList ids = fanOutTargetsForFile(f.fileId);
+        if (ids.isEmpty()) continue;
+        bool everywhere = true;
+        for (const QString& id : ids) {
+            const FanOutTarget& state = m_fanOutTargets[id];
+            if (!state.finished && !state.completedFileIds.contains(f.fileId)) {
+                everywhere = false;
+                break;
+            }
+        }
+        if (everywhere) ++filesCompleted;
+    }
+    updateRemoteProgress(percent, filesCompleted);
+}
+
+void UploadManager::finishFanOutIfDone() {
+    if (m_fanOutTargets.isEmpty() || !m_uploadInProgress || m_cancelRequested) return;
+    for (const FanOutTarget& state : std::as_const(m_fanOutTargets)) {
+        if (!state.finished) return;
+    }
+    updateRemoteProgress(100, m_totalFiles);
+    completeOutgoingUpload();
+}
+
 void UploadManager::requestRemoval(const QString& clientId) {
     if (!m_ws || !m_ws->isConnected() || clientId.isEmpty()) return;
     // Phase 3: canvasSessionId is MANDATORY - always set to DEFAULT_IDEA_ID at minimum
@@ -118,6 +320,17 @@ void UploadManager::requestRemoval(const QString& clientId) {
 }
 
 void UploadManager::requestUnload() {
+    if (isFanOutUpload()) {
+        if (!m_uploadActive || !m_ws || !m_ws->isConnected()) return;
+        scheduleActionDebounce();
+        for (auto it = m_fanOutTargets.cbegin(); it != m_fanOutTargets.cend(); ++it) {
+            m_fanOutRemovalsPending.insert(it.key());
+            m_ws->sendRemoveAllFiles(it.key(), it->canvasSessionId);
+        }
+        // State resets once every target confirmed in onAllFilesRemovedRemote()
+        emit uiStateChanged();
+        return;
+    }
     const QString clientId = m_uploadTargetClientId.isEmpty() ? m_targetClientId : m_uploadTargetClientId;
     if (!m_uploadActive || clientId.isEmpty()) return;
     // Phase 3: canvasSessionId is MANDATORY - always set to DEFAULT_IDEA_ID at minimum
@@ -135,6 +348,27 @@ void UploadManager::requestUnload() {
 }
 
 void UploadManager::requestCancel() {
+    if (isFanOutUpload()) {
+        if (!m_ws || !m_ws->isConnected() || !m_uploadInProgress || m_cancelRequested) return;
+        scheduleActionDebounce();
+        if (!m_pendingUploadFiles.isEmpty()) {
+            resetToInitial();
+            emit uiStateChanged();
+            return;
+        }
+        m_cancelRequested = true;
+        m_cancelFinalizePending = true;
+        if (!m_currentUploadId.isEmpty()) {
+            m_ws->sendFanOutUploadAbort(m_currentUploadId, QStringList(), "User cancelled");
+        }
+        for (auto it = m_fanOutTargets.cbegin(); it != m_fanOutTargets.cend(); ++it) {
+            m_fanOutRemovalsPending.insert(it.key());
+            m_ws->sendRemoveAllFiles(it.key(), it->canvasSessionId);
+        }
+        emit uiStateChanged();
+        startCancelFallbackTimer();
+        return;
+    }
     const QString clientId = m_uploadTargetClientId.isEmpty() ? m_targetClientId : m_uploadTargetClientId;
     if (!m_ws || !m_ws->isConnected() || clientId.isEmpty()) return;
     if (!m_uploadInProgress) return;
@@ -148,6 +382,13 @@ void UploadManager::requestCancel() {
     // Mark action in progress to prevent spam
     scheduleActionDebounce();
     
+    if (!m_pendingUploadFiles.isEmpty() || !m_directNegotiationFiles.isEmpty()) {
+        // Nothing reached the server yet: drop the queued upload locally
+        resetToInitial();
+        emit uiStateChanged();
+        return;
+    }
+
     m_cancelRequested = true;
     m_cancelFinalizePending = true;
     if (!m_currentUploadId.isEmpty()) {
@@ -157,7 +398,11 @@ void UploadManager::requestCancel() {
     requestRemoval(clientId);
     // We'll reset final state upon all_files_removed callback
     emit uiStateChanged();
-    // Start fallback timer (3s) in case remote never responds
+    startCancelFallbackTimer();
+}
+
+void UploadManager::startCancelFallbackTimer() {
+    // Fallback (3s) in case remote never responds
     if (!m_cancelFallbackTimer) {
         m_cancelFallbackTimer = new QTimer(this);
         m_cancelFallbackTimer->setSingleShot(true);
@@ -171,6 +416,7 @@ void UploadManager::requestCancel() {
 }
 
 void UploadManager::startUpload(const QVector<UploadFileInfo>& files) {
+    MOUFFETTE_TRACE_SCOPE("upload.startUpload");
     // Prevent concurrent uploads
     if (m_uploadInProgress || m_finalizing) {
         qWarning() << "UploadManager: Upload already in progress, ignoring new start request";
@@ -185,10 +431,6 @@ void UploadManager::startUpload(const QVector<UploadFileInfo>& files) {
     // Mark action in progress to prevent spam
     scheduleActionDebounce();
     
-    if (m_ws) {
-        // Prepare the dedicated upload channel to avoid blocking control messages
-        m_ws->beginUploadSession(true);
-    }
     // Capture stable target id for the entire upload session
     m_uploadTargetClientId = m_targetClientId;
     m_currentUploadId = QUuid::createUuid().toString(QUuid::WithoutBraces);
@@ -204,6 +446,155 @@ void UploadManager::startUpload(const QVector<UploadFileInfo>& files) {
     emit uiStateChanged();
     resetProgressTracking();
 
+    if (m_ws && m_ws->isConnected() && !m_ws->isUploadChannelReady()) {
+        // The channel is normally pre-warmed; if it is (re)connecting, queue instead of blocking the UI
+        m_pendingUploadFiles = files;
+        m_ws->ensureUploadChannel();
+        m_uploadChannelWaitTimer->start(UPLOAD_CHANNEL_WAIT_MS);
+        MOUFFETTE_METRIC_COUNT("upload.queuedForChannel", 1);
+        return;
+    }
+    streamUpload(files);
+}
+
+void UploadManager::onUploadChannelReadyChanged(bool ready) {
+    if (ready && !m_pendingUploadFiles.isEmpty()) {
+        flushPendingUpload();
+    }
+}
+
+void UploadManager::flushPendingUpload() {
+    const QVector<UploadFileInfo> files = m_pendingUploadFiles;
+    clearPendingUpload();
+    if (files.isEmpty() || !m_uploadInProgress || m_cancelRequested) {
+        return;
+    }
+    streamUpload(files);
+}
+
+void UploadManager::clearPendingUpload() {
+    m_pendingUploadFiles.clear();
+    if (m_uploadChannelWaitTimer) m_uploadChannelWaitTimer->stop();
+}
+
+void UploadManager::handleDirectTransferRequest(const QJsonObject& message) {
+    const QString senderClientId = message.value("senderClientId").toString();
+    const QString uploadId = message.value("uploadId").toString();
+    if (!m_ws || senderClientId.isEmpty()) return;
+    QString token;
+    quint16 port = 0;
+    QStringList addresses;
+    bool available = false;
+    if (DirectTransferServer::enabled()) {
+        if (!m_directServer) {
+            m_directServer = new DirectTransferServer(this);
+            connect(m_directServer, &DirectTransferServer::messageReceived, this, [this](const QJsonObject& message) {
+                // Same writer as relayed uploads; chunks stop there
+                if (m_ws && m_ws->chunkWriter()->apply(message)) return;
+                handleIncomingMessage(message);
+            });
+        }
+        available = m_directServer->offer(senderClientId, &token, &port, &addresses);
+    }
+    // Always answer so the sender falls back to the relay without waiting for its timeout
+    m_ws->sendDirectTransferOffer(senderClientId, uploadId, available, token, port, addresses);
+}
+
+void UploadManager::handleDirectTransferOffer(const QJsonObject& message) {
+    // Late offers (streaming already started over the relay) are ignored
+    if (m_directState != DirectTransferState::Negotiating || m_directNegotiationFiles.isEmpty()) return;
+    if (message.value("uploadId").toString() != m_currentUploadId) return;
+    m_directOfferTimer->stop();
+    QStringList addresses;
+    for (const QJsonValue& v : message.value("addresses").toArray()) addresses.append(v.toString());
+    const int port = message.value("port").toInt();
+    if (!message.value("available").toBool() || addresses.isEmpty() || port <= 0 || port > 65535) {
+        finishDirectNegotiation(false);
+        return;
+    }
+    m_directLink->open(addresses, static_cast<quint16>(port), message.value("token").toString(), DIRECT_CONNECT_TIMEOUT_MS);
+}
+
+void UploadManager::finishDirectNegotiation(bool linked) {
+    m_directOfferTimer->stop();
+    const QVector<UploadFileInfo> files = m_directNegotiationFiles;
+    m_directNegotiationFiles.clear();
+    if (files.isEmpty()) {
+        // Nothing left waiting on this negotiation; never attach a link to a stream in progress
+        linked = false;
+    }
+    if (linked) {
+        m_directState = DirectTransferState::Active;
+        m_ws->setDirectUploadLink(m_directLink);
+        MOUFFETTE_METRIC_COUNT("directTransfer.uploadsDirect", 1);
+    } else {
+        m_directState = DirectTransferState::Unavailable;
+        m_directLink->close();
+        MOUFFETTE_METRIC_COUNT("directTransfer.uploadsRelayed", 1);
+    }
+    if (!files.isEmpty() && m_uploadInProgress && !m_cancelRequested) {
+        streamUpload(files);
+    }
+}
+
+void UploadManager::onDirectLinkClosed() {
+    if (m_directState != DirectTransferState::Active) return;
+    m_directLinkLost = true;
+    if (m_ws) m_ws->setDirectUploadLink(nullptr);
+    // Mid-stream the chunk loop notices the flag; otherwise upload_complete may not have arrived
+    if (!m_directStreaming && m_uploadInProgress && !m_cancelRequested) {
+        restartOverRelay(m_outgoingFiles);
+    }
+}
+
+void UploadManager::restartOverRelay(const QVector<UploadFileInfo>& files) {
+    if (!m_ws) return;
+    qWarning() << "UploadManager: Direct link lost during upload" << m_currentUploadId << "- restarting over the relay";
+    MOUFFETTE_METRIC_COUNT("directTransfer.restartsOverRelay", 1);
+    const QString previousUploadId = m_currentUploadId;
+    releaseDirectLink();
+    m_directState = DirectTransferState::Unavailable;
+    // Only the server tracked the direct attempt; the target drops it on the next upload_start
+    m_ws->sendUploadAbort(m_uploadTargetClientId, previousUploadId, "Direct link lost", m_activeIdeaId, false);
+    m_currentUploadId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    m_lastPercent = 0;
+    m_filesCompleted = 0;
+    m_totalBytes = 0;
+    m_sentBytes = 0;
+    m_remoteProgressReceived = false;
+    resetProgressTracking();
+    emit uiStateChanged();
+    streamUpload(files);
+}
+
+void UploadManager::releaseDirectLink() {
+    if (m_ws) m_ws->setDirectUploadLink(nullptr);
+    if (m_directOfferTimer) m_directOfferTimer->stop();
+    if (m_directLink) m_directLink->close();
+    m_directNegotiationFiles.clear();
+    m_directState = DirectTransferState::Idle;
+    m_directStreaming = false;
+    m_directLinkLost = false;
+}
+
+void UploadManager::streamUpload(const QVector<UploadFileInfo>& files) {
+    MOUFFETTE_TRACE_SCOPE("upload.streamUpload");
+    if (!m_ws) {
+        return;
+    }
+    const bool fanOut = isFanOutUpload();
+    // A direct link reaches a single target, so fan-out always goes through the relay
+    if (!fanOut && m_directState == DirectTransferState::Idle && DirectTransferServer::enabled()) {
+        // Ask the target for a LAN endpoint first; streaming starts once that settles either way
+        m_directState = DirectTransferState::Negotiating;
+        m_directNegotiationFiles = files;
+        m_ws->sendDirectTransferRequest(m_uploadTargetClientId, m_currentUploadId);
+        m_directOfferTimer->start(DIRECT_OFFER_WAIT_MS);
+        return;
+    }
+    // Uses the dedicated upload channel when ready so chunks do not delay control messages
+    m_ws->beginUploadSession(true);
+
     // Build manifest with file deduplication info
     QJsonArray manifest;
     
@@ -228,23 +619,45 @@ void UploadManager::startUpload(const QVector<UploadFileInfo>& files) {
         // accumulate for weighted progress
         if (f.size > 0) m_totalBytes += f.size;
     }
-    m_ws->sendUploadStart(m_uploadTargetClientId, manifest, m_currentUploadId, m_activeIdeaId);
+    if (fanOut) {
+        m_ws->sendFanOutUploadStart(fanOutTargetsJson(), manifest, m_currentUploadId);
+    } else {
+        m_ws->sendUploadStart(m_uploadTargetClientId, manifest, m_currentUploadId, m_activeIdeaId);
+    }
 
     // Stream sequentially (same logic as previously in MainWindow)
     m_outgoingFiles = files;
+    m_directStreaming = (m_directState == DirectTransferState::Active);
+    QElapsedTimer streamTimer;
+    streamTimer.start();
     const int chunkSize = 128 * 1024;
     for (const auto& f : files) {
+        if (fanOut && fanOutTargetsForFile(f.fileId).isEmpty()) continue; // its targets dropped out
         QFile file(f.path);
         if (!file.open(QIODevice::ReadOnly)) continue;
         emit fileUploadStarted(f.fileId);
         qint64 sentForFile = 0;
         int chunkIndex = 0;
         while (!file.atEnd()) {
-            if (m_cancelRequested) break;
+            if (m_cancelRequested || m_directLinkLost) break;
+            MOUFFETTE_TRACE_SCOPE("upload.sendChunk");
+            QStringList chunkTargets;
+            if (fanOut) {
+                // Re-evaluated per chunk: a target may have been cancelled while we yielded
+                chunkTargets = fanOutTargetsForFile(f.fileId);
+                if (chunkTargets.isEmpty()) break;
+            }
             QByteArray chunk = file.read(chunkSize);
-            m_ws->sendUploadChunk(m_uploadTargetClientId, m_currentUploadId, f.fileId, chunkIndex++, chunk.toBase64(), m_activeIdeaId);
+            if (fanOut) {
+                m_ws->sendFanOutUploadChunk(chunkTargets, m_currentUploadId, f.fileId, chunkIndex++, chunk.toBase64());
+                MOUFFETTE_METRIC_COUNT("upload.fanOutChunkCopies", chunkTargets.size());
+            } else {
+                m_ws->sendUploadChunk(m_uploadTargetClientId, m_currentUploadId, f.fileId, chunkIndex++, chunk.toBase64(), m_activeIdeaId);
+            }
             sentForFile += chunk.size();
             m_sentBytes += chunk.size();
+            MOUFFETTE_METRIC_COUNT("upload.chunksSent", 1);
+            MOUFFETTE_METRIC_COUNT("upload.bytesSent", chunk.size());
             if (f.size > 0) {
                 int p = static_cast<int>(std::round(sentForFile * 100.0 / static_cast<double>(f.size)));
                 updatePerFileLocalProgress(f.fileId, p);
@@ -260,11 +673,12 @@ void UploadManager::startUpload(const QVector<UploadFileInfo>& files) {
             QCoreApplication::processEvents(QEventLoop::AllEvents, 2);
         }
         file.close();
+        if (m_directLinkLost) break;
         if (!m_cancelRequested) {
             updatePerFileLocalProgress(f.fileId, 99);
             emit fileUploadFinished(f.fileId);
         }
-        if (m_cancelRequested) break;
+        if (m_cancelRequested || m_directLinkLost) break;
         // After a file is fully sent, update local filesCompleted
         if (!m_cancelRequested) {
             m_filesCompleted = std::min(m_filesCompleted + 1, m_totalFiles);
@@ -277,11 +691,21 @@ void UploadManager::startUpload(const QVector<UploadFileInfo>& files) {
             }
         }
     }
+    m_directStreaming = false;
     if (m_cancelRequested) {
         finalizeLocalCancelState();
         return;
     }
-    m_ws->sendUploadComplete(m_uploadTargetClientId, m_currentUploadId, m_activeIdeaId);
+    if (m_directLinkLost) {
+        restartOverRelay(files);
+        return;
+    }
+    if (fanOut) {
+        m_ws->sendFanOutUploadComplete(m_currentUploadId);
+    } else {
+        m_ws->sendUploadComplete(m_uploadTargetClientId, m_currentUploadId, m_activeIdeaId);
+    }
+    MOUFFETTE_METRIC_HISTOGRAM("upload.streamMs", streamTimer.elapsed());
     // We have sent all bytes; remain in uploading state until remote finishes
     // Enter finalizing only when we stop sending and await remote ack
     m_uploadInProgress = true;
@@ -313,6 +737,10 @@ void UploadManager::resetToInitial() {
     m_totalBytes = 0;
     m_remoteProgressReceived = false;
     m_outgoingFiles.clear();
+    m_fanOutTargets.clear();
+    m_fanOutRemovalsPending.clear();
+    clearPendingUpload();
+    releaseDirectLink();
     resetProgressTracking();
     if (m_cancelFallbackTimer) m_cancelFallbackTimer->stop();
     if (m_actionDebounceTimer) m_actionDebounceTimer->stop();
@@ -327,10 +755,13 @@ void UploadManager::finalizeLocalCancelState() {
     const QString targetId = !m_lastRemovalClientId.isEmpty()
                                ? m_lastRemovalClientId
                                : (!m_uploadTargetClientId.isEmpty() ? m_uploadTargetClientId : m_targetClientId);
+    const QStringList fanOutIds = m_fanOutTargets.keys();
     m_cancelFinalizePending = false;
     resetToInitial();
     m_lastRemovalClientId = targetId;
-    if (!targetId.isEmpty()) {
+    if (!fanOutIds.isEmpty()) {
+        for (const QString& id : fanOutIds) m_fileManager->unmarkAllForClient(id);
+    } else if (!targetId.isEmpty()) {
         m_fileManager->unmarkAllForClient(targetId);
     }
     emit allFilesRemoved();
@@ -430,18 +861,10 @@ void UploadManager::cleanupIncomingSession(bool deleteDiskContents,
                                            const QString& cacheDirOverride,
                                            const QString& uploadIdOverride,
                                            const QString& ideaOverride) {
-    auto dropChunkTracking = [this](const QString& uploadId) {
-        if (uploadId.isEmpty()) return;
-        const QString prefix = uploadId + ":";
-        auto it = m_expectedChunkIndex.begin();
-        while (it != m_expectedChunkIndex.end()) {
-            if (it.key().startsWith(prefix)) {
-                it = m_expectedChunkIndex.erase(it);
-            } else {
-                ++it;
-            }
-        }
-        m_canceledIncoming.remove(uploadId);
+    // Closes the cache files on the writer and drops any chunk still in flight for the upload
+    auto discardChunks = [this](const QString& uploadId) {
+        if (uploadId.isEmpty() || !m_ws) return;
+        m_ws->chunkWriter()->discard(uploadId);
     };
 
     QString senderId = senderOverride;
@@ -466,30 +889,20 @@ void UploadManager::cleanupIncomingSession(bool deleteDiskContents,
             canvasSessionId = m_incoming.canvasSessionId.isEmpty() ? DEFAULT_IDEA_ID : m_incoming.canvasSessionId;
         }
 
-        for (auto it = m_incoming.openFiles.begin(); it != m_incoming.openFiles.end(); ++it) {
-            if (it.value()) {
-                it.value()->flush();
-                it.value()->close();
-                delete it.value();
-            }
-        }
-        m_incoming.openFiles.clear();
         fileIds = m_incoming.expectedSizes.keys();
 
-        dropChunkTracking(uploadId);
+        discardChunks(uploadId);
 
         m_incoming = IncomingUploadSession();
     } else {
         if (cacheDirPath.isEmpty() && !senderId.isEmpty()) {
-            QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-            if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-            cacheDirPath = base + "/Mouffette/Uploads/" + senderId;
+            cacheDirPath = incomingCacheRoot() + "/" + senderId;
         }
         if (uploadId.isEmpty()) uploadId = uploadIdOverride;
     }
 
     if (!uploadIdOverride.isEmpty() && uploadIdOverride != uploadId) {
-        dropChunkTracking(uploadIdOverride);
+        discardChunks(uploadIdOverride);
     }
 
     // Phase 3: canvasSessionId is MANDATORY - check if it's a specific idea or default
@@ -564,14 +977,23 @@ void UploadManager::cleanupIncomingSession(bool deleteDiskContents,
     }
 
     if (!matchesActiveSession && !uploadId.isEmpty()) {
-        dropChunkTracking(uploadId);
+        discardChunks(uploadId);
     }
 }
 
 // Slots forwarded from WebSocketClient (sender side)
-void UploadManager::onUploadProgress(const QString& uploadId, int percent, int filesCompleted, int totalFiles) {
+void UploadManager::onUploadProgress(const QString& uploadId, int percent, int filesCompleted, int totalFiles, const QString& targetClientId) {
     if (uploadId != m_currentUploadId) return;
     if (m_cancelRequested) return;
+    if (isFanOutUpload()) {
+        auto it = m_fanOutTargets.find(targetClientId);
+        if (it == m_fanOutTargets.end() || it->finished) return;
+        it->percent = std::max(it->percent, std::clamp(percent, 0, 100));
+        it->filesCompleted = std::max(it->filesCompleted, filesCompleted);
+        emit targetUploadProgress(targetClientId, it->percent, it->filesCompleted, static_cast<int>(it->fileIds.size()));
+        updateFanOutRemoteProgress();
+        return;
+    }
     // Always accept target-side progress; it's authoritative
     m_lastPercent = percent;
     m_filesCompleted = filesCompleted;
@@ -581,19 +1003,57 @@ void UploadManager::onUploadProgress(const QString& uploadId, int percent, int f
     updateRemoteProgress(percent, filesCompleted);
 }
 
-void UploadManager::onUploadCompletedFileIds(const QString& uploadId, const QStringList& fileIds) {
+void UploadManager::onUploadCompletedFileIds(const QString& uploadId, const QStringList& fileIds, const QString& targetClientId) {
     if (uploadId != m_currentUploadId) return;
     if (m_cancelRequested) return;
     if (fileIds.isEmpty()) return;
+    if (isFanOutUpload()) {
+        auto it = m_fanOutTargets.find(targetClientId);
+        if (it == m_fanOutTargets.end()) return;
+        for (const QString& fid : fileIds) it->completedFileIds.insert(fid);
+        // Report a file as uploaded only once every target needing it has it
+        QStringList everywhere;
+        for (const QString& fid : fileIds) {
+            bool done = true;
+            for (const QString& id : fanOutTargetsForFile(fid)) {
+                if (!m_fanOutTargets[id].completedFileIds.contains(fid)) {
+                    done = false;
+                    break;
+                }
+            }
+            if (done) everywhere.append(fid);
+        }
+        if (everywhere.isEmpty()) return;
+        emit uploadCompletedFileIds(everywhere);
+        for (const QString& fid : everywhere) {
+            updatePerFileRemoteProgress(fid, 100);
+        }
+        return;
+    }
     emit uploadCompletedFileIds(fileIds);
     for (const QString& fid : fileIds) {
         updatePerFileRemoteProgress(fid, 100);
     }
 }
 
-void UploadManager::onUploadFinished(const QString& uploadId) {
+void UploadManager::onUploadFinished(const QString& uploadId, const QString& targetClientId) {
     if (uploadId != m_currentUploadId) return;
     if (m_cancelRequested) return;
+    if (isFanOutUpload()) {
+        auto it = m_fanOutTargets.find(targetClientId);
+        if (it == m_fanOutTargets.end() || it->finished) return;
+        it->finished = true;
+        it->percent = 100;
+        it->completedFileIds = it->fileIds;
+        it->filesCompleted = static_cast<int>(it->fileIds.size());
+        for (const QString& fid : std::as_const(it->fileIds)) {
+            m_fileManager->markFileUploadedToClient(fid, targetClientId);
+        }
+        emit targetUploadFinished(targetClientId);
+        updateFanOutRemoteProgress();
+        finishFanOutIfDone();
+        return;
+    }
     updateRemoteProgress(100, m_totalFiles > 0 ? m_totalFiles : m_filesCompleted);
     // Switch to finalizing for a brief moment to align UI state, then finish
     m_uploadInProgress = false;
@@ -606,17 +1066,36 @@ void UploadManager::onUploadFinished(const QString& uploadId) {
         // File-based tracking covers all media instances
         const QList<QString> mediaIds = m_fileManager->getMediaIdsForFile(f.fileId);
     }
-    
+    completeOutgoingUpload();
+}
+
+void UploadManager::completeOutgoingUpload() {
     m_uploadActive = true; // switch to active state
     m_uploadInProgress = false;
     m_finalizing = false; // finalization complete
     m_actionInProgress = false; // Clear action lock
+    releaseDirectLink();
     emit uploadFinished();
     emit uiStateChanged();
     if (m_ws) m_ws->endUploadSession();
 }
 
-void UploadManager::onAllFilesRemovedRemote() {
+void UploadManager::onAllFilesRemovedRemote(const QString& targetClientId) {
+    if (isFanOutUpload()) {
+        // Confirmations from individually cancelled targets are not pending and change nothing
+        if (!m_fanOutRemovalsPending.remove(targetClientId)) return;
+        m_fileManager->unmarkAllForClient(targetClientId);
+        if (!m_fanOutRemovalsPending.isEmpty()) return;
+        if (m_cancelFinalizePending) {
+            finalizeLocalCancelState();
+            return;
+        }
+        resetToInitial();
+        m_actionInProgress = false;
+        emit allFilesRemoved();
+        emit uiStateChanged();
+        return;
+    }
     if (m_cancelFinalizePending) {
         finalizeLocalCancelState();
         return;
@@ -644,6 +1123,8 @@ void UploadManager::onAllFilesRemovedRemote() {
 void UploadManager::onConnectionLost() {
     // If we were uploading or finalizing, treat it as an aborted session.
     const bool hadOngoing = m_uploadInProgress || m_finalizing;
+    clearPendingUpload();
+    releaseDirectLink();
 
     if (hadOngoing) {
         // Cancel local flags immediately
@@ -653,7 +1134,12 @@ void UploadManager::onConnectionLost() {
 
         // Do not mark anything as uploaded; roll back any optimistic UI
         // Unmark any files that were part of the outgoing batch but not yet confirmed by onUploadFinished
-        if (!m_uploadTargetClientId.isEmpty()) {
+        if (isFanOutUpload()) {
+            for (auto it = m_fanOutTargets.cbegin(); it != m_fanOutTargets.cend(); ++it) {
+                if (it->finished) continue;
+                for (const QString& fid : it->fileIds) m_fileManager->unmarkFileUploadedToClient(fid, it.key());
+            }
+        } else if (!m_uploadTargetClientId.isEmpty()) {
             for (const auto& f : m_outgoingFiles) {
                 m_fileManager->unmarkFileUploadedToClient(f.fileId, m_uploadTargetClientId);
                 // File-based unmark covers all media instances
@@ -673,6 +1159,8 @@ void UploadManager::onConnectionLost() {
         m_totalBytes = 0;
         m_remoteProgressReceived = false;
         m_outgoingFiles.clear();
+        m_fanOutTargets.clear();
+        m_fanOutRemovalsPending.clear();
     }
 
     if (m_ws) {
@@ -688,12 +1176,11 @@ void UploadManager::cleanupIncomingCacheForConnectionLoss() {
         qDebug() << "UploadManager: Clearing incoming upload cache for sender" << m_incoming.senderId << "after connection loss";
     }
     m_incoming = IncomingUploadSession();
-    m_expectedChunkIndex.clear();
-    m_canceledIncoming.clear();
+    if (m_ws) {
+        m_ws->chunkWriter()->discard();
+    }
 
-    QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-    if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-    const QString uploadsRoot = base + "/Mouffette/Uploads";
+    const QString uploadsRoot = incomingCacheRoot();
     QDir uploadsDir(uploadsRoot);
     if (!uploadsDir.exists()) {
         return;
@@ -708,13 +1195,47 @@ void UploadManager::cleanupIncomingCacheForConnectionLoss() {
     m_fileManager->removeReceivedFileMappingsUnderPathPrefix(uploadsRoot + "/");
 }
 
+QString UploadManager::incomingCacheRoot() const {
+    return m_ws ? m_ws->chunkWriter()->cacheRoot() : IncomingChunkWriter::defaultCacheRoot();
+}
+
+void UploadManager::onIncomingChunkProgress(const QString& uploadId, const QHash<QString, qint64>& receivedByFile) {
+    if (uploadId.isEmpty() || uploadId != m_incoming.uploadId) return;
+
+    // Only files whose byte count moved since the last report go into the per-file array
+    QJsonArray perFileArr;
+    for (auto it = receivedByFile.constBegin(); it != receivedByFile.constEnd(); ++it) {
+        if (!m_incoming.receivedByFile.contains(it.key())) continue;
+        const qint64 got = it.value();
+        if (got == m_incoming.receivedByFile.value(it.key())) continue;
+        m_incoming.received += got - m_incoming.receivedByFile.value(it.key());
+        m_incoming.receivedByFile[it.key()] = got;
+        const qint64 expected = m_incoming.expectedSizes.value(it.key());
+        int pf = 0;
+        if (expected > 0) pf = static_cast<int>(std::round(got * 100.0 / expected));
+        QJsonObject o; o["fileId"] = it.key(); o["percent"] = pf; perFileArr.append(o);
+    }
+    if (perFileArr.isEmpty()) return;
+
+    int filesCompleted = 0;
+    QStringList completedIds;
+    for (auto it = m_incoming.expectedSizes.constBegin(); it != m_incoming.expectedSizes.constEnd(); ++it) {
+        qint64 expected = it.value();
+        qint64 got = m_incoming.receivedByFile.value(it.key(), 0);
+        if (expected > 0 && got >= expected) { filesCompleted++; completedIds.append(it.key()); }
+    }
+    if (m_ws && !m_incoming.senderId.isEmpty() && m_incoming.totalSize > 0) {
+        int percent = static_cast<int>(std::round(m_incoming.received * 100.0 / m_incoming.totalSize));
+        m_ws->notifyUploadProgressToSender(m_incoming.senderId, m_incoming.uploadId, percent, filesCompleted, m_incoming.totalFiles, completedIds, perFileArr);
+    }
+}
+
 // Incoming side (target) - replicate subset of MainWindow logic for assembling files
 void UploadManager::handleIncomingMessage(const QJsonObject& message) {
     const QString type = message.value("type").toString();
     if (type == "upload_start") {
+        // The cache files were already created by IncomingChunkWriter on the network thread
         m_incoming = IncomingUploadSession();
-        // Reset per-session chunk ordering state
-        m_expectedChunkIndex.clear();
         m_incoming.senderId = message.value("senderClientId").toString();
         m_incoming.uploadId = message.value("uploadId").toString();
         
@@ -725,23 +1246,17 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
         
         qDebug() << "UploadManager: Received directional canvasSessionId:" << m_incoming.canvasSessionId;
         
-        m_canceledIncoming.remove(m_incoming.uploadId);
-        QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-        if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-        QDir dir(base); dir.mkpath("Mouffette/Uploads");
-        // Use sender client ID as folder name instead of upload ID
-        QString cacheDir = base + "/Mouffette/Uploads/" + m_incoming.senderId;
-        QDir().mkpath(cacheDir);
+        const QString cacheDir = incomingCacheRoot() + "/" + m_incoming.senderId;
         m_incoming.cacheDirPath = cacheDir;
+        const QSet<QString> openedFileIds = m_ws ? m_ws->chunkWriter()->openedFileIds(m_incoming.uploadId) : QSet<QString>();
         
-        qDebug() << "UploadManager: Creating upload folder:" << cacheDir;
+        qDebug() << "UploadManager: Upload folder:" << cacheDir;
         qDebug() << "UploadManager: Sender ID:" << m_incoming.senderId;
         QJsonArray files = message.value("files").toArray();
         m_incoming.totalFiles = files.size();
         for (const QJsonValue& v : files) {
             QJsonObject f = v.toObject();
             QString fileId = f.value("fileId").toString();
-            QString name = f.value("name").toString();
             QString extension = f.value("extension").toString();
             QJsonArray mediaIdsArray = f.value("mediaIds").toArray();
             qint64 size = static_cast<qint64>(f.value("sizeBytes").toDouble());
@@ -753,24 +1268,13 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
             }
             
             // Store all mediaIds for this fileId
-            QStringList mediaIdsList;
             for (const QJsonValue& mediaIdVal : mediaIdsArray) {
-                QString mediaId = mediaIdVal.toString();
-                mediaIdsList.append(mediaId);
-                m_incoming.fileIdToMediaId.insert(fileId, mediaId);
+                m_incoming.fileIdToMediaId.insert(fileId, mediaIdVal.toString());
             }
             
-            // Use fileId as filename with original extension
-            QString filename = fileId;
-            if (!extension.isEmpty()) {
-                filename += "." + extension;
-            }
-            QString fullPath = cacheDir + "/" + filename;
-            qDebug() << "UploadManager: Creating file:" << fullPath;
-            qDebug() << "UploadManager: File ID:" << fileId;
-            QFile* qf = new QFile(fullPath);
-            if (!qf->open(QIODevice::WriteOnly)) { delete qf; continue; }
-            m_incoming.openFiles.insert(fileId, qf);
+            if (!openedFileIds.contains(fileId)) continue;
+            const QString fullPath = m_ws->chunkWriter()->cacheFilePath(m_incoming.senderId, fileId, extension);
+            qDebug() << "UploadManager: Receiving file:" << fullPath;
             m_incoming.expectedSizes.insert(fileId, qMax<qint64>(0, size));
             m_incoming.receivedByFile.insert(fileId, 0);
             // Register mapping so remote scene resolution can find this fileId immediately (even before complete)
@@ -779,76 +1283,10 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
             if (m_incoming.canvasSessionId != DEFAULT_IDEA_ID) {
                 m_fileManager->associateFileWithIdea(fileId, m_incoming.canvasSessionId);
             }
-            // Initialize expected chunk index for this file to 0
-            m_expectedChunkIndex.insert(m_incoming.uploadId + ":" + fileId, 0);
         }
         if (m_ws && !m_incoming.senderId.isEmpty()) {
             m_ws->notifyUploadProgressToSender(m_incoming.senderId, m_incoming.uploadId, 0, 0, m_incoming.totalFiles, QStringList());
         }
-    } else if (type == "upload_chunk") {
-        if (message.value("uploadId").toString() != m_incoming.uploadId) return;
-        const QString canvasSessionId = message.value("canvasSessionId").toString();
-        // Phase 3: canvasSessionId matching - compare against incoming canvasSessionId (both should be set)
-        if (!canvasSessionId.isEmpty() && m_incoming.canvasSessionId != DEFAULT_IDEA_ID && canvasSessionId != m_incoming.canvasSessionId) {
-            qWarning() << "UploadManager: Ignoring chunk for mismatched idea" << canvasSessionId << "expected" << m_incoming.canvasSessionId;
-            return;
-        }
-        if (m_canceledIncoming.contains(m_incoming.uploadId)) return;
-        QString fid = message.value("fileId").toString();
-        QFile* qf = m_incoming.openFiles.value(fid, nullptr);
-        if (!qf) return;
-        
-        // CRITICAL FIX: Handle chunk ordering properly per upload session
-        int chunkIndex = message.value("chunkIndex").toInt();
-        QByteArray data = QByteArray::fromBase64(message.value("data").toString().toUtf8());
-
-        const QString key = m_incoming.uploadId + ":" + fid;
-        if (!m_expectedChunkIndex.contains(key)) {
-            m_expectedChunkIndex.insert(key, 0);
-        }
-        const int expected = m_expectedChunkIndex.value(key);
-        if (chunkIndex != expected) {
-            qWarning() << "UploadManager: Out-of-order chunk for" << fid
-                       << "(upload" << m_incoming.uploadId << ") - expected" << expected
-                       << "got" << chunkIndex << "- dropping to prevent corruption";
-            return;
-        }
-        m_expectedChunkIndex[key] = expected + 1;
-
-        // Ensure we are at end for append (defensive in case of any reuse)
-        qf->seek(qf->size());
-        qint64 written = qf->write(data);
-        if (written != data.size()) {
-            qWarning() << "UploadManager: Partial write - expected" << data.size() << "wrote" << written;
-        }
-        qf->flush(); // Ensure data is written immediately
-        
-        m_incoming.received += data.size();
-        if (m_incoming.receivedByFile.contains(fid)) {
-            qint64 soFar = m_incoming.receivedByFile.value(fid) + data.size();
-            m_incoming.receivedByFile[fid] = soFar;
-        }
-        int filesCompleted = 0;
-        QStringList completedIds;
-        for (auto it = m_incoming.expectedSizes.constBegin(); it != m_incoming.expectedSizes.constEnd(); ++it) {
-            qint64 expected = it.value();
-            qint64 got = m_incoming.receivedByFile.value(it.key(), 0);
-            if (expected > 0 && got >= expected) { filesCompleted++; completedIds.append(it.key()); }
-        }
-        if (m_ws && !m_incoming.senderId.isEmpty() && m_incoming.totalSize > 0) {
-            int percent = static_cast<int>(std::round(m_incoming.received * 100.0 / m_incoming.totalSize));
-            // Build per-file progress array (only for files in progress to reduce payload)
-            QJsonArray perFileArr;
-            // Include the file that just received data
-            if (m_incoming.expectedSizes.contains(fid)) {
-                const qint64 expected = m_incoming.expectedSizes.value(fid);
-                const qint64 got = m_incoming.receivedByFile.value(fid, 0);
-                int pf = 0;
-                if (expected > 0) pf = static_cast<int>(std::round(got * 100.0 / expected));
-                QJsonObject o; o["fileId"] = fid; o["percent"] = pf; perFileArr.append(o);
-            }
-            m_ws->notifyUploadProgressToSender(m_incoming.senderId, m_incoming.uploadId, percent, filesCompleted, m_incoming.totalFiles, completedIds, perFileArr);
-        }
     } else if (type == "upload_complete") {
         if (message.value("uploadId").toString() != m_incoming.uploadId) return;
         const QString canvasSessionId = message.value("canvasSessionId").toString();
@@ -857,18 +1295,7 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
             qWarning() << "UploadManager: Ignoring upload_complete for mismatched idea" << canvasSessionId << "expected" << m_incoming.canvasSessionId;
             return;
         }
-        
-        // Clean up chunk tracking before closing files (for this upload)
-        const QString prefix = m_incoming.uploadId + ":";
-        auto itKey = m_expectedChunkIndex.begin();
-        while (itKey != m_expectedChunkIndex.end()) {
-            if (itKey.key().startsWith(prefix)) itKey = m_expectedChunkIndex.erase(itKey); else ++itKey;
-        }
-        
-        for (auto it = m_incoming.openFiles.begin(); it != m_incoming.openFiles.end(); ++it) {
-            if (it.value()) { it.value()->flush(); it.value()->close(); delete it.value(); }
-        }
-        m_incoming.openFiles.clear();
+        // Files were closed by IncomingChunkWriter before this message was posted
 
         // Preload completed video files into RAM for low-latency playback
         for (auto it = m_incoming.fileIdToExtension.constBegin(); it != m_incoming.fileIdToExtension.constEnd(); ++it) {
@@ -896,9 +1323,6 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
         const QString abortedId = message.value("uploadId").toString();
         const QString senderClientId = message.value("senderClientId").toString();
         const QString canvasSessionId = message.value("canvasSessionId").toString();
-        if (!abortedId.isEmpty()) {
-            m_canceledIncoming.insert(abortedId);
-        }
 
         QString ackTarget = !m_incoming.senderId.isEmpty() ? m_incoming.senderId : senderClientId;
         if (m_ws && !ackTarget.isEmpty()) {
@@ -907,9 +1331,7 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
 
         QString cacheOverride = m_incoming.cacheDirPath;
         if (cacheOverride.isEmpty() && !ackTarget.isEmpty()) {
-            QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-            if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-            cacheOverride = base + "/Mouffette/Uploads/" + ackTarget;
+            cacheOverride = incomingCacheRoot() + "/" + ackTarget;
         }
 
         cleanupIncomingSession(true, false, ackTarget, cacheOverride, abortedId, canvasSessionId);
@@ -923,26 +1345,24 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
 
         QString cacheOverride = m_incoming.cacheDirPath;
         if (cacheOverride.isEmpty() && !ackTarget.isEmpty()) {
-            QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-            if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-            cacheOverride = base + "/Mouffette/Uploads/" + ackTarget;
+            cacheOverride = incomingCacheRoot() + "/" + ackTarget;
         }
 
         cleanupIncomingSession(true, false, ackTarget, cacheOverride, QString(), canvasSessionId);
-        // Clear all expected indices; treat as a hard reset
-        m_expectedChunkIndex.clear();
     } else if (type == "connection_lost_cleanup") {
         // Optional: sender notified us to clean any partials; delete cache folder for that sender
         QString senderClientId = message.value("senderClientId").toString();
         if (!senderClientId.isEmpty()) {
-            QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-            if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-            QString dirPath = base + "/Mouffette/Uploads/" + senderClientId;
+            QString dirPath = incomingCacheRoot() + "/" + senderClientId;
             QDir dir(dirPath);
             if (dir.exists()) {
                 dir.removeRecursively();
             }
         }
+    } else if (type == "direct_transfer_request") {
+        handleDirectTransferRequest(message);
+    } else if (type == "direct_transfer_offer") {
+        handleDirectTransferOffer(message);
     } else if (type == "remove_file") {
         const QString senderClientId = message.value("senderClientId").toString();
         const QString fileId = message.value("fileId").toString();
@@ -962,9 +1382,7 @@ void UploadManager::handleIncomingMessage(const QJsonObject& message) {
                 return;
             }
 
-            QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-            if (base.isEmpty()) base = QDir::homePath() + "/.cache";
-            QString dirPath = base + "/Mouffette/Uploads/" + senderClientId;
+            QString dirPath = incomingCacheRoot() + "/" + senderClientId;
 
             bool removedAny = false;
             const QString mappedPath = m_fileManager->getFilePathForId(fileId);
@@ -7,6 +7,7 @@
 #include <QHash>
 #include <QFile>
 #include <QSet>
+#include <QStringList>
 #include <QVector>
 #include <QTimer>
 #include <QUuid>
@@ -25,12 +26,18 @@ struct UploadFileInfo {
     qint64 size = 0;
 };
 
+// One receiver of a fan-out upload. clientId is the server-side id the target is known by,
+// which is what the relay echoes back as targetClientId in progress notifications.
+struct UploadTarget {
+    QString clientId;
+    QString canvasSessionId;
+};
+
 struct IncomingUploadSession {
     QString senderId;
     QString uploadId;
     QString canvasSessionId;
     QString cacheDirPath;
-    QHash<QString, QFile*> openFiles;          // fileId -> QFile*
     QHash<QString, qint64> expectedSizes;      // fileId -> total bytes
     QHash<QString, qint64> receivedByFile;     // fileId -> received bytes
     QHash<QString, QString> fileIdToMediaId;   // fileId -> mediaId for target-side naming
@@ -47,6 +54,9 @@ struct IncomingUploadSession {
 //  - Handle cancel/abort, unload, and incoming upload assembly
 //  - Expose high level signals UI can bind to
 //  - Keep WebSocket protocol usage isolated
+class DirectTransferServer;
+class DirectTransferLink;
+
 class UploadManager : public QObject {
     Q_OBJECT
 public:
@@ -77,6 +87,13 @@ public:
     //  - else if uploading: cancel
     //  - else start new upload with provided files
     void toggleUpload(const QVector<UploadFileInfo>& files);
+    // Streams files once to several targets; the server duplicates each chunk to the targets
+    // that still need that file. Targets already holding a fileId are left out of its fan-out.
+    void startFanOutUpload(const QVector<UploadFileInfo>& files, const QVector<UploadTarget>& targets);
+    // Drops one target from the running fan-out; the others keep receiving
+    void cancelFanOutTarget(const QString& clientId);
+    bool isFanOutUpload() const { return !m_fanOutTargets.isEmpty(); }
+    QStringList fanOutTargetClientIds() const { return m_fanOutTargets.keys(); }
     void requestUnload();
     void requestCancel();
     void requestRemoval(const QString& clientId);
@@ -95,20 +112,49 @@ signals:
     void fileUploadStarted(const QString& fileId);
     void fileUploadProgress(const QString& fileId, int percent);
     void fileUploadFinished(const QString& fileId);
+    // Fan-out only: per-target lifecycle alongside the aggregated signals above
+    void targetUploadProgress(const QString& clientId, int percent, int filesCompleted, int totalFiles);
+    void targetUploadFinished(const QString& clientId);
+    void targetUploadCanceled(const QString& clientId);
 
 public slots:
     // Forwarded from WebSocket layer
-    void onUploadProgress(const QString& uploadId, int percent, int filesCompleted, int totalFiles);
-    void onUploadCompletedFileIds(const QString& uploadId, const QStringList& fileIds);
-    void onUploadFinished(const QString& uploadId);
-    void onAllFilesRemovedRemote();
+    // targetClientId is only consulted for fan-out uploads
+    void onUploadProgress(const QString& uploadId, int percent, int filesCompleted, int totalFiles, const QString& targetClientId = QString());
+    void onUploadCompletedFileIds(const QString& uploadId, const QStringList& fileIds, const QString& targetClientId = QString());
+    void onUploadFinished(const QString& uploadId, const QString& targetClientId = QString());
+    void onAllFilesRemovedRemote(const QString& targetClientId = QString());
     // Handle network connection loss while uploading/finalizing
     void onConnectionLost();
+    // Starts an upload queued while the dedicated upload channel was still connecting
+    void onUploadChannelReadyChanged(bool ready);
+    // Target side: bytes written so far by IncomingChunkWriter (see WebSocketClient::chunkWriter)
+    void onIncomingChunkProgress(const QString& uploadId, const QHash<QString, qint64>& receivedByFile);
 
 private:
     void startUpload(const QVector<UploadFileInfo>& files);
+    void streamUpload(const QVector<UploadFileInfo>& files);
+    void flushPendingUpload();
+    void clearPendingUpload();
+    // LAN direct transfer (see DirectTransferServer); the relay is always the fallback
+    void handleDirectTransferRequest(const QJsonObject& message);
+    void handleDirectTransferOffer(const QJsonObject& message);
+    void finishDirectNegotiation(bool linked);
+    void onDirectLinkClosed();
+    void restartOverRelay(const QVector<UploadFileInfo>& files);
+    void releaseDirectLink();
+    void completeOutgoingUpload();
+    void startCancelFallbackTimer();
+    // Fan-out bookkeeping
+    QStringList fanOutTargetsForFile(const QString& fileId) const;
+    QJsonArray fanOutTargetsJson() const;
+    void dropFanOutTarget(const QString& clientId, bool notifyTarget);
+    void updateFanOutRemoteProgress();
+    void finishFanOutIfDone();
     void resetToInitial();
     void cleanupIncomingCacheForConnectionLoss();
+    // Root of this client's per-sender cache folders (the chunk writer's, else the default)
+    QString incomingCacheRoot() const;
     void finalizeLocalCancelState();
     void cleanupIncomingSession(bool deleteDiskContents,
                                 bool notifySender,
@@ -158,10 +204,42 @@ private:
 
     // Sender-side per-file tracking
     QVector<UploadFileInfo> m_outgoingFiles;
+    // Fan-out upload state per target (empty for the regular single-target upload)
+    struct FanOutTarget {
+        QString canvasSessionId;
+        QSet<QString> fileIds;          // files this target does not hold yet
+        QSet<QString> completedFileIds; // confirmed by the target
+        qint64 totalBytes = 0;
+        int percent = 0;
+        int filesCompleted = 0;
+        bool finished = false;
+    };
+    QHash<QString, FanOutTarget> m_fanOutTargets; // clientId -> state
+    QSet<QString> m_fanOutRemovalsPending;       // clientIds awaiting all_files_removed
     QHash<QString, int> m_localFilePercents;
     QHash<QString, int> m_remoteFilePercents;
     QHash<QString, int> m_effectiveFilePercents;
 
+    // Upload accepted while the upload channel was not ready yet; streamed once it is (or on timeout)
+    QVector<UploadFileInfo> m_pendingUploadFiles;
+    QTimer* m_uploadChannelWaitTimer = nullptr;
+    static constexpr int UPLOAD_CHANNEL_WAIT_MS = 1500;
+
+    // Sender side direct transfer for the current upload
+    enum class DirectTransferState { Idle, Negotiating, Active, Unavailable };
+    DirectTransferState m_directState = DirectTransferState::Idle;
+    DirectTransferLink* m_directLink = nullptr;
+    QTimer* m_directOfferTimer = nullptr;  // bounds the wait for direct_transfer_offer
+    // Upload held while negotiating; separate from m_pendingUploadFiles so a channel-ready or
+    // channel-wait flush cannot start streaming over the relay before the negotiation settles
+    QVector<UploadFileInfo> m_directNegotiationFiles;
+    bool m_directStreaming = false;        // chunks are being written to the link right now
+    bool m_directLinkLost = false;
+    static constexpr int DIRECT_OFFER_WAIT_MS = 1000;
+    static constexpr int DIRECT_CONNECT_TIMEOUT_MS = 1000;
+    // Target side endpoint, created on the first request when direct transfer is enabled
+    DirectTransferServer* m_directServer = nullptr;
+
     QString m_lastRemovalClientId;
 
     // Phase 4.3: FileManager injected (not singleton)
@@ -169,9 +247,6 @@ private:
 
     // Incoming session (target side)
     IncomingUploadSession m_incoming;
-    QSet<QString> m_canceledIncoming; // uploadIds canceled by sender
-    // Track next expected chunk index per (uploadId:fileId) on the target side
-    QHash<QString, int> m_expectedChunkIndex;
     
     // Local client ID for directional session generation
     QString m_myClientId; 
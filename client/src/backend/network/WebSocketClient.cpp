@@ -1,11 +1,14 @@
 #include "backend/network/WebSocketClient.h"
+#include "backend/network/DirectTransferLink.h"
+#include "backend/network/IncomingChunkWriter.h"
+#include "backend/network/ThreadedWebSocket.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
 #include <QJsonArray>
 #include <QDebug>
 #include <QUrlQuery>
-#include <QElapsedTimer>
-#include <QCoreApplication>
-#include <QThread>
 #include <QUuid>
+#include <algorithm>
 
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 // 🔐 MOUFFETTE IDENTIFICATION SYSTEM - TERMINOLOGY FIX
@@ -46,35 +49,41 @@
 
 WebSocketClient::WebSocketClient(QObject *parent)
     : QObject(parent)
+    , m_chunkWriter(std::make_shared<IncomingChunkWriter>())
     , m_webSocket(nullptr)
     , m_connectionStatus("Disconnected")
     , m_reconnectTimer(new QTimer(this))
     , m_reconnectAttempts(0)
     , m_sessionId(QUuid::createUuid().toString(QUuid::WithoutBraces))
+    , m_uploadHeartbeatTimer(new QTimer(this))
+    , m_uploadReconnectTimer(new QTimer(this))
+    , m_sendFlushTimer(new QTimer(this))
 {
     m_reconnectTimer->setSingleShot(true);
     connect(m_reconnectTimer, &QTimer::timeout, this, &WebSocketClient::attemptReconnect);
+    m_uploadHeartbeatTimer->setInterval(UPLOAD_HEARTBEAT_INTERVAL);
+    connect(m_uploadHeartbeatTimer, &QTimer::timeout, this, &WebSocketClient::sendUploadHeartbeat);
+    m_uploadReconnectTimer->setSingleShot(true);
+    connect(m_uploadReconnectTimer, &QTimer::timeout, this, &WebSocketClient::attemptUploadReconnect);
+    // Zero-interval single shot: everything queued during one event-loop pass goes out together
+    m_sendFlushTimer->setSingleShot(true);
+    m_sendFlushTimer->setInterval(0);
+    connect(m_sendFlushTimer, &QTimer::timeout, this, &WebSocketClient::flushSendQueue);
     m_clientId = m_sessionId;
     qDebug() << "WebSocketClient: Initialized sessionId" << m_sessionId;
 }
 
-void WebSocketClient::onUploadTextMessageReceived(const QString& message) {
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
-    if (error.error != QJsonParseError::NoError) {
-        qWarning() << "Failed to parse JSON message on upload channel:" << error.errorString();
-        return;
-    }
-    QJsonObject obj = doc.object();
-    const QString type = obj.value("type").toString();
-    if (type == "welcome") {
+void WebSocketClient::onUploadMessageReceived(const InboundMessage& message) {
+    MOUFFETTE_TRACE_SCOPE("ws.receiveUpload");
+    if (message.kind == InboundMessage::Kind::Welcome) {
         // Keep a separate client id for the upload channel; do not override control id
-        m_uploadClientId = obj.value("clientId").toString();
+        m_uploadClientId = message.json.value("clientId").toString();
         qDebug() << "Upload channel received client ID:" << m_uploadClientId;
+        setUploadChannelReady(true);
         return;
     }
     // Reuse the same message handler for upload progress/finished/all_files_removed
-    handleMessage(obj);
+    handleMessage(message);
 }
 
 WebSocketClient::~WebSocketClient() {
@@ -99,13 +108,15 @@ void WebSocketClient::connectToServer(const QString& serverUrl) {
         m_webSocket->deleteLater();
     }
     
+    m_sendQueue.clear();
+    m_sendFlushTimer->stop();
     m_serverUrl = serverUrl;
-    m_webSocket = new QWebSocket();
+    m_webSocket = new ThreadedWebSocket(m_chunkWriter);
     
-    connect(m_webSocket, &QWebSocket::connected, this, &WebSocketClient::onConnected);
-    connect(m_webSocket, &QWebSocket::disconnected, this, &WebSocketClient::onDisconnected);
-    connect(m_webSocket, &QWebSocket::textMessageReceived, this, &WebSocketClient::onTextMessageReceived);
-    connect(m_webSocket, &QWebSocket::errorOccurred, this, &WebSocketClient::onError);
+    connect(m_webSocket, &ThreadedWebSocket::connected, this, &WebSocketClient::onConnected);
+    connect(m_webSocket, &ThreadedWebSocket::disconnected, this, &WebSocketClient::onDisconnected);
+    connect(m_webSocket, &ThreadedWebSocket::messageReceived, this, &WebSocketClient::onMessageReceived);
+    connect(m_webSocket, &ThreadedWebSocket::errorOccurred, this, &WebSocketClient::onError);
     
     setConnectionStatus("Connecting...");
     qDebug() << "Connecting to server:" << serverUrl;
@@ -117,24 +128,29 @@ void WebSocketClient::disconnect() {
     m_userInitiatedDisconnect = true;
     m_reconnectTimer->stop();
     m_reconnectAttempts = 0;
+    // Deliver what is already queued (e.g. a scene stop) before the socket goes away
+    flushSendQueue();
     if (m_webSocket) {
         if (m_webSocket->state() == QAbstractSocket::ConnectedState || m_webSocket->state() == QAbstractSocket::ConnectingState) {
             m_webSocket->close();
         }
     }
-    if (m_uploadSocket) {
-        if (m_uploadSocket->state() == QAbstractSocket::ConnectedState || m_uploadSocket->state() == QAbstractSocket::ConnectingState) {
-            m_uploadSocket->close();
-        }
-    }
+    closeUploadChannel();
 }
 
 void WebSocketClient::onUploadConnected() {
     qDebug() << "Upload channel connected";
+    m_uploadReconnectAttempts = 0;
+    m_uploadPongPending = false;
+    m_uploadHeartbeatTimer->start();
 }
 
 void WebSocketClient::onUploadDisconnected() {
     qDebug() << "Upload channel disconnected";
+    m_uploadHeartbeatTimer->stop();
+    m_uploadClientId.clear();
+    setUploadChannelReady(false);
+    scheduleUploadReconnect();
 }
 
 void WebSocketClient::onUploadError(QAbstractSocket::SocketError error) {
@@ -147,83 +163,93 @@ void WebSocketClient::onUploadError(QAbstractSocket::SocketError error) {
         default: errorString = QString("Socket error: %1").arg(error);
     }
     qWarning() << "Upload WebSocket error:" << errorString;
+    MOUFFETTE_METRIC_COUNT("ws.upload.errors", 1);
+    // A failed open never reaches disconnected(); retry from here instead
+    if (m_uploadSocket && m_uploadSocket->state() == QAbstractSocket::UnconnectedState) {
+        setUploadChannelReady(false);
+        scheduleUploadReconnect();
+    }
 }
 
-bool WebSocketClient::isConnected() const {
-    return m_webSocket && m_webSocket->state() == QAbstractSocket::ConnectedState;
+void WebSocketClient::onUploadPong(quint64 elapsedTime, const QByteArray& payload) {
+    Q_UNUSED(payload);
+    m_uploadPongPending = false;
+    MOUFFETTE_METRIC_HISTOGRAM("ws.upload.pingRttMs", static_cast<double>(elapsedTime));
 }
 
-bool WebSocketClient::isUploadChannelConnected() const {
-    return m_uploadSocket && m_uploadSocket->state() == QAbstractSocket::ConnectedState;
+void WebSocketClient::sendUploadHeartbeat() {
+    if (!isUploadChannelConnected()) {
+        m_uploadHeartbeatTimer->stop();
+        return;
+    }
+    if (m_uploadPongPending) {
+        // No pong for a whole interval: the socket is half-open, drop it and let reconnect take over
+        qWarning() << "Upload channel heartbeat timed out; reconnecting";
+        MOUFFETTE_METRIC_COUNT("ws.upload.heartbeatTimeouts", 1);
+        m_uploadPongPending = false;
+        m_uploadSocket->abort();
+        return;
+    }
+    m_uploadPongPending = true;
+    m_uploadSocket->ping();
 }
 
-bool WebSocketClient::prepareUploadChannel(int timeoutMs) {
-    if (isUploadChannelConnected()) {
-        return true;
+void WebSocketClient::scheduleUploadReconnect() {
+    if (m_userInitiatedDisconnect || !isConnected() || m_uploadReconnectTimer->isActive()) {
+        return;
     }
+    const int shift = std::min(m_uploadReconnectAttempts, 5);
+    const int delay = std::min(UPLOAD_RECONNECT_MIN_INTERVAL << shift, UPLOAD_RECONNECT_MAX_INTERVAL);
+    ++m_uploadReconnectAttempts;
+    m_uploadReconnectTimer->start(delay);
+}
 
-    if (!ensureUploadChannel()) {
-        return false;
+void WebSocketClient::attemptUploadReconnect() {
+    if (!isConnected() || isUploadChannelConnected()) {
+        return;
     }
+    MOUFFETTE_METRIC_COUNT("ws.upload.reconnects", 1);
+    ensureUploadChannel();
+}
 
-    QElapsedTimer timer;
-    timer.start();
-    while (timer.elapsed() < timeoutMs) {
-        if (isUploadChannelConnected()) {
-            return true;
-        }
-        QCoreApplication::processEvents();
-        QThread::msleep(20);
+void WebSocketClient::setUploadChannelReady(bool ready) {
+    if (m_uploadChannelReady == ready) {
+        return;
     }
+    m_uploadChannelReady = ready;
+    MOUFFETTE_METRIC_GAUGE("ws.upload.ready", ready ? 1 : 0);
+    emit uploadChannelReadyChanged(ready);
+}
+
+bool WebSocketClient::isConnected() const {
+    return m_webSocket && m_webSocket->state() == QAbstractSocket::ConnectedState;
+}
 
-    qWarning() << "Upload channel did not connect within timeout";
-    return false;
+bool WebSocketClient::isUploadChannelConnected() const {
+    return m_uploadSocket && m_uploadSocket->state() == QAbstractSocket::ConnectedState;
 }
 
 void WebSocketClient::beginUploadSession(bool preferUploadChannel) {
     if (m_uploadSessionActive) {
-        if (preferUploadChannel && !m_useUploadSocketForSession) {
-            if (prepareUploadChannel()) {
-                m_useUploadSocketForSession = true;
-            }
+        if (preferUploadChannel && !m_useUploadSocketForSession && m_uploadChannelReady) {
+            m_useUploadSocketForSession = true;
         }
         return;
     }
 
     m_uploadSessionActive = true;
-    m_useUploadSocketForSession = false;
-
-    if (!preferUploadChannel) {
-        return;
-    }
-
-    static QElapsedTimer throttleTimer;
-    static bool timerInitialized = false;
-    if (!timerInitialized) {
-        throttleTimer.start();
-        timerInitialized = true;
-    }
-
-    if (!isUploadChannelConnected()) {
-        if (!ensureUploadChannel()) {
-            qWarning() << "Failed to initiate dedicated upload channel";
-        }
-    }
-
-    if (prepareUploadChannel()) {
-        m_useUploadSocketForSession = true;
-    } else {
-        if (!timerInitialized || throttleTimer.elapsed() > 2000) {
-            qWarning() << "Falling back to control channel for this upload session";
-            throttleTimer.restart();
-        }
+    m_useUploadSocketForSession = preferUploadChannel && m_uploadChannelReady;
+    if (preferUploadChannel && !m_useUploadSocketForSession) {
+        qWarning() << "Upload channel not ready; using control channel for this upload session";
+        MOUFFETTE_METRIC_COUNT("ws.upload.controlFallbacks", 1);
+        ensureUploadChannel();
     }
 }
 
 void WebSocketClient::endUploadSession() {
+    // The channel itself stays open for the next session
     m_uploadSessionActive = false;
     m_useUploadSocketForSession = false;
-    closeUploadChannel();
 }
 
 bool WebSocketClient::ensureUploadChannel() {
@@ -237,11 +263,12 @@ bool WebSocketClient::ensureUploadChannel() {
     }
 
     if (!m_uploadSocket) {
-        m_uploadSocket = new QWebSocket();
-        connect(m_uploadSocket, &QWebSocket::connected, this, &WebSocketClient::onUploadConnected);
-        connect(m_uploadSocket, &QWebSocket::disconnected, this, &WebSocketClient::onUploadDisconnected);
-        connect(m_uploadSocket, &QWebSocket::errorOccurred, this, &WebSocketClient::onUploadError);
-        connect(m_uploadSocket, &QWebSocket::textMessageReceived, this, &WebSocketClient::onUploadTextMessageReceived);
+        m_uploadSocket = new ThreadedWebSocket(m_chunkWriter);
+        connect(m_uploadSocket, &ThreadedWebSocket::connected, this, &WebSocketClient::onUploadConnected);
+        connect(m_uploadSocket, &ThreadedWebSocket::disconnected, this, &WebSocketClient::onUploadDisconnected);
+        connect(m_uploadSocket, &ThreadedWebSocket::errorOccurred, this, &WebSocketClient::onUploadError);
+        connect(m_uploadSocket, &ThreadedWebSocket::messageReceived, this, &WebSocketClient::onUploadMessageReceived);
+        connect(m_uploadSocket, &ThreadedWebSocket::pong, this, &WebSocketClient::onUploadPong);
     }
 
     if (m_uploadSocket->state() == QAbstractSocket::ConnectingState) {
@@ -261,9 +288,18 @@ bool WebSocketClient::ensureUploadChannel() {
 }
 
 void WebSocketClient::closeUploadChannel() {
+    m_uploadHeartbeatTimer->stop();
+    m_uploadReconnectTimer->stop();
+    m_uploadReconnectAttempts = 0;
+    m_uploadPongPending = false;
+    m_useUploadSocketForSession = false;
+    m_uploadClientId.clear();
+    setUploadChannelReady(false);
     if (!m_uploadSocket) {
         return;
     }
+    // Deliberate close: keep onUploadDisconnected() from scheduling a reconnect
+    m_uploadSocket->disconnect(this);
     if (m_uploadSocket->state() != QAbstractSocket::UnconnectedState) {
         m_uploadSocket->close();
     }
@@ -299,13 +335,69 @@ void WebSocketClient::registerClient(const QString& machineName, const QString&
             screensArray.append(screen.toJson());
         }
         message["screens"] = screensArray;
+        message["stateHash"] = ClientStateSync::stateHash(screens, volumePercent);
     }
     // Legacy systemUI field removed; per-screen uiZones now embedded in screens
+    // Opt in to incremental client directory events instead of full list broadcasts
+    message["capabilities"] = QJsonArray{QStringLiteral("client_directory_delta"),
+                                           QStringLiteral("cursor_samples"),
+                                           QStringLiteral("state_delta")};
     
-    sendMessage(message);
+    sendMessage(message, OutboundMessageQueue::Priority::Critical);
     qDebug() << "Registering client:" << machineName << "(" << platform << ") with persistentId:" << m_persistentClientId;
 }
 
+void WebSocketClient::requestClientList() {
+    if (!isConnected()) {
+        qWarning() << "Cannot request client list: not connected to server";
+        return;
+    }
+    QJsonObject message;
+    message["type"] = "request_client_list";
+    sendMessage(message);
+}
+
+void WebSocketClient::handleClientDirectoryDelta(const InboundMessage& inbound) {
+    const QJsonObject& message = inbound.json;
+    const QString& type = inbound.type;
+    const qint64 version = message.value("version").toVariant().toLongLong();
+
+    ClientDirectory::ChangeKind kind = ClientDirectory::ChangeKind::Left;
+    ClientInfo client;
+    if (type == "client_left") {
+        client.setId(message.value("id").toString());
+        client.setClientId(message.value("persistentClientId").toString());
+    } else {
+        kind = (type == "client_joined") ? ClientDirectory::ChangeKind::Joined : ClientDirectory::ChangeKind::Updated;
+        client = inbound.clientInfo;
+    }
+
+    // The directory lists other clients only; events about ourselves just advance the version
+    const bool isSelf = !m_clientId.isEmpty() && client.getId() == m_clientId;
+    ClientDirectory::ApplyResult result = ClientDirectory::ApplyResult::Applied;
+    if (isSelf) {
+        result = m_clientDirectory.skip(version);
+    } else if (kind == ClientDirectory::ChangeKind::Left) {
+        result = m_clientDirectory.applyRemoval(client.getId(), version, &client);
+    } else {
+        result = m_clientDirectory.applyUpsert(client, version);
+    }
+
+    if (result == ClientDirectory::ApplyResult::Gap) {
+        // Missed an event (or no snapshot yet): resynchronise from a full list
+        if (!m_clientListRequestPending) {
+            qDebug() << "Client directory gap at version" << version << "(local" << m_clientDirectory.version() << ") - requesting snapshot";
+            m_clientListRequestPending = true;
+            requestClientList();
+        }
+        return;
+    }
+    if (result == ClientDirectory::ApplyResult::Stale || isSelf) {
+        return;
+    }
+    emit clientDirectoryChanged(kind, client);
+}
+
 void WebSocketClient::requestScreens(const QString& targetClientId) {
     if (!isConnected()) {
         qWarning() << "Cannot request screens: not connected to server";
@@ -349,17 +441,46 @@ void WebSocketClient::sendStateSnapshot(const QList<ScreenInfo>& screens, int vo
     for (const auto& s : screens) arr.append(s.toJson());
     msg["screens"] = arr;
     if (volumePercent >= 0) msg["volumePercent"] = volumePercent;
+    msg["stateHash"] = ClientStateSync::stateHash(screens, volumePercent);
     // Legacy systemUI omitted
+    sendMessage(msg, OutboundMessageQueue::Priority::Normal,
+                OutboundMessageQueue::coalesceKey(QStringLiteral("register"), QString(), QStringLiteral("state_snapshot")));
+}
+
+void WebSocketClient::sendStateDelta(const QJsonObject& delta, const QString& baseHash, const QString& hash) {
+    if (!isConnected()) return;
+    QJsonObject msg = delta;
+    msg["type"] = "state_delta";
+    msg["baseHash"] = baseHash;
+    msg["hash"] = hash;
+    // Deltas chain on each other's hashes, so none may be coalesced away
     sendMessage(msg);
 }
 
+void WebSocketClient::sendStateHash(const QString& hash) {
+    if (!isConnected()) return;
+    QJsonObject msg;
+    msg["type"] = "state_hash";
+    msg["hash"] = hash;
+    sendMessage(msg, OutboundMessageQueue::Priority::Bulk, OutboundMessageQueue::coalesceKey(QStringLiteral("state_hash")));
+}
+
 void WebSocketClient::sendCursorUpdate(int globalX, int globalY) {
     if (!isConnected()) return;
     QJsonObject msg;
     msg["type"] = "cursor_update";
     msg["x"] = globalX;
     msg["y"] = globalY;
-    sendMessage(msg);
+    sendMessage(msg, OutboundMessageQueue::Priority::Bulk, OutboundMessageQueue::coalesceKey(QStringLiteral("cursor_update")));
+}
+
+void WebSocketClient::sendCursorSamples(const QVector<CursorSample>& samples) {
+    if (!isConnected() || samples.isEmpty()) return;
+    QJsonObject msg = CursorStream::encode(samples);
+    msg["type"] = "cursor_samples";
+    // Each batch carries distinct history, so later batches must not replace queued ones
+    sendMessage(msg, OutboundMessageQueue::Priority::Bulk);
+    MOUFFETTE_METRIC_COUNT("cursor.samplesSent", samples.size());
 }
 
 void WebSocketClient::sendUploadStart(const QString& targetClientId, const QJsonArray& filesManifest, const QString& uploadId, const QString& canvasSessionId) {
@@ -380,6 +501,7 @@ void WebSocketClient::sendUploadStart(const QString& targetClientId, const QJson
 }
 
 void WebSocketClient::sendUploadChunk(const QString& targetClientId, const QString& uploadId, const QString& fileId, int chunkIndex, const QByteArray& dataBase64, const QString& canvasSessionId) {
+    MOUFFETTE_TRACE_SCOPE("ws.sendUploadChunk");
     if (!(isConnected() || isUploadChannelConnected())) return;
     if (m_canceledUploads.contains(uploadId)) return; // drop silently
     
@@ -422,7 +544,7 @@ void WebSocketClient::sendUploadComplete(const QString& targetClientId, const QS
     sendMessageUpload(msg);
 }
 
-void WebSocketClient::sendUploadAbort(const QString& targetClientId, const QString& uploadId, const QString& reason, const QString& canvasSessionId) {
+void WebSocketClient::sendUploadAbort(const QString& targetClientId, const QString& uploadId, const QString& reason, const QString& canvasSessionId, bool relayToTarget) {
     if (!(isConnected() || isUploadChannelConnected())) return;
     m_canceledUploads.insert(uploadId);
     
@@ -433,6 +555,7 @@ void WebSocketClient::sendUploadAbort(const QString& targetClientId, const QStri
     msg["uploadId"] = uploadId;
     msg["canvasSessionId"] = canvasSessionId;
     if (!reason.isEmpty()) msg["reason"] = reason;
+    if (!relayToTarget) msg["relay"] = false;
     if (!m_clientId.isEmpty()) {
         msg["senderClientId"] = m_clientId;           // Legacy (backward compat)
         msg["senderPersistentClientId"] = m_clientId;  // PHASE 2: Explicit field
@@ -440,6 +563,99 @@ void WebSocketClient::sendUploadAbort(const QString& targetClientId, const QStri
     sendMessageUpload(msg);
 }
 
+void WebSocketClient::sendFanOutUploadStart(const QJsonArray& targets, const QJsonArray& filesManifest, const QString& uploadId) {
+    if (!(isConnected() || isUploadChannelConnected())) return;
+
+    QJsonObject msg;
+    msg["type"] = "upload_start";
+    msg["uploadId"] = uploadId;
+    msg["files"] = filesManifest;
+    msg["fanOut"] = targets; // [{targetClientId, canvasSessionId, fileIds}], split per target by the server
+    if (!m_clientId.isEmpty()) {
+        msg["senderClientId"] = m_clientId;
+        msg["senderPersistentClientId"] = m_clientId;
+    }
+    sendMessageUpload(msg);
+}
+
+void WebSocketClient::sendFanOutUploadChunk(const QStringList& targetClientIds, const QString& uploadId, const QString& fileId, int chunkIndex, const QByteArray& dataBase64) {
+    MOUFFETTE_TRACE_SCOPE("ws.sendFanOutUploadChunk");
+    if (!(isConnected() || isUploadChannelConnected())) return;
+    if (m_canceledUploads.contains(uploadId) || targetClientIds.isEmpty()) return;
+
+    QJsonObject msg;
+    msg["type"] = "upload_chunk";
+    msg["targetClientIds"] = QJsonArray::fromStringList(targetClientIds);
+    msg["uploadId"] = uploadId;
+    msg["fileId"] = fileId;
+    msg["chunkIndex"] = chunkIndex;
+    msg["data"] = QString::fromLatin1(dataBase64);
+    if (!m_clientId.isEmpty()) {
+        msg["senderClientId"] = m_clientId;
+        msg["senderPersistentClientId"] = m_clientId;
+    }
+    sendMessageUpload(msg);
+}
+
+void WebSocketClient::sendFanOutUploadComplete(const QString& uploadId) {
+    if (!(isConnected() || isUploadChannelConnected())) return;
+    if (m_canceledUploads.contains(uploadId)) return; // already canceled
+
+    QJsonObject msg;
+    msg["type"] = "upload_complete";
+    msg["uploadId"] = uploadId;
+    msg["fanOut"] = true;
+    if (!m_clientId.isEmpty()) {
+        msg["senderClientId"] = m_clientId;
+        msg["senderPersistentClientId"] = m_clientId;
+    }
+    sendMessageUpload(msg);
+}
+
+void WebSocketClient::sendFanOutUploadAbort(const QString& uploadId, const QStringList& targetClientIds, const QString& reason) {
+    if (!(isConnected() || isUploadChannelConnected())) return;
+    // Dropping a subset of targets keeps the stream alive for the others
+    if (targetClientIds.isEmpty()) m_canceledUploads.insert(uploadId);
+
+    QJsonObject msg;
+    msg["type"] = "upload_abort";
+    msg["uploadId"] = uploadId;
+    msg["fanOut"] = true;
+    if (!targetClientIds.isEmpty()) msg["targetClientIds"] = QJsonArray::fromStringList(targetClientIds);
+    if (!reason.isEmpty()) msg["reason"] = reason;
+    if (!m_clientId.isEmpty()) {
+        msg["senderClientId"] = m_clientId;
+        msg["senderPersistentClientId"] = m_clientId;
+    }
+    sendMessageUpload(msg);
+}
+
+void WebSocketClient::sendDirectTransferRequest(const QString& targetClientId, const QString& uploadId) {
+    if (!isConnected()) return;
+    QJsonObject msg;
+    msg["type"] = "direct_transfer_request";
+    msg["targetClientId"] = targetClientId;
+    msg["uploadId"] = uploadId;
+    if (!m_clientId.isEmpty()) msg["senderClientId"] = m_clientId;
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
+}
+
+void WebSocketClient::sendDirectTransferOffer(const QString& senderClientId, const QString& uploadId, bool available,
+                                              const QString& token, quint16 port, const QStringList& addresses) {
+    if (!isConnected()) return;
+    QJsonObject msg;
+    msg["type"] = "direct_transfer_offer";
+    msg["targetClientId"] = senderClientId; // Routed back to the requesting sender
+    msg["uploadId"] = uploadId;
+    msg["available"] = available;
+    if (available) {
+        msg["token"] = token;
+        msg["port"] = static_cast<int>(port);
+        msg["addresses"] = QJsonArray::fromStringList(addresses);
+    }
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
+}
+
 void WebSocketClient::sendRemoveAllFiles(const QString& targetClientId, const QString& canvasSessionId) {
     if (!isConnected()) return;
     
@@ -510,7 +726,14 @@ void WebSocketClient::notifyUploadProgressToSender(const QString& senderClientId
     if (!perFileProgress.isEmpty()) {
         msg["perFileProgress"] = perFileProgress;
     }
-    sendMessage(msg);
+    // Reports carry cumulative totals plus the percent of the file that just advanced: keep the
+    // latest report per file so no file's last percent is lost to coalescing
+    QString entity = uploadId;
+    if (perFileProgress.size() == 1) {
+        entity += QLatin1Char('/') + perFileProgress.first().toObject().value("fileId").toString();
+    }
+    sendMessage(msg, OutboundMessageQueue::Priority::Bulk,
+                OutboundMessageQueue::coalesceKey(QStringLiteral("upload_progress"), senderClientId, entity));
 }
 
 void WebSocketClient::notifyUploadFinishedToSender(const QString& senderClientId, const QString& uploadId) {
@@ -519,7 +742,8 @@ void WebSocketClient::notifyUploadFinishedToSender(const QString& senderClientId
     msg["type"] = "upload_finished";
     msg["senderClientId"] = senderClientId;
     msg["uploadId"] = uploadId;
-    sendMessage(msg);
+    // Same lane as upload_progress so it can never overtake the last progress report
+    sendMessage(msg, OutboundMessageQueue::Priority::Bulk);
 }
 
 void WebSocketClient::notifyAllFilesRemovedToSender(const QString& senderClientId) {
@@ -537,7 +761,7 @@ void WebSocketClient::sendRemoteSceneStart(const QString& targetClientId, const
     msg["targetClientId"] = targetClientId;
     msg["scene"] = scenePayload; // contains screens + media arrays
     if (!m_clientId.isEmpty()) msg["senderClientId"] = m_clientId;
-    sendMessage(msg);
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
 }
 
 void WebSocketClient::sendRemoteSceneStop(const QString& targetClientId) {
@@ -546,7 +770,7 @@ void WebSocketClient::sendRemoteSceneStop(const QString& targetClientId) {
     msg["type"] = "remote_scene_stop";
     msg["targetClientId"] = targetClientId;
     if (!m_clientId.isEmpty()) msg["senderClientId"] = m_clientId;
-    sendMessage(msg);
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
 }
 
 void WebSocketClient::sendRemoteSceneStopResult(const QString& senderClientId, bool success, const QString& errorMessage) {
@@ -559,7 +783,7 @@ void WebSocketClient::sendRemoteSceneStopResult(const QString& senderClientId, b
         msg["error"] = errorMessage;
     }
     if (!m_clientId.isEmpty()) msg["senderClientId"] = m_clientId;
-    sendMessage(msg);
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
 }
 
 void WebSocketClient::sendRemoteSceneValidationResult(const QString& senderClientId, bool success, const QString& errorMessage) {
@@ -572,7 +796,7 @@ void WebSocketClient::sendRemoteSceneValidationResult(const QString& senderClien
         msg["error"] = errorMessage;
     }
     if (!m_clientId.isEmpty()) msg["senderClientId"] = m_clientId;
-    sendMessage(msg);
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
 }
 
 void WebSocketClient::sendRemoteSceneLaunched(const QString& senderClientId) {
@@ -581,7 +805,7 @@ void WebSocketClient::sendRemoteSceneLaunched(const QString& senderClientId) {
     msg["type"] = "remote_scene_launched";
     msg["targetClientId"] = senderClientId; // Send back to the sender
     if (!m_clientId.isEmpty()) msg["senderClientId"] = m_clientId;
-    sendMessage(msg);
+    sendMessage(msg, OutboundMessageQueue::Priority::Critical);
 }
 
 void WebSocketClient::onConnected() {
@@ -592,10 +816,17 @@ void WebSocketClient::onConnected() {
     m_reconnectAttempts = 0;
     m_reconnectTimer->stop();
     emit connected();
+    // Pre-warm the upload channel so the first upload does not wait for a handshake
+    ensureUploadChannel();
 }
 
 void WebSocketClient::onDisconnected() {
     qDebug() << "Disconnected from server";
+    m_clientDirectory.clear();
+    m_clientListRequestPending = false;
+    m_sendQueue.clear();
+    m_sendFlushTimer->stop();
+    closeUploadChannel();
     // If user initiated, keep status as Disconnected (no error, no reconnect)
     setConnectionStatus("Disconnected");
     emit disconnected();
@@ -613,17 +844,9 @@ void WebSocketClient::onDisconnected() {
     }
 }
 
-void WebSocketClient::onTextMessageReceived(const QString& message) {
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
-    
-    if (error.error != QJsonParseError::NoError) {
-        qWarning() << "Failed to parse JSON message:" << error.errorString();
-        return;
-    }
-    
-    QJsonObject messageObj = doc.object();
-    handleMessage(messageObj);
+void WebSocketClient::onMessageReceived(const InboundMessage& message) {
+    MOUFFETTE_TRACE_SCOPE("ws.receive");
+    handleMessage(message);
 }
 
 void WebSocketClient::onError(QAbstractSocket::SocketError error) {
@@ -692,21 +915,24 @@ void WebSocketClient::attemptReconnect() {
     }
 }
 
-void WebSocketClient::handleMessage(const QJsonObject& message) {
-    QString type = message["type"].toString();
+void WebSocketClient::handleMessage(const InboundMessage& inbound) {
+    using Kind = InboundMessage::Kind;
+    const QJsonObject& message = inbound.json;
     // Suppress noisy logs for high-frequency message types
-    if (type != "upload_progress" && type != "cursor_update") {
-        qDebug() << "Received message type:" << type;
+    if (inbound.kind != Kind::UploadProgress && inbound.kind != Kind::CursorUpdate &&
+        inbound.kind != Kind::CursorSamples && inbound.kind != Kind::StateHash) {
+        qDebug() << "Received message type:" << inbound.type;
     }
     
-    if (type == "welcome") {
+    switch (inbound.kind) {
+    case Kind::Welcome:
         // ✅ ID TERMINOLOGY FIX: Read explicit "socketId" field (new) with fallback to "clientId" (legacy)
         m_socketClientId = message.contains("socketId") 
             ? message["socketId"].toString() 
             : message["clientId"].toString();
         qDebug() << "Received welcome with socket ID:" << m_socketClientId;
-    }
-    else if (type == "error") {
+        break;
+    case Kind::Error: {
         const QString err = message.value("message").toString();
         qWarning() << "❌ Server error:" << err;
         
@@ -717,63 +943,66 @@ void WebSocketClient::handleMessage(const QJsonObject& message) {
             // Business logic error - remote client is offline, this is normal
             qDebug() << "Remote client is offline, ignoring error (not a connection issue)";
             // Don't emit connectionError - this would trigger reconnection
-            return;
+            break;
         }
         
         // For other errors, emit signal so UI can show the error to user
         emit connectionError(err);
+        break;
     }
-    else if (type == "registration_confirmed") {
-        QJsonObject clientInfoObj = message["clientInfo"].toObject();
-        ClientInfo clientInfo = ClientInfo::fromJson(clientInfoObj);
-        if (!clientInfo.getId().isEmpty()) {
-            m_clientId = clientInfo.getId();
-        }
-        qDebug() << "Registration confirmed for session" << m_clientId << "persistent" << clientInfo.clientId();
-        emit registrationConfirmed(clientInfo);
-    }
-    else if (type == "client_list") {
-        QJsonArray clientsArray = message["clients"].toArray();
-        QList<ClientInfo> clients;
-        
-        for (const auto& clientValue : clientsArray) {
-            ClientInfo client = ClientInfo::fromJson(clientValue.toObject());
-            clients.append(client);
+    case Kind::RegistrationConfirmed:
+        if (!inbound.clientInfo.getId().isEmpty()) {
+            m_clientId = inbound.clientInfo.getId();
         }
-        
-        emit clientListReceived(clients);
-    }
-    else if (type == "screens_info") {
-        QJsonObject clientInfoObj = message["clientInfo"].toObject();
-        ClientInfo clientInfo = ClientInfo::fromJson(clientInfoObj);
-        emit screensInfoReceived(clientInfo);
-    }
-    else if (type == "watch_status") {
-        bool watched = message["watched"].toBool(false);
-        emit watchStatusChanged(watched);
-    }
-    else if (type == "data_request") {
+        qDebug() << "Registration confirmed for session" << m_clientId << "persistent" << inbound.clientInfo.clientId();
+        emit registrationConfirmed(inbound.clientInfo);
+        break;
+    case Kind::ClientList:
+        // Servers without a directory version send full lists only; treat each one as version 0
+        m_clientDirectory.resetFromSnapshot(inbound.clients, message.value("version").toVariant().toLongLong());
+        m_clientListRequestPending = false;
+        emit clientListReceived(inbound.clients);
+        break;
+    case Kind::ClientDirectoryDelta:
+        handleClientDirectoryDelta(inbound);
+        break;
+    case Kind::ScreensInfo:
+        emit screensInfoReceived(inbound.clientInfo);
+        break;
+    case Kind::WatchStatus:
+        emit watchStatusChanged(message["watched"].toBool(false));
+        break;
+    case Kind::DataRequest:
         emit dataRequestReceived();
-    }
-    else if (type == "cursor_update") {
+        break;
+    case Kind::StateDelta:
+        emit remoteStateDeltaReceived(message.value("targetClientId").toString(), message);
+        break;
+    case Kind::StateHash:
+        emit remoteStateHashReceived(message.value("targetClientId").toString(), message.value("hash").toString());
+        break;
+    case Kind::CursorUpdate:
         // Forward to UI with target id context
-        const QString targetId = message.value("targetClientId").toString();
-        const int x = message.value("x").toInt();
-        const int y = message.value("y").toInt();
-        emit cursorPositionReceived(targetId, x, y);
-    }
-    else if (type == "upload_progress") {
+        emit cursorPositionReceived(message.value("targetClientId").toString(),
+                                    message.value("x").toInt(), message.value("y").toInt());
+        break;
+    case Kind::CursorSamples:
+        // Decoded (and validated) on the network thread
+        emit cursorSamplesReceived(message.value("targetClientId").toString(), inbound.cursorSamples);
+        break;
+    case Kind::UploadProgress: {
         const QString uploadId = message.value("uploadId").toString();
         const int percent = message.value("percent").toInt();
         const int filesCompleted = message.value("filesCompleted").toInt();
         const int totalFiles = message.value("totalFiles").toInt();
-        emit uploadProgressReceived(uploadId, percent, filesCompleted, totalFiles);
+        const QString targetClientId = message.value("targetClientId").toString();
+        emit uploadProgressReceived(uploadId, percent, filesCompleted, totalFiles, targetClientId);
         if (message.contains("completedFileIds") && message.value("completedFileIds").isArray()) {
             QStringList ids;
             const QJsonArray arr = message.value("completedFileIds").toArray();
             ids.reserve(arr.size());
             for (const auto& v : arr) ids.append(v.toString());
-            emit uploadCompletedFileIdsReceived(uploadId, ids);
+            emit uploadCompletedFileIdsReceived(uploadId, ids, targetClientId);
         }
         if (message.contains("perFileProgress") && message.value("perFileProgress").isArray()) {
             const QJsonArray arr = message.value("perFileProgress").toArray();
@@ -786,65 +1015,115 @@ void WebSocketClient::handleMessage(const QJsonObject& message) {
             }
             if (!map.isEmpty()) emit uploadPerFileProgressReceived(uploadId, map);
         }
-    }
-    else if (type == "upload_finished") {
-        const QString uploadId = message.value("uploadId").toString();
-        emit uploadFinishedReceived(uploadId);
-    }
-    else if (type == "all_files_removed") {
-        emit allFilesRemovedReceived();
-    }
-    else if (type == "remote_scene_start") {
-        const QString sender = message.value("senderClientId").toString();
-        const QJsonObject scene = message.value("scene").toObject();
-        emit remoteSceneStartReceived(sender, scene);
-    }
-    else if (type == "remote_scene_stop") {
-        const QString sender = message.value("senderClientId").toString();
-        emit remoteSceneStopReceived(sender);
-    }
-    else if (type == "remote_scene_stopped") {
-        const QString sender = message.value("senderClientId").toString();
-        const bool success = message.value("success").toBool(false);
-        const QString error = message.value("error").toString();
-        emit remoteSceneStoppedReceived(sender, success, error);
-    }
-    else if (type == "remote_scene_validation") {
-        const QString sender = message.value("senderClientId").toString();
-        const bool success = message.value("success").toBool();
-        const QString error = message.value("error").toString();
-        emit remoteSceneValidationReceived(sender, success, error);
-    }
-    else if (type == "remote_scene_launched") {
-        const QString sender = message.value("senderClientId").toString();
-        emit remoteSceneLaunchedReceived(sender);
-    }
-    else if (type == "state_sync") {
-        // PHASE 2: Handle server state synchronization after reconnection
-        qDebug() << "WebSocketClient: Received state_sync from server";
-        // Forward to MainWindow for processing
+        break;
+    }
+    case Kind::UploadFinished:
+        emit uploadFinishedReceived(message.value("uploadId").toString(), message.value("targetClientId").toString());
+        break;
+    case Kind::AllFilesRemoved:
+        emit allFilesRemovedReceived(message.value("targetClientId").toString());
+        break;
+    case Kind::RemoteSceneStart:
+        emit remoteSceneStartReceived(message.value("senderClientId").toString(), message.value("scene").toObject());
+        break;
+    case Kind::RemoteSceneStop:
+        emit remoteSceneStopReceived(message.value("senderClientId").toString());
+        break;
+    case Kind::RemoteSceneStopped:
+        emit remoteSceneStoppedReceived(message.value("senderClientId").toString(),
+                                        message.value("success").toBool(false),
+                                        message.value("error").toString());
+        break;
+    case Kind::RemoteSceneValidation:
+        emit remoteSceneValidationReceived(message.value("senderClientId").toString(),
+                                           message.value("success").toBool(),
+                                           message.value("error").toString());
+        break;
+    case Kind::RemoteSceneLaunched:
+        emit remoteSceneLaunchedReceived(message.value("senderClientId").toString());
+        break;
+    case Kind::UploadStart:
+    case Kind::UploadChunk:
+    case Kind::UploadComplete:
+    case Kind::UploadAbort:
+        // Target-side upload control; file bytes were already handled by IncomingChunkWriter
         emit messageReceived(message);
-    }
-    else {
-        // Forward unknown messages
+        break;
+    case Kind::Unknown:
+        if (inbound.type == QLatin1String("state_sync")) {
+            // PHASE 2: Handle server state synchronization after reconnection
+            qDebug() << "WebSocketClient: Received state_sync from server";
+        }
+        // Forward unknown messages (state_sync goes to MainWindow)
         emit messageReceived(message);
+        break;
     }
 }
 
-void WebSocketClient::sendMessage(const QJsonObject& message) {
+void WebSocketClient::sendMessage(const QJsonObject& message, OutboundMessageQueue::Priority priority, const QString& coalesceKey) {
+    MOUFFETTE_TRACE_SCOPE("ws.sendMessage");
     if (!isConnected()) {
         qWarning() << "Cannot send message: not connected";
         return;
     }
     
-    QJsonDocument doc(message);
-    QString jsonString = doc.toJson(QJsonDocument::Compact);
-    m_webSocket->sendTextMessage(jsonString);
+    if (m_sendQueue.enqueue(message, priority, coalesceKey)) {
+        MOUFFETTE_METRIC_COUNT("ws.sendQueue.coalesced", 1);
+    }
+    MOUFFETTE_METRIC_GAUGE("ws.sendQueue.depth", m_sendQueue.size());
+    if (!m_sendFlushTimer->isActive()) {
+        m_sendFlushTimer->start();
+    }
+}
+
+void WebSocketClient::flushSendQueue() {
+    MOUFFETTE_TRACE_SCOPE("ws.flushSendQueue");
+    m_sendFlushTimer->stop();
+    if (m_sendQueue.isEmpty()) {
+        return;
+    }
+    const qint64 now = m_sendQueue.nowMs();
+    const QVector<OutboundMessageQueue::Entry> entries = m_sendQueue.takeAll();
+    MOUFFETTE_METRIC_GAUGE("ws.sendQueue.depth", 0);
+    if (!isConnected()) {
+        qWarning() << "Dropping" << entries.size() << "queued messages: not connected";
+        MOUFFETTE_METRIC_COUNT("ws.sendQueue.dropped", entries.size());
+        return;
+    }
+    for (const OutboundMessageQueue::Entry& entry : entries) {
+        MOUFFETTE_METRIC_HISTOGRAM("ws.sendQueue.ageMs", now - entry.enqueuedAtMs);
+        m_webSocket->sendJson(entry.message);
+    }
+    MOUFFETTE_METRIC_COUNT("ws.sendQueue.sent", entries.size());
 }
 
 void WebSocketClient::sendMessageUpload(const QJsonObject& message) {
+    MOUFFETTE_TRACE_SCOPE("ws.sendMessageUpload");
+    // Upload messages bypass the queue, so write out anything queued before them first; otherwise
+    // e.g. an upload_start could overtake the remove_all_files or remote_scene_* that preceded it
+    flushSendQueue();
     const QString type = message.value("type").toString();
-    QWebSocket* channel = nullptr;
+    // Aborts always take the relay: the server must stop tracking and the link may be what failed
+    if (m_directUploadLink && type != "upload_abort") {
+        if (!m_directUploadLink->sendMessage(message)) {
+            qWarning() << "Direct upload link closed; dropping" << type;
+            return;
+        }
+        if (type == "upload_chunk") {
+            MOUFFETTE_METRIC_COUNT("directTransfer.chunksSent", 1);
+            return;
+        }
+        // The server still records the transfer (file ownership, stall cleanup) without forwarding it
+        QJsonObject tracking = message;
+        tracking["relay"] = false;
+        sendMessageUploadRelayed(tracking);
+        return;
+    }
+    sendMessageUploadRelayed(message);
+}
+
+void WebSocketClient::sendMessageUploadRelayed(const QJsonObject& message) {
+    ThreadedWebSocket* channel = nullptr;
     bool attemptedUploadChannel = false;
 
     if (m_useUploadSocketForSession) {
@@ -857,9 +1136,10 @@ void WebSocketClient::sendMessageUpload(const QJsonObject& message) {
     if (!channel && isConnected()) {
         channel = m_webSocket;
         if (attemptedUploadChannel) {
+            // The channel reconnects on its own; finish this session on the control socket
             qWarning() << "Falling back to control channel for upload session";
+            MOUFFETTE_METRIC_COUNT("ws.upload.controlFallbacks", 1);
             m_useUploadSocketForSession = false;
-            closeUploadChannel();
         }
     }
 
@@ -868,8 +1148,7 @@ void WebSocketClient::sendMessageUpload(const QJsonObject& message) {
         return;
     }
 
-    QJsonDocument doc(message);
-    channel->sendTextMessage(doc.toJson(QJsonDocument::Compact));
+    channel->sendJson(message);
 }
 
 void WebSocketClient::setConnectionStatus(const QString& status) {
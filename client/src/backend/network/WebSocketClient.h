@@ -2,14 +2,25 @@
 #define WEBSOCKETCLIENT_H
 
 #include <QObject>
-#include <QWebSocket>
+#include <QPointer>
+#include <QAbstractSocket>
 #include <QSet>
 #include <QHash>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QTimer>
 #include <QJsonArray>
+#include <memory>
 #include "backend/domain/models/ClientInfo.h"
+#include "backend/network/ClientDirectory.h"
+#include "backend/network/ClientStateSync.h"
+#include "backend/network/CursorStream.h"
+#include "backend/network/InboundMessage.h"
+#include "backend/network/OutboundMessageQueue.h"
+
+class DirectTransferLink;
+class IncomingChunkWriter;
+class ThreadedWebSocket;
 
 class WebSocketClient : public QObject {
     Q_OBJECT
@@ -22,28 +33,52 @@ public:
     void connectToServer(const QString& serverUrl);
     void disconnect();
     bool isConnected() const;
-    // Upload channel (secondary socket) management
+    // Upload channel (secondary socket) management. The channel is opened as soon as the control
+    // connection is up and kept alive (heartbeat + reconnect with backoff) until it drops.
     bool ensureUploadChannel(); // opens m_uploadSocket if needed (async); returns true if already connected or opening
     void closeUploadChannel();  // closes m_uploadSocket if open
     bool isUploadChannelConnected() const;
-    bool prepareUploadChannel(int timeoutMs = 1500);
+    // Connected and welcomed by the server; uploadChannelReadyChanged() reports transitions
+    bool isUploadChannelReady() const { return m_uploadChannelReady; }
+    // Never blocks: routes the session over the upload channel only if it is ready right now
     void beginUploadSession(bool preferUploadChannel);
     void endUploadSession();
+    // Target-side writer for relayed upload chunks, fed on the network thread
+    IncomingChunkWriter* chunkWriter() const { return m_chunkWriter.get(); }
     
     // Client registration
     void registerClient(const QString& machineName, const QString& platform, const QList<ScreenInfo>& screens, int volumePercent);
+    void requestClientList();
     void requestScreens(const QString& targetClientId);
     void watchScreens(const QString& targetClientId);
     void unwatchScreens(const QString& targetClientId);
     void sendStateSnapshot(const QList<ScreenInfo>& screens, int volumePercent);
+    // Change-driven updates to the published snapshot (see ClientStateSync)
+    void sendStateDelta(const QJsonObject& delta, const QString& baseHash, const QString& hash);
+    void sendStateHash(const QString& hash);
         // Send current cursor position (global desktop coordinates) when this client is watched
         void sendCursorUpdate(int globalX, int globalY);
+        // Send a batch of timestamped cursor samples (see CursorStream); never coalesced
+        void sendCursorSamples(const QVector<CursorSample>& samples);
 
     // Upload/unload protocol (JSON relayed by server)
     void sendUploadStart(const QString& targetClientId, const QJsonArray& filesManifest, const QString& uploadId, const QString& canvasSessionId);
     void sendUploadChunk(const QString& targetClientId, const QString& uploadId, const QString& fileId, int chunkIndex, const QByteArray& dataBase64, const QString& canvasSessionId);
     void sendUploadComplete(const QString& targetClientId, const QString& uploadId, const QString& canvasSessionId);
-    void sendUploadAbort(const QString& targetClientId, const QString& uploadId, const QString& reason, const QString& canvasSessionId);
+    // relayToTarget=false only clears the server's tracking (the target never saw this upload)
+    void sendUploadAbort(const QString& targetClientId, const QString& uploadId, const QString& reason, const QString& canvasSessionId, bool relayToTarget = true);
+    // LAN direct transfer negotiation (relayed); see DirectTransferServer
+    // Fan-out upload: one stream from the sender, duplicated by the server to every listed target.
+    // targets: [{targetClientId, canvasSessionId, fileIds}]; an empty abort list aborts every target.
+    void sendFanOutUploadStart(const QJsonArray& targets, const QJsonArray& filesManifest, const QString& uploadId);
+    void sendFanOutUploadChunk(const QStringList& targetClientIds, const QString& uploadId, const QString& fileId, int chunkIndex, const QByteArray& dataBase64);
+    void sendFanOutUploadComplete(const QString& uploadId);
+    void sendFanOutUploadAbort(const QString& uploadId, const QStringList& targetClientIds, const QString& reason);
+    void sendDirectTransferRequest(const QString& targetClientId, const QString& uploadId);
+    void sendDirectTransferOffer(const QString& senderClientId, const QString& uploadId, bool available,
+                                 const QString& token = QString(), quint16 port = 0, const QStringList& addresses = QStringList());
+    // While set, upload_start/chunk/complete go over the link; the relay only gets tracking copies
+    void setDirectUploadLink(DirectTransferLink* link) { m_directUploadLink = link; }
     void sendRemoveAllFiles(const QString& targetClientId, const QString& canvasSessionId);
     void sendRemoveFile(const QString& targetClientId, const QString& canvasSessionId, const QString& fileId);
     
@@ -66,12 +101,15 @@ public:
 
     // Client-side cancel safeguard: mark an uploadId as cancelled to ignore any further chunk sends
     void cancelUploadId(const QString& uploadId) { m_canceledUploads.insert(uploadId); }
+    int canceledUploadCount() const { return m_canceledUploads.size(); }
     
     // Getters
     QString getClientId() const { return m_clientId; }
     QString getSessionId() const { return m_sessionId; }
     QString getPersistentClientId() const { return m_persistentClientId; }
     QString getConnectionStatus() const { return m_connectionStatus; }
+    // Other registered clients as currently known from the server's client directory
+    const QList<ClientInfo>& connectedClients() const { return m_clientDirectory.clients(); }
     
     // Set persistent client ID (called once at startup after loading from settings)
     void setPersistentClientId(const QString& id) { m_persistentClientId = id; }
@@ -83,22 +121,30 @@ signals:
     void fatalError(const QString& error); // PHASE 1: Non-recoverable errors (e.g., SSL handshake failure)
     void connectionStatusChanged(const QString& status); // emitted whenever textual connection status updates
     void clientListReceived(const QList<ClientInfo>& clients);
+    // One incremental directory change; connectedClients() already reflects it when emitted
+    void clientDirectoryChanged(ClientDirectory::ChangeKind kind, const ClientInfo& client);
+    void uploadChannelReadyChanged(bool ready);
     void registrationConfirmed(const ClientInfo& clientInfo);
     void screensInfoReceived(const ClientInfo& clientInfo);
     void messageReceived(const QJsonObject& message);
     void watchStatusChanged(bool watched);
     void dataRequestReceived();
+    // Watcher side: changes to, and heartbeat hash of, a watched target's screens/volume
+    void remoteStateDeltaReceived(const QString& targetClientId, const QJsonObject& delta);
+    void remoteStateHashReceived(const QString& targetClientId, const QString& hash);
         // Emitted to watchers with remote cursor position of the watched target
         void cursorPositionReceived(const QString& targetClientId, int x, int y);
+        void cursorSamplesReceived(const QString& targetClientId, const QVector<CursorSample>& samples);
 
     // Upload progress signals (from target via server)
-    void uploadProgressReceived(const QString& uploadId, int percent, int filesCompleted, int totalFiles);
+    // targetClientId names the reporting target (needed to tell fan-out targets apart)
+    void uploadProgressReceived(const QString& uploadId, int percent, int filesCompleted, int totalFiles, const QString& targetClientId);
     // New: carries fileIds that the target reports as fully received so far
-    void uploadCompletedFileIdsReceived(const QString& uploadId, const QStringList& fileIds);
+    void uploadCompletedFileIdsReceived(const QString& uploadId, const QStringList& fileIds, const QString& targetClientId);
     // New: fine-grained per-file percent from target
     void uploadPerFileProgressReceived(const QString& uploadId, const QHash<QString,int>& filePercents);
-    void uploadFinishedReceived(const QString& uploadId);
-    void allFilesRemovedReceived();
+    void uploadFinishedReceived(const QString& uploadId, const QString& targetClientId);
+    void allFilesRemovedReceived(const QString& targetClientId);
     // Remote scene inbound events
     void remoteSceneStartReceived(const QString& senderClientId, const QJsonObject& scenePayload);
     void remoteSceneStopReceived(const QString& senderClientId);
@@ -110,24 +156,41 @@ signals:
 private slots:
     void onConnected();
     void onDisconnected();
-    void onTextMessageReceived(const QString& message);
-    void onUploadTextMessageReceived(const QString& message);
+    void onMessageReceived(const InboundMessage& message);
+    void onUploadMessageReceived(const InboundMessage& message);
     void onError(QAbstractSocket::SocketError error);
     void attemptReconnect();
     // Upload socket handlers
     void onUploadConnected();
     void onUploadDisconnected();
     void onUploadError(QAbstractSocket::SocketError error);
+    void onUploadPong(quint64 elapsedTime, const QByteArray& payload);
+    void sendUploadHeartbeat();
+    void attemptUploadReconnect();
 
 private:
-    void handleMessage(const QJsonObject& message);
-    void sendMessage(const QJsonObject& message);
+    void handleMessage(const InboundMessage& inbound);
+    // Queues for the next event-loop tick; see OutboundMessageQueue for priority and coalescing
+    void sendMessage(const QJsonObject& message,
+                     OutboundMessageQueue::Priority priority = OutboundMessageQueue::Priority::Normal,
+                     const QString& coalesceKey = QString());
+    void flushSendQueue();
     void sendMessageUpload(const QJsonObject& message);
+    void sendMessageUploadRelayed(const QJsonObject& message);
     void setConnectionStatus(const QString& status);
+    void handleClientDirectoryDelta(const InboundMessage& inbound);
+    void setUploadChannelReady(bool ready);
+    void scheduleUploadReconnect();
     QSet<QString> m_canceledUploads; // uploadIds that should drop further chunk sends
+    ClientDirectory m_clientDirectory;
+    OutboundMessageQueue m_sendQueue;
+    bool m_clientListRequestPending = false;
     
-    QWebSocket* m_webSocket;
-    QWebSocket* m_uploadSocket = nullptr;
+    // Shared with the network thread, which writes relayed upload chunks into it
+    std::shared_ptr<IncomingChunkWriter> m_chunkWriter;
+    ThreadedWebSocket* m_webSocket;
+    ThreadedWebSocket* m_uploadSocket = nullptr;
+    QPointer<DirectTransferLink> m_directUploadLink;
     QString m_serverUrl;
     QString m_clientId;           // Current session ID assigned/confirmed by server
     QString m_persistentClientId; // Stable ID generated by client, persisted across sessions
@@ -140,8 +203,17 @@ private:
     bool m_userInitiatedDisconnect = false;
     bool m_uploadSessionActive = false;
     bool m_useUploadSocketForSession = false;
+    bool m_uploadChannelReady = false;
+    bool m_uploadPongPending = false;
+    QTimer* m_uploadHeartbeatTimer;
+    QTimer* m_uploadReconnectTimer;
+    QTimer* m_sendFlushTimer;
+    int m_uploadReconnectAttempts = 0;
     static const int MAX_RECONNECT_ATTEMPTS = 5;
     static const int RECONNECT_INTERVAL = 3000; // 3 seconds
+    static const int UPLOAD_HEARTBEAT_INTERVAL = 10000; // a missed pong by the next tick drops the channel
+    static const int UPLOAD_RECONNECT_MIN_INTERVAL = 500;
+    static const int UPLOAD_RECONNECT_MAX_INTERVAL = 15000;
 };
 
 #endif // WEBSOCKETCLIENT_H
@@ -0,0 +1,82 @@
+#include "frontend/rendering/canvas/RemoteCursorInterpolator.h"
+#include <algorithm>
+
+void RemoteCursorInterpolator::push(const QVector<CursorSample>& samples, qint64 localNowMs) {
+    if (samples.isEmpty()) {
+        return;
+    }
+    // A sender restart resets its clock; drop history that would now sort after the new samples
+    if (!m_samples.isEmpty() && samples.first().timeMs < m_samples.last().timeMs) {
+        reset();
+    }
+    const qint64 observed = localNowMs - samples.last().timeMs;
+    if (!m_hasClockOffset || observed < m_clockOffsetMs) {
+        m_clockOffsetMs = observed;
+        m_hasClockOffset = true;
+    } else {
+        // Follow slow drift (or a permanently longer route) without chasing jitter
+        m_clockOffsetMs += std::max<qint64>(1, (observed - m_clockOffsetMs) / 32);
+    }
+    m_samples += samples;
+}
+
+void RemoteCursorInterpolator::reset() {
+    m_samples.clear();
+    m_hasClockOffset = false;
+    m_clockOffsetMs = 0;
+}
+
+bool RemoteCursorInterpolator::positionAt(qint64 localNowMs, QPointF* position) {
+    if (m_samples.isEmpty() || !position) {
+        return false;
+    }
+    const qint64 t = playbackTime(localNowMs);
+
+    int last = -1; // newest sample at or before the playback time
+    while (last + 1 < m_samples.size() && m_samples.at(last + 1).timeMs <= t) {
+        ++last;
+    }
+    if (last < 0) {
+        const CursorSample& first = m_samples.first();
+        *position = QPointF(first.x, first.y);
+        return true;
+    }
+    // Keep the sample before 'last' too: it gives the velocity when extrapolating
+    if (last > 1) {
+        m_samples.remove(0, last - 1);
+        last = 1;
+    }
+
+    const CursorSample& a = m_samples.at(last);
+    if (last + 1 < m_samples.size()) {
+        const CursorSample& b = m_samples.at(last + 1);
+        // After an idle gap the move starts shortly before b, not at the earlier rest sample
+        const qint64 start = std::max(a.timeMs, b.timeMs - kMaxSegmentMs);
+        if (t <= start) {
+            *position = QPointF(a.x, a.y);
+            return true;
+        }
+        const qreal f = static_cast<qreal>(t - start) / static_cast<qreal>(std::max<qint64>(1, b.timeMs - start));
+        *position = QPointF(a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f);
+        return true;
+    }
+
+    // Starved: continue along the last segment, then ease back so a cursor that really stopped
+    // does not stay parked past its final position
+    *position = QPointF(a.x, a.y);
+    if (last >= 1) {
+        const CursorSample& p = m_samples.at(last - 1);
+        const qint64 span = a.timeMs - p.timeMs;
+        const qint64 ahead = t - a.timeMs;
+        if (span > 0 && span <= kMaxSegmentMs) {
+            const qint64 lead = ahead <= kMaxExtrapolationMs ? ahead : std::max<qint64>(0, 2 * kMaxExtrapolationMs - ahead);
+            const qreal f = static_cast<qreal>(lead) / static_cast<qreal>(span);
+            *position += QPointF((a.x - p.x) * f, (a.y - p.y) * f);
+        }
+    }
+    return true;
+}
+
+bool RemoteCursorInterpolator::isSettled(qint64 localNowMs) const {
+    return m_samples.isEmpty() || playbackTime(localNowMs) >= m_samples.last().timeMs + 2 * kMaxExtrapolationMs;
+}
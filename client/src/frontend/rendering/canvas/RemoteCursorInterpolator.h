@@ -0,0 +1,38 @@
+#ifndef REMOTECURSORINTERPOLATOR_H
+#define REMOTECURSORINTERPOLATOR_H
+
+#include <QPointF>
+#include <QVector>
+#include "backend/network/CursorStream.h"
+
+/**
+ * Replays batched remote cursor samples on the local clock.
+ *
+ * Playback runs kPlaybackDelayMs behind the newest sample so a whole batch is normally buffered
+ * and positions are linearly interpolated between samples; if the next batch is late the last
+ * velocity is extrapolated for at most kMaxExtrapolationMs, then eased back. The sender/receiver clock offset
+ * tracks the lowest observed transit time and drifts up slowly to follow clock skew.
+ */
+class RemoteCursorInterpolator {
+public:
+    static constexpr int kPlaybackDelayMs = CursorStream::kBatchIntervalMs + 30;
+    static constexpr int kMaxExtrapolationMs = 40;
+    static constexpr int kMaxSegmentMs = 120; // longer gaps are idle time: hold, then move
+
+    void push(const QVector<CursorSample>& samples, qint64 localNowMs);
+    void reset();
+    bool isEmpty() const { return m_samples.isEmpty(); }
+    // Remote desktop position to display at localNowMs; false when there is nothing to show
+    bool positionAt(qint64 localNowMs, QPointF* position);
+    // Playback has passed the last sample for good; the caller can stop ticking
+    bool isSettled(qint64 localNowMs) const;
+
+private:
+    qint64 playbackTime(qint64 localNowMs) const { return localNowMs - m_clockOffsetMs - kPlaybackDelayMs; }
+
+    QVector<CursorSample> m_samples; // ascending sender time
+    qint64 m_clockOffsetMs = 0;      // local time minus sender time
+    bool m_hasClockOffset = false;
+};
+
+#endif // REMOTECURSORINTERPOLATOR_H
@@ -9,8 +9,12 @@
 #include "backend/domain/media/MediaItems.h"
 #include "backend/domain/media/MediaSettingsPanel.h" // for settingsPanel() accessor usage
 #include "backend/domain/media/TextMediaItem.h" // for text media creation
+#include "backend/domain/media/TextRasterScheduler.h"
 #include "frontend/ui/notifications/ToastNotificationSystem.h" // for toast notifications
 #include "frontend/ui/widgets/ClippedContainer.h" // for ClippedContainer widget
+#include "backend/files/SceneDocument.h" // canvas document container format
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsSceneHoverEvent>
@@ -61,6 +65,7 @@
 #include <QDebug>
 #include <cmath>
 #include <algorithm>
+#include <utility>
 #include <limits>
 
 #ifdef Q_OS_MACOS
@@ -444,6 +449,7 @@ ScreenCanvas::~ScreenCanvas() {
 }
 
 QJsonObject ScreenCanvas::serializeSceneState() const {
+    MOUFFETTE_TRACE_SCOPE("canvas.serializeScene");
     QJsonObject root;
     // Phase 3: canvasSessionId is MANDATORY - only include in manifest if it's not the default
     if (m_activeIdeaId != DEFAULT_IDEA_ID) {
@@ -522,6 +528,12 @@ QJsonObject ScreenCanvas::serializeSceneState() const {
                             break;
                     }
                     m["verticalAlignment"] = verticalAlignment;
+
+                    // Optional: lets the remote draw the host's line breaks without re-shaping
+                    const QJsonObject textLayout = textMedia->shapedLayoutPayload();
+                    if (!textLayout.isEmpty()) {
+                        m["textLayout"] = textLayout;
+                    }
                 }
             } else {
                 m["type"] = media->isVideoMedia() ? "video" : "image";
@@ -649,6 +661,354 @@ QJsonObject ScreenCanvas::serializeSceneState() const {
     return root;
 }
 
+namespace {
+QJsonObject mediaSettingsToJson(const ResizableMediaBase::MediaSettingsState& s) {
+    QJsonObject o;
+    o["displayAutomatically"] = s.displayAutomatically;
+    o["displayDelayEnabled"] = s.displayDelayEnabled;
+    o["displayDelayText"] = s.displayDelayText;
+    o["unmuteAutomatically"] = s.unmuteAutomatically;
+    o["unmuteDelayEnabled"] = s.unmuteDelayEnabled;
+    o["unmuteDelayText"] = s.unmuteDelayText;
+    o["playAutomatically"] = s.playAutomatically;
+    o["playDelayEnabled"] = s.playDelayEnabled;
+    o["playDelayText"] = s.playDelayText;
+    o["pauseDelayEnabled"] = s.pauseDelayEnabled;
+    o["pauseDelayText"] = s.pauseDelayText;
+    o["repeatEnabled"] = s.repeatEnabled;
+    o["repeatCountText"] = s.repeatCountText;
+    o["fadeInEnabled"] = s.fadeInEnabled;
+    o["fadeInText"] = s.fadeInText;
+    o["fadeOutEnabled"] = s.fadeOutEnabled;
+    o["fadeOutText"] = s.fadeOutText;
+    o["audioFadeInEnabled"] = s.audioFadeInEnabled;
+    o["audioFadeInText"] = s.audioFadeInText;
+    o["audioFadeOutEnabled"] = s.audioFadeOutEnabled;
+    o["audioFadeOutText"] = s.audioFadeOutText;
+    o["opacityOverrideEnabled"] = s.opacityOverrideEnabled;
+    o["opacityText"] = s.opacityText;
+    o["volumeOverrideEnabled"] = s.volumeOverrideEnabled;
+    o["volumeText"] = s.volumeText;
+    o["hideDelayEnabled"] = s.hideDelayEnabled;
+    o["hideDelayText"] = s.hideDelayText;
+    o["hideWhenVideoEnds"] = s.hideWhenVideoEnds;
+    o["muteDelayEnabled"] = s.muteDelayEnabled;
+    o["muteDelayText"] = s.muteDelayText;
+    o["muteWhenVideoEnds"] = s.muteWhenVideoEnds;
+    return o;
+}
+
+ResizableMediaBase::MediaSettingsState mediaSettingsFromJson(const QJsonObject& o) {
+    ResizableMediaBase::MediaSettingsState s;
+    auto readBool = [&](const char* key, bool& field) { if (o.contains(key)) field = o.value(key).toBool(field); };
+    auto readText = [&](const char* key, QString& field) { if (o.contains(key)) field = o.value(key).toString(field); };
+    readBool("displayAutomatically", s.displayAutomatically);
+    readBool("displayDelayEnabled", s.displayDelayEnabled);
+    readText("displayDelayText", s.displayDelayText);
+    readBool("unmuteAutomatically", s.unmuteAutomatically);
+    readBool("unmuteDelayEnabled", s.unmuteDelayEnabled);
+    readText("unmuteDelayText", s.unmuteDelayText);
+    readBool("playAutomatically", s.playAutomatically);
+    readBool("playDelayEnabled", s.playDelayEnabled);
+    readText("playDelayText", s.playDelayText);
+    readBool("pauseDelayEnabled", s.pauseDelayEnabled);
+    readText("pauseDelayText", s.pauseDelayText);
+    readBool("repeatEnabled", s.repeatEnabled);
+    readText("repeatCountText", s.repeatCountText);
+    readBool("fadeInEnabled", s.fadeInEnabled);
+    readText("fadeInText", s.fadeInText);
+    readBool("fadeOutEnabled", s.fadeOutEnabled);
+    readText("fadeOutText", s.fadeOutText);
+    readBool("audioFadeInEnabled", s.audioFadeInEnabled);
+    readText("audioFadeInText", s.audioFadeInText);
+    readBool("audioFadeOutEnabled", s.audioFadeOutEnabled);
+    readText("audioFadeOutText", s.audioFadeOutText);
+    readBool("opacityOverrideEnabled", s.opacityOverrideEnabled);
+    readText("opacityText", s.opacityText);
+    readBool("volumeOverrideEnabled", s.volumeOverrideEnabled);
+    readText("volumeText", s.volumeText);
+    readBool("hideDelayEnabled", s.hideDelayEnabled);
+    readText("hideDelayText", s.hideDelayText);
+    readBool("hideWhenVideoEnds", s.hideWhenVideoEnds);
+    readBool("muteDelayEnabled", s.muteDelayEnabled);
+    readText("muteDelayText", s.muteDelayText);
+    readBool("muteWhenVideoEnds", s.muteWhenVideoEnds);
+    return s;
+}
+
+QJsonObject textPropertiesToJson(const TextMediaItem* text) {
+    QJsonObject o;
+    o["text"] = text->text();
+    o["font"] = text->font().toString();
+    o["fontWeight"] = text->textFontWeightValue();
+    o["fontWeightOverride"] = text->textFontWeightOverrideEnabled();
+    o["italic"] = text->italicEnabled();
+    o["underline"] = text->underlineEnabled();
+    o["uppercase"] = text->uppercaseEnabled();
+    o["textColor"] = text->textColor().name(QColor::HexArgb);
+    o["textColorOverride"] = text->textColorOverrideEnabled();
+    o["borderWidthPercent"] = text->textBorderWidth();
+    o["borderWidthOverride"] = text->textBorderWidthOverrideEnabled();
+    o["borderColor"] = text->textBorderColor().name(QColor::HexArgb);
+    o["borderColorOverride"] = text->textBorderColorOverrideEnabled();
+    o["highlightEnabled"] = text->highlightEnabled();
+    o["highlightColor"] = text->highlightColor().name(QColor::HexArgb);
+    o["horizontalAlignment"] = static_cast<int>(text->horizontalAlignment());
+    o["verticalAlignment"] = static_cast<int>(text->verticalAlignment());
+    o["fitToText"] = text->fitToTextEnabled();
+    o["uniformScale"] = text->uniformScaleFactor();
+    return o;
+}
+
+void applyTextPropertiesFromJson(TextMediaItem* text, const QJsonObject& o) {
+    QFont font;
+    if (font.fromString(o.value("font").toString())) {
+        text->setFont(font);
+    }
+    text->setTextFontWeightValue(o.value("fontWeight").toInt(text->textFontWeightValue()), false);
+    text->setTextFontWeightOverrideEnabled(o.value("fontWeightOverride").toBool());
+    text->setItalicEnabled(o.value("italic").toBool(text->italicEnabled()));
+    text->setUnderlineEnabled(o.value("underline").toBool(text->underlineEnabled()));
+    text->setUppercaseEnabled(o.value("uppercase").toBool(text->uppercaseEnabled()));
+    text->setTextColor(QColor(o.value("textColor").toString(text->textColor().name(QColor::HexArgb))));
+    text->setTextColorOverrideEnabled(o.value("textColorOverride").toBool());
+    text->setTextBorderWidth(o.value("borderWidthPercent").toDouble(text->textBorderWidth()));
+    text->setTextBorderWidthOverrideEnabled(o.value("borderWidthOverride").toBool());
+    text->setTextBorderColor(QColor(o.value("borderColor").toString(text->textBorderColor().name(QColor::HexArgb))));
+    text->setTextBorderColorOverrideEnabled(o.value("borderColorOverride").toBool());
+    text->setHighlightEnabled(o.value("highlightEnabled").toBool());
+    text->setHighlightColor(QColor(o.value("highlightColor").toString(text->highlightColor().name(QColor::HexArgb))));
+    text->setHorizontalAlignment(static_cast<TextMediaItem::HorizontalAlignment>(
+        std::clamp(o.value("horizontalAlignment").toInt(1), 0, 2)));
+    text->setVerticalAlignment(static_cast<TextMediaItem::VerticalAlignment>(
+        std::clamp(o.value("verticalAlignment").toInt(1), 0, 2)));
+    text->setFitToTextEnabled(o.value("fitToText").toBool());
+    text->setUniformScaleFactor(o.value("uniformScale").toDouble(1.0));
+}
+} // namespace
+
+QJsonObject ScreenCanvas::serializeDocument() const {
+    QJsonObject root;
+    root["canvasSessionId"] = m_activeIdeaId;
+    QJsonArray screensArr;
+    for (const ScreenInfo& si : m_screens) {
+        screensArr.append(si.toJson());
+    }
+    root["screens"] = screensArr;
+
+    QJsonObject files;   // fileId -> { path, fileName, poster, width, height }
+    QJsonArray mediaArr; // bottom-to-top z order
+    if (m_scene) {
+        for (QGraphicsItem* gi : getMediaItemsSortedByZ()) {
+            auto* media = dynamic_cast<ResizableMediaBase*>(gi);
+            if (!media || media->isBeingDeleted()) continue;
+
+            QJsonObject m;
+            m["mediaId"] = media->mediaId();
+            m["fileId"] = media->fileId();
+            m["x"] = media->pos().x();
+            m["y"] = media->pos().y();
+            m["scale"] = media->scale();
+            m["z"] = media->zValue();
+            m["baseWidth"] = media->baseSizePx().width();
+            m["baseHeight"] = media->baseSizePx().height();
+            m["visible"] = media->isContentVisible();
+            m["contentOpacity"] = media->contentOpacity();
+            m["settings"] = mediaSettingsToJson(media->mediaSettingsState());
+
+            if (auto* text = dynamic_cast<TextMediaItem*>(media)) {
+                m["type"] = "text";
+                m["text"] = textPropertiesToJson(text);
+                mediaArr.append(m);
+                continue;
+            }
+
+            m["type"] = media->isVideoMedia() ? "video" : "image";
+            if (auto* video = dynamic_cast<ResizableVideoItem*>(media)) {
+                m["muted"] = video->isMuted();
+                m["volume"] = video->volume();
+            }
+            const QString fileId = media->fileId();
+            if (!fileId.isEmpty() && !files.contains(fileId)) {
+                QJsonObject f;
+                const QString path = !media->sourcePath().isEmpty()
+                    ? media->sourcePath()
+                    : (m_fileManager ? m_fileManager->getFilePathForId(fileId) : QString());
+                f["path"] = path;
+                f["fileName"] = QFileInfo(path).fileName();
+                f["width"] = media->baseSizePx().width();
+                f["height"] = media->baseSizePx().height();
+                QImage poster;
+                if (auto* video = dynamic_cast<ResizableVideoItem*>(media)) {
+                    poster = video->posterFrameImage();
+                } else if (auto* pixmapItem = dynamic_cast<ResizablePixmapItem*>(media)) {
+                    poster = pixmapItem->pixmap().toImage();
+                }
+                f["poster"] = SceneDocument::encodePoster(poster);
+                files.insert(fileId, f);
+            }
+            mediaArr.append(m);
+        }
+    }
+    root["files"] = files;
+    root["media"] = mediaArr;
+    return root;
+}
+
+bool ScreenCanvas::loadDocument(const QJsonObject& document, QString* errorMessage) {
+    if (!m_scene) {
+        if (errorMessage) *errorMessage = QStringLiteral("Canvas has no scene");
+        return false;
+    }
+    if (m_hostSceneActive) {
+        if (errorMessage) *errorMessage = QStringLiteral("Cannot open a document while a scene is running");
+        return false;
+    }
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
+    // Replace current media
+    const QList<ResizableMediaBase*> existing = [this]() {
+        QList<ResizableMediaBase*> out;
+        for (QGraphicsItem* gi : m_scene->items()) {
+            if (auto* media = dynamic_cast<ResizableMediaBase*>(gi)) out.append(media);
+        }
+        return out;
+    }();
+    m_scene->clearSelection();
+    for (ResizableMediaBase* media : existing) {
+        deleteMediaItem(media);
+    }
+
+    // Screens reflect the live remote layout; only fall back to the saved layout when none is known
+    if (!hasActiveScreens()) {
+        QList<ScreenInfo> screens;
+        for (const QJsonValue& v : document.value("screens").toArray()) {
+            screens.append(ScreenInfo::fromJson(v.toObject()));
+        }
+        if (!screens.isEmpty()) {
+            setScreens(screens);
+        }
+    }
+
+    const QJsonObject files = document.value("files").toObject();
+    // Posters are decoded once per file on a worker after the scene is built
+    struct PosterTarget {
+        ResizableMediaBase* media = nullptr;
+        std::weak_ptr<bool> guard;
+    };
+    QHash<QString, QString> encodedPosters;
+    QHash<QString, QVector<PosterTarget>> posterTargets;
+    int created = 0;
+    for (const QJsonValue& v : document.value("media").toArray()) {
+        const QJsonObject m = v.toObject();
+        const QString type = m.value("type").toString();
+        const QString fileId = m.value("fileId").toString();
+        const QSize baseSize(m.value("baseWidth").toInt(), m.value("baseHeight").toInt());
+        const QJsonObject file = files.value(fileId).toObject();
+        const QString path = file.value("path").toString();
+
+        ResizableMediaBase* media = nullptr;
+        if (type == QLatin1String("text")) {
+            const QJsonObject textProps = m.value("text").toObject();
+            auto* text = new TextMediaItem(baseSize.isEmpty() ? QSize(TextMediaDefaults::DEFAULT_WIDTH, TextMediaDefaults::DEFAULT_HEIGHT) : baseSize,
+                                           m_mediaHandleVisualSizePx, m_mediaHandleSelectionSizePx,
+                                           textProps.value("text").toString());
+            text->setMediaId(m.value("mediaId").toString());
+            text->setScale(m.value("scale").toDouble(1.0));
+            applyTextPropertiesFromJson(text, textProps);
+            media = text;
+        } else if (path.isEmpty() || !QFileInfo::exists(path)) {
+            qWarning() << "ScreenCanvas: skipping document media with missing file" << fileId << path;
+            continue;
+        } else if (type == QLatin1String("video")) {
+            auto* video = new ResizableVideoItem(path, 12, 30, file.value("fileName").toString(), m_videoControlsFadeMs, /*deferSourceLoad*/ true);
+            if (m_applicationSuspended) {
+                video->setApplicationSuspended(true);
+            }
+            video->setMediaId(m.value("mediaId").toString());
+            video->setSourcePath(path);
+            const qreal scale = m.value("scale").toDouble(1.0);
+            video->setInitialScaleFactor(scale);
+            video->setDocumentPlaceholder(QImage(), baseSize);
+            video->setScale(scale);
+            media = video;
+        } else {
+            auto* pixmapItem = new ResizablePixmapItem(baseSize, QPixmap(), path, 12, 30, file.value("fileName").toString());
+            pixmapItem->setMediaId(m.value("mediaId").toString());
+            pixmapItem->setSourcePath(path);
+            pixmapItem->setScale(m.value("scale").toDouble(1.0));
+            media = pixmapItem;
+        }
+
+        media->setPos(m.value("x").toDouble(), m.value("y").toDouble());
+        media->setZValue(m.value("z").toDouble(1.0));
+        m_nextMediaZValue = std::max(m_nextMediaZValue, media->zValue() + 1.0);
+        media->setMediaSettingsState(mediaSettingsFromJson(m.value("settings").toObject()));
+        if (auto* video = dynamic_cast<ResizableVideoItem*>(media)) {
+            // Applying the settings resets the volume to the override (or 100%), so restore audio after it
+            if (m.contains("volume")) video->setVolume(m.value("volume").toDouble(1.0));
+            if (m.contains("muted")) video->setMuted(m.value("muted").toBool(), true);
+        }
+        media->setContentVisible(m.value("visible").toBool(true));
+        media->setContentOpacity(m.value("contentOpacity").toDouble(1.0));
+        m_scene->addItem(media);
+        emit mediaItemAdded(media);
+        ++created;
+        if (type != QLatin1String("text") && !file.value("poster").toString().isEmpty()) {
+            encodedPosters.insert(fileId, file.value("poster").toString());
+            posterTargets[fileId].append(PosterTarget{media, media->lifetimeGuard()});
+        }
+    }
+
+    if (!encodedPosters.isEmpty()) {
+        auto* watcher = new QFutureWatcher<QHash<QString, QImage>>(this);
+        connect(watcher, &QFutureWatcher<QHash<QString, QImage>>::finished, this, [watcher, posterTargets]() {
+            const QHash<QString, QImage> posters = watcher->result();
+            watcher->deleteLater();
+            for (auto it = posterTargets.cbegin(); it != posterTargets.cend(); ++it) {
+                const QImage poster = posters.value(it.key());
+                for (const PosterTarget& target : it.value()) {
+                    if (poster.isNull() || target.guard.expired()) continue;
+                    if (auto* video = dynamic_cast<ResizableVideoItem*>(target.media)) {
+                        video->setDocumentPoster(poster);
+                    } else if (auto* pixmapItem = dynamic_cast<ResizablePixmapItem*>(target.media)) {
+                        pixmapItem->setDocumentPoster(poster);
+                    }
+                }
+            }
+        });
+        watcher->setFuture(QtConcurrent::run([encodedPosters]() {
+            QHash<QString, QImage> posters;
+            for (auto it = encodedPosters.cbegin(); it != encodedPosters.cend(); ++it) {
+                posters.insert(it.key(), SceneDocument::decodePoster(it.value()));
+            }
+            return posters;
+        }));
+    }
+
+    if (document.contains("canvasSessionId")) {
+        setActiveIdeaId(document.value("canvasSessionId").toString());
+    }
+    // One overlay refresh for the whole document instead of one per item
+    scheduleInfoOverlayRefresh();
+    qInfo() << "[CanvasDocument] loaded" << created << "items in" << loadTimer.elapsed() << "ms";
+    return true;
+}
+
+bool ScreenCanvas::saveDocumentToFile(const QString& filePath, QString* errorMessage) const {
+    return SceneDocument::writeToFile(serializeDocument(), filePath, errorMessage);
+}
+
+bool ScreenCanvas::openDocumentFromFile(const QString& filePath, QString* errorMessage) {
+    const QJsonObject document = SceneDocument::readFromFile(filePath, errorMessage);
+    if (document.isEmpty()) {
+        return false;
+    }
+    return loadDocument(document, errorMessage);
+}
+
 void ScreenCanvas::setActiveIdeaId(const QString& canvasSessionId) {
     if (m_activeIdeaId == canvasSessionId) {
         return;
@@ -1485,6 +1845,10 @@ ScreenCanvas::ScreenCanvas(QWidget* parent) : QGraphicsView(parent) {
     setScene(m_scene);
     // Expand virtual scene rect so user can pan into empty space (design tool feel)
     m_scene->setSceneRect(-50000, -50000, 100000, 100000);
+    m_textRasterScheduler = new TextRasterScheduler(m_scene, this);
+    m_textRasterScheduler->setViewportProvider([this]() -> QRectF {
+        return viewport() ? mapToScene(viewport()->rect()).boundingRect() : QRectF();
+    });
     setRenderHint(QPainter::Antialiasing, true);
     // Figma-like: no scrollbars, we manually pan/zoom via transform.
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
@@ -1589,6 +1953,18 @@ void ScreenCanvas::processPendingOverlayRelayoutSet() {
     }
 }
 
+void ScreenCanvas::processPendingVideoControlsRelayoutSet() {
+    const QSet<ResizableMediaBase*> pending = std::exchange(m_pendingVideoControlsRelayoutSet, {});
+    for (ResizableMediaBase* media : pending) {
+        if (!media || media->scene() != m_scene) {
+            continue;
+        }
+        if (auto* video = dynamic_cast<ResizableVideoItem*>(media)) {
+            video->requestOverlayRelayout();
+        }
+    }
+}
+
 void ScreenCanvas::processSceneChangedMaintenance() {
     if (!m_sceneChangedWorkPending) {
         return;
@@ -1596,15 +1972,16 @@ void ScreenCanvas::processSceneChangedMaintenance() {
 
     m_sceneChangedWorkPending = false;
     ++m_perfSceneChangedBatchCount;
+    MOUFFETTE_METRIC_COUNT("canvas.sceneChangedBatches", 1);
 
     maybeRefreshInfoOverlayOnSceneChanged();
     processPendingOverlayRelayoutSet();
+    processPendingVideoControlsRelayoutSet();
     if (m_lastOverlayLayoutTimer.elapsed() > 20) {
         layoutInfoOverlay();
         m_lastOverlayLayoutTimer.restart();
     }
     updateSelectionChromeFast();
-
     maybeEmitCanvasPerfSnapshot();
 }
 
@@ -1627,10 +2004,16 @@ void ScreenCanvas::requestZoomRelayout(bool forceFull) {
 }
 
 void ScreenCanvas::processZoomRelayout() {
+    MOUFFETTE_TRACE_SCOPE("canvas.zoomRelayout");
     if (!m_zoomRelayoutPending || !m_scene) {
         return;
     }
 
+    QElapsedTimer relayoutTimer;
+    if (Metrics::enabled()) {
+        relayoutTimer.start();
+    }
+
     const bool forceFull = m_zoomRelayoutForceFull;
     m_zoomRelayoutPending = false;
     m_zoomRelayoutForceFull = false;
@@ -1645,20 +2028,47 @@ void ScreenCanvas::processZoomRelayout() {
     } else {
         relayoutAllMediaOverlays(m_scene);
         ++m_perfFullRelayoutCount;
+        MOUFFETTE_METRIC_COUNT("canvas.fullRelayouts", 1);
     }
 
     ++m_perfRelayoutCount;
+    MOUFFETTE_METRIC_COUNT("canvas.relayouts", 1);
     if (m_lastOverlayLayoutTimer.elapsed() > 24) {
         layoutInfoOverlay();
         m_lastOverlayLayoutTimer.restart();
     }
     updateSelectionChromeFast();
 
+    if (relayoutTimer.isValid()) {
+        MOUFFETTE_METRIC_HISTOGRAM("canvas.zoomRelayoutMs", relayoutTimer.nsecsElapsed() / 1e6);
+    }
     maybeEmitCanvasPerfSnapshot();
 }
 
+ScreenCanvas::InteractionCounters ScreenCanvas::interactionCounters() const {
+    InteractionCounters c = m_perfTotals;
+    c.zoomEvents += m_perfZoomEventCount;
+    c.relayouts += m_perfRelayoutCount;
+    c.fullRelayouts += m_perfFullRelayoutCount;
+    c.selectionChrome += m_perfSelectionChromeCount;
+    c.sceneChangedBatches += m_perfSceneChangedBatchCount;
+    c.groupTransforms += m_perfGroupTransformCount;
+    return c;
+}
+
+void ScreenCanvas::resetInteractionCounters() {
+    m_perfTotals = InteractionCounters{};
+    m_perfZoomEventCount = 0;
+    m_perfRelayoutCount = 0;
+    m_perfFullRelayoutCount = 0;
+    m_perfSelectionChromeCount = 0;
+    m_perfSceneChangedBatchCount = 0;
+    m_perfGroupTransformCount = 0;
+}
+
 void ScreenCanvas::recordZoomEvent() {
     ++m_perfZoomEventCount;
+    MOUFFETTE_METRIC_COUNT("canvas.zoomEvents", 1);
     if (!m_canvasPerfWindow.isValid()) {
         m_canvasPerfWindow.start();
     }
@@ -1722,17 +2132,160 @@ void ScreenCanvas::maybeEmitCanvasPerfSnapshot() {
             << "fullRelayouts" << m_perfFullRelayoutCount
             << "selectionChrome" << m_perfSelectionChromeCount
             << "sceneChangedBatches" << m_perfSceneChangedBatchCount
+            << "groupTransforms" << m_perfGroupTransformCount
             << "viewportMode" << static_cast<int>(viewportUpdateMode());
 
+    m_perfTotals = interactionCounters();
     m_perfZoomEventCount = 0;
     m_perfRelayoutCount = 0;
     m_perfFullRelayoutCount = 0;
     m_perfSelectionChromeCount = 0;
     m_perfSceneChangedBatchCount = 0;
+    m_perfGroupTransformCount = 0;
     m_canvasPerfWindow.restart();
 }
 
+QList<ResizableMediaBase*> ScreenCanvas::selectedMediaItems() const {
+    QList<ResizableMediaBase*> out;
+    if (!m_scene) {
+        return out;
+    }
+    for (QGraphicsItem* it : m_scene->selectedItems()) {
+        if (auto* media = dynamic_cast<ResizableMediaBase*>(it)) {
+            if (!media->isBeingDeleted()) {
+                out.append(media);
+            }
+        }
+    }
+    return out;
+}
+
+void ScreenCanvas::beginGroupTransform(const QList<ResizableMediaBase*>& items) {
+    m_groupTransform = GroupTransformSession{};
+    if (!m_scene || items.isEmpty()) {
+        return;
+    }
+
+    QRectF bounds;
+    for (ResizableMediaBase* media : items) {
+        if (!media || media->scene() != m_scene || media->isBeingDeleted() || m_groupTransform.itemSet.contains(media)) {
+            continue;
+        }
+        m_groupTransform.items.append(media);
+        m_groupTransform.itemSet.insert(media);
+        m_groupTransform.guards.append(media->lifetimeGuard());
+        m_groupTransform.startPositions.append(media->pos());
+        bounds = bounds.isNull() ? media->sceneBoundingRect() : bounds.united(media->sceneBoundingRect());
+    }
+    m_groupTransform.startBounds = bounds;
+    m_groupTransform.active = !m_groupTransform.items.isEmpty();
+}
+
+void ScreenCanvas::updateGroupTranslation(const QPointF& sceneDelta, bool snap) {
+    if (!m_groupTransform.active) {
+        return;
+    }
+
+    // One snap query for the selection bounding box; every member receives the same offset.
+    const QRectF& start = m_groupTransform.startBounds;
+    const qreal unit = ResizableMediaBase::sceneGridUnit();
+    QPointF target = start.topLeft() + sceneDelta;
+    target = QPointF(std::round(target.x() / unit) * unit, std::round(target.y() / unit) * unit);
+    target = snapToMediaAndScreenTargets(target, QRectF(QPointF(0, 0), start.size()), snap, m_groupTransform.itemSet);
+    const QPointF offset = target - start.topLeft();
+
+    QList<ResizableMediaBase*> moved;
+    moved.reserve(m_groupTransform.items.size());
+    ResizableMediaBase::beginBatchedTransform();
+    for (int i = 0; i < m_groupTransform.items.size(); ++i) {
+        if (m_groupTransform.guards[i].expired()) {
+            continue;
+        }
+        ResizableMediaBase* media = m_groupTransform.items[i];
+        media->setPos(m_groupTransform.startPositions[i] + offset);
+        moved.append(media);
+    }
+    ResizableMediaBase::endBatchedTransform();
+
+    commitGroupTransformPass(moved);
+}
+
+void ScreenCanvas::endGroupTransform() {
+    if (!m_groupTransform.active) {
+        return;
+    }
+    m_groupTransform = GroupTransformSession{};
+    clearSnapIndicators();
+}
+
+void ScreenCanvas::translateSelectedMedia(const QPointF& sceneDelta) {
+    const QList<ResizableMediaBase*> selection = selectedMediaItems();
+    if (selection.isEmpty()) {
+        return;
+    }
+    beginGroupTransform(selection);
+    updateGroupTranslation(sceneDelta, false);
+    endGroupTransform();
+}
+
+void ScreenCanvas::alignSelectedMedia(GroupAlignment alignment) {
+    const QList<ResizableMediaBase*> selection = selectedMediaItems();
+    if (selection.size() < 2) {
+        return;
+    }
+
+    QRectF bounds;
+    for (ResizableMediaBase* media : selection) {
+        bounds = bounds.isNull() ? media->sceneBoundingRect() : bounds.united(media->sceneBoundingRect());
+    }
+
+    ResizableMediaBase::beginBatchedTransform();
+    for (ResizableMediaBase* media : selection) {
+        const QRectF r = media->sceneBoundingRect();
+        QPointF delta;
+        switch (alignment) {
+            case GroupAlignment::Left:             delta.setX(bounds.left() - r.left()); break;
+            case GroupAlignment::HorizontalCenter: delta.setX(bounds.center().x() - r.center().x()); break;
+            case GroupAlignment::Right:            delta.setX(bounds.right() - r.right()); break;
+            case GroupAlignment::Top:              delta.setY(bounds.top() - r.top()); break;
+            case GroupAlignment::VerticalCenter:   delta.setY(bounds.center().y() - r.center().y()); break;
+            case GroupAlignment::Bottom:           delta.setY(bounds.bottom() - r.bottom()); break;
+        }
+        media->setPos(media->pos() + delta);
+    }
+    ResizableMediaBase::endBatchedTransform();
+
+    commitGroupTransformPass(selection);
+}
+
+void ScreenCanvas::commitGroupTransformPass(const QList<ResizableMediaBase*>& items) {
+    if (items.isEmpty()) {
+        return;
+    }
+
+    ++m_perfGroupTransformCount;
+    MOUFFETTE_METRIC_COUNT("canvas.groupTransforms", 1);
+
+    // Only positions are applied per move. Overlays, video controls and selection chrome (the
+    // per-item itemChange path was skipped) follow in the next maintenance batch.
+    for (ResizableMediaBase* media : items) {
+        queueOverlayRelayoutFor(media);
+        if (dynamic_cast<ResizableVideoItem*>(media)) {
+            m_pendingVideoControlsRelayoutSet.insert(media);
+        }
+    }
+    scheduleSceneChangedMaintenance();
+
+    emit mediaGroupTransformed(items);
+}
+
 QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const QRectF& mediaBounds, bool shiftPressed, ResizableMediaBase* movingItem) const {
+    QSet<ResizableMediaBase*> movingItems;
+    if (movingItem) movingItems.insert(movingItem);
+    return snapToMediaAndScreenTargets(scenePos, mediaBounds, shiftPressed, movingItems);
+}
+
+QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const QRectF& mediaBounds, bool shiftPressed, const QSet<ResizableMediaBase*>& movingItems) const {
     if (!shiftPressed) {
         // Leaving snap mode – clear any existing indicators
         const_cast<ScreenCanvas*>(this)->clearSnapIndicators();
@@ -1794,7 +2347,7 @@ QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const
 
     for (QGraphicsItem* gi : items) {
         auto* other = dynamic_cast<ResizableMediaBase*>(gi);
-        if (!other || other == movingItem) continue;
+        if (!other || movingItems.contains(other)) continue;
         QRectF otherR = other->sceneBoundingRect();
 
         // Corner snapping between media (priority over edges)
@@ -1834,7 +2387,7 @@ QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const
     const qreal fullTol = std::min<qreal>(0.75, cornerSnapDistanceScene * 0.15);
         for (QGraphicsItem* gi : items) {
             auto* other = dynamic_cast<ResizableMediaBase*>(gi);
-            if (!other || other == movingItem) continue;
+            if (!other || movingItems.contains(other)) continue;
             QRectF o = other->sceneBoundingRect();
             if (std::abs(o.left()   - finalRect.left())   < fullTol &&
                 std::abs(o.right()  - finalRect.right())  < fullTol &&
@@ -1886,7 +2439,7 @@ QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const
         }
         // Media corners
         for (QGraphicsItem* gi : items) {
-            auto* other = dynamic_cast<ResizableMediaBase*>(gi); if (!other || other == movingItem) continue; QRectF r = other->sceneBoundingRect();
+            auto* other = dynamic_cast<ResizableMediaBase*>(gi); if (!other || movingItems.contains(other)) continue; QRectF r = other->sceneBoundingRect();
             testCornerSet({ r.topLeft(), r.topRight(), r.bottomLeft(), r.bottomRight() });
         }
         QVector<qreal> verticalXs; QVector<qreal> horizontalYs;
@@ -1928,7 +2481,7 @@ QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const
 
     for (QGraphicsItem* gi : items) {
         auto* other = dynamic_cast<ResizableMediaBase*>(gi);
-        if (!other || other == movingItem) continue;
+        if (!other || movingItems.contains(other)) continue;
         QRectF o = other->sceneBoundingRect();
         QRectF m = QRectF(snapped, movingRect.size());
         // Candidate deltas for X alignment
@@ -1956,7 +2509,7 @@ QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const
         // Full overlap detection in edge-alignment path (identical rect case where edge logic, not corner, resolved last)
     bool fullOverlap = false; QRectF overlapSourceRect; const qreal fullTol = std::min<qreal>(0.75, snapDistanceScene * 0.15);
         for (QGraphicsItem* gi : items) {
-            auto* other = dynamic_cast<ResizableMediaBase*>(gi); if (!other || other == movingItem) continue;
+            auto* other = dynamic_cast<ResizableMediaBase*>(gi); if (!other || movingItems.contains(other)) continue;
             QRectF o = other->sceneBoundingRect();
             if (std::abs(o.left()   - finalRect.left())   < fullTol &&
                 std::abs(o.right()  - finalRect.right())  < fullTol &&
@@ -2006,7 +2559,7 @@ QPointF ScreenCanvas::snapToMediaAndScreenTargets(const QPointF& scenePos, const
         // Consider other media
         for (QGraphicsItem* gi : items) {
             auto* other = dynamic_cast<ResizableMediaBase*>(gi);
-            if (!other || other == movingItem) continue;
+            if (!other || movingItems.contains(other)) continue;
             QRectF o = other->sceneBoundingRect();
             if (std::abs(finalRect.left() - o.left()) < tol) addUnique(verticalXs, o.left());
             if (std::abs(finalRect.left() - o.right()) < tol) addUnique(verticalXs, o.right());
@@ -2322,6 +2875,40 @@ void ScreenCanvas::recenterWithMargin(int marginPx) {
 }
 
 void ScreenCanvas::updateRemoteCursor(int globalX, int globalY) {
+    // Legacy single-position update: snap, dropping any interpolated playback
+    if (m_remoteCursorAnimTimer) m_remoteCursorAnimTimer->stop();
+    m_remoteCursorInterpolator.reset();
+    showRemoteCursorAt(globalX, globalY);
+}
+
+void ScreenCanvas::pushRemoteCursorSamples(const QVector<CursorSample>& samples) {
+    if (samples.isEmpty()) return;
+    if (!m_remoteCursorClock.isValid()) m_remoteCursorClock.start();
+    m_remoteCursorInterpolator.push(samples, m_remoteCursorClock.elapsed());
+    if (!m_remoteCursorAnimTimer) {
+        m_remoteCursorAnimTimer = new QTimer(this);
+        m_remoteCursorAnimTimer->setTimerType(Qt::PreciseTimer);
+        m_remoteCursorAnimTimer->setInterval(16);
+        connect(m_remoteCursorAnimTimer, &QTimer::timeout, this, &ScreenCanvas::advanceRemoteCursor);
+    }
+    if (!m_remoteCursorAnimTimer->isActive()) {
+        m_remoteCursorAnimTimer->start();
+        advanceRemoteCursor();
+    }
+}
+
+void ScreenCanvas::advanceRemoteCursor() {
+    const qint64 now = m_remoteCursorClock.elapsed();
+    QPointF remotePos;
+    if (m_remoteCursorInterpolator.positionAt(now, &remotePos)) {
+        showRemoteCursorAt(qRound(remotePos.x()), qRound(remotePos.y()));
+    }
+    if (m_remoteCursorInterpolator.isSettled(now) && m_remoteCursorAnimTimer) {
+        m_remoteCursorAnimTimer->stop();
+    }
+}
+
+void ScreenCanvas::showRemoteCursorAt(int globalX, int globalY) {
     // Inputs are remote global desktop coordinates relative to remote virtual desktop origin.
     QPointF scenePos = mapRemoteCursorToScene(globalX, globalY);
     if (scenePos.isNull()) return; // outside any screen
@@ -2332,6 +2919,8 @@ void ScreenCanvas::updateRemoteCursor(int globalX, int globalY) {
 }
 
 void ScreenCanvas::hideRemoteCursor() {
+    if (m_remoteCursorAnimTimer) m_remoteCursorAnimTimer->stop();
+    m_remoteCursorInterpolator.reset();
     if (m_remoteCursorDot) m_remoteCursorDot->hide();
 }
 
@@ -2380,6 +2969,7 @@ QGraphicsRectItem* ScreenCanvas::createSelectionHandle(qreal zValue) {
 void ScreenCanvas::updateSelectionChrome() {
     if (!m_scene) return;
     ++m_perfSelectionChromeCount;
+    MOUFFETTE_METRIC_COUNT("canvas.selectionChrome", 1);
     QSet<ResizableMediaBase*> stillSelected;
     for (QGraphicsItem* it : m_scene->selectedItems()) {
         if (auto* media = dynamic_cast<ResizableMediaBase*>(it)) {
@@ -2418,6 +3008,7 @@ void ScreenCanvas::updateSelectionChromeFast() {
     }
 
     ++m_perfSelectionChromeCount;
+    MOUFFETTE_METRIC_COUNT("canvas.selectionChrome", 1);
 
     QSet<ResizableMediaBase*> stillSelected;
     for (QGraphicsItem* it : m_scene->selectedItems()) {
@@ -3018,11 +3609,27 @@ void ScreenCanvas::keyPressEvent(QKeyEvent* event) {
         clearSnapIndicators();
     }
     // Arrow key handling: 
+    // - Alt+arrows: align selected media to the selection's left/right/top/bottom edge
+    // - Alt+Shift+arrows: align selected media on the selection's horizontal/vertical center
     // - Shift+Up/Down: change Z-order of selected media
     // - Regular arrows: nudge selected media by 1 screen pixel
     // - No selection: consume arrows to prevent view navigation
     if (event->key() == Qt::Key_Left || event->key() == Qt::Key_Right ||
         event->key() == Qt::Key_Up   || event->key() == Qt::Key_Down) {
+
+        if (event->modifiers().testFlag(Qt::AltModifier)) {
+            const bool centers = event->modifiers().testFlag(Qt::ShiftModifier);
+            GroupAlignment alignment = GroupAlignment::Left;
+            switch (event->key()) {
+                case Qt::Key_Left:  alignment = centers ? GroupAlignment::HorizontalCenter : GroupAlignment::Left; break;
+                case Qt::Key_Right: alignment = centers ? GroupAlignment::HorizontalCenter : GroupAlignment::Right; break;
+                case Qt::Key_Up:    alignment = centers ? GroupAlignment::VerticalCenter : GroupAlignment::Top; break;
+                default:            alignment = centers ? GroupAlignment::VerticalCenter : GroupAlignment::Bottom; break;
+            }
+            alignSelectedMedia(alignment);
+            event->accept();
+            return;
+        }
         
         // Handle Shift+Up/Down for Z-order changes
         if (event->modifiers().testFlag(Qt::ShiftModifier) && 
@@ -3063,16 +3670,9 @@ void ScreenCanvas::keyPressEvent(QKeyEvent* event) {
                         default: break;
                     }
                     if (dx != 0.0 || dy != 0.0) {
-                        for (QGraphicsItem* it : sel) {
-                            if (auto* base = dynamic_cast<ResizableMediaBase*>(it)) {
-                                base->setPos(base->pos() + QPointF(dx, dy));
-                                // Relayout overlays/labels for this item after movement
-                                base->requestLabelRelayout();
-                                base->updateOverlayLayout();
-                                queueOverlayRelayoutFor(base);
-                                moved = true;
-                            }
-                        }
+                        // Nudge the whole selection in one batched pass (overlays relayout once per batch)
+                        moved = !selectedMediaItems().isEmpty();
+                        translateSelectedMedia(QPointF(dx, dy));
                     }
                 }
             }
@@ -3107,6 +3707,7 @@ void ScreenCanvas::deleteMediaItem(ResizableMediaBase* item) {
     item->setEnabled(false);
     item->prepareForDeletion();
     m_pendingOverlayRelayoutSet.remove(item);
+    m_pendingVideoControlsRelayoutSet.remove(item);
 
     clearSelectionChromeFor(item);
     if (item->isSelected()) item->setSelected(false);
@@ -3289,6 +3890,11 @@ void ScreenCanvas::mousePressEvent(QMouseEvent* event) {
             m_draggingSelected = selectedUnderCursor;
             m_dragStartScene = mapToScene(event->pos());
             m_dragItemStartPos = m_draggingSelected->pos();
+            // Multi-selection moves go through the group transform engine (single pass per move)
+            const QList<ResizableMediaBase*> selection = selectedMediaItems();
+            if (selection.size() > 1) {
+                beginGroupTransform(selection);
+            }
             event->accept();
             return;
         }
@@ -3432,6 +4038,11 @@ void ScreenCanvas::mouseMoveEvent(QMouseEvent* event) {
         if (m_draggingSelected) {
             const QPointF sceneNow = mapToScene(event->pos());
             const QPointF delta = sceneNow - m_dragStartScene;
+            if (m_groupTransform.active) {
+                updateGroupTranslation(delta, event->modifiers().testFlag(Qt::ShiftModifier));
+                event->accept();
+                return;
+            }
             m_draggingSelected->setPos(m_dragItemStartPos + delta);
             m_draggingSelected->updateOverlayLayout();
             queueOverlayRelayoutFor(m_draggingSelected);
@@ -3465,6 +4076,11 @@ void ScreenCanvas::mouseMoveEvent(QMouseEvent* event) {
         if (m_draggingSelected) {
             const QPointF sceneNow = mapToScene(event->pos());
             const QPointF delta = sceneNow - m_dragStartScene;
+            if (m_groupTransform.active) {
+                updateGroupTranslation(delta, event->modifiers().testFlag(Qt::ShiftModifier));
+                event->accept();
+                return;
+            }
             m_draggingSelected->setPos(m_dragItemStartPos + delta);
             // Keep overlays and selection chrome in sync while dragging
             m_draggingSelected->updateOverlayLayout();
@@ -3517,6 +4133,7 @@ void ScreenCanvas::mouseReleaseEvent(QMouseEvent* event) {
         // If we were manually dragging a selected (possibly occluded) item, finish without letting base change selection
         if (m_draggingSelected) {
             m_draggingSelected = nullptr;
+            endGroupTransform();
             m_leftMouseActive = false; m_draggingSincePress = false; m_selectionAtPress.clear();
             event->accept();
             return;
@@ -4969,6 +5586,7 @@ void ScreenCanvas::handleRemoteConnectionLost() {
 // (Removed legacy duplicate snap indicator drawing functions; SnapGuideItem now handles rendering.)
 
 void ScreenCanvas::startHostSceneState(HostSceneMode mode) {
+    MOUFFETTE_TRACE_SCOPE("canvas.startHostScene");
     if (m_hostSceneActive) return;
     m_hostSceneActive = true;
     m_hostSceneMode = mode;
@@ -5019,6 +5637,8 @@ void ScreenCanvas::startHostSceneState(HostSceneMode mode) {
                     const int muteDelayMs = media->autoMuteDelayMs();
                     const bool shouldAutoUnmute = media->autoUnmuteEnabled();
                     const int unmuteDelayMs = media->autoUnmuteDelayMs();
+                    // Documents open with deferred sources; make sure playback has a source before scheduling
+                    vid->ensureSourceLoaded();
                     QMediaPlayer* player = vid->mediaPlayer();
 
                     if ((hideOnEnd || muteOnEnd) && player) {
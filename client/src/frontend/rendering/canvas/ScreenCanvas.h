@@ -14,6 +14,7 @@
 #include <QSet>
 #include "backend/domain/models/ClientInfo.h" // for ScreenInfo
 #include "backend/domain/media/MediaItems.h" // for ResizableMediaBase / ResizableVideoItem
+#include "frontend/rendering/canvas/RemoteCursorInterpolator.h"
 #include <QGestureEvent>
 #include <QPinchGesture>
 #include <QString>
@@ -35,6 +36,7 @@ class QToolButton;
 class QScrollArea;
 class QScrollBar;
 class TextMediaItem;
+class TextRasterScheduler;
 
 extern int gMediaListOverlayAbsoluteMaxWidthPx; // Absolute width cap (px) for media list overlay; 0 disables cap
 
@@ -61,6 +63,8 @@ public:
     void setDragPreviewFadeDurationMs(int ms) { m_dragPreviewFadeMs = qMax(0, ms); }
     void setVideoControlsFadeDurationMs(int ms) { m_videoControlsFadeMs = qMax(0, ms); }
     void updateRemoteCursor(int globalX, int globalY);
+    // Batched samples (cursor_samples); replayed smoothly by the remote cursor animation
+    void pushRemoteCursorSamples(const QVector<CursorSample>& samples);
     void hideRemoteCursor();
     void setMediaHandleSelectionSizePx(int px); // hit area
     void setMediaHandleVisualSizePx(int px);    // drawn square
@@ -77,6 +81,13 @@ public:
     bool isHostSceneActive() const { return m_hostSceneActive; }
     // Serialize current canvas state (screens + media) for remote scene start
     QJsonObject serializeSceneState() const;
+    // Persistent canvas document (see SceneDocument): media keyed by mediaId, file table keyed by fileId
+    // with cached posters/dimensions. Loading shows items immediately; full-res pixmaps and video
+    // sources are hydrated lazily when items first enter the viewport.
+    QJsonObject serializeDocument() const;
+    bool loadDocument(const QJsonObject& document, QString* errorMessage = nullptr);
+    bool saveDocumentToFile(const QString& filePath, QString* errorMessage = nullptr) const;
+    bool openDocumentFromFile(const QString& filePath, QString* errorMessage = nullptr);
     void setActiveIdeaId(const QString& canvasSessionId);
     QString activeIdeaId() const { return m_activeIdeaId; }
     // Remote scene integration setters
@@ -154,12 +165,39 @@ public:
                                                          qreal proposedW,
                                                          qreal proposedH) const;
 
+    // Group transform engine: applies one transform to a whole selection in a single pass
+    // (one snap query on the selection bounds, one notification); overlay, video control and
+    // selection chrome relayout is deferred to the next scene maintenance batch.
+    // Arrow keys nudge the selection through it; Alt(+Shift)+arrows align it.
+    enum class GroupAlignment { Left, HorizontalCenter, Right, Top, VerticalCenter, Bottom };
+    void beginGroupTransform(const QList<ResizableMediaBase*>& items);
+    void updateGroupTranslation(const QPointF& sceneDelta, bool snap); // delta relative to begin
+    void endGroupTransform();
+    bool isGroupTransformActive() const { return m_groupTransform.active; }
+    void translateSelectedMedia(const QPointF& sceneDelta);
+    void alignSelectedMedia(GroupAlignment alignment);
+
+    // Cumulative interaction counters (the same events [CanvasPerf] logs per 1s window, but never
+    // reset by logging). Used by the headless benchmark to report relayout work per scenario.
+    struct InteractionCounters {
+        quint64 zoomEvents = 0;
+        quint64 relayouts = 0;
+        quint64 fullRelayouts = 0;
+        quint64 selectionChrome = 0;
+        quint64 sceneChangedBatches = 0;
+        quint64 groupTransforms = 0;
+    };
+    InteractionCounters interactionCounters() const;
+    void resetInteractionCounters();
+
 signals:
     // Emitted when a new media item is added to the canvas
     void mediaItemAdded(ResizableMediaBase* mediaItem);
     // Emitted when a media item is removed from the canvas
     void mediaItemRemoved(ResizableMediaBase* mediaItem);
     void remoteSceneLaunchStateChanged(bool active, const QString& targetClientId, const QString& targetMachineName);
+    // Emitted once per group transform pass (move/scale/align), regardless of item count
+    void mediaGroupTransformed(const QList<ResizableMediaBase*>& items);
 
 protected:
     bool event(QEvent* event) override;
@@ -210,6 +248,8 @@ private:
     QRectF screensBoundingRect() const;
     void zoomAroundViewportPos(const QPointF& vpPos, qreal factor);
     void recreateRemoteCursorItem();
+    void showRemoteCursorAt(int globalX, int globalY);
+    void advanceRemoteCursor();
     // Global top-right info overlay (lists media files)
     void initInfoOverlay();
     void scheduleInfoOverlayRefresh();
@@ -230,6 +270,7 @@ private:
     void processZoomRelayout();
     void queueOverlayRelayoutFor(ResizableMediaBase* media);
     void processPendingOverlayRelayoutSet();
+    void processPendingVideoControlsRelayoutSet();
     void maybeEmitCanvasPerfSnapshot();
     void recordZoomEvent();
     void queueZoomInput(const QPointF& vpPos, qreal factor);
@@ -247,6 +288,8 @@ private:
     // Snap-to-screen helpers
     QPointF snapToScreenBorders(const QPointF& scenePos, const QRectF& mediaBounds, bool shiftPressed) const;
     QPointF snapToMediaAndScreenTargets(const QPointF& scenePos, const QRectF& mediaBounds, bool shiftPressed, ResizableMediaBase* movingItem) const;
+    // Same as above, excluding every item of a moving group from the snap candidates
+    QPointF snapToMediaAndScreenTargets(const QPointF& scenePos, const QRectF& mediaBounds, bool shiftPressed, const QSet<ResizableMediaBase*>& movingItems) const;
     struct ResizeSnapResult {
         qreal scale {1.0};
         bool cornerSnapped {false};
@@ -263,6 +306,7 @@ private:
     QList<QRectF> getScreenBorderRects() const;
 
     QGraphicsScene* m_scene = nullptr;
+    TextRasterScheduler* m_textRasterScheduler = nullptr; // shared raster queue + memory budget for text items
     QList<QGraphicsRectItem*> m_screenItems;
     QList<ScreenInfo> m_screens;
     QList<QGraphicsRectItem*> m_uiZoneItems; // per-screen uiZones overlays
@@ -305,8 +349,14 @@ private:
     quint64 m_perfFullRelayoutCount = 0;
     quint64 m_perfSelectionChromeCount = 0;
     quint64 m_perfSceneChangedBatchCount = 0;
+    quint64 m_perfGroupTransformCount = 0;
+    InteractionCounters m_perfTotals; // accumulated from closed [CanvasPerf] windows
     QSet<ResizableMediaBase*> m_pendingOverlayRelayoutSet;
+    QSet<ResizableMediaBase*> m_pendingVideoControlsRelayoutSet; // videos moved by a group transform
     QGraphicsEllipseItem* m_remoteCursorDot = nullptr;
+    RemoteCursorInterpolator m_remoteCursorInterpolator;
+    QTimer* m_remoteCursorAnimTimer = nullptr; // ~60 fps while interpolated samples are playing
+    QElapsedTimer m_remoteCursorClock;
     // Remote cursor styling
     int m_remoteCursorDiameterPx = 30;
     QColor m_remoteCursorFill = Qt::white;
@@ -465,6 +515,19 @@ protected:
     QPointF m_dragStartScene;
     QPointF m_dragItemStartPos;
 
+    // Group transform session state (start snapshot so every pass is applied from the origin)
+    struct GroupTransformSession {
+        bool active = false;
+        QList<ResizableMediaBase*> items;
+        QSet<ResizableMediaBase*> itemSet;
+        QVector<std::weak_ptr<bool>> guards;
+        QVector<QPointF> startPositions;
+        QRectF startBounds;
+    };
+    GroupTransformSession m_groupTransform;
+    QList<ResizableMediaBase*> selectedMediaItems() const;
+    void commitGroupTransformPass(const QList<ResizableMediaBase*>& items);
+
     // Snap visual indicators routed through dedicated SnapGuideItem (no local caching needed)
     void updateSnapIndicators(const QVector<QLineF>& lines);
     void clearSnapIndicators();
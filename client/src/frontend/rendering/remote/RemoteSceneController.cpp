@@ -1,6 +1,9 @@
 #include "frontend/rendering/remote/RemoteSceneController.h"
 #include "backend/network/WebSocketClient.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
 #include "frontend/ui/notifications/ToastNotificationSystem.h"
+#include "backend/domain/media/GlyphBitmapCache.h"
 #include <QJsonArray>
 #include <QScreen>
 #include <QGuiApplication>
@@ -51,6 +54,9 @@
 #include <QEvent>
 #include <QEventLoop>
 #include <QAccessible>
+#include <QFutureWatcher>
+#include <QPalette>
+#include <QtConcurrent/QtConcurrentRun>
 #include <cmath>
 #include "backend/files/FileManager.h"
 #include "backend/platform/macos/MacWindowManager.h"
@@ -59,13 +65,13 @@
 #include <QVideoFrameFormat>
 #include <array>
 #include <limits>
+#include <utility>
 
 
 namespace {
 constexpr qint64 kStartPositionToleranceMs = 120;
 constexpr qint64 kDecoderSyncToleranceMs = 25;
 constexpr int kLivePlaybackWarmupFrames = 2;
-constexpr int kDefaultRemoteRenderedGlyphCacheCostKb = 32768;
 
 bool parseEnvBool(const QByteArray& raw, bool* valid = nullptr) {
     const QByteArray lowered = raw.trimmed().toLower();
@@ -109,21 +115,6 @@ bool textGlyphAtlasV1Enabled() {
     return enabled;
 }
 
-int renderedGlyphCacheMaxCostKb() {
-    static const int maxCostKb = []() {
-        const QByteArray raw = qgetenv("MOUFFETTE_TEXT_GLYPH_CACHE_MAX_COST_KB");
-        if (!raw.isEmpty()) {
-            bool ok = false;
-            const int parsed = raw.trimmed().toInt(&ok);
-            if (ok) {
-                return std::clamp(parsed, 1024, 262144);
-            }
-        }
-        return kDefaultRemoteRenderedGlyphCacheCostKb;
-    }();
-    return maxCostKb;
-}
-
 struct RemoteGlyphCacheStats {
     quint64 hits = 0;
     quint64 misses = 0;
@@ -135,6 +126,7 @@ struct RemoteGlyphCacheStats {
     int maxCostKb = 0;
     QVector<qint64> recentDurationsMs;
     QElapsedTimer window;
+    QMutex mutex; // span rasters report from the remote text raster pool
 };
 
 RemoteGlyphCacheStats& remoteGlyphCacheStats() {
@@ -143,11 +135,16 @@ RemoteGlyphCacheStats& remoteGlyphCacheStats() {
 }
 
 void recordRemoteGlyphCacheInsert(bool evictionHint, int currentCostKb, int maxCostKb) {
+    MOUFFETTE_METRIC_COUNT("remote.glyphCache.inserts", 1);
+    if (evictionHint) MOUFFETTE_METRIC_COUNT("remote.glyphCache.evictionHints", 1);
+    MOUFFETTE_METRIC_GAUGE("remote.glyphCache.costKb", currentCostKb);
+    MOUFFETTE_METRIC_GAUGE("remote.glyphCache.maxCostKb", maxCostKb);
     if (!textProfilingEnabled()) {
         return;
     }
 
     RemoteGlyphCacheStats& stats = remoteGlyphCacheStats();
+    QMutexLocker locker(&stats.mutex);
     ++stats.inserts;
     if (evictionHint) {
         ++stats.evictionHints;
@@ -157,11 +154,16 @@ void recordRemoteGlyphCacheInsert(bool evictionHint, int currentCostKb, int maxC
 }
 
 void recordRemoteGlyphCacheStats(quint64 hits, quint64 misses, quint64 glyphsDrawn, qint64 durationMs) {
+    MOUFFETTE_METRIC_COUNT("remote.glyphCache.hits", hits);
+    MOUFFETTE_METRIC_COUNT("remote.glyphCache.misses", misses);
+    MOUFFETTE_METRIC_COUNT("remote.glyphCache.glyphsDrawn", glyphsDrawn);
+    MOUFFETTE_METRIC_HISTOGRAM("remote.glyphCache.renderMs", durationMs);
     if (!textProfilingEnabled()) {
         return;
     }
 
     RemoteGlyphCacheStats& stats = remoteGlyphCacheStats();
+    QMutexLocker locker(&stats.mutex);
     stats.hits += hits;
     stats.misses += misses;
     stats.glyphsDrawn += glyphsDrawn;
@@ -243,190 +245,49 @@ uint qHash(const GlyphPathKey& key, uint seed = 0) {
 }
 
 QPainterPath cachedGlyphPath(const QRawFont& font, quint32 glyphIndex) {
+    // Locked because the shared glyph bitmap cache may call this from raster worker threads
     static QHash<GlyphPathKey, QPainterPath> s_cache;
+    static QMutex s_cacheMutex;
 
     const qreal pixelSize = font.pixelSize();
     const qint64 pixelSizeScaled = static_cast<qint64>(std::llround(pixelSize * 1024.0));
     const GlyphPathKey cacheKey{font.familyName(), font.styleName(), pixelSizeScaled, glyphIndex};
-    const auto it = s_cache.constFind(cacheKey);
-    if (it != s_cache.cend()) {
-        return *it;
+    {
+        QMutexLocker locker(&s_cacheMutex);
+        const auto it = s_cache.constFind(cacheKey);
+        if (it != s_cache.cend()) {
+            return *it;
+        }
     }
 
     QPainterPath path;
     if (font.isValid()) {
         path = font.pathForGlyph(glyphIndex);
     }
+    QMutexLocker locker(&s_cacheMutex);
     s_cache.insert(cacheKey, path);
     return path;
 }
 
-struct RemoteRenderedGlyphKey {
-    QString family;
-    QString style;
-    qint64 pixelSizeScaled = 0;
-    quint32 glyphIndex = 0;
-    QRgb fillColor = 0;
-    QRgb strokeColor = 0;
-    QRgb highlightColor = 0;
-    quint8 highlightEnabled = 0;
-    qint32 strokeWidthScaled = 0;
-    qint32 scaleBucket = 0;
-
-    friend bool operator==(const RemoteRenderedGlyphKey& a, const RemoteRenderedGlyphKey& b) {
-        return a.family == b.family &&
-               a.style == b.style &&
-               a.pixelSizeScaled == b.pixelSizeScaled &&
-               a.glyphIndex == b.glyphIndex &&
-               a.fillColor == b.fillColor &&
-               a.strokeColor == b.strokeColor &&
-               a.highlightColor == b.highlightColor &&
-               a.highlightEnabled == b.highlightEnabled &&
-               a.strokeWidthScaled == b.strokeWidthScaled &&
-               a.scaleBucket == b.scaleBucket;
-    }
-};
-
-uint qHash(const RemoteRenderedGlyphKey& key, uint seed = 0) {
-    seed = ::qHash(key.family, seed);
-    seed = ::qHash(key.style, seed);
-    seed = ::qHash(static_cast<quint64>(key.pixelSizeScaled), seed);
-    seed = ::qHash(key.glyphIndex, seed);
-    seed = ::qHash(key.fillColor, seed);
-    seed = ::qHash(key.strokeColor, seed);
-    seed = ::qHash(key.highlightColor, seed);
-    seed = ::qHash(key.highlightEnabled, seed);
-    seed = ::qHash(key.strokeWidthScaled, seed);
-    return ::qHash(key.scaleBucket, seed);
-}
-
-struct RemoteRenderedGlyphBitmap {
-    QPixmap strokePixmap;
-    QPixmap fillPixmap;
-    QPointF originOffset;
-};
-
-RemoteRenderedGlyphBitmap cachedRenderedGlyph(const QRawFont& font,
-                                              quint32 glyphIndex,
-                                              const QColor& fillColor,
-                                              const QColor& strokeColor,
-                                              const QColor& highlightColor,
-                                              bool highlightEnabled,
-                                              qreal strokeWidth,
-                                              qreal scaleFactor,
-                                              bool* cacheHit = nullptr) {
-    RemoteRenderedGlyphBitmap result;
-    if (!font.isValid() || strokeWidth < 0.0) {
-        if (cacheHit) {
-            *cacheHit = false;
-        }
-        return result;
-    }
-
-    static QCache<RemoteRenderedGlyphKey, RemoteRenderedGlyphBitmap> s_renderedGlyphCache(renderedGlyphCacheMaxCostKb());
-    static QMutex s_renderedGlyphCacheMutex;
-
-    const qreal pixelSize = font.pixelSize();
-    const qint64 pixelSizeScaled = static_cast<qint64>(std::llround(pixelSize * 1024.0));
-    RemoteRenderedGlyphKey cacheKey;
-    cacheKey.family = font.familyName();
-    cacheKey.style = font.styleName();
-    cacheKey.pixelSizeScaled = pixelSizeScaled;
-    cacheKey.glyphIndex = glyphIndex;
-    cacheKey.fillColor = fillColor.rgba();
-    cacheKey.strokeColor = strokeColor.rgba();
-    cacheKey.highlightColor = highlightColor.rgba();
-    cacheKey.highlightEnabled = highlightEnabled ? 1 : 0;
-    cacheKey.strokeWidthScaled = static_cast<qint32>(std::llround(strokeWidth * 1024.0));
-    cacheKey.scaleBucket = static_cast<qint32>(std::llround(std::max(std::abs(scaleFactor), 1e-4) * 256.0));
-
-    {
-        QMutexLocker locker(&s_renderedGlyphCacheMutex);
-        if (const RemoteRenderedGlyphBitmap* cached = s_renderedGlyphCache.object(cacheKey)) {
-            if (cacheHit) {
-                *cacheHit = true;
-            }
-            return *cached;
-        }
-    }
-
-    const QPainterPath glyphPath = cachedGlyphPath(font, glyphIndex);
-    if (glyphPath.isEmpty()) {
-        if (cacheHit) {
-            *cacheHit = false;
-        }
-        return result;
-    }
-
-    const QRectF pathBounds = glyphPath.boundingRect();
-    const qreal padding = std::ceil(strokeWidth * 2.0) + 2.0;
-    const QRectF renderBounds = pathBounds.adjusted(-padding, -padding, padding, padding);
-    const qreal rasterScale = std::max(std::abs(scaleFactor), 1e-4);
-    const int width = std::max(1, static_cast<int>(std::ceil(renderBounds.width() * rasterScale)));
-    const int height = std::max(1, static_cast<int>(std::ceil(renderBounds.height() * rasterScale)));
-
-    QImage fillImage(width, height, QImage::Format_ARGB32_Premultiplied);
-    fillImage.fill(Qt::transparent);
-
-    if (strokeWidth > 0.0) {
-        QImage strokeImage(width, height, QImage::Format_ARGB32_Premultiplied);
-        strokeImage.fill(Qt::transparent);
-        QPainter strokePainter(&strokeImage);
-        strokePainter.setRenderHint(QPainter::Antialiasing, true);
-        strokePainter.scale(rasterScale, rasterScale);
-        strokePainter.translate(-renderBounds.left(), -renderBounds.top());
-        strokePainter.setPen(QPen(strokeColor, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        strokePainter.setBrush(Qt::NoBrush);
-        strokePainter.drawPath(glyphPath);
-        strokePainter.end();
-        result.strokePixmap = QPixmap::fromImage(strokeImage);
-        result.strokePixmap.setDevicePixelRatio(rasterScale);
-    }
-
-    QPainter fillPainter(&fillImage);
-    fillPainter.setRenderHint(QPainter::Antialiasing, true);
-    fillPainter.scale(rasterScale, rasterScale);
-    fillPainter.translate(-renderBounds.left(), -renderBounds.top());
-    fillPainter.setPen(Qt::NoPen);
-    fillPainter.setBrush(fillColor);
-    fillPainter.drawPath(glyphPath);
-    fillPainter.end();
-
-    result.fillPixmap = QPixmap::fromImage(fillImage);
-    result.fillPixmap.setDevicePixelRatio(rasterScale);
-    result.originOffset = renderBounds.topLeft();
-    if (result.fillPixmap.isNull() && result.strokePixmap.isNull()) {
-        if (cacheHit) {
-            *cacheHit = false;
-        }
-        return result;
-    }
-
-    {
-        QMutexLocker locker(&s_renderedGlyphCacheMutex);
-        const int countBefore = s_renderedGlyphCache.count();
-        const int totalCostBefore = s_renderedGlyphCache.totalCost();
-        if (!s_renderedGlyphCache.object(cacheKey)) {
-            const int strokeCostKb = result.strokePixmap.isNull()
-                ? 0
-                : (result.strokePixmap.width() * result.strokePixmap.height() * 4) / 1024;
-            const int fillCostKb = result.fillPixmap.isNull()
-                ? 0
-                : (result.fillPixmap.width() * result.fillPixmap.height() * 4) / 1024;
-            const int costKb = std::max(1, strokeCostKb + fillCostKb);
-            s_renderedGlyphCache.insert(cacheKey, new RemoteRenderedGlyphBitmap(result), costKb);
-            const int countAfter = s_renderedGlyphCache.count();
-            const int totalCostAfter = s_renderedGlyphCache.totalCost();
-            const bool evictionHint = (countAfter <= countBefore) ||
-                (totalCostAfter < (totalCostBefore + costKb));
-            recordRemoteGlyphCacheInsert(evictionHint, totalCostAfter, s_renderedGlyphCache.maxCost());
-        }
-    }
-
-    if (cacheHit) {
-        *cacheHit = false;
-    }
-    return result;
+GlyphCoverage cachedGlyphCoverage(const QRawFont& font,
+                                  quint32 glyphIndex,
+                                  qreal strokeWidth,
+                                  qreal scaleFactor,
+                                  bool* cacheHit = nullptr) {
+    // Shares entries and the memory budget with the editor's glyph atlas renderer
+    GlyphBitmapCache::InsertInfo insertInfo;
+    GlyphCoverage coverage = GlyphBitmapCache::instance().fetchOrRender(font,
+                                                                        glyphIndex,
+                                                                        strokeWidth,
+                                                                        scaleFactor,
+                                                                        &cachedGlyphPath,
+                                                                        GlyphBitmapCache::Consumer::Remote,
+                                                                        cacheHit,
+                                                                        &insertInfo);
+    if (insertInfo.inserted) {
+        recordRemoteGlyphCacheInsert(insertInfo.evictionHint, insertInfo.totalCostKb, insertInfo.maxCostKb);
+    }
+    return coverage;
 }
 
 QRectF computeDocumentTextBounds(const QTextDocument& doc, QAbstractTextDocumentLayout* layout) {
@@ -469,6 +330,97 @@ QRectF computeDocumentTextBounds(const QTextDocument& doc, QAbstractTextDocument
     return bounds;
 }
 
+// Draws a host-shaped layout through the shared glyph cache; mirrors the editor's atlas path
+// (outline masks under fill masks, vector paths for glyphs the cache could not produce).
+void paintShapedTextLayout(QPainter* painter,
+                           const ShapedTextLayout& layout,
+                           const QVector<QRawFont>& fonts,
+                           const QPointF& shift,
+                           qreal deviceScale,
+                           const QColor& fillColor,
+                           const QColor& outlineColor,
+                           qreal strokeWidth,
+                           bool highlightEnabled,
+                           const QColor& highlightColor) {
+    MOUFFETTE_TRACE_SCOPE("remote.text.shapedLayout");
+    QElapsedTimer timer;
+    timer.start();
+
+    if (highlightEnabled && highlightColor.alpha() > 0) {
+        painter->save();
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(highlightColor);
+        for (const ShapedTextLayout::Line& line : layout.lines) {
+            if (!line.highlightRect.isEmpty()) {
+                painter->drawRect(line.highlightRect.translated(shift));
+            }
+        }
+        painter->restore();
+    }
+
+    const qreal cacheScale = std::max(std::abs(deviceScale), 1e-4);
+    quint64 cacheHits = 0;
+    quint64 cacheMisses = 0;
+    quint64 glyphDrawn = 0;
+    QVector<GlyphMaskDraw> glyphMasks;
+    QVector<QPainterPath> fallbackPaths;
+    for (const ShapedTextLayout::Line& line : layout.lines) {
+        const QPointF lineOrigin = line.origin + shift;
+        for (const ShapedTextLayout::Run& run : line.runs) {
+            if (run.fontIndex < 0 || run.fontIndex >= fonts.size()) {
+                continue;
+            }
+            const QRawFont& rawFont = fonts.at(run.fontIndex);
+            for (int gi = 0; gi < run.glyphIndexes.size(); ++gi) {
+                const QPointF glyphPos = lineOrigin + run.positions.at(gi);
+                bool cacheHit = false;
+                const GlyphCoverage coverage = cachedGlyphCoverage(rawFont, run.glyphIndexes.at(gi),
+                                                                   strokeWidth, cacheScale, &cacheHit);
+                if (cacheHit) {
+                    ++cacheHits;
+                } else {
+                    ++cacheMisses;
+                }
+                if (coverage.isNull()) {
+                    const QPainterPath glyphPath = cachedGlyphPath(rawFont, run.glyphIndexes.at(gi));
+                    if (glyphPath.isEmpty()) {
+                        continue;
+                    }
+                    fallbackPaths.append(glyphPath.translated(glyphPos));
+                } else {
+                    glyphMasks.append(GlyphMaskDraw{glyphPos, coverage});
+                }
+                ++glyphDrawn;
+            }
+        }
+    }
+
+    if (strokeWidth > 0.0) {
+        if (!fallbackPaths.isEmpty()) {
+            painter->save();
+            painter->setPen(QPen(outlineColor, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+            painter->setBrush(Qt::NoBrush);
+            for (const QPainterPath& path : std::as_const(fallbackPaths)) {
+                painter->drawPath(path);
+            }
+            painter->restore();
+        }
+        drawTintedGlyphMasks(painter, glyphMasks, GlyphMaskLayer::Stroke, outlineColor);
+    }
+    if (!fallbackPaths.isEmpty()) {
+        painter->save();
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(fillColor);
+        for (const QPainterPath& path : std::as_const(fallbackPaths)) {
+            painter->drawPath(path);
+        }
+        painter->restore();
+    }
+    drawTintedGlyphMasks(painter, glyphMasks, GlyphMaskLayer::Fill, fillColor);
+
+    recordRemoteGlyphCacheStats(cacheHits, cacheMisses, glyphDrawn, timer.elapsed());
+}
+
 QFont::Weight qFontWeightFromCss(int cssWeight) {
     struct WeightMapping {
         int css;
@@ -531,6 +483,7 @@ qint64 frameTimestampMs(const QVideoFrame& frame) {
 }
 
 QImage convertFrameToImage(const QVideoFrame& frame) {
+    MOUFFETTE_TRACE_SCOPE("remote.convertFrame");
     if (!frame.isValid()) {
         return {};
     }
@@ -571,85 +524,240 @@ QImage convertFrameToImage(const QVideoFrame& frame) {
     return mapped;
 }
 
-class RemoteOutlineTextItem : public QGraphicsTextItem {
-public:
-    RemoteOutlineTextItem() : QGraphicsTextItem() {}
-    
-    explicit RemoteOutlineTextItem(QGraphicsItem* parent) : QGraphicsTextItem(parent) {}
-    
-    RemoteOutlineTextItem(const QString& text, QGraphicsItem* parent) : QGraphicsTextItem(text, parent) {}
-
-    void setOutlineParameters(const QColor& fillColor, const QColor& outlineColor, qreal strokeWidthPx) {
-        m_fillColor = fillColor;
-        m_outlineColor = outlineColor.isValid() ? outlineColor : fillColor;
-        m_strokeWidth = std::max<qreal>(0.0, strokeWidthPx);
-        applyDocumentFormatting();
+int remoteTextRasterThreadCount() {
+    const QByteArray raw = qgetenv("MOUFFETTE_REMOTE_TEXT_RASTER_THREADS");
+    if (!raw.isEmpty()) {
+        bool ok = false;
+        const int parsed = raw.trimmed().toInt(&ok);
+        if (ok) {
+            return std::clamp(parsed, 1, 16);
+        }
     }
+    return std::clamp(QThread::idealThreadCount() / 2, 1, 4);
+}
 
-    void setHighlightParameters(bool enabled, const QColor& color) {
-        QColor resolved = color;
-        if (!resolved.isValid()) {
-            resolved = QColor(255, 255, 0, 160);
-        }
-        const bool active = enabled && resolved.alpha() > 0;
-        if (m_highlightEnabled != active || m_highlightColor != resolved) {
-            m_highlightEnabled = active;
-            m_highlightColor = active ? resolved : QColor(Qt::transparent);
-            applyDocumentFormatting();
+qreal remoteOutlineWidth(double percent, const QFont& baseFont) {
+    if (percent <= 0.0) {
+        return 0.0;
+    }
+    QFontMetricsF metrics(baseFont);
+    qreal reference = metrics.height();
+    if (reference <= 0.0) {
+        if (baseFont.pixelSize() > 0) {
+            reference = static_cast<qreal>(baseFont.pixelSize());
+        } else {
+            reference = baseFont.pointSizeF();
         }
     }
+    if (reference <= 0.0) {
+        reference = 16.0;
+    }
+    constexpr qreal kMaxOutlineThicknessFactor = 0.35;
+    constexpr qreal kOutlineCurveExponent = 1.35;
+    constexpr qreal kMaxOutlineStrokePx = 14.0;
+    const qreal normalized = std::clamp(percent / 100.0, 0.0, 1.0);
+    const qreal eased = std::pow(normalized, kOutlineCurveExponent);
+    const qreal scaledStroke = eased * kMaxOutlineThicknessFactor * reference;
+    return std::clamp(scaledStroke, 0.0, kMaxOutlineStrokePx);
+}
 
-    void paintInto(QPainter* painter) {
-        if (!painter) {
-            return;
-        }
-        QStyleOptionGraphicsItem option;
-        option.state = QStyle::State_None;
-        QGraphicsTextItem::paint(painter, &option, nullptr);
+qreal remoteOutlineOverflowAllowance(qreal stroke) {
+    if (stroke <= 0.0) {
+        return 0.0;
     }
+    constexpr qreal kOverflowScale = 0.45;
+    constexpr qreal kOverflowMinPx = 2.0;
+    return std::ceil(std::max<qreal>(stroke * kOverflowScale, kOverflowMinPx));
+}
 
-private:
-    void applyDocumentFormatting() {
-        QTextDocument* doc = document();
-        if (!doc) {
-            return;
+// QRawFont must stay on the thread that created it, so raster workers resolve the host fonts
+// themselves. Pool threads are long-lived and keep the font sets they have already resolved.
+constexpr int kMaxShapedFontSetsPerThread = 64;
+
+bool shapedLayoutFontsForThread(const ShapedTextLayout& layout, QVector<QRawFont>* fonts) {
+    thread_local QHash<QString, QVector<QRawFont>> t_fontSets;
+    QString key;
+    for (const ShapedTextLayout::FontIdentity& identity : layout.fonts) {
+        key += QStringLiteral("%1\x1f%2\x1f%3\x1f%4\x1f%5\x1f%6\x1e")
+                   .arg(identity.family, identity.style)
+                   .arg(identity.pixelSize, 0, 'g', 8)
+                   .arg(identity.unitsPerEm, 0, 'g', 8)
+                   .arg(identity.ascent, 0, 'g', 8)
+                   .arg(identity.descent, 0, 'g', 8);
+    }
+    const auto it = t_fontSets.constFind(key);
+    if (it != t_fontSets.constEnd()) {
+        *fonts = it.value();
+        return true;
+    }
+    if (!TextLayoutPayload::resolveFonts(layout, fonts)) {
+        return false;
+    }
+    if (t_fontSets.size() >= kMaxShapedFontSetsPerThread) {
+        t_fontSets.clear();
+    }
+    t_fontSets.insert(key, *fonts);
+    return true;
+}
+
+// Inputs for rasterising one text span off the GUI thread. Span geometry (display size, source
+// offset, device pixel ratio) is resolved on the GUI thread; everything else is plain data.
+struct RemoteTextRasterJob {
+    QString text;
+    QFont font;
+    QColor fillColor;
+    QColor outlineColor;
+    QColor highlightColor;
+    bool highlightEnabled = false;
+    double borderWidthPercent = 0.0;
+    bool fitToText = false;
+    Qt::Alignment horizontalAlignment = Qt::AlignHCenter;
+    Qt::Alignment verticalAlignment = Qt::AlignVCenter;
+    qreal baseWidth = 200.0;
+    qreal baseHeight = 100.0;
+    qreal uniformScale = 1.0;
+    qreal scaleX = 1.0;
+    qreal fullDisplayHeight = 0.0;
+    QPointF sourcePixelOffset;
+    QSize spanSize;
+    qreal dpr = 1.0;
+    // Fonts are resolved on the worker (see shapedLayoutFontsForThread)
+    std::shared_ptr<const ShapedTextLayout> shapedLayout;
+};
+
+// Lays out and paints one span into a device-pixel image. Runs on the remote text raster pool,
+// so it uses a bare QTextDocument rather than a graphics item.
+QImage renderRemoteTextSpan(const RemoteTextRasterJob& job) {
+    MOUFFETTE_TRACE_SCOPE("remote.text.spanRaster");
+    QElapsedTimer timer;
+    timer.start();
+
+    const qreal strokeWidth = remoteOutlineWidth(job.borderWidthPercent, job.font);
+    const qreal padding = std::max<qreal>(0.0, strokeWidth + remoteOutlineOverflowAllowance(strokeWidth));
+
+    // Reconstruct host layout: host renders text into a logical width that is
+    // reduced by the uniform scale factor, then applies that factor visually.
+    // Host: logicalWidth = (baseWidth / uniformScale) - 2*padding
+    const qreal logicalWidth = std::max<qreal>(1.0, (job.baseWidth / job.uniformScale) - 2.0 * padding);
+
+    // With a host-shaped layout the lines are already broken and positioned; only the
+    // alignment inside our (stroke-padded) logical width has to be redone.
+    QVector<QRawFont> shapedLayoutFonts;
+    const bool useShapedLayout = job.shapedLayout && shapedLayoutFontsForThread(*job.shapedLayout, &shapedLayoutFonts);
+    if (job.shapedLayout && !useShapedLayout) {
+        MOUFFETTE_METRIC_COUNT("remote.textLayout.fallbacks", 1);
+    }
+
+    QTextDocument document;
+    QPointF shapedLayoutShift;
+    QRectF docBounds;
+    if (useShapedLayout) {
+        docBounds = job.shapedLayout->docBounds;
+        if (!job.fitToText) {
+            const qreal slack = logicalWidth - job.shapedLayout->wrapWidth;
+            if (job.horizontalAlignment == Qt::AlignHCenter) {
+                shapedLayoutShift.setX(slack * 0.5);
+            } else if (job.horizontalAlignment == Qt::AlignRight) {
+                shapedLayoutShift.setX(slack);
+            }
         }
+        docBounds.translate(shapedLayoutShift);
+    } else {
+        document.setDocumentMargin(0.0);
+        document.setDefaultFont(job.font);
+        document.setPlainText(job.text);
 
-        QTextCursor cursor(doc);
+        QTextCursor cursor(&document);
         cursor.select(QTextCursor::Document);
         QTextCharFormat format;
-        format.setForeground(m_fillColor);
-
-        if (m_strokeWidth > 0.0) {
-            const QColor outline = m_outlineColor.isValid() ? m_outlineColor : m_fillColor;
-            format.setTextOutline(QPen(outline, m_strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        format.setForeground(job.fillColor);
+        if (strokeWidth > 0.0) {
+            format.setTextOutline(QPen(job.outlineColor, strokeWidth * 2.0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
         } else {
             format.clearProperty(QTextFormat::TextOutline);
         }
-
-        if (m_highlightEnabled && m_highlightColor.isValid() && m_highlightColor.alpha() > 0) {
-            format.setBackground(QBrush(m_highlightColor));
+        if (job.highlightEnabled && job.highlightColor.alpha() > 0) {
+            format.setBackground(QBrush(job.highlightColor));
         } else {
             format.clearBackground();
         }
-
         cursor.mergeCharFormat(format);
-        setDefaultTextColor(m_fillColor);
-        update();
+
+        QTextOption textOption = document.defaultTextOption();
+        textOption.setWrapMode(job.fitToText ? QTextOption::NoWrap : QTextOption::WordWrap);
+        textOption.setAlignment(job.horizontalAlignment);
+        document.setDefaultTextOption(textOption);
+        document.setTextWidth(job.fitToText ? -1.0 : logicalWidth);
+
+        if (QAbstractTextDocumentLayout* docLayout = document.documentLayout()) {
+            docBounds = computeDocumentTextBounds(document, docLayout);
+        } else {
+            const qreal logicalHeight = std::max<qreal>(1.0, (job.baseHeight - 2.0 * padding) / job.uniformScale);
+            docBounds = QRectF(0.0, 0.0, logicalWidth, logicalHeight);
+        }
     }
 
-    QColor m_fillColor = Qt::white;
-    QColor m_outlineColor = Qt::white;
-    qreal m_strokeWidth = 0.0;
-    bool m_highlightEnabled = false;
-    QColor m_highlightColor = Qt::transparent;
-};
+    const qreal appliedScale = job.scaleX * job.uniformScale;
+
+    // Apply padding offsets to match host-side margin handling
+    const qreal paddingX = padding * appliedScale;
+    const qreal paddingY = padding * appliedScale;
+
+    // Center the text vertically within the padded height (matches host offset logic)
+    const qreal scaledDocTop = docBounds.top() * appliedScale;
+    const qreal scaledDocHeight = std::max<qreal>(1.0, docBounds.height()) * appliedScale;
+    const qreal availableHeightScene = std::max<qreal>(0.0, job.fullDisplayHeight - 2.0 * paddingY);
+    qreal verticalOffset = paddingY;
+    if (job.verticalAlignment == Qt::AlignTop) {
+        verticalOffset = paddingY - scaledDocTop;
+    } else if (job.verticalAlignment == Qt::AlignBottom) {
+        verticalOffset = paddingY + std::max<qreal>(0.0, availableHeightScene - scaledDocHeight) - scaledDocTop;
+    } else {
+        verticalOffset = paddingY + std::max<qreal>(0.0, (availableHeightScene - scaledDocHeight) * 0.5) - scaledDocTop;
+    }
+
+    const int pw = std::max(1, job.spanSize.width());
+    const int ph = std::max(1, job.spanSize.height());
+    const int rasterW = std::max(1, static_cast<int>(std::ceil(static_cast<qreal>(pw) * job.dpr)));
+    const int rasterH = std::max(1, static_cast<int>(std::ceil(static_cast<qreal>(ph) * job.dpr)));
+    QImage raster(rasterW, rasterH, QImage::Format_ARGB32_Premultiplied);
+    raster.fill(Qt::transparent);
+
+    {
+        QPainter p(&raster);
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setRenderHint(QPainter::TextAntialiasing, true);
+        p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        p.scale(job.dpr, job.dpr);
+        constexpr qreal kTextClipGuardPx = 0.5;
+        p.setClipRect(QRectF(-kTextClipGuardPx,
+                             -kTextClipGuardPx,
+                             static_cast<qreal>(pw) + 2.0 * kTextClipGuardPx,
+                             static_cast<qreal>(ph) + 2.0 * kTextClipGuardPx));
+        p.translate(paddingX - job.sourcePixelOffset.x(), verticalOffset - job.sourcePixelOffset.y());
+        p.scale(appliedScale, appliedScale);
+        if (useShapedLayout) {
+            paintShapedTextLayout(&p, *job.shapedLayout, shapedLayoutFonts, shapedLayoutShift,
+                                  appliedScale * job.dpr, job.fillColor, job.outlineColor, strokeWidth,
+                                  job.highlightEnabled, job.highlightColor);
+        } else if (QAbstractTextDocumentLayout* docLayout = document.documentLayout()) {
+            QAbstractTextDocumentLayout::PaintContext context;
+            context.palette.setColor(QPalette::Text, job.fillColor);
+            docLayout->draw(&p, context);
+        }
+    }
+
+    MOUFFETTE_METRIC_HISTOGRAM("remote.textRaster.spanMs", timer.elapsed());
+    return raster;
+}
 } // namespace
 
 RemoteSceneController::RemoteSceneController(FileManager* fileManager, WebSocketClient* ws, QObject* parent)
     : QObject(parent)
     , m_fileManager(fileManager)
     , m_ws(ws) {
+    m_textRasterPool.setMaxThreadCount(remoteTextRasterThreadCount());
+    m_textRasterPool.setObjectName(QStringLiteral("RemoteTextRasterPool"));
     if (m_ws) {
         connect(m_ws, &WebSocketClient::remoteSceneStartReceived, this, &RemoteSceneController::onRemoteSceneStart);
         connect(m_ws, &WebSocketClient::remoteSceneStopReceived, this, &RemoteSceneController::onRemoteSceneStop);
@@ -658,6 +766,12 @@ RemoteSceneController::RemoteSceneController(FileManager* fileManager, WebSocket
 
 RemoteSceneController::~RemoteSceneController() {
     clearScene();
+    // Queued span rasters are dropped; running ones finish but their watchers never report back
+    m_textRasterPool.clear();
+    for (QFutureWatcherBase* watcher : findChildren<QFutureWatcherBase*>()) {
+        watcher->disconnect(this);
+    }
+    m_textRasterPool.waitForDone();
     for (auto it = m_screenWindows.begin(); it != m_screenWindows.end(); ++it) {
         ScreenWindow& sw = it.value();
         if (sw.window) {
@@ -684,6 +798,7 @@ void RemoteSceneController::resetSceneSynchronization() {
 }
 
 void RemoteSceneController::onRemoteSceneStart(const QString& senderClientId, const QJsonObject& scene) {
+    MOUFFETTE_TRACE_SCOPE("remote.sceneStart");
     if (!m_enabled) return;
 
     if (m_sceneStartInProgress || m_teardownInProgress) {
@@ -1330,6 +1445,7 @@ void RemoteSceneController::triggerAutoPlayNow(const std::shared_ptr<RemoteMedia
 }
 
 void RemoteSceneController::applyPixmapToSpans(const std::shared_ptr<RemoteMediaItem>& item, const QPixmap& pixmap) const {
+    MOUFFETTE_TRACE_SCOPE("remote.applyPixmapToSpans");
     if (!item) return;
     if (pixmap.isNull()) return;
 
@@ -1500,6 +1616,7 @@ void RemoteSceneController::finalizeLivePlaybackStart(const std::shared_ptr<Remo
 }
 
 void RemoteSceneController::activateScene() {
+    MOUFFETTE_TRACE_SCOPE("remote.activateScene");
     if (m_sceneActivated) return;
     m_sceneActivated = true;
     m_sceneActivationRequested = false;
@@ -1805,6 +1922,7 @@ QWidget* RemoteSceneController::ensureScreenWindow(int screenId, int x, int y, i
 }
 
 void RemoteSceneController::buildWindows(const QJsonArray& screensArray) {
+    MOUFFETTE_TRACE_SCOPE("remote.buildWindows");
     // Map host screen list to local physical screens by index.
     const QList<QScreen*> localScreens = QGuiApplication::screens();
     QScreen* primaryLocal = QGuiApplication::primaryScreen();
@@ -1823,6 +1941,7 @@ void RemoteSceneController::buildWindows(const QJsonArray& screensArray) {
 }
 
 void RemoteSceneController::buildMedia(const QJsonArray& mediaArray) {
+    MOUFFETTE_TRACE_SCOPE("remote.buildMedia");
     // QGraphicsScene::items() (used on host serialization) returns items in descending Z (topmost first) by default.
     // If we create children in that order, later widgets sit on top of earlier ones, reversing the stack.
     // Therefore, build from the end to the beginning so the topmost item is created last and remains on top.
@@ -1877,6 +1996,20 @@ void RemoteSceneController::buildMedia(const QJsonArray& mediaArray) {
         } else {
             item->verticalAlignment = RemoteMediaItem::VerticalAlignment::Center;
         }
+
+        if (m.value("textLayout").isObject()) {
+            auto shaped = std::make_shared<ShapedTextLayout>();
+            QString error;
+            // Checked here only to decide early; the fonts themselves are resolved by the raster workers
+            if (TextLayoutPayload::decode(m.value("textLayout").toObject(), shaped.get(), &error) &&
+                TextLayoutPayload::resolveFonts(*shaped, nullptr, &error)) {
+                item->shapedLayout = std::move(shaped);
+                MOUFFETTE_METRIC_COUNT("remote.textLayout.used", 1);
+            } else {
+                qInfo() << "[RemoteTextLayout] falling back to local layout for" << item->mediaId << ":" << error;
+                MOUFFETTE_METRIC_COUNT("remote.textLayout.fallbacks", 1);
+            }
+        }
     }
         // Parse spans if present
         if (m.contains("spans") && m.value("spans").isArray()) {
@@ -1960,6 +2093,47 @@ void RemoteSceneController::scheduleMedia(const std::shared_ptr<RemoteMediaItem>
     scheduleMediaMulti(item);
 }
 
+void RemoteSceneController::startTextSpanRaster(const std::shared_ptr<RemoteMediaItem>& item,
+                                                int spanIndex,
+                                                std::function<QImage()> render,
+                                                qreal dpr) {
+    const quint64 epoch = item->sceneEpoch;
+    std::weak_ptr<RemoteMediaItem> weakItem = item;
+    QGraphicsPixmapItem* target = item->spans[spanIndex].imageItem;
+
+    auto future = QtConcurrent::run(&m_textRasterPool, std::move(render));
+    auto* watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, weakItem, epoch, spanIndex, target, dpr]() {
+        const QImage raster = watcher->result();
+        watcher->deleteLater();
+        auto item = weakItem.lock();
+        if (!item || epoch != m_sceneEpoch) return;
+        if (spanIndex >= item->spans.size() || item->spans[spanIndex].imageItem != target) return;
+        if (!raster.isNull()) {
+            QPixmap textPixmap = QPixmap::fromImage(raster);
+            textPixmap.setDevicePixelRatio(dpr);
+            target->setPixmap(textPixmap);
+        }
+        item->spans[spanIndex].renderReady = true;
+        updateTextRasterReadiness(item);
+    });
+    watcher->setFuture(future);
+}
+
+void RemoteSceneController::updateTextRasterReadiness(const std::shared_ptr<RemoteMediaItem>& item) {
+    if (!item || item->loaded) return;
+    bool renderedAllSpans = !item->spans.isEmpty();
+    for (const auto& span : item->spans) {
+        if (!span.imageItem || (span.requiresRender && !span.renderReady)) {
+            renderedAllSpans = false;
+            break;
+        }
+    }
+    if (!renderedAllSpans) return;
+    item->loaded = true;
+    evaluateItemReadiness(item);
+}
+
 void RemoteSceneController::scheduleMediaMulti(const std::shared_ptr<RemoteMediaItem>& item) {
     if (item->spans.isEmpty()) return;
     const quint64 epoch = item->sceneEpoch;
@@ -1998,212 +2172,86 @@ void RemoteSceneController::scheduleMediaMulti(const std::shared_ptr<RemoteMedia
         if (!scene) continue;
         
         if (item->type == "text") {
-            RemoteOutlineTextItem preRaster;
-            preRaster.setOpacity(1.0);
-            if (QTextDocument* doc = preRaster.document()) {
-                doc->setDocumentMargin(0.0);
-            }
-
-            // Set up font
-            QFont font(item->fontFamily, item->fontSize);
-            font.setItalic(item->fontItalic);
+            RemoteTextRasterJob job;
+            job.text = item->text;
+            job.font = QFont(item->fontFamily, item->fontSize);
+            job.font.setItalic(item->fontItalic);
             if (item->fontWeight > 0) {
-                font.setWeight(qFontWeightFromCss(item->fontWeight));
+                job.font.setWeight(qFontWeightFromCss(item->fontWeight));
             } else if (item->fontBold) {
-                font.setWeight(QFont::Bold);
+                job.font.setWeight(QFont::Bold);
             }
-            preRaster.setFont(font);
 
-            // Set text color
-            QColor color(item->textColor);
-            if (!color.isValid()) {
-                color = QColor(Qt::white);
+            job.fillColor = QColor(item->textColor);
+            if (!job.fillColor.isValid()) {
+                job.fillColor = QColor(Qt::white);
             }
-
-            auto computeOutlineWidth = [](double percent, const QFont& baseFont) -> qreal {
-                if (percent <= 0.0) {
-                    return 0.0;
-                }
-                QFontMetricsF metrics(baseFont);
-                qreal reference = metrics.height();
-                if (reference <= 0.0) {
-                    if (baseFont.pixelSize() > 0) {
-                        reference = static_cast<qreal>(baseFont.pixelSize());
-                    } else {
-                        reference = baseFont.pointSizeF();
-                    }
-                }
-                if (reference <= 0.0) {
-                    reference = 16.0;
-                }
-                constexpr qreal kMaxOutlineThicknessFactor = 0.35;
-                constexpr qreal kOutlineCurveExponent = 1.35;
-                constexpr qreal kMaxOutlineStrokePx = 14.0;
-                const qreal normalized = std::clamp(percent / 100.0, 0.0, 1.0);
-                const qreal eased = std::pow(normalized, kOutlineCurveExponent);
-                const qreal scaledStroke = eased * kMaxOutlineThicknessFactor * reference;
-                return std::clamp(scaledStroke, 0.0, kMaxOutlineStrokePx);
-            };
-
-            const qreal strokeWidth = computeOutlineWidth(item->textBorderWidthPercent, font);
-            auto outlineOverflowAllowance = [](qreal stroke) -> qreal {
-                if (stroke <= 0.0) {
-                    return 0.0;
-                }
-                constexpr qreal kOverflowScale = 0.45;
-                constexpr qreal kOverflowMinPx = 2.0;
-                return std::ceil(std::max<qreal>(stroke * kOverflowScale, kOverflowMinPx));
-            };
-
-            const qreal padding = std::max<qreal>(0.0, strokeWidth + outlineOverflowAllowance(strokeWidth));
-            QColor outlineColor(item->textBorderColor);
-            if (!outlineColor.isValid()) {
-                outlineColor = color;
-            }
-
-            // Set text content
-            preRaster.setPlainText(item->text);
-
-            if (QTextDocument* doc = preRaster.document()) {
-                QTextCursor cursor(doc);
-                cursor.select(QTextCursor::Document);
-                QTextCharFormat format;
-                format.setForeground(color);
-                format.clearProperty(QTextFormat::TextOutline);
-                cursor.mergeCharFormat(format);
+            job.outlineColor = QColor(item->textBorderColor);
+            if (!job.outlineColor.isValid()) {
+                job.outlineColor = job.fillColor;
             }
-
-            preRaster.setOutlineParameters(color, outlineColor, strokeWidth);
-            QColor highlightColor(item->textHighlightColor);
-            if (!highlightColor.isValid()) {
-                highlightColor = QColor(255, 255, 0, 160);
+            job.highlightColor = QColor(item->textHighlightColor);
+            if (!job.highlightColor.isValid()) {
+                job.highlightColor = QColor(255, 255, 0, 160);
             }
-            preRaster.setHighlightParameters(item->highlightEnabled, highlightColor);
-
-            // Center alignment
-            QTextDocument* doc = preRaster.document();
-            QTextOption textOption = doc ? doc->defaultTextOption() : QTextOption();
-            textOption.setWrapMode(item->fitToTextEnabled ? QTextOption::NoWrap : QTextOption::WordWrap);
-            Qt::Alignment hAlign = Qt::AlignHCenter;
+            job.highlightEnabled = item->highlightEnabled;
+            job.borderWidthPercent = item->textBorderWidthPercent;
+            job.fitToText = item->fitToTextEnabled;
             switch (item->horizontalAlignment) {
                 case RemoteMediaItem::HorizontalAlignment::Left:
-                    hAlign = Qt::AlignLeft;
+                    job.horizontalAlignment = Qt::AlignLeft;
                     break;
                 case RemoteMediaItem::HorizontalAlignment::Center:
-                    hAlign = Qt::AlignHCenter;
+                    job.horizontalAlignment = Qt::AlignHCenter;
                     break;
                 case RemoteMediaItem::HorizontalAlignment::Right:
-                    hAlign = Qt::AlignRight;
+                    job.horizontalAlignment = Qt::AlignRight;
                     break;
             }
-            textOption.setAlignment(hAlign);
-            if (doc) {
-                doc->setDefaultTextOption(textOption);
-            }
-            
-            // Reconstruct host layout: host renders text into a logical width that is
-            // reduced by the uniform scale factor, then applies that factor visually.
-            const qreal baseWidth = static_cast<qreal>(item->baseWidth > 0 ? item->baseWidth : 200);
-            const qreal baseHeight = static_cast<qreal>(item->baseHeight > 0 ? item->baseHeight : 100);
-            const qreal uniformScale = std::max<qreal>(static_cast<qreal>(std::abs(item->uniformScale)), 1e-4);
-
-            // Match host calculation: divide base width by scale first, then subtract padding
-            // Host: logicalWidth = (baseWidth / uniformScale) - 2*padding
-            const qreal logicalWidth = std::max<qreal>(1.0, (baseWidth / uniformScale) - 2.0 * padding);
-            if (item->fitToTextEnabled) {
-                preRaster.setTextWidth(-1.0);
-            } else {
-                preRaster.setTextWidth(logicalWidth);
-            }
-
-            QSizeF docSize;
-            QRectF docBounds;
-            if (doc && doc->documentLayout()) {
-                QAbstractTextDocumentLayout* docLayout = doc->documentLayout();
-                docSize = docLayout->documentSize();
-                docBounds = computeDocumentTextBounds(*doc, docLayout);
-            } else {
-                const qreal logicalHeight = std::max<qreal>(1.0, (baseHeight - 2.0 * padding) / uniformScale);
-                docSize = QSizeF(logicalWidth, logicalHeight);
-                docBounds = QRectF(0.0, 0.0, std::max<qreal>(logicalWidth, 1.0), logicalHeight);
-            }
-
-            const qreal safeBaseWidth = std::max<qreal>(baseWidth, 1.0);
-            const qreal safeBaseHeight = std::max<qreal>(baseHeight, 1.0);
-            const qreal safeSrcNw = std::max<qreal>(1e-6, s.srcNw);
-            const qreal safeSrcNh = std::max<qreal>(1e-6, s.srcNh);
-            const qreal fullDisplayWidth = (s.destNw * containerW) / safeSrcNw;
-            const qreal fullDisplayHeight = (s.destNh * containerH) / safeSrcNh;
-            const qreal scaleX = fullDisplayWidth / safeBaseWidth;
-            const qreal scaleY = fullDisplayHeight / safeBaseHeight;
-            const qreal appliedScale = scaleX * uniformScale;
-            
-            // Apply padding offsets to match host-side margin handling
-            const qreal paddingX = padding * appliedScale;
-            const qreal paddingY = padding * appliedScale;
-
-            // Center the text vertically within the padded height (matches host offset logic)
-            const qreal docVisualTop = docBounds.top();
-            const qreal docVisualHeight = std::max<qreal>(1.0, docBounds.height());
-            const qreal scaledDocTop = docVisualTop * appliedScale;
-            const qreal scaledDocHeight = docVisualHeight * appliedScale;
-            const qreal availableHeightScene = std::max<qreal>(0.0, fullDisplayHeight - 2.0 * paddingY);
-            qreal verticalOffset = paddingY;
             switch (item->verticalAlignment) {
                 case RemoteMediaItem::VerticalAlignment::Top:
-                    verticalOffset = paddingY - scaledDocTop;
+                    job.verticalAlignment = Qt::AlignTop;
                     break;
                 case RemoteMediaItem::VerticalAlignment::Center:
-                    verticalOffset = paddingY + std::max<qreal>(0.0, (availableHeightScene - scaledDocHeight) * 0.5) - scaledDocTop;
+                    job.verticalAlignment = Qt::AlignVCenter;
                     break;
                 case RemoteMediaItem::VerticalAlignment::Bottom:
-                    verticalOffset = paddingY + std::max<qreal>(0.0, availableHeightScene - scaledDocHeight) - scaledDocTop;
+                    job.verticalAlignment = Qt::AlignBottom;
                     break;
             }
-            
-            // Position the text with horizontal padding as well
-            const qreal horizontalOffset = paddingX;
-            const qreal sourcePixelOffsetX = s.srcNx * baseWidth * scaleX;
-            const qreal sourcePixelOffsetY = s.srcNy * baseHeight * scaleY;
+            job.shapedLayout = item->shapedLayout;
+
+            job.baseWidth = static_cast<qreal>(item->baseWidth > 0 ? item->baseWidth : 200);
+            job.baseHeight = static_cast<qreal>(item->baseHeight > 0 ? item->baseHeight : 100);
+            job.uniformScale = std::max<qreal>(static_cast<qreal>(std::abs(item->uniformScale)), 1e-4);
 
-            qreal spanDpr = 1.0;
+            const qreal safeBaseWidth = std::max<qreal>(job.baseWidth, 1.0);
+            const qreal safeBaseHeight = std::max<qreal>(job.baseHeight, 1.0);
+            const qreal safeSrcNw = std::max<qreal>(1e-6, s.srcNw);
+            const qreal safeSrcNh = std::max<qreal>(1e-6, s.srcNh);
+            const qreal fullDisplayWidth = (s.destNw * containerW) / safeSrcNw;
+            job.fullDisplayHeight = (s.destNh * containerH) / safeSrcNh;
+            job.scaleX = fullDisplayWidth / safeBaseWidth;
+            const qreal scaleY = job.fullDisplayHeight / safeBaseHeight;
+            job.sourcePixelOffset = QPointF(s.srcNx * job.baseWidth * job.scaleX, s.srcNy * job.baseHeight * scaleY);
+            job.spanSize = QSize(pw, ph);
             if (QWidget* topLevel = container->window()) {
                 if (QScreen* screen = topLevel->screen()) {
-                    spanDpr = std::max<qreal>(1.0, screen->devicePixelRatio());
+                    job.dpr = std::max<qreal>(1.0, screen->devicePixelRatio());
                 }
             }
 
-            const int rasterW = std::max(1, static_cast<int>(std::ceil(static_cast<qreal>(pw) * spanDpr)));
-            const int rasterH = std::max(1, static_cast<int>(std::ceil(static_cast<qreal>(ph) * spanDpr)));
-            QImage raster(rasterW, rasterH, QImage::Format_ARGB32_Premultiplied);
-            raster.fill(Qt::transparent);
-
-            {
-                QPainter p(&raster);
-                p.setRenderHint(QPainter::Antialiasing, true);
-                p.setRenderHint(QPainter::TextAntialiasing, true);
-                p.setRenderHint(QPainter::SmoothPixmapTransform, true);
-                p.scale(spanDpr, spanDpr);
-                constexpr qreal kTextClipGuardPx = 0.5;
-                p.setClipRect(QRectF(-kTextClipGuardPx,
-                                     -kTextClipGuardPx,
-                                     static_cast<qreal>(pw) + 2.0 * kTextClipGuardPx,
-                                     static_cast<qreal>(ph) + 2.0 * kTextClipGuardPx));
-                p.translate(horizontalOffset - sourcePixelOffsetX, verticalOffset - sourcePixelOffsetY);
-                p.scale(appliedScale, appliedScale);
-                preRaster.paintInto(&p);
-            }
-
-            QPixmap textPixmap = QPixmap::fromImage(raster);
-            textPixmap.setDevicePixelRatio(spanDpr);
-
+            // The pixmap is filled in when the span raster comes back from the worker pool
             QGraphicsPixmapItem* textPixmapItem = new QGraphicsPixmapItem();
             textPixmapItem->setPos(exactX, exactY);
             textPixmapItem->setOpacity(0.0);
             textPixmapItem->setTransformationMode(Qt::SmoothTransformation);
-            textPixmapItem->setPixmap(textPixmap);
             scene->addItem(textPixmapItem);
             s.imageItem = textPixmapItem;
+            s.requiresRender = true;
+            s.renderReady = false;
+            const qreal spanDpr = job.dpr;
+            startTextSpanRaster(item, i, [job = std::move(job)]() { return renderRemoteTextSpan(job); }, spanDpr);
         } else if (item->type == "image") {
             // Create a pixmap item for host-provided still images
             QGraphicsPixmapItem* pixmapItem = new QGraphicsPixmapItem();
@@ -2229,18 +2277,13 @@ void RemoteSceneController::scheduleMediaMulti(const std::shared_ptr<RemoteMedia
     std::weak_ptr<RemoteMediaItem> weakItem = item;
 
     if (item->type == "text") {
-        bool renderedAllSpans = !item->spans.isEmpty();
         for (const auto& span : item->spans) {
             if (!span.imageItem) {
-                renderedAllSpans = false;
+                qWarning() << "RemoteSceneController: text pre-raster incomplete for" << item->mediaId;
                 break;
             }
         }
-        item->loaded = renderedAllSpans;
-        if (!renderedAllSpans) {
-            qWarning() << "RemoteSceneController: text pre-raster incomplete for" << item->mediaId;
-        }
-        evaluateItemReadiness(item);
+        // Readiness is reported from updateTextRasterReadiness() as span rasters arrive
     } else if (item->type == "image") {
         auto attemptLoad = [this, epoch, weakItem]() {
             auto item = weakItem.lock();
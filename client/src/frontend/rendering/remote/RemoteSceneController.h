@@ -12,7 +12,10 @@
 #include <QVideoFrame>
 #include <QImage>
 #include <QPointer>
+#include <QThreadPool>
+#include <functional>
 #include <memory>
+#include "backend/domain/media/TextLayoutPayload.h"
 
 class WebSocketClient;
 class FileManager;
@@ -74,6 +77,8 @@ private:
 		enum class VerticalAlignment { Top, Center, Bottom };
 		HorizontalAlignment horizontalAlignment = HorizontalAlignment::Center;
 		VerticalAlignment verticalAlignment = VerticalAlignment::Center;
+		// Host-shaped layout, set only when every font it uses resolved identically on this machine
+		std::shared_ptr<const ShapedTextLayout> shapedLayout;
 		// Multi-screen spans support: each span maps to a screen with its own normalized geom
 		struct Span {
 			int screenId = -1;
@@ -172,6 +177,9 @@ private:
     void teardownMediaItem(const std::shared_ptr<RemoteMediaItem>& item);
     void markItemReady(const std::shared_ptr<RemoteMediaItem>& item);
     void evaluateItemReadiness(const std::shared_ptr<RemoteMediaItem>& item);
+    // Text spans are rasterised on m_textRasterPool; the item becomes loaded once every span has its pixmap
+    void startTextSpanRaster(const std::shared_ptr<RemoteMediaItem>& item, int spanIndex, std::function<QImage()> render, qreal dpr);
+    void updateTextRasterReadiness(const std::shared_ptr<RemoteMediaItem>& item);
     void startSceneActivationIfReady();
     void activateScene();
     void startDeferredTimers();
@@ -212,5 +220,6 @@ private:
 	QTimer* m_sceneRestartDelayTimer = nullptr;
 	bool m_restartCooldownActive = false;
 	PendingSceneRequest m_deferredSceneStart;
+	QThreadPool m_textRasterPool;
 };
 
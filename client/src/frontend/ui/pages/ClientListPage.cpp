@@ -211,6 +211,78 @@ void ClientListPage::updateClientList(const QList<ClientInfo>& clients) {
     refreshOngoingScenesList();
 }
 
+void ClientListPage::upsertClient(const ClientInfo& client) {
+    if (!m_clientListWidget) {
+        const int row = rowForClient(client.clientId());
+        if (row >= 0) m_availableClients[row] = client;
+        else m_availableClients.append(client);
+        return;
+    }
+
+    // Drop the "no clients" placeholder before adding the first real row
+    for (int i = m_clientListWidget->count() - 1; i >= 0; --i) {
+        QListWidgetItem* existing = m_clientListWidget->item(i);
+        if (existing && existing->flags() == Qt::NoItemFlags) {
+            delete m_clientListWidget->takeItem(i);
+        }
+    }
+
+    const int row = rowForClient(client.clientId());
+    if (row >= 0) {
+        m_availableClients[row] = client;
+        if (QListWidgetItem* item = m_clientListWidget->item(row)) {
+            const QString display = client.getDisplayText();
+            if (item->text() != display) {
+                item->setText(display);
+            }
+            item->setData(Qt::UserRole, client.getId());
+        }
+    } else {
+        // Online clients come first, followed by offline ones from session history
+        int insertAt = m_availableClients.size();
+        if (client.isOnline()) {
+            for (int i = 0; i < m_availableClients.size(); ++i) {
+                if (!m_availableClients.at(i).isOnline()) {
+                    insertAt = i;
+                    break;
+                }
+            }
+        }
+        m_availableClients.insert(insertAt, client);
+        QListWidgetItem* item = new QListWidgetItem(client.getDisplayText());
+        item->setData(Qt::UserRole, client.getId());
+        m_clientListWidget->insertItem(insertAt, item);
+    }
+
+    refreshOngoingScenesList();
+}
+
+void ClientListPage::removeClient(const QString& persistentClientId) {
+    const int row = rowForClient(persistentClientId);
+    if (row < 0) {
+        return;
+    }
+    m_availableClients.removeAt(row);
+    if (!m_clientListWidget) {
+        return;
+    }
+    delete m_clientListWidget->takeItem(row);
+    ensureClientListPlaceholder();
+    refreshOngoingScenesList();
+}
+
+int ClientListPage::rowForClient(const QString& persistentClientId) const {
+    if (persistentClientId.isEmpty()) {
+        return -1;
+    }
+    for (int i = 0; i < m_availableClients.size(); ++i) {
+        if (m_availableClients.at(i).clientId() == persistentClientId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void ClientListPage::setEnabled(bool enabled) {
     if (m_clientListWidget) {
         m_clientListWidget->setEnabled(enabled);
@@ -52,6 +52,18 @@ public:
      */
     void updateClientList(const QList<ClientInfo>& clients);
 
+    /**
+     * @brief Insert or replace one client row (matched by persistent client ID)
+     * @param client Display entry; online clients are inserted ahead of offline ones
+     */
+    void upsertClient(const ClientInfo& client);
+
+    /**
+     * @brief Remove the row of one client
+     * @param persistentClientId Persistent client ID of the row to remove
+     */
+    void removeClient(const QString& persistentClientId);
+
     /**
      * @brief Refresh the list of ongoing scenes from session manager
      */
@@ -112,6 +124,11 @@ private:
      */
     void applyListWidgetStyle(QListWidget* listWidget);
 
+    /**
+     * @brief Row index of a client in m_availableClients, or -1
+     */
+    int rowForClient(const QString& persistentClientId) const;
+
     // Session manager (not owned)
     SessionManager* m_sessionManager;
 
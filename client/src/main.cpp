@@ -4,6 +4,10 @@
 #include <QDir>
 #include <QDebug>
 #include "MainWindow.h"
+#include "backend/managers/system/MetricsRegistry.h"
+#include "backend/managers/system/TraceRecorder.h"
+#include <QShortcut>
+#include <QKeySequence>
 
 namespace {
 // Remove the entire upload cache folder used by UploadManager:
@@ -38,6 +42,9 @@ int main(int argc, char *argv[]) {
     // Disable focus rectangle on all widgets (especially visible on Windows)
     app.setStyleSheet("* { outline: none; }");
     
+    // Structured perf metrics export (MOUFFETTE_METRICS_FILE / MOUFFETTE_METRICS_SOCKET)
+    Metrics::startExporterFromEnvironment(&app);
+
     // Ensure uploads cache is empty on startup
     cleanUploadsFolder();
 
@@ -49,6 +56,14 @@ int main(int argc, char *argv[]) {
 
     MainWindow window;
     QObject::connect(&app, &QGuiApplication::applicationStateChanged, &window, &MainWindow::handleApplicationStateChanged);
+    if (Trace::enabled()) {
+        // Dump the recorded timeline on demand (Ctrl+Alt+Shift+T) and on clean shutdown
+        auto dumpTrace = []() { Trace::writeChromeTrace(Trace::defaultTraceFilePath()); };
+        auto* traceShortcut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Alt+Shift+T")), &window);
+        traceShortcut->setContext(Qt::ApplicationShortcut);
+        QObject::connect(traceShortcut, &QShortcut::activated, &app, dumpTrace);
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, &app, dumpTrace);
+    }
     window.show(); // Explicitly show main window since tray UX removed
     return app.exec();
 }
@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 import argparse
+import json
 import re
 import statistics
 from pathlib import Path
@@ -75,6 +76,39 @@ def summarize(text_samples, canvas_samples):
     }
 
 
+def summarize_metrics(snapshot):
+    """Build the same summary from a MOUFFETTE_METRICS_FILE snapshot (cumulative counters)."""
+    counters = snapshot.get("counters", {})
+    raster = snapshot.get("histograms", {}).get("text.raster.durationMs", {})
+    completed = counters.get("text.raster.completed", 0)
+    dropped = counters.get("text.raster.dropped", 0)
+    stale = counters.get("text.raster.stale", 0)
+    zoom = counters.get("canvas.zoomEvents", 0)
+    relayout = counters.get("canvas.relayouts", 0)
+    return {
+        "completed": completed,
+        "dropped": dropped,
+        "stale": stale,
+        "avg_p95": raster.get("p95Ms", 0.0),
+        "avg_avg": raster.get("avgMs", 0.0),
+        "drop_ratio": (dropped / completed) if completed else 0.0,
+        "stale_ratio": (stale / completed) if completed else 0.0,
+        "zoom": zoom,
+        "relayout": relayout,
+        "full": counters.get("canvas.fullRelayouts", 0),
+        "chrome": counters.get("canvas.selectionChrome", 0),
+        "relayout_per_zoom": (relayout / zoom) if zoom else 0.0,
+    }
+
+
+def load_metrics_snapshot(path: Path):
+    try:
+        data = json.loads(path.read_text(encoding="utf-8", errors="ignore"))
+    except ValueError:
+        return None
+    return data if isinstance(data, dict) and "counters" in data else None
+
+
 def print_report(summary):
     print("Text/Canvas Perf Summary")
     print("========================")
@@ -92,13 +126,18 @@ def print_report(summary):
 
 
 def main():
-    parser = argparse.ArgumentParser(description="Summarize Mouffette text/canvas perf logs")
-    parser.add_argument("log", type=Path, help="Path to captured application log file")
+    parser = argparse.ArgumentParser(description="Summarize Mouffette text/canvas perf logs or metrics snapshots")
+    parser.add_argument("log", type=Path, help="Path to captured application log file or MOUFFETTE_METRICS_FILE snapshot")
     args = parser.parse_args()
 
     if not args.log.exists():
         raise SystemExit(f"Log file not found: {args.log}")
 
+    snapshot = load_metrics_snapshot(args.log)
+    if snapshot is not None:
+        print_report(summarize_metrics(snapshot))
+        return
+
     text_samples, canvas_samples = parse_log(args.log)
     summary = summarize(text_samples, canvas_samples)
     print_report(summary)
@@ -44,12 +44,20 @@ class MouffetteServer {
         
         // PHASE 2: Server-side state tracking
         this.uploads = new Map();        // uploadId -> { sender, target, canvasSessionId, startTime, files: [fileIds] }
+                                         // fan-out uploads carry fanOut: Map(targetClientId -> { targetPersistent, canvasSessionId, files }) instead of a single target
         this.clientFiles = new Map();    // persistentClientId -> Map(canvasSessionId -> Set(fileId))
         this.sessionsByPersistent = new Map(); // persistentClientId -> Set(sessionId)
         
         // PHASE 2: Active canvas tracking (CRITICAL for canvasSessionId validation)
         this.activeCanvases = new Map(); // persistentClientId -> Set(canvasSessionId)
         
+        // Versioned client directory: every published change bumps directoryVersion. Clients that
+        // register with the 'client_directory_delta' capability receive client_joined / client_left /
+        // client_updated events and request a fresh client_list snapshot when they detect a gap.
+        this.directoryVersion = 0;
+        this.directoryEntries = new Map(); // sessionId -> last published entry JSON
+        this.directoryPublishScheduled = false;
+        
         // PHASE 1: Upload timeout configuration
         this.UPLOAD_TIMEOUT_MS = 30 * 60 * 1000; // 30 minutes
         this.uploadCleanupInterval = null;
@@ -190,7 +198,7 @@ class MouffetteServer {
                     this.unregisterSessionForPersistent(clientInfo.persistentId, clientInfo.sessionId || finalId);
                 }
                 this.clients.delete(finalId);
-                this.broadcastClientList();
+                this.scheduleDirectoryPublish();
             });
             
             ws.on('error', (error) => {
@@ -227,13 +235,12 @@ class MouffetteServer {
                     this.unregisterSessionForPersistent(clientInfo.persistentId, clientInfo.sessionId || finalId);
                 }
                 this.clients.delete(finalId);
-                this.broadcastClientList();
+                this.scheduleDirectoryPublish();
             });
             
-            // Send current client list to new client
+            // Send current client list to new client. Unregistered sockets are not part of the
+            // directory, so nothing needs to be published to the others yet.
             this.sendClientList(clientId);
-            // Broadcast updated client list to all clients
-            this.broadcastClientList();
         });
     }
     
@@ -264,6 +271,10 @@ class MouffetteServer {
                 this.handleUploadStart(clientId, message);
                 break;
             case 'upload_chunk':
+                if (Array.isArray(message.targetClientIds)) {
+                    this.relayToTargets(clientId, message.targetClientIds, message);
+                    break;
+                }
                 // PHASE 2: Extract targetClientId with fallback
                 {
                     const targetClientId = message.targetPersistentClientId || message.targetClientId;
@@ -276,6 +287,11 @@ class MouffetteServer {
             case 'upload_abort':
                 this.handleUploadAbort(clientId, message);
                 break;
+            // LAN direct transfer negotiation: relayed as-is, the bytes then bypass the server
+            case 'direct_transfer_request':
+            case 'direct_transfer_offer':
+                this.relayToTarget(clientId, message.targetClientId, message);
+                break;
             case 'remove_all_files':
                 this.handleRemoveAllFiles(clientId, message);
                 break;
@@ -311,6 +327,15 @@ class MouffetteServer {
             case 'cursor_update':
                 this.handleCursorUpdate(clientId, message);
                 break;
+            case 'cursor_samples':
+                this.handleCursorSamples(clientId, message);
+                break;
+            case 'state_delta':
+                this.handleStateDelta(clientId, message);
+                break;
+            case 'state_hash':
+                this.handleStateHash(clientId, message);
+                break;
             case 'remote_scene_start':
                 // Relay to target client (like uploads). Expect: targetClientId, scene payload
                 console.log(`🎬 Received remote_scene_start from ${clientId} to ${message.targetClientId}`);
@@ -378,6 +403,26 @@ class MouffetteServer {
         }
     }
 
+    // Fan-out relay: the message is serialized once and the same frame goes to every target
+    relayToTargets(senderId, targetClientIds, message) {
+        if (!message.senderClientId) message.senderClientId = senderId;
+        const upload = message.uploadId ? this.uploads.get(message.uploadId) : null;
+        let payload = null;
+        for (const targetClientId of targetClientIds) {
+            // Targets dropped from a fan-out upload stop receiving its chunks
+            if (upload && upload.fanOut && !upload.fanOut.has(targetClientId)) continue;
+            const resolvedId = this.resolveClientId(targetClientId);
+            const targetClient = resolvedId ? this.clients.get(resolvedId) : null;
+            if (!targetClient || !targetClient.ws) continue;
+            if (!payload) payload = JSON.stringify(message);
+            try {
+                targetClient.ws.send(payload);
+            } catch (e) {
+                console.error('❌ Fan-out relay failed:', e);
+            }
+        }
+    }
+
     // Helper to relay a message from target -> sender
     relayToSender(targetId, senderClientId, message) {
         const senderClient = this.clients.get(senderClientId);
@@ -555,6 +600,11 @@ class MouffetteServer {
         }
         if (Object.prototype.hasOwnProperty.call(message, 'screens')) {
             client.screens = message.screens || [];
+            // A full snapshot defines the hashed state that later state_delta messages build on
+            client.stateHash = typeof message.stateHash === 'string' ? message.stateHash : null;
+            if (client.stateHash && typeof message.volumePercent !== 'number') {
+                client.volumePercent = -1;
+            }
         }
         if (Object.prototype.hasOwnProperty.call(message, 'systemUI') && Array.isArray(message.systemUI)) {
             client.systemUI = message.systemUI;
@@ -567,6 +617,11 @@ class MouffetteServer {
         } else if (!client.platform) {
             client.platform = 'unknown';
         }
+        if (Array.isArray(message.capabilities)) {
+            client.supportsDirectoryDelta = message.capabilities.includes('client_directory_delta');
+            client.supportsCursorSamples = message.capabilities.includes('cursor_samples');
+            client.supportsStateDelta = message.capabilities.includes('state_delta');
+        }
         
     console.log(`✅ Client registered: ${client.machineName} (${client.platform}) with ${client.screens.length} screen(s) [session: ${client.sessionId}] [persistent: ${client.persistentId}]`);
         
@@ -607,8 +662,9 @@ class MouffetteServer {
             }
         }
         
-        // Broadcast updated client list
-        this.broadcastClientList();
+        // Publish the change to everyone else; the registering client starts from a fresh snapshot
+        this.scheduleDirectoryPublish();
+        this.sendClientList(client.id);
     // Notify watchers of this target with fresh screens
     this.notifyWatchersOfTarget(client.id);  // Use actual client.id
     }
@@ -633,20 +689,89 @@ class MouffetteServer {
         
         client.ws.send(JSON.stringify({
             type: 'client_list',
+            version: this.directoryVersion,
             clients: clientList
         }));
     }
     
+    // Full list for every registered client that does not understand directory deltas
     broadcastClientList() {
         for (const [clientId, client] of this.clients) {
-            if (client.machineName) { // Only send to registered clients
+            if (client.machineName && !client.supportsDirectoryDelta) { // Only send to registered clients
                 this.sendClientList(clientId);
             }
         }
     }
     
+    directoryEntryFor(c) {
+        return {
+            id: c.id,
+            sessionId: c.sessionId || c.id,
+            persistentClientId: c.persistentId,
+            machineName: c.machineName,
+            screens: c.screens,
+            platform: c.platform,
+            systemUI: c.systemUI || [],
+            volumePercent: c.volumePercent,
+            status: c.status
+        };
+    }
+    
+    // Coalesce every change made during this tick (e.g. a reconnect storm) into one publish
+    scheduleDirectoryPublish() {
+        if (this.directoryPublishScheduled) return;
+        this.directoryPublishScheduled = true;
+        setImmediate(() => {
+            this.directoryPublishScheduled = false;
+            this.publishDirectoryChanges();
+        });
+    }
+    
+    // Diff the registered clients against the last published directory and send each delta once,
+    // serialised once, to every delta-capable client. Legacy clients still get the full list.
+    publishDirectoryChanges() {
+        const events = [];
+        const current = new Map();
+        for (const c of this.clients.values()) {
+            if (!c.machineName || !c.persistentId) continue;
+            const entry = this.directoryEntryFor(c);
+            const json = JSON.stringify(entry);
+            current.set(c.id, json);
+            const previous = this.directoryEntries.get(c.id);
+            if (previous === undefined) {
+                events.push({ type: 'client_joined', client: entry });
+            } else if (previous !== json) {
+                events.push({ type: 'client_updated', client: entry });
+            }
+        }
+        for (const [id, json] of this.directoryEntries) {
+            if (!current.has(id)) {
+                const entry = JSON.parse(json);
+                events.push({ type: 'client_left', id: id, persistentClientId: entry.persistentClientId });
+            }
+        }
+        this.directoryEntries = current;
+        if (events.length === 0) return;
+        
+        const payloads = events.map(event => {
+            this.directoryVersion += 1;
+            return JSON.stringify({ ...event, version: this.directoryVersion });
+        });
+        for (const client of this.clients.values()) {
+            if (!client.machineName || !client.supportsDirectoryDelta) continue;
+            if (!client.ws || client.ws.readyState !== WebSocket.OPEN) continue;
+            for (const payload of payloads) {
+                client.ws.send(payload);
+            }
+        }
+        this.broadcastClientList();
+    }
+    
     // PHASE 2: Upload state tracking methods
     handleUploadStart(senderId, message) {
+        if (Array.isArray(message.fanOut)) {
+            return this.handleFanOutUploadStart(senderId, message);
+        }
         // PHASE 2: Read targetPersistentClientId (new) with fallback to targetClientId (legacy)
         const targetClientId = message.targetPersistentClientId || message.targetClientId;
         const { uploadId, canvasSessionId, files } = message;
@@ -681,6 +806,8 @@ class MouffetteServer {
         
         console.log(`   Files: ${fileIds.length > 0 ? fileIds.length + ' file(s)' : 'none'}`);
         
+        // relay === false: tracking copy of a transfer streamed over a direct LAN link
+        if (message.relay === false) return;
         // Relay to target WITHOUT modifying canvasSessionId
         this.relayToTarget(senderId, targetClientId, message);
     }
@@ -691,8 +818,16 @@ class MouffetteServer {
         const { uploadId, canvasSessionId } = message;
         const upload = this.uploads.get(uploadId);
         
+        if (message.fanOut) {
+            if (!upload || !upload.fanOut) {
+                console.warn(`⚠️ fan-out upload_complete for unknown uploadId: ${uploadId}`);
+                return;
+            }
+            return this.handleFanOutUploadComplete(senderId, message, upload);
+        }
         if (!upload) {
             console.warn(`⚠️ upload_complete for unknown uploadId: ${uploadId}`);
+            if (message.relay === false) return;
             // Still relay (backward compatibility)
             return this.relayToTarget(senderId, targetClientId, message);
         }
@@ -703,17 +838,7 @@ class MouffetteServer {
         // Track files received by target
         const effectiveTarget = upload.targetPersistent;
         const effectiveIdea = upload.canvasSessionId;
-        
-        if (!this.clientFiles.has(effectiveTarget)) {
-            this.clientFiles.set(effectiveTarget, new Map());
-        }
-        const targetIdeas = this.clientFiles.get(effectiveTarget);
-        if (!targetIdeas.has(effectiveIdea)) {
-            targetIdeas.set(effectiveIdea, new Set());
-        }
-        
-        const ideaFiles = targetIdeas.get(effectiveIdea);
-        upload.files.forEach(fileId => ideaFiles.add(fileId));
+        this.recordClientFiles(effectiveTarget, effectiveIdea, upload.files);
         
         const duration = ((Date.now() - upload.startTime) / 1000).toFixed(1);
         console.log(`✅ Upload complete: ${uploadId} (${duration}s) - ${upload.files.length} files to ${effectiveTarget}:${effectiveIdea}`);
@@ -721,16 +846,124 @@ class MouffetteServer {
         // Cleanup upload tracking
         this.uploads.delete(uploadId);
         
+        if (message.relay === false) return;
         // Relay to target
         this.relayToTarget(senderId, targetClientId, message);
     }
     
+    recordClientFiles(targetPersistent, canvasSessionId, fileIds) {
+        if (!this.clientFiles.has(targetPersistent)) {
+            this.clientFiles.set(targetPersistent, new Map());
+        }
+        const targetIdeas = this.clientFiles.get(targetPersistent);
+        if (!targetIdeas.has(canvasSessionId)) {
+            targetIdeas.set(canvasSessionId, new Set());
+        }
+        const ideaFiles = targetIdeas.get(canvasSessionId);
+        fileIds.forEach(fileId => ideaFiles.add(fileId));
+    }
+
+    // Per-target copy of a fan-out control message, shaped like the single-target form
+    fanOutMessageFor(message, targetClientId, target) {
+        const perTarget = {
+            ...message,
+            targetClientId,
+            targetPersistentClientId: targetClientId,
+            canvasSessionId: target.canvasSessionId
+        };
+        delete perTarget.fanOut;
+        delete perTarget.targetClientIds;
+        return perTarget;
+    }
+
+    // Fan-out: one sender stream, split here into a regular upload_start per target
+    handleFanOutUploadStart(senderId, message) {
+        const { uploadId } = message;
+        const manifest = Array.isArray(message.files) ? message.files : [];
+        if (!uploadId || message.fanOut.length === 0) {
+            console.warn(`⚠️ fan-out upload_start missing required fields from ${senderId}`);
+            return this.sendError(senderId, 'Missing uploadId or fan-out targets');
+        }
+
+        const targets = new Map();
+        for (const entry of message.fanOut) {
+            const targetClientId = entry && entry.targetClientId;
+            if (!targetClientId || !entry.canvasSessionId || targets.has(targetClientId)) continue;
+            const wanted = new Set(Array.isArray(entry.fileIds) ? entry.fileIds : []);
+            const targetManifest = manifest.filter(f => f && wanted.has(f.fileId));
+            if (targetManifest.length === 0) continue;
+            targets.set(targetClientId, {
+                targetPersistent: this.getPersistentId(targetClientId),
+                canvasSessionId: entry.canvasSessionId,
+                files: targetManifest.map(f => f.fileId),
+                manifest: targetManifest
+            });
+        }
+        if (targets.size === 0) {
+            return this.sendError(senderId, 'Fan-out upload has no target needing files');
+        }
+
+        const senderPersistentId = this.getPersistentId(senderId);
+        this.uploads.set(uploadId, {
+            senderSession: senderId,
+            senderPersistent: senderPersistentId,
+            fanOut: targets,
+            startTime: Date.now(),
+            files: manifest.map(f => f && f.fileId).filter(Boolean)
+        });
+        console.log(`📤 Fan-out upload started: ${senderPersistentId}/${senderId} -> ${targets.size} target(s) [${uploadId}], ${manifest.length} file(s)`);
+
+        for (const [targetClientId, target] of targets) {
+            const perTarget = this.fanOutMessageFor(message, targetClientId, target);
+            perTarget.files = target.manifest;
+            this.relayToTarget(senderId, targetClientId, perTarget);
+            delete target.manifest;
+        }
+    }
+
+    handleFanOutUploadComplete(senderId, message, upload) {
+        const { uploadId } = message;
+        for (const [targetClientId, target] of upload.fanOut) {
+            this.recordClientFiles(target.targetPersistent, target.canvasSessionId, target.files);
+            this.relayToTarget(senderId, targetClientId, this.fanOutMessageFor(message, targetClientId, target));
+        }
+        const duration = ((Date.now() - upload.startTime) / 1000).toFixed(1);
+        console.log(`✅ Fan-out upload complete: ${uploadId} (${duration}s) - ${upload.files.length} files to ${upload.fanOut.size} target(s)`);
+        this.uploads.delete(uploadId);
+    }
+
+    // Aborts the listed targets of a fan-out upload, or all of them when none are listed
+    handleFanOutUploadAbort(senderId, message) {
+        const { uploadId } = message;
+        const upload = this.uploads.get(uploadId);
+        if (!upload || !upload.fanOut) return;
+        const targetClientIds = Array.isArray(message.targetClientIds) && message.targetClientIds.length > 0
+            ? message.targetClientIds
+            : [...upload.fanOut.keys()];
+        for (const targetClientId of targetClientIds) {
+            const target = upload.fanOut.get(targetClientId);
+            if (!target) continue;
+            upload.fanOut.delete(targetClientId);
+            this.relayToTarget(senderId, targetClientId, this.fanOutMessageFor(message, targetClientId, target));
+        }
+        if (upload.fanOut.size === 0) {
+            console.log(`❌ Fan-out upload aborted: ${uploadId}`);
+            this.uploads.delete(uploadId);
+        } else {
+            console.log(`❌ Fan-out upload ${uploadId}: dropped ${targetClientIds.length} target(s), ${upload.fanOut.size} remaining`);
+        }
+    }
+
     handleUploadAbort(senderId, message) {
+        if (message.fanOut) {
+            return this.handleFanOutUploadAbort(senderId, message);
+        }
         const { uploadId } = message;
         if (uploadId && this.uploads.has(uploadId)) {
             console.log(`❌ Upload aborted: ${uploadId}`);
             this.uploads.delete(uploadId);
         }
+        if (message.relay === false) return;
         // PHASE 2: Extract targetClientId with fallback
         const targetClientId = message.targetPersistentClientId || message.targetClientId;
         this.relayToTarget(senderId, targetClientId, message);
@@ -934,14 +1167,38 @@ class MouffetteServer {
         const x = typeof message.x === 'number' ? Math.round(message.x) : null;
         const y = typeof message.y === 'number' ? Math.round(message.y) : null;
         if (x === null || y === null) return;
+        const payload = JSON.stringify({ type: 'cursor_update', targetClientId: targetId, x, y });
         for (const watcherId of watchers) {
             const watcher = this.clients.get(watcherId);
             if (!watcher || !watcher.ws) continue;
-            watcher.ws.send(JSON.stringify({
-                type: 'cursor_update',
-                targetClientId: targetId,
-                x, y
-            }));
+            watcher.ws.send(payload);
+        }
+    }
+
+    handleCursorSamples(targetId, message) {
+        // Forward a batch of cursor samples; watchers without the capability get the newest position
+        const watchers = this.watchersByTarget.get(targetId);
+        if (!watchers || watchers.size === 0) return;
+        if (typeof message.x !== 'number' || typeof message.y !== 'number') return;
+        let batchPayload = null;
+        let legacyPayload = null;
+        for (const watcherId of watchers) {
+            const watcher = this.clients.get(watcherId);
+            if (!watcher || !watcher.ws) continue;
+            if (watcher.supportsCursorSamples) {
+                if (!batchPayload) batchPayload = JSON.stringify({ ...message, targetClientId: targetId });
+                watcher.ws.send(batchPayload);
+            } else {
+                if (!legacyPayload) {
+                    legacyPayload = JSON.stringify({
+                        type: 'cursor_update',
+                        targetClientId: targetId,
+                        x: Math.round(message.x),
+                        y: Math.round(message.y)
+                    });
+                }
+                watcher.ws.send(legacyPayload);
+            }
         }
     }
     
@@ -997,28 +1254,98 @@ class MouffetteServer {
         this.watchingByWatcher.delete(watcherId);
     }
     
-    notifyWatchersOfTarget(targetId) {
+    notifyWatchersOfTarget(targetId, legacyOnly = false) {
         const set = this.watchersByTarget.get(targetId);
         if (!set || set.size === 0) return;
         const target = this.clients.get(targetId);
         if (!target) return;
+        let payload = null;
         for (const watcherId of set) {
             const watcher = this.clients.get(watcherId);
             if (!watcher || !watcher.ws) continue;
-            watcher.ws.send(JSON.stringify({
-                type: 'screens_info',
-                clientInfo: {
-                    id: target.id,
-                    sessionId: target.sessionId || target.id,
-                    persistentClientId: target.persistentId || target.id,
-                    machineName: target.machineName,
-                    platform: target.platform,
-                    screens: target.screens,
-                    systemUI: target.systemUI || [],
-                    volumePercent: target.volumePercent
-                }
-            }));
+            if (legacyOnly && watcher.supportsStateDelta) continue;
+            if (!payload) {
+                payload = JSON.stringify({
+                    type: 'screens_info',
+                    clientInfo: {
+                        id: target.id,
+                        sessionId: target.sessionId || target.id,
+                        persistentClientId: target.persistentId || target.id,
+                        machineName: target.machineName,
+                        platform: target.platform,
+                        screens: target.screens,
+                        systemUI: target.systemUI || [],
+                        volumePercent: target.volumePercent
+                    }
+                });
+            }
+            watcher.ws.send(payload);
+        }
+    }
+
+    // Send a message to watchers of targetId that registered the state_delta capability
+    sendToStateDeltaWatchers(targetId, message) {
+        const set = this.watchersByTarget.get(targetId);
+        if (!set || set.size === 0) return;
+        let payload = null;
+        for (const watcherId of set) {
+            const watcher = this.clients.get(watcherId);
+            if (!watcher || !watcher.ws || !watcher.supportsStateDelta) continue;
+            if (!payload) payload = JSON.stringify(message);
+            watcher.ws.send(payload);
+        }
+    }
+
+    requestStateSnapshot(client) {
+        client.stateHash = null;
+        if (client.ws) {
+            client.ws.send(JSON.stringify({ type: 'data_request', fields: ['screens', 'volume'] }));
+        }
+    }
+
+    handleStateDelta(clientId, message) {
+        const client = this.clients.get(clientId);
+        if (!client || !client.machineName) return;
+        if (!client.stateHash || message.baseHash !== client.stateHash || typeof message.hash !== 'string') {
+            // Our copy is not the state this delta was made against
+            this.requestStateSnapshot(client);
+            return;
+        }
+        let screens = Array.isArray(client.screens) ? client.screens.slice() : [];
+        if (Array.isArray(message.removedScreenIds)) {
+            const removed = new Set(message.removedScreenIds);
+            screens = screens.filter(s => !removed.has(s.id));
+        }
+        if (Array.isArray(message.screens)) {
+            for (const screen of message.screens) {
+                const index = screens.findIndex(s => s.id === screen.id);
+                if (index >= 0) screens[index] = screen; else screens.push(screen);
+            }
+        }
+        client.screens = screens;
+        if (typeof message.volumePercent === 'number') {
+            client.volumePercent = message.volumePercent < 0 ? -1 : Math.min(100, Math.round(message.volumePercent));
+        }
+        client.stateHash = message.hash;
+
+        const delta = { type: 'state_delta', targetClientId: client.id, baseHash: message.baseHash, hash: message.hash };
+        if (Array.isArray(message.screens)) delta.screens = message.screens;
+        if (Array.isArray(message.removedScreenIds)) delta.removedScreenIds = message.removedScreenIds;
+        if (typeof message.volumePercent === 'number') delta.volumePercent = client.volumePercent;
+        this.sendToStateDeltaWatchers(client.id, delta);
+        this.notifyWatchersOfTarget(client.id, true);
+        // Directory entries carry screens and volume too; the publish diff skips unchanged entries
+        this.scheduleDirectoryPublish();
+    }
+
+    handleStateHash(clientId, message) {
+        const client = this.clients.get(clientId);
+        if (!client || !client.machineName) return;
+        if (!client.stateHash || message.hash !== client.stateHash) {
+            this.requestStateSnapshot(client);
+            return;
         }
+        this.sendToStateDeltaWatchers(client.id, { type: 'state_hash', targetClientId: client.id, hash: client.stateHash });
     }
     
     getStats() {